@@ -0,0 +1,228 @@
+#include <Ryme/Ryme.hpp>
+#include <Ryme/Camera.hpp>
+#include <Ryme/Mesh.hpp>
+#include <Ryme/RenderSystem.hpp>
+
+#include <cmath>
+#include <random>
+
+using namespace ryme;
+
+// A field of instances is flown over, and the triangles drawn with LODs chosen by the RenderSystem
+// are compared against drawing every instance at full detail. Selection runs on the CPU exactly as it
+// does in SelectLODs(), so no GPU is needed.
+
+constexpr uint32_t SphereSegments = 256;
+
+constexpr uint32_t SphereRings = 128;
+
+constexpr size_t InstanceCount = 20000;
+
+constexpr float FieldSize = 2000.0f;
+
+constexpr uint32_t ScreenHeight = 720;
+
+constexpr int FrameCount = 240;
+
+// A bumpy sphere, with a UV seam down one side and split poles, so the simplifier has to preserve
+// attribute seams
+MeshData generateSphere()
+{
+    MeshData data;
+
+    for (uint32_t ring = 0; ring <= SphereRings; ++ring) {
+        float v = float(ring) / SphereRings;
+        float theta = v * glm::pi<float>();
+
+        // The poles and both sides of the seam must land on exactly the same positions to be welded
+        float sinTheta = (ring == 0 or ring == SphereRings ? 0.0f : std::sin(theta));
+
+        for (uint32_t segment = 0; segment <= SphereSegments; ++segment) {
+            float u = float(segment) / SphereSegments;
+            float phi = float(segment % SphereSegments) / SphereSegments * glm::two_pi<float>();
+
+            Vec3 normal = {
+                sinTheta * std::cos(phi),
+                std::cos(theta),
+                sinTheta * std::sin(phi),
+            };
+
+            float radius = 1.0f + 0.05f * std::sin(theta * 12.0f) * std::cos(phi * 8.0f);
+
+            data.VertexList.push_back(Vertex{
+                .Position = Vec4(normal * radius, 1.0f),
+                .Normal = Vec4(normal, 0.0f),
+                .Color = Vec4(1.0f),
+                .TexCoord = Vec2(u, v),
+            });
+        }
+    }
+
+    const uint32_t stride = SphereSegments + 1;
+
+    for (uint32_t ring = 0; ring < SphereRings; ++ring) {
+        for (uint32_t segment = 0; segment < SphereSegments; ++segment) {
+            uint32_t i0 = ring * stride + segment;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + stride;
+            uint32_t i3 = i2 + 1;
+
+            if (ring > 0) {
+                data.IndexList.insert(data.IndexList.end(), { i0, i1, i2 });
+            }
+
+            if (ring < SphereRings - 1) {
+                data.IndexList.insert(data.IndexList.end(), { i1, i3, i2 });
+            }
+        }
+    }
+
+    return data;
+}
+
+struct Instance
+{
+    Vec3 Position;
+
+    float Scale;
+
+    uint32_t LOD = 0;
+
+    uint32_t LODWithoutHysteresis = 0;
+
+}; // struct Instance
+
+int main(int argc, char ** argv)
+{
+    try {
+        MeshData data = generateSphere();
+
+        /// LOD Generation
+
+        ProfileZone generateZone("Generate", true);
+
+        data.GenerateLODs({ 0.5f, 0.25f, 0.125f, 0.0625f, 0.03125f });
+
+        double generateMilliseconds = generateZone.End();
+
+        const size_t fullTriangleCount = data.IndexList.size() / 3;
+
+        Log(RYME_ANCHOR, "Generated {} LODs for {} triangles in {:.1f} ms",
+            data.LODList.size(),
+            fullTriangleCount,
+            generateMilliseconds
+        );
+
+        List<float> lodErrorList = { 0.0f };
+        List<size_t> lodTriangleCountList = { fullTriangleCount };
+
+        for (const auto& lod : data.LODList) {
+            lodErrorList.push_back(lod.Error);
+            lodTriangleCountList.push_back(lod.IndexList.size() / 3);
+
+            Log(RYME_ANCHOR, "LOD {}: {} triangles ({:.1f}%), error {:.5f}",
+                lodErrorList.size() - 1,
+                lod.IndexList.size() / 3,
+                100.0 * lod.IndexList.size() / data.IndexList.size(),
+                lod.Error
+            );
+        }
+
+        /// Stress Scene
+
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> positionDistribution(-FieldSize * 0.5f, FieldSize * 0.5f);
+        std::uniform_real_distribution<float> scaleDistribution(1.0f, 4.0f);
+
+        List<Instance> instanceList(InstanceCount);
+        for (auto& instance : instanceList) {
+            instance.Position = Vec3(positionDistribution(random), 0.0f, positionDistribution(random));
+            instance.Scale = scaleDistribution(random);
+        }
+
+        Camera camera;
+        camera.SetAspect(Vec2(1280.0f, ScreenHeight));
+
+        Mat4 projection = camera.GetProjection();
+        float pixelsPerUnitAtOne = std::fabs(projection[1][1]) * ScreenHeight * 0.5f;
+
+        const float threshold = 1.0f;
+        const float hysteresis = 0.25f;
+
+        size_t totalTriangleCount = 0;
+        size_t totalFullTriangleCount = 0;
+        size_t switchCount = 0;
+        size_t switchCountWithoutHysteresis = 0;
+
+        ProfileZone selectZone("Select", true);
+
+        for (int frame = 0; frame < FrameCount; ++frame) {
+            // Fly across the field at a low altitude, swaying and bobbing, which moves instances back and
+            // forth across the LOD thresholds
+            float t = float(frame) / FrameCount;
+            camera.Transform.Position = Vec3(
+                (t - 0.5f) * FieldSize + 20.0f * std::sin(frame * 0.8f),
+                20.0f + 10.0f * std::sin(t * 40.0f),
+                0.0f
+            );
+
+            for (auto& instance : instanceList) {
+                float distance = glm::length(instance.Position - camera.Transform.Position) - instance.Scale;
+                float pixelsPerUnit = pixelsPerUnitAtOne / std::max(distance, camera.GetNear()) * instance.Scale;
+
+                // The first frame starts every instance at full detail, so its switches are not counted
+                uint32_t lod = RenderSystem::SelectLOD(lodErrorList, pixelsPerUnit, instance.LOD, threshold, hysteresis);
+                if (frame > 0 and lod != instance.LOD) {
+                    ++switchCount;
+                }
+
+                uint32_t lodWithoutHysteresis = RenderSystem::SelectLOD(
+                    lodErrorList,
+                    pixelsPerUnit,
+                    instance.LODWithoutHysteresis,
+                    threshold,
+                    0.0f
+                );
+
+                if (frame > 0 and lodWithoutHysteresis != instance.LODWithoutHysteresis) {
+                    ++switchCountWithoutHysteresis;
+                }
+
+                instance.LOD = lod;
+                instance.LODWithoutHysteresis = lodWithoutHysteresis;
+
+                totalTriangleCount += lodTriangleCountList[lod];
+                totalFullTriangleCount += fullTriangleCount;
+            }
+        }
+
+        double selectMilliseconds = selectZone.End() / FrameCount;
+
+        Log(RYME_ANCHOR, "Selected LODs for {} instances in {:.3f} ms per frame",
+            InstanceCount,
+            selectMilliseconds
+        );
+
+        Log(RYME_ANCHOR, "Without LODs: {:.1f}M triangles per frame",
+            totalFullTriangleCount / (FrameCount * 1e6)
+        );
+
+        Log(RYME_ANCHOR, "With LODs: {:.1f}M triangles per frame, {:.1f}x fewer ({:.1f}% saved)",
+            totalTriangleCount / (FrameCount * 1e6),
+            double(totalFullTriangleCount) / double(totalTriangleCount),
+            100.0 * (1.0 - double(totalTriangleCount) / double(totalFullTriangleCount))
+        );
+
+        Log(RYME_ANCHOR, "LOD switches per frame: {:.1f} with hysteresis, {:.1f} without",
+            double(switchCount) / (FrameCount - 1),
+            double(switchCountWithoutHysteresis) / (FrameCount - 1)
+        );
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include <Ryme/Ryme.hpp>
+#include <Ryme/Camera.hpp>
+#include <Ryme/Frustum.hpp>
+#include <Ryme/Mesh.hpp>
+#include <Ryme/Meshlet.hpp>
+
+#include <cmath>
+
+using namespace ryme;
+
+// A dense mesh is split into meshlets, then viewed from all around it, near and far. The meshlets culled
+// against the frustum and by their normal cones are counted exactly as MeshletCuller does on the GPU,
+// so no GPU is needed.
+
+constexpr uint32_t SphereSegments = 512;
+
+constexpr uint32_t SphereRings = 256;
+
+constexpr uint32_t ViewCount = 64;
+
+// A bumpy sphere, which is dense enough to split into thousands of meshlets
+MeshData generateSphere()
+{
+    MeshData data;
+
+    for (uint32_t ring = 0; ring <= SphereRings; ++ring) {
+        float v = float(ring) / SphereRings;
+        float theta = v * glm::pi<float>();
+
+        float sinTheta = (ring == 0 or ring == SphereRings ? 0.0f : std::sin(theta));
+
+        for (uint32_t segment = 0; segment <= SphereSegments; ++segment) {
+            float u = float(segment) / SphereSegments;
+            float phi = float(segment % SphereSegments) / SphereSegments * glm::two_pi<float>();
+
+            Vec3 normal = {
+                sinTheta * std::cos(phi),
+                std::cos(theta),
+                sinTheta * std::sin(phi),
+            };
+
+            float radius = 1.0f + 0.05f * std::sin(theta * 12.0f) * std::cos(phi * 8.0f);
+
+            data.VertexList.push_back(Vertex{
+                .Position = Vec4(normal * radius, 1.0f),
+                .Normal = Vec4(normal, 0.0f),
+                .Color = Vec4(1.0f),
+                .TexCoord = Vec2(u, v),
+            });
+        }
+    }
+
+    const uint32_t stride = SphereSegments + 1;
+
+    for (uint32_t ring = 0; ring < SphereRings; ++ring) {
+        for (uint32_t segment = 0; segment < SphereSegments; ++segment) {
+            uint32_t i0 = ring * stride + segment;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + stride;
+            uint32_t i3 = i2 + 1;
+
+            if (ring > 0) {
+                data.IndexList.insert(data.IndexList.end(), { i0, i1, i2 });
+            }
+
+            if (ring < SphereRings - 1) {
+                data.IndexList.insert(data.IndexList.end(), { i1, i3, i2 });
+            }
+        }
+    }
+
+    return data;
+}
+
+struct View
+{
+    const char * Name;
+
+    float Distance;
+
+    // How far the camera is turned away from the center of the mesh
+    float Angle;
+
+}; // struct View
+
+int main(int argc, char ** argv)
+{
+    try {
+        MeshData data = generateSphere();
+
+        const size_t triangleCount = data.IndexList.size() / 3;
+
+        /// Meshlet Generation
+
+        ProfileZone buildZone("Build", true);
+
+        MeshletData meshletData = data.BuildMeshlets();
+
+        double buildMilliseconds = buildZone.End();
+
+        size_t meshletVertexCount = 0;
+        size_t uncullableCount = 0;
+
+        for (size_t i = 0; i < meshletData.MeshletList.size(); ++i) {
+            meshletVertexCount += meshletData.MeshletList[i].VertexCount;
+
+            if (meshletData.BoundsList[i].ConeCutoff >= 1.0f) {
+                ++uncullableCount;
+            }
+        }
+
+        Log(RYME_ANCHOR, "Built {} meshlets for {} triangles in {:.1f} ms",
+            meshletData.MeshletList.size(),
+            triangleCount,
+            buildMilliseconds
+        );
+
+        Log(RYME_ANCHOR, "Average of {:.1f} vertices and {:.1f} triangles per meshlet, {} without a normal cone",
+            double(meshletVertexCount) / meshletData.MeshletList.size(),
+            double(triangleCount) / meshletData.MeshletList.size(),
+            uncullableCount
+        );
+
+        /// Culling
+
+        const List<View> viewList = {
+            { "Far", 10.0f, 0.0f },
+            { "Near", 2.0f, 0.0f },
+            { "Close", 1.2f, 0.0f },
+            { "Glancing", 2.0f, 0.45f },
+            { "Away", 2.0f, glm::pi<float>() },
+        };
+
+        Camera camera;
+        camera.SetAspect(Vec2(1280.0f, 720.0f));
+
+        List<vk::DrawIndexedIndirectCommand> drawList;
+
+        for (const auto& view : viewList) {
+            MeshletCullStats totalStats;
+            size_t drawCount = 0;
+
+            ProfileZone cullZone("Cull", true);
+
+            // Orbit around the mesh, so every side of it is seen
+            for (uint32_t i = 0; i < ViewCount; ++i) {
+                float orbit = float(i) / ViewCount * glm::two_pi<float>();
+
+                Vec3 position = Vec3(std::cos(orbit), 0.3f, std::sin(orbit)) * view.Distance;
+                Vec3 toCenter = glm::normalize(-position);
+
+                camera.Transform.Position = position;
+                camera.SetForward(glm::angleAxis(view.Angle, camera.GetUp()) * toCenter);
+
+                // The mesh has no transform, so its space is world space
+                Frustum frustum = Frustum::FromMatrix(camera.GetProjection() * camera.GetView());
+
+                auto stats = CullMeshlets(meshletData, frustum, position, drawList);
+
+                totalStats.MeshletCount += stats.MeshletCount;
+                totalStats.FrustumCulledCount += stats.FrustumCulledCount;
+                totalStats.ConeCulledCount += stats.ConeCulledCount;
+                totalStats.VisibleTriangleCount += stats.VisibleTriangleCount;
+
+                drawCount += drawList.size();
+            }
+
+            double cullMilliseconds = cullZone.End() / ViewCount;
+
+            Log(RYME_ANCHOR, "{}: {:.1f}% frustum culled, {:.1f}% cone culled, {:.1f}% of triangles drawn in {:.1f} draws, {:.3f} ms",
+                view.Name,
+                100.0 * totalStats.FrustumCulledCount / totalStats.MeshletCount,
+                100.0 * totalStats.ConeCulledCount / totalStats.MeshletCount,
+                100.0 * totalStats.VisibleTriangleCount / (triangleCount * ViewCount),
+                double(drawCount) / ViewCount,
+                cullMilliseconds
+            );
+        }
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#version 450 core
+
+layout(location = 0) in vec4 v_Normal;
+
+layout (location = 0) out vec4 o_Color;
+
+void main() {
+    o_Color = vec4(normalize(v_Normal.xyz) * 0.5 + 0.5, 1);
+}
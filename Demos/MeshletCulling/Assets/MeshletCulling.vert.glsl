@@ -0,0 +1,15 @@
+#version 450 core
+
+#include <Ryme/VertexAttributes.inc.glsl>
+
+layout(push_constant) uniform MeshletCullingConstants
+{
+    mat4 u_MVP;
+};
+
+layout(location = 0) out vec4 v_Normal;
+
+void main() {
+    gl_Position = u_MVP * a_Position;
+    v_Normal = a_Normal;
+}
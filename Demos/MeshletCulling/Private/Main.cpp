@@ -0,0 +1,228 @@
+#include <Ryme/Ryme.hpp>
+#include <Ryme/Camera.hpp>
+#include <Ryme/Frustum.hpp>
+#include <Ryme/Mesh.hpp>
+#include <Ryme/Meshlet.hpp>
+#include <Ryme/MeshletCuller.hpp>
+#include <Ryme/Pipeline.hpp>
+#include <Ryme/Shader.hpp>
+
+#include <cmath>
+
+using namespace ryme;
+
+// A dense mesh is split into meshlets, which are culled by MeshletCuller on the GPU and drawn with
+// indirect draws while the camera orbits it. The view changes every frame, so the command buffers are
+// recorded again every frame as well. The meshlets the CPU culling keeps are logged alongside, as
+// the GPU draws the same ones.
+
+constexpr uint32_t SphereSegments = 256;
+
+constexpr uint32_t SphereRings = 128;
+
+// A bumpy sphere, which is dense enough to split into hundreds of meshlets
+MeshData generateSphere()
+{
+    MeshData data;
+
+    for (uint32_t ring = 0; ring <= SphereRings; ++ring) {
+        float v = float(ring) / SphereRings;
+        float theta = v * glm::pi<float>();
+
+        float sinTheta = (ring == 0 or ring == SphereRings ? 0.0f : std::sin(theta));
+
+        for (uint32_t segment = 0; segment <= SphereSegments; ++segment) {
+            float u = float(segment) / SphereSegments;
+            float phi = float(segment % SphereSegments) / SphereSegments * glm::two_pi<float>();
+
+            Vec3 normal = {
+                sinTheta * std::cos(phi),
+                std::cos(theta),
+                sinTheta * std::sin(phi),
+            };
+
+            float radius = 1.0f + 0.05f * std::sin(theta * 12.0f) * std::cos(phi * 8.0f);
+
+            data.VertexList.push_back(Vertex{
+                .Position = Vec4(normal * radius, 1.0f),
+                .Normal = Vec4(normal, 0.0f),
+                .Color = Vec4(1.0f),
+                .TexCoord = Vec2(u, v),
+            });
+        }
+    }
+
+    const uint32_t stride = SphereSegments + 1;
+
+    for (uint32_t ring = 0; ring < SphereRings; ++ring) {
+        for (uint32_t segment = 0; segment < SphereSegments; ++segment) {
+            uint32_t i0 = ring * stride + segment;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + stride;
+            uint32_t i3 = i2 + 1;
+
+            if (ring > 0) {
+                data.IndexList.insert(data.IndexList.end(), { i0, i1, i2 });
+            }
+
+            if (ring < SphereRings - 1) {
+                data.IndexList.insert(data.IndexList.end(), { i1, i3, i2 });
+            }
+        }
+    }
+
+    return data;
+}
+
+int main(int argc, char ** argv)
+{
+    try {
+        Init({
+            .ApplicationName = DEMO_NAME,
+            .ApplicationVersion = GetVersion(),
+            .WindowTitle = DEMO_NAME " (" RYME_VERSION_STRING ")",
+            .WindowSize = { 1280, 720 },
+        });
+
+        {
+            MeshData data = generateSphere();
+
+            // Reorders the indices, so it has to be done before the mesh is created from them
+            MeshletData meshletData = data.BuildMeshlets();
+
+            Mesh mesh(std::move(data));
+
+            MeshletCuller culler;
+            culler.Create(meshletData);
+
+            Log(RYME_ANCHOR, "Culling {} meshlets on the GPU, draw count {}supported, multi draw {}supported",
+                culler.GetMeshletCount(),
+                (Graphics::IsDrawIndirectCountSupported() ? "" : "not "),
+                (Graphics::IsMultiDrawIndirectSupported() ? "" : "not ")
+            );
+
+            Shader shader;
+            if (not shader.LoadFromFiles({ "MeshletCulling.vert", "MeshletCulling.frag" })) {
+                throw Exception("Failed to load 'MeshletCulling' shaders");
+            }
+
+            Pipeline pipeline(&shader);
+
+            Camera camera;
+            Mat4 viewProjection = Mat4(1.0f);
+
+            // The render passes are created again along with the swapchain
+            vk::RenderPass pipelineRenderPass;
+
+            Graphics::SetRenderGraphFunc([&](RenderGraph& renderGraph) {
+                auto depthImage = renderGraph.CreateImage("Depth", {
+                    .Format = Graphics::GetDepthImageFormat(),
+                });
+
+                // Nothing reads what it writes as far as the graph knows, so it has to be kept explicitly
+                auto& cullPass = renderGraph.AddPass("Cull");
+                cullPass.SetCullable(false);
+                cullPass.SetExecuteFunc([&](vk::CommandBuffer commandBuffer) {
+                    culler.Cull(commandBuffer);
+                });
+
+                auto& mainPass = renderGraph.AddPass("Main");
+                mainPass.AddColorAttachment(RenderGraph::Backbuffer, Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+                mainPass.SetDepthAttachment(depthImage, 1.0f);
+                mainPass.SetExecuteFunc([&, pass = &mainPass](vk::CommandBuffer commandBuffer) {
+                    if (pipelineRenderPass != pass->GetVkRenderPass()) {
+                        pipelineRenderPass = pass->GetVkRenderPass();
+                        pipeline.SetRenderPass(pipelineRenderPass);
+                        pipeline.Create();
+                    }
+
+                    vk::Extent2D extent = pass->GetExtent();
+
+                    commandBuffer.setViewport(0, vk::Viewport(
+                        0.0f, 0.0f,
+                        float(extent.width), float(extent.height),
+                        0.0f, 1.0f
+                    ));
+
+                    commandBuffer.setScissor(0, vk::Rect2D({ 0, 0 }, extent));
+
+                    commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline.GetVkPipeline());
+
+                    commandBuffer.pushConstants(
+                        shader.GetPipelineLayout(),
+                        vk::ShaderStageFlagBits::eVertex,
+                        0, sizeof(Mat4), &viewProjection
+                    );
+
+                    mesh.Bind(commandBuffer);
+                    culler.Draw(commandBuffer);
+                });
+            });
+
+            List<vk::DrawIndexedIndirectCommand> drawList;
+
+            uint64_t lastLoggedFrame = 0;
+
+            bool isRunning = true;
+
+            SDL_Event e;
+            while (isRunning) {
+                Profiler::MarkFrame();
+
+                while (SDL_PollEvent(&e)) {
+                    if (e.type == SDL_QUIT) {
+                        isRunning = false;
+                    }
+                    else {
+                        Graphics::HandleEvent(e);
+                    }
+                }
+
+                auto frameStats = Graphics::GetFrameStats();
+
+                // Orbit around the mesh, moving in and out so the frustum cuts through it
+                float time = frameStats.FrameCount / 60.0f;
+                float distance = 2.0f + std::sin(time * 0.3f);
+
+                Vec3 position = Vec3(std::cos(time * 0.5f), 0.3f, std::sin(time * 0.5f)) * distance;
+
+                camera.Transform.Position = position;
+                camera.SetForward(glm::normalize(-position));
+                camera.SetAspect(Vec2(Graphics::GetWindowSize()));
+
+                viewProjection = camera.GetProjection() * camera.GetView();
+
+                // The mesh has no transform, so its space is world space
+                Frustum frustum = Frustum::FromMatrix(viewProjection);
+
+                culler.SetView(frustum, position);
+
+                if (frameStats.FrameCount >= lastLoggedFrame + 120) {
+                    lastLoggedFrame = frameStats.FrameCount;
+
+                    auto stats = CullMeshlets(meshletData, frustum, position, drawList);
+
+                    Log(RYME_ANCHOR, "{} of {} meshlets visible, {:.1f} FPS",
+                        stats.MeshletCount - stats.FrustumCulledCount - stats.ConeCulledCount,
+                        stats.MeshletCount,
+                        frameStats.FramesPerSecond
+                    );
+                }
+
+                Graphics::Render();
+            }
+
+            // The graph refers to everything in this scope
+            Graphics::SetRenderGraphFunc(nullptr);
+        }
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+    }
+
+    Term();
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include <Ryme/Ryme.hpp>
+#include <Ryme/Mipmap.hpp>
+
+#include <cmath>
+#include <random>
+
+using namespace ryme;
+
+// Sampling with and without mips is compared on the CPU, which shares the same cache behaviour as a
+// GPU texture unit: without mips, neighbouring pixels of a minified surface read texels that are far
+// apart, so almost every fetch misses the cache.
+
+constexpr uint32_t TextureSize = 2048;
+
+constexpr uint32_t ScreenWidth = 1280;
+
+constexpr uint32_t ScreenHeight = 720;
+
+// Number of times the texture repeats across the screen, each pixel covers ~25 texels
+constexpr float TextureRepeat = 16.0f;
+
+constexpr int FrameCount = 10;
+
+Vec4 sampleBilinear(const uint8_t * data, uint32_t width, uint32_t height, float u, float v)
+{
+    float x = u * width - 0.5f;
+    float y = v * height - 0.5f;
+
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+
+    float tx = x - fx;
+    float ty = y - fy;
+
+    // Wrap addressing, width and height are powers of two
+    uint32_t x0 = static_cast<uint32_t>(static_cast<int64_t>(fx)) & (width - 1);
+    uint32_t y0 = static_cast<uint32_t>(static_cast<int64_t>(fy)) & (height - 1);
+    uint32_t x1 = (x0 + 1) & (width - 1);
+    uint32_t y1 = (y0 + 1) & (height - 1);
+
+    auto fetch = [&](uint32_t px, uint32_t py) {
+        const uint8_t * texel = data + (size_t(py) * width + px) * 4;
+        return Vec4(texel[0], texel[1], texel[2], texel[3]);
+    };
+
+    Vec4 top = glm::mix(fetch(x0, y0), fetch(x1, y0), tx);
+    Vec4 bottom = glm::mix(fetch(x0, y1), fetch(x1, y1), tx);
+
+    return glm::mix(top, bottom, ty);
+}
+
+double renderFrame(const uint8_t * data, const MipLevel& mipLevel)
+{
+    ProfileZone zone("renderFrame", true);
+
+    Vec4 sum(0.0f);
+
+    for (uint32_t y = 0; y < ScreenHeight; ++y) {
+        float v = (y + 0.5f) / ScreenHeight * TextureRepeat;
+
+        for (uint32_t x = 0; x < ScreenWidth; ++x) {
+            // Skew the rows so the access pattern is not perfectly aligned with the texture
+            float u = (x + 0.5f) / ScreenWidth * TextureRepeat + v * 0.125f;
+
+            sum += sampleBilinear(data + mipLevel.Offset, mipLevel.Width, mipLevel.Height, u, v);
+        }
+    }
+
+    // Keep the result alive so the loop is not optimized away
+    volatile float result = sum.x + sum.y + sum.z + sum.w;
+    (void)result;
+
+    return zone.End();
+}
+
+int main(int argc, char ** argv)
+{
+    try {
+        auto mipLevelList = GetMipLevelList(TextureSize, TextureSize, 4);
+
+        const auto& lastLevel = mipLevelList.back();
+        List<uint8_t> mipChain(lastLevel.Offset + lastLevel.Size);
+
+        std::mt19937 random(1234);
+        for (size_t i = 0; i < mipLevelList[0].Size; ++i) {
+            mipChain[i] = static_cast<uint8_t>(random());
+        }
+
+        /// Mip Chain Generation
+
+        ProfileZone generateZone("Generate", true);
+
+        for (size_t level = 1; level < mipLevelList.size(); ++level) {
+            const auto& previous = mipLevelList[level - 1];
+
+            DownsampleRGBA8(
+                mipChain.data() + previous.Offset,
+                previous.Width,
+                previous.Height,
+                mipChain.data() + mipLevelList[level].Offset
+            );
+        }
+
+        double generateMilliseconds = generateZone.End();
+
+        Log(RYME_ANCHOR, "Generated {} levels for {}x{} in {:.3f} ms, {:.1f} MB/s",
+            mipLevelList.size(),
+            TextureSize,
+            TextureSize,
+            generateMilliseconds,
+            (mipLevelList[0].Size / (1024.0 * 1024.0)) / (generateMilliseconds / 1000.0)
+        );
+
+        /// Sampling
+
+        float texelsPerPixel = (TextureSize * TextureRepeat) / ScreenWidth;
+        uint32_t selectedLevel = std::min<uint32_t>(
+            static_cast<uint32_t>(std::round(std::log2(texelsPerPixel))),
+            mipLevelList.size() - 1
+        );
+
+        // Warm up
+        renderFrame(mipChain.data(), mipLevelList[0]);
+        renderFrame(mipChain.data(), mipLevelList[selectedLevel]);
+
+        double withoutMipsMilliseconds = 0.0;
+        double withMipsMilliseconds = 0.0;
+
+        for (int i = 0; i < FrameCount; ++i) {
+            withoutMipsMilliseconds += renderFrame(mipChain.data(), mipLevelList[0]);
+            withMipsMilliseconds += renderFrame(mipChain.data(), mipLevelList[selectedLevel]);
+        }
+
+        withoutMipsMilliseconds /= FrameCount;
+        withMipsMilliseconds /= FrameCount;
+
+        Log(RYME_ANCHOR, "Sampling {}x{} at {:.1f} texels per pixel",
+            ScreenWidth,
+            ScreenHeight,
+            texelsPerPixel
+        );
+
+        Log(RYME_ANCHOR, "Without Mips: {:.3f} ms per frame", withoutMipsMilliseconds);
+
+        Log(RYME_ANCHOR, "With Mips (level {}): {:.3f} ms per frame, {:.2f}x faster",
+            selectedLevel,
+            withMipsMilliseconds,
+            withoutMipsMilliseconds / withMipsMilliseconds
+        );
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
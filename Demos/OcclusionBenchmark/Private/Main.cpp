@@ -0,0 +1,228 @@
+#include <Ryme/Ryme.hpp>
+#include <Ryme/Camera.hpp>
+#include <Ryme/Frustum.hpp>
+#include <Ryme/OcclusionBuffer.hpp>
+#include <Ryme/ThreadPool.hpp>
+
+#include <cstring>
+#include <random>
+
+using namespace ryme;
+
+// A walk down the streets of a city, where the buildings hide almost everything that is inside of the
+// view. The objects left after frustum culling are tested against an OcclusionBuffer drawn from the
+// buildings, which needs no GPU, and the result is checked to be the same on one thread as on many.
+
+constexpr uint32_t BlockCount = 24;
+
+constexpr float BlockSize = 40.0f;
+
+constexpr float StreetWidth = 12.0f;
+
+constexpr size_t PropCount = 50000;
+
+constexpr int FrameCount = 240;
+
+// A cube from -1 to 1, which every building is scaled from
+OccluderMesh generateCube()
+{
+    OccluderMesh mesh;
+
+    for (unsigned i = 0; i < 8; ++i) {
+        mesh.PositionList.push_back(Vec3(
+            (i & 1 ? 1.0f : -1.0f),
+            (i & 2 ? 1.0f : -1.0f),
+            (i & 4 ? 1.0f : -1.0f)
+        ));
+    }
+
+    const uint32_t faceList[6][4] = {
+        { 0, 1, 3, 2 },
+        { 4, 6, 7, 5 },
+        { 0, 4, 5, 1 },
+        { 2, 3, 7, 6 },
+        { 0, 2, 6, 4 },
+        { 1, 5, 7, 3 },
+    };
+
+    for (const auto& face : faceList) {
+        mesh.IndexList.insert(mesh.IndexList.end(), { face[0], face[1], face[2] });
+        mesh.IndexList.insert(mesh.IndexList.end(), { face[0], face[2], face[3] });
+    }
+
+    return mesh;
+}
+
+struct Prop
+{
+    Vec3 Min;
+
+    Vec3 Max;
+
+}; // struct Prop
+
+int main(int argc, char ** argv)
+{
+    try {
+        const float citySize = BlockCount * BlockSize;
+
+        std::mt19937 random(1234);
+
+        /// Buildings
+
+        OccluderMesh cube = generateCube();
+
+        std::uniform_real_distribution<float> heightDistribution(10.0f, 60.0f);
+
+        List<Mat4> buildingList;
+
+        for (uint32_t z = 0; z < BlockCount; ++z) {
+            for (uint32_t x = 0; x < BlockCount; ++x) {
+                float height = heightDistribution(random);
+                float halfWidth = (BlockSize - StreetWidth) * 0.5f;
+
+                Vec3 center = {
+                    (x + 0.5f) * BlockSize - citySize * 0.5f,
+                    height * 0.5f,
+                    (z + 0.5f) * BlockSize - citySize * 0.5f,
+                };
+
+                Mat4 model = glm::translate(Mat4(1.0f), center);
+                model = glm::scale(model, Vec3(halfWidth, height * 0.5f, halfWidth));
+
+                buildingList.push_back(model);
+            }
+        }
+
+        /// Props
+
+        std::uniform_real_distribution<float> positionDistribution(-citySize * 0.5f, citySize * 0.5f);
+        std::uniform_real_distribution<float> sizeDistribution(0.25f, 1.5f);
+
+        List<Prop> propList(PropCount);
+
+        for (auto& prop : propList) {
+            Vec3 center = Vec3(positionDistribution(random), 0.0f, positionDistribution(random));
+            float size = sizeDistribution(random);
+
+            prop.Min = center - Vec3(size, 0.0f, size);
+            prop.Max = center + Vec3(size, size * 2.0f, size);
+        }
+
+        /// Walk
+
+        Camera camera;
+        camera.SetAspect(Vec2(1280.0f, 720.0f));
+        camera.SetClip({ 0.5f, 2000.0f });
+
+        ThreadPool threadPool;
+
+        OcclusionBuffer occlusionBuffer;
+        OcclusionBuffer referenceBuffer;
+
+        size_t frustumVisibleCount = 0;
+        size_t occlusionVisibleCount = 0;
+        size_t mismatchCount = 0;
+
+        double rasterizeMilliseconds = 0.0;
+        double referenceMilliseconds = 0.0;
+        double testMilliseconds = 0.0;
+
+        for (int frame = 0; frame < FrameCount; ++frame) {
+            // Down the middle of a street, looking from side to side
+            float t = float(frame) / FrameCount;
+            float yaw = 0.6f * std::sin(t * 12.0f);
+
+            camera.Transform.Position = Vec3(
+                -citySize * 0.5f + BlockSize * (BlockCount / 2),
+                1.7f,
+                (0.45f - t * 0.9f) * citySize
+            );
+
+            camera.SetForward(glm::angleAxis(yaw, camera.GetUp()) * Vec3(0.0f, 0.0f, -1.0f));
+
+            Mat4 viewProjection = camera.GetProjection() * camera.GetView();
+            Frustum frustum = Frustum::FromMatrix(viewProjection);
+
+            ProfileZone rasterizeZone("Rasterize", true);
+
+            occlusionBuffer.Clear(viewProjection);
+            for (const auto& building : buildingList) {
+                occlusionBuffer.AddOccluder(cube, building);
+            }
+
+            occlusionBuffer.Rasterize(&threadPool);
+
+            rasterizeMilliseconds += rasterizeZone.End();
+
+            // The same occluders on a single thread must give exactly the same depth
+            ProfileZone referenceZone("Reference", true);
+
+            referenceBuffer.Clear(viewProjection);
+            for (const auto& building : buildingList) {
+                referenceBuffer.AddOccluder(cube, building);
+            }
+
+            referenceBuffer.Rasterize();
+
+            referenceMilliseconds += referenceZone.End();
+
+            const auto& depthList = occlusionBuffer.GetDepthList();
+            const auto& referenceDepthList = referenceBuffer.GetDepthList();
+
+            if (memcmp(depthList.data(), referenceDepthList.data(), depthList.size() * sizeof(float)) != 0) {
+                ++mismatchCount;
+            }
+
+            ProfileZone testZone("Test", true);
+
+            for (const auto& prop : propList) {
+                if (not frustum.IntersectsBox(prop.Min, prop.Max)) {
+                    continue;
+                }
+
+                ++frustumVisibleCount;
+
+                if (occlusionBuffer.IsBoxVisible(prop.Min, prop.Max, Mat4(1.0f))) {
+                    ++occlusionVisibleCount;
+                }
+            }
+
+            testMilliseconds += testZone.End();
+        }
+
+        Log(RYME_ANCHOR, "{} buildings with {} triangles, {} props, {}x{} depth on {} threads",
+            buildingList.size(),
+            occlusionBuffer.GetStats().TriangleCount,
+            PropCount,
+            occlusionBuffer.GetWidth(),
+            occlusionBuffer.GetHeight(),
+            threadPool.GetThreadCount() + 1
+        );
+
+        Log(RYME_ANCHOR, "Rasterize: {:.3f} ms per frame, {:.3f} ms on a single thread",
+            rasterizeMilliseconds / FrameCount,
+            referenceMilliseconds / FrameCount
+        );
+
+        Log(RYME_ANCHOR, "Test: {:.3f} ms per frame for {:.0f} props inside of the frustum",
+            testMilliseconds / FrameCount,
+            double(frustumVisibleCount) / FrameCount
+        );
+
+        Log(RYME_ANCHOR, "Frustum culling alone draws {:.0f} props per frame, with occlusion culling {:.0f} ({:.1f}% hidden)",
+            double(frustumVisibleCount) / FrameCount,
+            double(occlusionVisibleCount) / FrameCount,
+            100.0 * (1.0 - double(occlusionVisibleCount) / double(frustumVisibleCount))
+        );
+
+        Log(RYME_ANCHOR, "Frames where the threaded and single threaded depth differ: {}", mismatchCount);
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
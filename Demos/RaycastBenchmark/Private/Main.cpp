@@ -0,0 +1,400 @@
+#include <Ryme/Ryme.hpp>
+#include <Ryme/AABBTree.hpp>
+#include <Ryme/ThreadPool.hpp>
+#include <Ryme/TriangleBVH.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace ryme;
+
+// Rays cast down onto a bumpy terrain of two hundred thousand triangles, first through a TriangleBVH
+// compared against testing every triangle, then across threads. Then a field of rocks, each with its
+// own TriangleBVH, picked with and without an AABBTree over their bounds first.
+
+constexpr uint32_t TerrainSize = 320;
+
+constexpr float TerrainScale = 1.0f;
+
+constexpr size_t CheckRayCount = 500;
+
+constexpr size_t BatchRayCount = 200000;
+
+constexpr uint32_t RockRingCount = 24;
+
+constexpr uint32_t RockSegmentCount = 48;
+
+constexpr size_t RockCount = 2000;
+
+constexpr float FieldSize = 500.0f;
+
+constexpr size_t PickRayCount = 2000;
+
+// The heightfield in the XZ plane, with two triangles per cell
+void generateTerrain(List<Vec3>& positionList, List<uint32_t>& indexList)
+{
+    for (uint32_t z = 0; z <= TerrainSize; ++z) {
+        for (uint32_t x = 0; x <= TerrainSize; ++x) {
+            float fx = float(x) * TerrainScale;
+            float fz = float(z) * TerrainScale;
+            float height = 4.0f * std::sin(fx * 0.05f) * std::cos(fz * 0.07f) + std::sin(fx * 0.9f + fz * 1.3f) * 0.3f;
+
+            positionList.push_back(Vec3(fx, height, fz));
+        }
+    }
+
+    const uint32_t rowSize = TerrainSize + 1;
+
+    for (uint32_t z = 0; z < TerrainSize; ++z) {
+        for (uint32_t x = 0; x < TerrainSize; ++x) {
+            uint32_t i = z * rowSize + x;
+
+            indexList.insert(indexList.end(), { i, i + rowSize, i + 1 });
+            indexList.insert(indexList.end(), { i + 1, i + rowSize, i + rowSize + 1 });
+        }
+    }
+}
+
+// A lumpy unit sphere
+void generateRock(List<Vec3>& positionList, List<uint32_t>& indexList)
+{
+    const float pi = 3.14159265f;
+
+    for (uint32_t ring = 0; ring <= RockRingCount; ++ring) {
+        float theta = pi * float(ring) / RockRingCount;
+
+        for (uint32_t segment = 0; segment <= RockSegmentCount; ++segment) {
+            float phi = 2.0f * pi * float(segment) / RockSegmentCount;
+            float radius = 1.0f + 0.15f * std::sin(theta * 5.0f) * std::cos(phi * 3.0f);
+
+            positionList.push_back(Vec3(
+                std::sin(theta) * std::cos(phi),
+                std::cos(theta),
+                std::sin(theta) * std::sin(phi)
+            ) * radius);
+        }
+    }
+
+    const uint32_t rowSize = RockSegmentCount + 1;
+
+    for (uint32_t ring = 0; ring < RockRingCount; ++ring) {
+        for (uint32_t segment = 0; segment < RockSegmentCount; ++segment) {
+            uint32_t i = ring * rowSize + segment;
+
+            indexList.insert(indexList.end(), { i, i + 1, i + rowSize });
+            indexList.insert(indexList.end(), { i + 1, i + rowSize + 1, i + rowSize });
+        }
+    }
+}
+
+// Möller and Trumbore, testing every triangle
+RayHit intersectEveryTriangle(const List<Vec3>& positionList, const List<uint32_t>& indexList, const Ray& ray)
+{
+    RayHit hit;
+
+    for (uint32_t triangle = 0; triangle < indexList.size() / 3; ++triangle) {
+        const Vec3& v0 = positionList[indexList[triangle * 3 + 0]];
+        Vec3 edge1 = positionList[indexList[triangle * 3 + 1]] - v0;
+        Vec3 edge2 = positionList[indexList[triangle * 3 + 2]] - v0;
+
+        Vec3 p = glm::cross(ray.Direction, edge2);
+        float det = glm::dot(edge1, p);
+        if (det == 0.0f) {
+            continue;
+        }
+
+        float inverseDet = 1.0f / det;
+
+        Vec3 t = ray.Origin - v0;
+        float u = glm::dot(t, p) * inverseDet;
+
+        Vec3 q = glm::cross(t, edge1);
+        float v = glm::dot(ray.Direction, q) * inverseDet;
+        float distance = glm::dot(edge2, q) * inverseDet;
+
+        if (u >= 0.0f and v >= 0.0f and u + v <= 1.0f and distance >= 0.0f and distance < hit.Distance) {
+            hit.Distance = distance;
+            hit.Barycentric = Vec2(u, v);
+            hit.Triangle = triangle;
+        }
+    }
+
+    return hit;
+}
+
+bool sameHit(const RayHit& a, const RayHit& b)
+{
+    if (a.IsHit() != b.IsHit()) {
+        return false;
+    }
+
+    // Triangles sharing an edge can both be hit at the same distance, so only the distance is compared
+    return (not a.IsHit() or std::abs(a.Distance - b.Distance) <= 1e-4f * std::max(1.0f, a.Distance));
+}
+
+int main(int argc, char ** argv)
+{
+    try {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+
+        /// Terrain
+
+        List<Vec3> terrainPositionList;
+        List<uint32_t> terrainIndexList;
+        generateTerrain(terrainPositionList, terrainIndexList);
+
+        ProfileZone buildZone("Build", true);
+
+        TriangleBVH terrain(terrainPositionList, terrainIndexList);
+
+        double buildMilliseconds = buildZone.End();
+
+        Log(RYME_ANCHOR, "Built a TriangleBVH over {} triangles in {:.2f} ms, with {} nodes",
+            terrain.GetTriangleCount(),
+            buildMilliseconds,
+            terrain.GetNodeCount()
+        );
+
+        const float terrainExtent = TerrainSize * TerrainScale;
+
+        // From above the terrain, down at an angle, with some of them missing past the edges
+        auto randomTerrainRay = [&]() {
+            Vec3 origin = Vec3(
+                unitDistribution(random) * terrainExtent,
+                20.0f + unitDistribution(random) * 20.0f,
+                unitDistribution(random) * terrainExtent
+            );
+
+            Vec3 target = Vec3(
+                (unitDistribution(random) * 1.2f - 0.1f) * terrainExtent,
+                0.0f,
+                (unitDistribution(random) * 1.2f - 0.1f) * terrainExtent
+            );
+
+            return Ray{
+                .Origin = origin,
+                .Direction = glm::normalize(target - origin),
+            };
+        };
+
+        List<Ray> checkRayList(CheckRayCount);
+        for (auto& ray : checkRayList) {
+            ray = randomTerrainRay();
+        }
+
+        List<RayHit> checkHitList(CheckRayCount);
+
+        ProfileZone bvhZone("BVH", true);
+
+        terrain.IntersectList(checkRayList, checkHitList);
+
+        double bvhMilliseconds = bvhZone.End();
+
+        size_t hitCount = 0;
+        size_t mismatchCount = 0;
+
+        ProfileZone everyTriangleZone("EveryTriangle", true);
+
+        for (size_t i = 0; i < CheckRayCount; ++i) {
+            RayHit expectedHit = intersectEveryTriangle(terrainPositionList, terrainIndexList, checkRayList[i]);
+
+            if (not sameHit(checkHitList[i], expectedHit)) {
+                ++mismatchCount;
+            }
+
+            if (expectedHit.IsHit()) {
+                ++hitCount;
+            }
+        }
+
+        double everyTriangleMilliseconds = everyTriangleZone.End();
+
+        Log(RYME_ANCHOR, "{} rays, {} hit: {:.4f} ms per ray with the TriangleBVH, {:.4f} ms testing every triangle",
+            CheckRayCount,
+            hitCount,
+            bvhMilliseconds / CheckRayCount,
+            everyTriangleMilliseconds / CheckRayCount
+        );
+
+        Log(RYME_ANCHOR, "Rays that differ from testing every triangle: {} of {}", mismatchCount, CheckRayCount);
+
+        /// Batch
+
+        List<Ray> batchRayList(BatchRayCount);
+        for (auto& ray : batchRayList) {
+            ray = randomTerrainRay();
+        }
+
+        List<RayHit> hitList(BatchRayCount);
+        List<RayHit> threadedHitList(BatchRayCount);
+
+        ProfileZone singleThreadZone("SingleThread", true);
+
+        terrain.IntersectList(batchRayList, hitList);
+
+        double singleThreadMilliseconds = singleThreadZone.End();
+
+        ThreadPool threadPool;
+
+        ProfileZone threadPoolZone("ThreadPool", true);
+
+        terrain.IntersectList(batchRayList, threadedHitList, &threadPool);
+
+        double threadPoolMilliseconds = threadPoolZone.End();
+
+        size_t threadMismatchCount = 0;
+        size_t anyMismatchCount = 0;
+        for (size_t i = 0; i < BatchRayCount; ++i) {
+            if (terrain.IntersectAny(batchRayList[i]) != hitList[i].IsHit()) {
+                ++anyMismatchCount;
+            }
+
+            if (hitList[i].Distance != threadedHitList[i].Distance) {
+                ++threadMismatchCount;
+            }
+        }
+
+        Log(RYME_ANCHOR, "{} rays: {:.2f} ms on one thread, {:.2f} ms on {} threads, {:.1f} million rays per second",
+            BatchRayCount,
+            singleThreadMilliseconds,
+            threadPoolMilliseconds,
+            threadPool.GetThreadCount(),
+            BatchRayCount / threadPoolMilliseconds / 1000.0
+        );
+
+        Log(RYME_ANCHOR, "Rays that differ between threads: {}, where IntersectAny() differs from Intersect(): {}",
+            threadMismatchCount,
+            anyMismatchCount
+        );
+
+        /// Pick
+
+        List<Vec3> rockPositionList;
+        List<uint32_t> rockIndexList;
+        generateRock(rockPositionList, rockIndexList);
+
+        TriangleBVH rock(rockPositionList, rockIndexList);
+
+        struct Rock
+        {
+            Vec3 Center;
+
+            float Scale;
+
+        }; // struct Rock
+
+        List<Rock> rockList(RockCount);
+
+        AABBTree tree;
+
+        for (auto& instance : rockList) {
+            instance.Center = Vec3(unitDistribution(random) * FieldSize, 0.0f, unitDistribution(random) * FieldSize);
+            instance.Scale = 0.5f + unitDistribution(random) * 2.5f;
+
+            tree.Insert(
+                instance.Center + rock.GetBoundsMin() * instance.Scale,
+                instance.Center + rock.GetBoundsMax() * instance.Scale,
+                &instance
+            );
+        }
+
+        tree.Rebuild();
+
+        // The ray in the space of the rock, with the distances along it kept the same
+        auto intersectRock = [&](const Rock& instance, const Ray& ray, RayHit& hit) {
+            Ray rockRay = {
+                .Origin = (ray.Origin - instance.Center) / instance.Scale,
+                .Direction = ray.Direction / instance.Scale,
+                .MaxDistance = ray.MaxDistance,
+            };
+
+            return rock.Intersect(rockRay, hit);
+        };
+
+        // Across the field, just above the ground
+        List<Ray> pickRayList(PickRayCount);
+        for (auto& ray : pickRayList) {
+            Vec3 origin = Vec3(unitDistribution(random) * FieldSize, 0.5f + unitDistribution(random), unitDistribution(random) * FieldSize);
+            Vec3 target = Vec3(unitDistribution(random) * FieldSize, 0.0f, unitDistribution(random) * FieldSize);
+
+            ray = Ray{
+                .Origin = origin,
+                .Direction = glm::normalize(target - origin),
+                .MaxDistance = FieldSize,
+            };
+        }
+
+        List<RayHit> pickHitList(PickRayCount);
+        List<RayHit> everyRockHitList(PickRayCount);
+        List<AABBTree::RayHit> boundsHitList;
+
+        size_t candidateCount = 0;
+
+        ProfileZone pickZone("Pick", true);
+
+        for (size_t i = 0; i < PickRayCount; ++i) {
+            const auto& ray = pickRayList[i];
+
+            boundsHitList.clear();
+            tree.QueryRay(ray.Origin, ray.Direction, ray.MaxDistance, boundsHitList);
+
+            std::sort(boundsHitList.begin(), boundsHitList.end(), [](const auto& a, const auto& b) {
+                return (a.Distance < b.Distance);
+            });
+
+            for (const auto& boundsHit : boundsHitList) {
+                if (boundsHit.Distance >= pickHitList[i].Distance) {
+                    break;
+                }
+
+                ++candidateCount;
+                intersectRock(*static_cast<Rock *>(tree.GetUserData(boundsHit.Proxy)), ray, pickHitList[i]);
+            }
+        }
+
+        double pickMilliseconds = pickZone.End();
+
+        ProfileZone everyRockZone("EveryRock", true);
+
+        for (size_t i = 0; i < PickRayCount; ++i) {
+            for (const auto& instance : rockList) {
+                intersectRock(instance, pickRayList[i], everyRockHitList[i]);
+            }
+        }
+
+        double everyRockMilliseconds = everyRockZone.End();
+
+        size_t pickHitCount = 0;
+        size_t pickMismatchCount = 0;
+
+        for (size_t i = 0; i < PickRayCount; ++i) {
+            if (pickHitList[i].IsHit()) {
+                ++pickHitCount;
+            }
+
+            if (pickHitList[i].Distance != everyRockHitList[i].Distance) {
+                ++pickMismatchCount;
+            }
+        }
+
+        Log(RYME_ANCHOR, "{} rocks of {} triangles, {} rays, {} hit: {:.4f} ms per ray with an AABBTree testing {:.1f} rocks, {:.4f} ms testing every rock",
+            RockCount,
+            rock.GetTriangleCount(),
+            PickRayCount,
+            pickHitCount,
+            pickMilliseconds / PickRayCount,
+            double(candidateCount) / PickRayCount,
+            everyRockMilliseconds / PickRayCount
+        );
+
+        Log(RYME_ANCHOR, "Rays that differ from testing every rock: {} of {}", pickMismatchCount, PickRayCount);
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
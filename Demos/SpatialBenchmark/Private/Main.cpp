@@ -0,0 +1,277 @@
+#include <Ryme/Ryme.hpp>
+#include <Ryme/AABBTree.hpp>
+#include <Ryme/Entity.hpp>
+#include <Ryme/Frustum.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace ryme;
+
+// A hundred thousand objects bouncing around inside of a box, with a few of them removed and added
+// again every frame. Every frame the AABBTree is refit and queried, and every few frames the results
+// are checked against testing every object.
+
+constexpr size_t ObjectCount = 100000;
+
+constexpr float WorldSize = 1000.0f;
+
+constexpr float WorldHeight = 100.0f;
+
+constexpr float MaxSpeed = 10.0f;
+
+constexpr size_t RespawnCount = 100;
+
+constexpr size_t QueryCount = 25;
+
+constexpr int FrameCount = 300;
+
+constexpr int CheckInterval = 10;
+
+struct Object
+{
+    Vec3 Center;
+
+    Vec3 HalfSize;
+
+    Vec3 Velocity;
+
+    uint32_t Proxy;
+
+}; // struct Object
+
+bool sameProxies(List<uint32_t> a, List<uint32_t> b)
+{
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return (a == b);
+}
+
+int main(int argc, char ** argv)
+{
+    try {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+
+        auto randomPosition = [&]() {
+            return Vec3(
+                unitDistribution(random) * WorldSize,
+                unitDistribution(random) * WorldHeight,
+                unitDistribution(random) * WorldSize
+            );
+        };
+
+        List<Object> objectList(ObjectCount);
+
+        for (auto& object : objectList) {
+            object.Center = randomPosition();
+            object.HalfSize = Vec3(0.25f + unitDistribution(random) * 1.25f);
+            object.Velocity = (Vec3(
+                unitDistribution(random),
+                unitDistribution(random),
+                unitDistribution(random)
+            ) * 2.0f - 1.0f) * MaxSpeed;
+        }
+
+        /// Build
+
+        AABBTree tree;
+
+        ProfileZone insertZone("Insert", true);
+
+        for (auto& object : objectList) {
+            object.Proxy = tree.Insert(object.Center - object.HalfSize, object.Center + object.HalfSize, &object);
+        }
+
+        double insertMilliseconds = insertZone.End();
+
+        tree.Update();
+        float insertedCost = tree.GetStats().Cost;
+
+        ProfileZone rebuildZone("Rebuild", true);
+
+        tree.Rebuild();
+
+        double rebuildMilliseconds = rebuildZone.End();
+
+        Log(RYME_ANCHOR, "{} objects inserted in {:.2f} ms with a cost of {:.1f}, rebuilt in {:.2f} ms with a cost of {:.1f} and a height of {}",
+            ObjectCount,
+            insertMilliseconds,
+            insertedCost,
+            rebuildMilliseconds,
+            tree.GetStats().Cost,
+            tree.GetStats().Height
+        );
+
+        /// Simulate
+
+        const float timeStep = 1.0f / 60.0f;
+
+        double updateMilliseconds = 0.0;
+        double queryMilliseconds = 0.0;
+        double bruteForceMilliseconds = 0.0;
+
+        size_t movedCount = 0;
+        size_t resultCount = 0;
+        size_t checkCount = 0;
+        size_t mismatchCount = 0;
+
+        List<uint32_t> frustumList;
+        List<uint32_t> boxList;
+        List<uint32_t> sphereList;
+        List<AABBTree::RayHit> rayHitList;
+
+        for (int frame = 0; frame < FrameCount; ++frame) {
+            ProfileZone updateZone("Update", true);
+
+            for (auto& object : objectList) {
+                object.Center += object.Velocity * timeStep;
+
+                for (unsigned i = 0; i < 3; ++i) {
+                    float limit = (i == 1 ? WorldHeight : WorldSize);
+                    if (object.Center[i] < 0.0f or object.Center[i] > limit) {
+                        object.Velocity[i] = -object.Velocity[i];
+                    }
+                }
+
+                tree.Move(object.Proxy, object.Center - object.HalfSize, object.Center + object.HalfSize);
+            }
+
+            for (size_t i = 0; i < RespawnCount; ++i) {
+                auto& object = objectList[random() % ObjectCount];
+                object.Center = randomPosition();
+
+                tree.Remove(object.Proxy);
+                object.Proxy = tree.Insert(object.Center - object.HalfSize, object.Center + object.HalfSize, &object);
+            }
+
+            tree.Update();
+
+            updateMilliseconds += updateZone.End();
+            movedCount += tree.GetStats().MovedCount;
+
+            bool check = (frame % CheckInterval == 0);
+
+            for (size_t query = 0; query < QueryCount; ++query) {
+                Vec3 eye = randomPosition();
+                Vec3 target = randomPosition();
+                Vec3 direction = glm::normalize(target - eye);
+
+                Mat4 view = glm::lookAt(eye, target, GetWorldUp());
+                Mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 250.0f);
+                Frustum frustum = Frustum::FromMatrix(projection * view);
+
+                Vec3 boxMin = target - Vec3(20.0f);
+                Vec3 boxMax = target + Vec3(20.0f);
+
+                float radius = 25.0f;
+
+                frustumList.clear();
+                boxList.clear();
+                sphereList.clear();
+                rayHitList.clear();
+
+                ProfileZone queryZone("Query", true);
+
+                tree.QueryFrustum(frustum, frustumList);
+                tree.QueryBox(boxMin, boxMax, boxList);
+                tree.QuerySphere(target, radius, sphereList);
+                tree.QueryRay(eye, direction, WorldSize, rayHitList);
+
+                queryMilliseconds += queryZone.End();
+
+                resultCount += frustumList.size() + boxList.size() + sphereList.size() + rayHitList.size();
+
+                if (not check) {
+                    continue;
+                }
+
+                List<uint32_t> expectedFrustumList;
+                List<uint32_t> expectedBoxList;
+                List<uint32_t> expectedSphereList;
+                List<uint32_t> expectedRayList;
+
+                Vec3 inverseDirection = 1.0f / direction;
+
+                ProfileZone bruteForceZone("BruteForce", true);
+
+                for (const auto& object : objectList) {
+                    Vec3 min = object.Center - object.HalfSize;
+                    Vec3 max = object.Center + object.HalfSize;
+
+                    if (frustum.IntersectsBox(min, max)) {
+                        expectedFrustumList.push_back(object.Proxy);
+                    }
+
+                    if (glm::all(glm::lessThanEqual(min, boxMax)) and glm::all(glm::lessThanEqual(boxMin, max))) {
+                        expectedBoxList.push_back(object.Proxy);
+                    }
+
+                    Vec3 offset = glm::clamp(target, min, max) - target;
+                    if (glm::dot(offset, offset) <= radius * radius) {
+                        expectedSphereList.push_back(object.Proxy);
+                    }
+
+                    Vec3 slab0 = (min - eye) * inverseDirection;
+                    Vec3 slab1 = (max - eye) * inverseDirection;
+                    Vec3 enter = glm::min(slab0, slab1);
+                    Vec3 exit = glm::max(slab0, slab1);
+
+                    float enterDistance = std::max(std::max(enter.x, enter.y), std::max(enter.z, 0.0f));
+                    float exitDistance = std::min(std::min(exit.x, exit.y), std::min(exit.z, WorldSize));
+
+                    if (enterDistance <= exitDistance) {
+                        expectedRayList.push_back(object.Proxy);
+                    }
+                }
+
+                bruteForceMilliseconds += bruteForceZone.End();
+
+                List<uint32_t> rayList;
+                for (const auto& hit : rayHitList) {
+                    rayList.push_back(hit.Proxy);
+                }
+
+                ++checkCount;
+
+                if (not sameProxies(frustumList, expectedFrustumList)
+                    or not sameProxies(boxList, expectedBoxList)
+                    or not sameProxies(sphereList, expectedSphereList)
+                    or not sameProxies(rayList, expectedRayList)) {
+                    ++mismatchCount;
+                }
+            }
+        }
+
+        const auto& stats = tree.GetStats();
+
+        Log(RYME_ANCHOR, "Move and refit: {:.3f} ms per frame, {:.0f} objects left their margin per frame",
+            updateMilliseconds / FrameCount,
+            double(movedCount) / FrameCount
+        );
+
+        Log(RYME_ANCHOR, "Rebuilt {} times, ending with a cost of {:.1f} and a height of {}",
+            stats.RebuildCount - 1,
+            stats.Cost,
+            stats.Height
+        );
+
+        Log(RYME_ANCHOR, "Frustum, box, sphere and ray queries: {:.3f} ms for each set, {:.0f} results",
+            queryMilliseconds / (FrameCount * QueryCount),
+            double(resultCount) / (FrameCount * QueryCount)
+        );
+
+        Log(RYME_ANCHOR, "Testing every object: {:.3f} ms for each set",
+            bruteForceMilliseconds / checkCount
+        );
+
+        Log(RYME_ANCHOR, "Sets of queries that differ from testing every object: {} of {}", mismatchCount, checkCount);
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include <Ryme/Ryme.hpp>
+#include <Ryme/Camera.hpp>
+#include <Ryme/ImageData.hpp>
+
+#include <cmath>
+#include <filesystem>
+
+using namespace ryme;
+
+// A row of textured quads recedes from the camera, which flies back and forth along it. Each frame,
+// every texture is requested with the size it covers on the screen, so the TextureStreamer uploads
+// more detailed levels as the camera gets closer, and evicts them again once it moves away.
+
+constexpr uint32_t TextureSize = 2048;
+
+constexpr uint32_t QuadCount = 4;
+
+// The size of each quad in world units, and the space between them
+constexpr float QuadSize = 2.0f;
+
+constexpr float QuadSpacing = 12.0f;
+
+// A checkerboard with a gradient, so every level has something to filter
+ImageData generateTexture()
+{
+    ImageData imageData = {
+        .Format = vk::Format::eR8G8B8A8Unorm,
+        .Width = TextureSize,
+        .Height = TextureSize,
+        .MipLevelList = {
+            MipLevel{
+                .Width = TextureSize,
+                .Height = TextureSize,
+                .Offset = 0,
+                .Size = TextureSize * TextureSize * 4,
+            },
+        },
+    };
+
+    imageData.Data.resize(TextureSize * TextureSize * 4);
+
+    for (uint32_t y = 0; y < TextureSize; ++y) {
+        for (uint32_t x = 0; x < TextureSize; ++x) {
+            bool isLight = (((x / 64) + (y / 64)) % 2 == 0);
+
+            uint8_t * texel = imageData.Data.data() + (y * TextureSize + x) * 4;
+            texel[0] = static_cast<uint8_t>(x * 255 / TextureSize);
+            texel[1] = static_cast<uint8_t>(y * 255 / TextureSize);
+            texel[2] = (isLight ? 255 : 32);
+            texel[3] = 255;
+        }
+    }
+
+    GenerateMipmaps(imageData);
+
+    return imageData;
+}
+
+int main(int argc, char ** argv)
+{
+    try {
+        Init({
+            .ApplicationName = DEMO_NAME,
+            .ApplicationVersion = GetVersion(),
+            .WindowTitle = DEMO_NAME " (" RYME_VERSION_STRING ")",
+            .WindowSize = { 1280, 720 },
+        });
+
+        Path texturePath = Path(std::filesystem::temp_directory_path().string()) / "TextureStreaming.ktx2";
+
+        if (not SaveKTX2(texturePath, generateTexture())) {
+            throw Exception("Failed to write '{}'", texturePath);
+        }
+
+        // Only the smallest levels are kept resident without being requested
+        TextureStreamer::SetMinResidentSize(64);
+
+        List<std::shared_ptr<Texture>> textureList;
+
+        for (uint32_t i = 0; i < QuadCount; ++i) {
+            textureList.push_back(TextureStreamer::Load(texturePath, {}, false));
+        }
+
+        Camera camera;
+
+        uint64_t lastLoggedFrame = 0;
+
+        bool isRunning = true;
+
+        SDL_Event e;
+        while (isRunning) {
+            Profiler::MarkFrame();
+
+            while (SDL_PollEvent(&e)) {
+                if (e.type == SDL_QUIT) {
+                    isRunning = false;
+                }
+                else {
+                    Graphics::HandleEvent(e);
+                }
+            }
+
+            auto frameStats = Graphics::GetFrameStats();
+
+            // From in front of the first quad to past the last one
+            float time = frameStats.FrameCount / 60.0f;
+            float cameraDistance = (0.5f - 0.5f * std::cos(time * 0.2f)) * QuadSpacing * QuadCount;
+
+            Vec2 windowSize = Vec2(Graphics::GetWindowSize());
+            camera.SetAspect(windowSize);
+
+            // The same measure RenderSystem::SelectLODs() uses, the size of a unit on the screen at a
+            // distance of one
+            float pixelsPerUnitAtOne = std::fabs(camera.GetProjection()[1][1]) * windowSize.y * 0.5f;
+
+            for (uint32_t i = 0; i < QuadCount; ++i) {
+                float distance = (i + 1) * QuadSpacing - cameraDistance;
+
+                // Behind the camera, so not drawn and not requested
+                if (distance <= camera.GetNear()) {
+                    continue;
+                }
+
+                float screenSize = QuadSize * pixelsPerUnitAtOne / distance;
+
+                TextureStreamer::Request(*textureList[i], screenSize);
+            }
+
+            TextureStreamer::Update();
+
+            if (frameStats.FrameCount >= lastLoggedFrame + 60) {
+                lastLoggedFrame = frameStats.FrameCount;
+
+                String residentLevels;
+                for (const auto& texture : textureList) {
+                    residentLevels += fmt::format(" {}", TextureStreamer::GetResidentLevel(*texture));
+                }
+
+                auto stats = TextureStreamer::GetStats();
+
+                Log(RYME_ANCHOR, "Camera at {:.1f}, resident levels{}, {:.1f} of {:.1f} MB resident",
+                    cameraDistance,
+                    residentLevels,
+                    stats.ResidentSize / 1.0e6,
+                    stats.TotalSize / 1.0e6
+                );
+            }
+
+            Graphics::Render();
+        }
+
+        // The streamer reads levels from the file for as long as the textures are alive
+        textureList.clear();
+        TextureStreamer::Term();
+
+        std::filesystem::remove(texturePath.ToString());
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+    }
+
+    Term();
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
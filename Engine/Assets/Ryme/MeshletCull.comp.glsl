@@ -0,0 +1,95 @@
+#version 450 core
+
+// Frustum and backface cone culling of meshlets, see MeshletCuller
+
+layout(local_size_x = 64) in;
+
+struct Meshlet
+{
+    uint FirstIndex;
+    uint IndexCount;
+    uint FirstVertex;
+    uint VertexCount;
+};
+
+struct MeshletBounds
+{
+    vec3 Center;
+    float Radius;
+    vec3 ConeApex;
+    float Padding;
+    vec3 ConeAxis;
+    float ConeCutoff;
+};
+
+struct DrawIndexedIndirectCommand
+{
+    uint IndexCount;
+    uint InstanceCount;
+    uint FirstIndex;
+    int VertexOffset;
+    uint FirstInstance;
+};
+
+layout(set = 0, binding = 0, std430) readonly buffer MeshletBuffer
+{
+    Meshlet b_Meshlets[];
+};
+
+layout(set = 0, binding = 1, std430) readonly buffer MeshletBoundsBuffer
+{
+    MeshletBounds b_Bounds[];
+};
+
+layout(set = 0, binding = 2, std430) writeonly buffer DrawBuffer
+{
+    DrawIndexedIndirectCommand b_Draws[];
+};
+
+layout(set = 0, binding = 3, std430) buffer DrawCountBuffer
+{
+    uint b_DrawCount;
+};
+
+layout(push_constant) uniform MeshletCullConstants
+{
+    // In the space of the mesh, with the normals pointing inside
+    vec4 u_FrustumPlanes[6];
+
+    // In the space of the mesh
+    vec3 u_CameraPosition;
+
+    uint u_MeshletCount;
+};
+
+bool isVisible(MeshletBounds bounds)
+{
+    for (int i = 0; i < 6; ++i) {
+        if (dot(u_FrustumPlanes[i].xyz, bounds.Center) + u_FrustumPlanes[i].w < -bounds.Radius) {
+            return false;
+        }
+    }
+
+    vec3 direction = bounds.ConeApex - u_CameraPosition;
+
+    float len = length(direction);
+    if (len > 0.0 && dot(direction / len, bounds.ConeAxis) >= bounds.ConeCutoff) {
+        return false;
+    }
+
+    return true;
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+
+    if (index >= u_MeshletCount || !isVisible(b_Bounds[index])) {
+        return;
+    }
+
+    Meshlet meshlet = b_Meshlets[index];
+
+    uint drawIndex = atomicAdd(b_DrawCount, 1);
+
+    b_Draws[drawIndex] = DrawIndexedIndirectCommand(meshlet.IndexCount, 1, meshlet.FirstIndex, 0, 0);
+}
\ No newline at end of file
@@ -0,0 +1,680 @@
+#include <Ryme/AABBTree.hpp>
+#include <Ryme/Array.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace ryme {
+
+// The number of buckets the centers are sorted into, when looking for the best split in Rebuild()
+const size_t BinCount = 16;
+
+// Set on entries of the query stack whose node is entirely inside of the query, so nothing below it
+// needs to be tested
+const uint32_t ContainedBit = 0x80000000;
+
+// Half of the surface area, which is all the heuristic needs
+inline float getArea(const Vec3& min, const Vec3& max)
+{
+    Vec3 size = max - min;
+    return (size.x * size.y) + (size.y * size.z) + (size.z * size.x);
+}
+
+bool isBoxInsideFrustum(const Frustum& frustum, const Vec3& min, const Vec3& max)
+{
+    for (const auto& plane : frustum.PlaneList) {
+        // The corner furthest against the normal is the first one to leave the plane
+        Vec3 corner = {
+            (plane.x >= 0.0f ? min.x : max.x),
+            (plane.y >= 0.0f ? min.y : max.y),
+            (plane.z >= 0.0f ? min.z : max.z),
+        };
+
+        if (glm::dot(Vec3(plane), corner) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <class Overlaps, class Contains, class Visit>
+void AABBTree::query(Overlaps overlaps, Contains contains, Visit visit) const
+{
+    if (_root == NullNode) {
+        return;
+    }
+
+    List<uint32_t> stack;
+    stack.reserve(_nodeList[_root].Height + 1);
+    stack.push_back(_root);
+
+    while (not stack.empty()) {
+        uint32_t entry = stack.back();
+        stack.pop_back();
+
+        uint32_t index = (entry & ~ContainedBit);
+        bool isContained = (entry & ContainedBit);
+
+        const auto& node = _nodeList[index];
+
+        if (not isContained) {
+            if (not overlaps(node.Min, node.Max)) {
+                continue;
+            }
+
+            isContained = contains(node.Min, node.Max);
+        }
+
+        if (node.IsLeaf()) {
+            visit(index, isContained);
+            continue;
+        }
+
+        uint32_t flag = (isContained ? ContainedBit : 0);
+
+        stack.push_back(node.ChildList[0] | flag);
+        stack.push_back(node.ChildList[1] | flag);
+    }
+}
+
+RYME_API
+uint32_t AABBTree::Insert(const Vec3& min, const Vec3& max, void * userData)
+{
+    uint32_t leaf = allocateNode();
+
+    auto& node = _nodeList[leaf];
+    node.Min = min - Vec3(_margin);
+    node.Max = max + Vec3(_margin);
+    node.UserData = userData;
+
+    _leafBoundsList[leaf] = { min, max };
+
+    insertLeaf(leaf);
+
+    ++_stats.ProxyCount;
+
+    return leaf;
+}
+
+RYME_API
+void AABBTree::Remove(uint32_t proxy)
+{
+    removeLeaf(proxy);
+    freeNode(proxy);
+
+    --_stats.ProxyCount;
+}
+
+RYME_API
+bool AABBTree::Move(uint32_t proxy, const Vec3& min, const Vec3& max)
+{
+    _leafBoundsList[proxy] = { min, max };
+
+    auto& node = _nodeList[proxy];
+
+    bool isInside = glm::all(glm::lessThanEqual(node.Min, min))
+        and glm::all(glm::lessThanEqual(max, node.Max));
+
+    // Bounds that shrank a lot would otherwise keep the size they had before
+    bool isTooLarge = glm::any(glm::greaterThan(node.Max - node.Min, (max - min) + Vec3(_margin * 4.0f)));
+
+    if (isInside and not isTooLarge) {
+        return false;
+    }
+
+    node.Min = min - Vec3(_margin);
+    node.Max = max + Vec3(_margin);
+
+    // Once a node is dirty so are all of the nodes above it, so there is no need to go further
+    uint32_t index = node.Parent;
+    while (index != NullNode and not _nodeList[index].IsDirty) {
+        _nodeList[index].IsDirty = true;
+        index = _nodeList[index].Parent;
+    }
+
+    _isDirty = true;
+    ++_movedCount;
+
+    return true;
+}
+
+RYME_API
+void AABBTree::Update()
+{
+    RYME_PROFILE_FUNCTION();
+
+    if (_isDirty) {
+        refitDirty();
+        _isDirty = false;
+    }
+
+    _stats.MovedCount = _movedCount;
+    _movedCount = 0;
+
+    updateStats();
+
+    if (_rebuiltCost <= 0.0f) {
+        _rebuiltCost = _stats.Cost;
+    }
+
+    if (_rebuildThreshold > 0.0f and _stats.Cost > _rebuiltCost * _rebuildThreshold) {
+        Rebuild();
+    }
+}
+
+RYME_API
+void AABBTree::Rebuild()
+{
+    RYME_PROFILE_FUNCTION();
+
+    // Dirty nodes are thrown away with the rest
+    _isDirty = false;
+
+    // Keep the leaves, as their indices are the proxies, and free everything else. Going through the
+    // nodes in order finds the leaves in the same order no matter what the old tree was, so the same
+    // proxies always build the same tree
+    List<BuildEntry> entryList;
+    entryList.reserve(_stats.ProxyCount);
+
+    if (_root != NullNode) {
+        for (size_t i = _nodeList.size(); i > 0; --i) {
+            uint32_t index = static_cast<uint32_t>(i - 1);
+
+            const auto& node = _nodeList[index];
+
+            if (node.Height == NullNode) {
+                continue;
+            }
+
+            if (node.IsLeaf()) {
+                entryList.push_back(BuildEntry{ node.Min, index, node.Max });
+            }
+            else {
+                // Freed from the highest to the lowest, so the nodes are used again in order, and
+                // each is close to its children
+                freeNode(index);
+            }
+        }
+    }
+
+    _internalArea = 0.0;
+
+    _root = NullNode;
+
+    if (not entryList.empty()) {
+        _root = buildNode(entryList.data(), entryList.size(), NullNode);
+    }
+
+    ++_stats.RebuildCount;
+
+    updateStats();
+
+    _rebuiltCost = _stats.Cost;
+}
+
+RYME_API
+void AABBTree::Clear()
+{
+    _nodeList.clear();
+    _leafBoundsList.clear();
+
+    _root = NullNode;
+    _freeNode = NullNode;
+    _internalArea = 0.0;
+    _rebuiltCost = 0.0f;
+    _isDirty = false;
+    _movedCount = 0;
+
+    _stats = {};
+}
+
+RYME_API
+void AABBTree::QueryFrustum(const Frustum& frustum, List<uint32_t>& proxyList) const
+{
+    RYME_PROFILE_FUNCTION();
+
+    query(
+        [&](const Vec3& min, const Vec3& max) {
+            return frustum.IntersectsBox(min, max);
+        },
+        [&](const Vec3& min, const Vec3& max) {
+            return isBoxInsideFrustum(frustum, min, max);
+        },
+        [&](uint32_t leaf, bool isContained) {
+            const auto& bounds = _leafBoundsList[leaf];
+            if (isContained or frustum.IntersectsBox(bounds.Min, bounds.Max)) {
+                proxyList.push_back(leaf);
+            }
+        }
+    );
+}
+
+RYME_API
+void AABBTree::QueryBox(const Vec3& min, const Vec3& max, List<uint32_t>& proxyList) const
+{
+    RYME_PROFILE_FUNCTION();
+
+    auto overlaps = [&](const Vec3& nodeMin, const Vec3& nodeMax) {
+        return glm::all(glm::lessThanEqual(nodeMin, max))
+            and glm::all(glm::lessThanEqual(min, nodeMax));
+    };
+
+    query(
+        overlaps,
+        [&](const Vec3& nodeMin, const Vec3& nodeMax) {
+            return glm::all(glm::lessThanEqual(min, nodeMin))
+                and glm::all(glm::lessThanEqual(nodeMax, max));
+        },
+        [&](uint32_t leaf, bool isContained) {
+            const auto& bounds = _leafBoundsList[leaf];
+            if (isContained or overlaps(bounds.Min, bounds.Max)) {
+                proxyList.push_back(leaf);
+            }
+        }
+    );
+}
+
+RYME_API
+void AABBTree::QuerySphere(const Vec3& center, float radius, List<uint32_t>& proxyList) const
+{
+    RYME_PROFILE_FUNCTION();
+
+    float radiusSquared = radius * radius;
+
+    auto overlaps = [&](const Vec3& min, const Vec3& max) {
+        Vec3 closest = glm::clamp(center, min, max);
+        Vec3 offset = closest - center;
+        return (glm::dot(offset, offset) <= radiusSquared);
+    };
+
+    query(
+        overlaps,
+        [&](const Vec3& min, const Vec3& max) {
+            // The corner furthest from the center is the last one to leave the sphere
+            Vec3 offset = glm::max(glm::abs(min - center), glm::abs(max - center));
+            return (glm::dot(offset, offset) <= radiusSquared);
+        },
+        [&](uint32_t leaf, bool isContained) {
+            const auto& bounds = _leafBoundsList[leaf];
+            if (isContained or overlaps(bounds.Min, bounds.Max)) {
+                proxyList.push_back(leaf);
+            }
+        }
+    );
+}
+
+RYME_API
+void AABBTree::QueryRay(const Vec3& origin, const Vec3& direction, float maxDistance, List<RayHit>& hitList) const
+{
+    RYME_PROFILE_FUNCTION();
+
+    // Components of 0 become infinity, which the slabs handle as parallel to the ray
+    Vec3 inverseDirection = 1.0f / direction;
+
+    auto intersect = [&](const Vec3& min, const Vec3& max, float& distance) {
+        Vec3 slab0 = (min - origin) * inverseDirection;
+        Vec3 slab1 = (max - origin) * inverseDirection;
+
+        Vec3 enter = glm::min(slab0, slab1);
+        Vec3 exit = glm::max(slab0, slab1);
+
+        distance = std::max(std::max(enter.x, enter.y), std::max(enter.z, 0.0f));
+        float exitDistance = std::min(std::min(exit.x, exit.y), std::min(exit.z, maxDistance));
+
+        return (distance <= exitDistance);
+    };
+
+    query(
+        [&](const Vec3& min, const Vec3& max) {
+            float distance;
+            return intersect(min, max, distance);
+        },
+        [&](const Vec3& min, const Vec3& max) {
+            return false;
+        },
+        [&](uint32_t leaf, bool isContained) {
+            const auto& bounds = _leafBoundsList[leaf];
+
+            float distance;
+            if (intersect(bounds.Min, bounds.Max, distance)) {
+                hitList.push_back(RayHit{ leaf, distance });
+            }
+        }
+    );
+}
+
+uint32_t AABBTree::allocateNode()
+{
+    if (_freeNode == NullNode) {
+        _nodeList.emplace_back();
+        _leafBoundsList.emplace_back();
+
+        return static_cast<uint32_t>(_nodeList.size() - 1);
+    }
+
+    uint32_t index = _freeNode;
+    _freeNode = _nodeList[index].Parent;
+
+    _nodeList[index] = Node();
+
+    return index;
+}
+
+void AABBTree::freeNode(uint32_t index)
+{
+    const auto& node = _nodeList[index];
+
+    if (not node.IsLeaf()) {
+        _internalArea -= getArea(node.Min, node.Max);
+    }
+
+    _nodeList[index] = Node();
+    _nodeList[index].Parent = _freeNode;
+    _nodeList[index].Height = NullNode;
+
+    _freeNode = index;
+}
+
+void AABBTree::insertLeaf(uint32_t leaf)
+{
+    if (_root == NullNode) {
+        _root = leaf;
+        _nodeList[leaf].Parent = NullNode;
+        return;
+    }
+
+    Vec3 min = _nodeList[leaf].Min;
+    Vec3 max = _nodeList[leaf].Max;
+
+    // Walk down towards the sibling that grows the surface area of the tree the least
+    uint32_t index = _root;
+
+    while (not _nodeList[index].IsLeaf()) {
+        const auto& node = _nodeList[index];
+
+        float area = getArea(node.Min, node.Max);
+        float combinedArea = getArea(glm::min(node.Min, min), glm::max(node.Max, max));
+
+        // A new parent for this node and the leaf
+        float cost = 2.0f * combinedArea;
+
+        // Going further down grows this node no matter which child is chosen
+        float inheritedCost = 2.0f * (combinedArea - area);
+
+        Array<float, 2> childCostList;
+
+        for (unsigned i = 0; i < 2; ++i) {
+            const auto& child = _nodeList[node.ChildList[i]];
+
+            childCostList[i] = getArea(glm::min(child.Min, min), glm::max(child.Max, max)) + inheritedCost;
+
+            if (not child.IsLeaf()) {
+                childCostList[i] -= getArea(child.Min, child.Max);
+            }
+        }
+
+        if (cost < childCostList[0] and cost < childCostList[1]) {
+            break;
+        }
+
+        index = node.ChildList[childCostList[0] <= childCostList[1] ? 0 : 1];
+    }
+
+    uint32_t sibling = index;
+    uint32_t parent = allocateNode();
+    uint32_t grandparent = _nodeList[sibling].Parent;
+
+    auto& parentNode = _nodeList[parent];
+    parentNode.Parent = grandparent;
+    parentNode.ChildList[0] = sibling;
+    parentNode.ChildList[1] = leaf;
+
+    // The nodes above a dirty one must be dirty as well
+    parentNode.IsDirty = _nodeList[sibling].IsDirty;
+
+    _nodeList[sibling].Parent = parent;
+    _nodeList[leaf].Parent = parent;
+
+    if (grandparent == NullNode) {
+        _root = parent;
+    }
+    else {
+        auto& grandparentNode = _nodeList[grandparent];
+        grandparentNode.ChildList[grandparentNode.ChildList[0] == sibling ? 0 : 1] = parent;
+    }
+
+    for (index = parent; index != NullNode; index = _nodeList[index].Parent) {
+        fitNode(index);
+    }
+}
+
+void AABBTree::removeLeaf(uint32_t leaf)
+{
+    if (leaf == _root) {
+        _root = NullNode;
+        return;
+    }
+
+    uint32_t parent = _nodeList[leaf].Parent;
+    uint32_t grandparent = _nodeList[parent].Parent;
+
+    const auto& parentNode = _nodeList[parent];
+    uint32_t sibling = parentNode.ChildList[parentNode.ChildList[0] == leaf ? 1 : 0];
+
+    // The sibling takes the place of the parent
+    _nodeList[sibling].Parent = grandparent;
+
+    freeNode(parent);
+
+    if (grandparent == NullNode) {
+        _root = sibling;
+        return;
+    }
+
+    auto& grandparentNode = _nodeList[grandparent];
+    grandparentNode.ChildList[grandparentNode.ChildList[0] == parent ? 0 : 1] = sibling;
+
+    for (uint32_t index = grandparent; index != NullNode; index = _nodeList[index].Parent) {
+        fitNode(index);
+    }
+}
+
+void AABBTree::fitNode(uint32_t index)
+{
+    auto& node = _nodeList[index];
+
+    const auto& child0 = _nodeList[node.ChildList[0]];
+    const auto& child1 = _nodeList[node.ChildList[1]];
+
+    _internalArea -= getArea(node.Min, node.Max);
+
+    node.Min = glm::min(child0.Min, child1.Min);
+    node.Max = glm::max(child0.Max, child1.Max);
+
+    _internalArea += getArea(node.Min, node.Max);
+
+    node.Height = 1 + std::max(child0.Height, child1.Height);
+}
+
+void AABBTree::refitDirty()
+{
+    if (_root == NullNode) {
+        return;
+    }
+
+    // Every dirty node is found before its children, so fitting them in reverse fits the children
+    // first
+    List<uint32_t> dirtyList;
+    List<uint32_t> stack = { _root };
+
+    while (not stack.empty()) {
+        uint32_t index = stack.back();
+        stack.pop_back();
+
+        const auto& node = _nodeList[index];
+        if (not node.IsDirty) {
+            continue;
+        }
+
+        dirtyList.push_back(index);
+
+        stack.push_back(node.ChildList[0]);
+        stack.push_back(node.ChildList[1]);
+    }
+
+    for (auto it = dirtyList.rbegin(); it != dirtyList.rend(); ++it) {
+        fitNode(*it);
+        _nodeList[*it].IsDirty = false;
+    }
+}
+
+uint32_t AABBTree::buildNode(BuildEntry * entryList, size_t entryCount, uint32_t parent)
+{
+    if (entryCount == 1) {
+        _nodeList[entryList[0].Leaf].Parent = parent;
+        return entryList[0].Leaf;
+    }
+
+    size_t splitCount = entryCount / 2;
+
+    // With only two there is nothing to choose
+    if (entryCount == 2) {
+        return buildSplit(entryList, entryCount, splitCount, parent);
+    }
+
+    // Twice the center, which sorts the same
+    auto getCenter = [](const BuildEntry& entry) {
+        return entry.Min + entry.Max;
+    };
+
+    Vec3 centerMin = getCenter(entryList[0]);
+    Vec3 centerMax = centerMin;
+
+    for (size_t i = 1; i < entryCount; ++i) {
+        Vec3 center = getCenter(entryList[i]);
+        centerMin = glm::min(centerMin, center);
+        centerMax = glm::max(centerMax, center);
+    }
+
+    Vec3 extent = centerMax - centerMin;
+
+    unsigned axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
+
+    if (extent[axis] > 0.0f) {
+        struct Bin
+        {
+            Vec3 Min = Vec3(std::numeric_limits<float>::max());
+
+            Vec3 Max = Vec3(std::numeric_limits<float>::lowest());
+
+            size_t Count = 0;
+
+        }; // struct Bin
+
+        Array<Bin, BinCount> binList;
+
+        float scale = BinCount / extent[axis];
+
+        auto getBin = [&](const BuildEntry& entry) {
+            size_t bin = static_cast<size_t>((getCenter(entry)[axis] - centerMin[axis]) * scale);
+            return std::min(bin, BinCount - 1);
+        };
+
+        for (size_t i = 0; i < entryCount; ++i) {
+            auto& bin = binList[getBin(entryList[i])];
+            bin.Min = glm::min(bin.Min, entryList[i].Min);
+            bin.Max = glm::max(bin.Max, entryList[i].Max);
+            ++bin.Count;
+        }
+
+        // The cost of everything right of each split, swept from the right
+        Array<float, BinCount> rightCostList;
+        Bin right;
+
+        for (size_t i = BinCount - 1; i > 0; --i) {
+            right.Min = glm::min(right.Min, binList[i].Min);
+            right.Max = glm::max(right.Max, binList[i].Max);
+            right.Count += binList[i].Count;
+
+            rightCostList[i] = (right.Count > 0 ? getArea(right.Min, right.Max) * right.Count : 0.0f);
+        }
+
+        Bin left;
+        float bestCost = std::numeric_limits<float>::max();
+        size_t bestBin = 0;
+
+        // Split between bin i - 1 and bin i
+        for (size_t i = 1; i < BinCount; ++i) {
+            left.Min = glm::min(left.Min, binList[i - 1].Min);
+            left.Max = glm::max(left.Max, binList[i - 1].Max);
+            left.Count += binList[i - 1].Count;
+
+            if (left.Count == 0 or left.Count == entryCount) {
+                continue;
+            }
+
+            float cost = getArea(left.Min, left.Max) * left.Count + rightCostList[i];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestBin = i;
+            }
+        }
+
+        if (bestBin > 0) {
+            auto it = std::partition(entryList, entryList + entryCount, [&](const auto& entry) {
+                return (getBin(entry) < bestBin);
+            });
+
+            splitCount = static_cast<size_t>(it - entryList);
+        }
+    }
+
+    return buildSplit(entryList, entryCount, splitCount, parent);
+}
+
+uint32_t AABBTree::buildSplit(BuildEntry * entryList, size_t entryCount, size_t splitCount, uint32_t parent)
+{
+    uint32_t index = allocateNode();
+
+    uint32_t child0 = buildNode(entryList, splitCount, index);
+    uint32_t child1 = buildNode(entryList + splitCount, entryCount - splitCount, index);
+
+    auto& node = _nodeList[index];
+    node.Parent = parent;
+    node.ChildList[0] = child0;
+    node.ChildList[1] = child1;
+
+    fitNode(index);
+
+    return index;
+}
+
+void AABBTree::updateStats()
+{
+    _stats.NodeCount = (_stats.ProxyCount > 0 ? _stats.ProxyCount * 2 - 1 : 0);
+    _stats.Height = 0;
+    _stats.Cost = 0.0f;
+
+    if (_root == NullNode) {
+        return;
+    }
+
+    const auto& root = _nodeList[_root];
+
+    _stats.Height = root.Height;
+
+    float rootArea = getArea(root.Min, root.Max);
+    if (rootArea > 0.0f) {
+        _stats.Cost = static_cast<float>(_internalArea / rootArea);
+    }
+}
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include <Ryme/Archive.hpp>
+#include <Ryme/Compression.hpp>
+#include <Ryme/Exception.hpp>
+#include <Ryme/Hash.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace ryme {
+
+RYME_API
+Archive::Archive(const Path& path)
+{
+    Open(path);
+}
+
+RYME_API
+bool Archive::Open(const Path& path)
+{
+    RYME_PROFILE_FUNCTION();
+
+    Close();
+
+    auto file = std::make_shared<MappedFile>();
+    if (not file->Open(path)) {
+        return false;
+    }
+
+    const uint8_t * data = file->GetData();
+    const uint64_t size = file->GetSize();
+
+    ArchiveHeader header;
+    if (size < sizeof(header)) {
+        throw Exception("Archive '{}' is too small", path);
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    if (header.Magic != Magic) {
+        throw Exception("Archive '{}' has an invalid magic number {:08X}", path, header.Magic);
+    }
+
+    if (header.Version != Version) {
+        throw Exception("Archive '{}' has an unsupported version {}", path, header.Version);
+    }
+
+    if (header.Alignment < DefaultAlignment or (header.Alignment & (header.Alignment - 1)) != 0) {
+        throw Exception("Archive '{}' has an invalid alignment {}", path, header.Alignment);
+    }
+
+    // The table of contents is read in place, so it has to be aligned
+    if (header.EntryListOffset % alignof(ArchiveEntry) != 0
+        or header.EntryListOffset > size
+        or header.EntryCount > (size - header.EntryListOffset) / sizeof(ArchiveEntry)) {
+        throw Exception("Archive '{}' has an invalid table of contents", path);
+    }
+
+    if (header.NameListOffset > size or header.NameListSize > size - header.NameListOffset) {
+        throw Exception("Archive '{}' has an invalid name list", path);
+    }
+
+    Span<const ArchiveEntry> entryList(
+        reinterpret_cast<const ArchiveEntry *>(data + header.EntryListOffset),
+        header.EntryCount
+    );
+
+    for (const auto& entry : entryList) {
+        if (entry.Offset % header.Alignment != 0
+            or entry.Offset > size
+            or entry.StoredSize > size - entry.Offset
+            or uint64_t(entry.NameOffset) + entry.NameSize > header.NameListSize) {
+            throw Exception("Archive '{}' has an entry out of bounds", path);
+        }
+
+        if (entry.Compression == ArchiveCompression::None) {
+            if (entry.StoredSize != entry.Size) {
+                throw Exception("Archive '{}' has an uncompressed entry with the wrong size", path);
+            }
+        }
+        else if (entry.Compression != ArchiveCompression::LZ) {
+            throw Exception("Archive '{}' has an entry with an unknown compression {}",
+                path, static_cast<uint32_t>(entry.Compression));
+        }
+    }
+
+    _path = path;
+    _entryList = entryList;
+    _nameList = StringView(reinterpret_cast<const char *>(data + header.NameListOffset), header.NameListSize);
+    _file = std::move(file);
+
+    return true;
+}
+
+RYME_API
+void Archive::Close()
+{
+    _path = Path();
+    _entryList = {};
+    _nameList = {};
+    _file.reset();
+}
+
+RYME_API
+StringView Archive::GetName(const ArchiveEntry& entry) const
+{
+    return _nameList.substr(entry.NameOffset, entry.NameSize);
+}
+
+RYME_API
+const ArchiveEntry * Archive::Find(StringView name) const
+{
+    uint64_t pathHash = Hash64(name);
+
+    auto it = std::lower_bound(_entryList.begin(), _entryList.end(), pathHash,
+        [](const ArchiveEntry& entry, uint64_t hash) {
+            return (entry.PathHash < hash);
+        }
+    );
+
+    // Every entry with the same hash is compared, in case of a collision
+    for (; it != _entryList.end() and it->PathHash == pathHash; ++it) {
+        if (GetName(*it) == name) {
+            return &*it;
+        }
+    }
+
+    return nullptr;
+}
+
+RYME_API
+VFS::File Archive::Read(const ArchiveEntry& entry) const
+{
+    RYME_PROFILE_FUNCTION();
+
+    Path path = _path / Path(GetName(entry));
+
+    Span<const uint8_t> storedData(_file->GetData() + entry.Offset, entry.StoredSize);
+
+    if (entry.Compression == ArchiveCompression::None) {
+        return VFS::File(_file, storedData, path);
+    }
+
+    List<uint8_t> data(entry.Size);
+
+    if (not DecompressLZ(storedData, data)) {
+        throw Exception("Failed to decompress '{}'", path);
+    }
+
+    return VFS::File(std::move(data), path);
+}
+
+RYME_API
+ArchiveWriter::ArchiveWriter(uint32_t alignment /*= Archive::DefaultAlignment*/)
+    : _alignment(alignment)
+{
+    if (_alignment < Archive::DefaultAlignment or (_alignment & (_alignment - 1)) != 0) {
+        throw Exception("Invalid archive alignment {}", _alignment);
+    }
+}
+
+RYME_API
+bool ArchiveWriter::AddFile(StringView name, const Path& path, bool compress /*= false*/)
+{
+    if (not _nameSet.emplace(name).second) {
+        return false;
+    }
+
+    _pendingList.push_back(PendingEntry{
+        .Name = String(name),
+        .SourcePath = path,
+        .Data = {},
+        .Compress = compress,
+    });
+
+    return true;
+}
+
+RYME_API
+bool ArchiveWriter::AddData(StringView name, List<uint8_t>&& data, bool compress /*= false*/)
+{
+    if (not _nameSet.emplace(name).second) {
+        return false;
+    }
+
+    _pendingList.push_back(PendingEntry{
+        .Name = String(name),
+        .SourcePath = Path(),
+        .Data = std::move(data),
+        .Compress = compress,
+    });
+
+    return true;
+}
+
+RYME_API
+bool ArchiveWriter::Write(const Path& path)
+{
+    RYME_PROFILE_FUNCTION();
+
+    _size = 0;
+    _storedSize = 0;
+
+    // Written to a temporary file first, so an archive being read at the same time is never half written
+    return WriteFileReplacing(path, [&](FILE * file) {
+        uint64_t offset = 0;
+
+        const uint8_t padding[256] = { };
+
+        auto writePadding = [&](uint64_t alignment) {
+            uint64_t paddingSize = (alignment - (offset % alignment)) % alignment;
+            while (paddingSize > 0) {
+                size_t count = std::min<uint64_t>(paddingSize, sizeof(padding));
+                fwrite(padding, 1, count, file);
+                offset += count;
+                paddingSize -= count;
+            }
+        };
+
+        auto writeData = [&](const void * data, uint64_t size) {
+            if (size > 0) {
+                fwrite(data, 1, size, file);
+                offset += size;
+            }
+        };
+
+        // Rewritten once the table of contents is known
+        ArchiveHeader header = {
+            .Magic = Archive::Magic,
+            .Version = Archive::Version,
+            .EntryCount = static_cast<uint32_t>(_pendingList.size()),
+            .Alignment = _alignment,
+            .EntryListOffset = 0,
+            .NameListOffset = 0,
+            .NameListSize = 0,
+        };
+
+        writeData(&header, sizeof(header));
+
+        List<ArchiveEntry> entryList;
+        entryList.reserve(_pendingList.size());
+
+        String nameList;
+
+        for (const auto& pending : _pendingList) {
+            MappedFile mappedFile;
+            Span<const uint8_t> data = pending.Data;
+
+            if (not pending.SourcePath.IsEmpty()) {
+                if (not mappedFile.Open(pending.SourcePath)) {
+                    Log(RYME_ANCHOR, "Failed to open '{}'", pending.SourcePath);
+                    return false;
+                }
+
+                data = mappedFile.GetSpan();
+            }
+
+            ArchiveEntry entry = {
+                .PathHash = Hash64(pending.Name),
+                .ContentHash = Hash64(data),
+                .Offset = 0,
+                .StoredSize = data.size(),
+                .Size = data.size(),
+                .NameOffset = static_cast<uint32_t>(nameList.size()),
+                .NameSize = static_cast<uint32_t>(pending.Name.size()),
+                .Compression = ArchiveCompression::None,
+                .Reserved = 0,
+            };
+
+            nameList += pending.Name;
+
+            // Only kept if it saves at least an eighth, otherwise reading it directly is worth more
+            List<uint8_t> compressedData;
+            if (pending.Compress and not data.empty()) {
+                compressedData = CompressLZ(data);
+
+                if (compressedData.size() <= data.size() - (data.size() / 8)) {
+                    entry.StoredSize = compressedData.size();
+                    entry.Compression = ArchiveCompression::LZ;
+                    data = compressedData;
+                }
+            }
+
+            writePadding(_alignment);
+
+            entry.Offset = offset;
+            writeData(data.data(), data.size());
+
+            entryList.push_back(entry);
+
+            _size += entry.Size;
+            _storedSize += entry.StoredSize;
+        }
+
+        // Sorted so entries can be found with a binary search, by name as well to be deterministic
+        std::sort(entryList.begin(), entryList.end(),
+            [&](const ArchiveEntry& lhs, const ArchiveEntry& rhs) {
+                if (lhs.PathHash != rhs.PathHash) {
+                    return (lhs.PathHash < rhs.PathHash);
+                }
+
+                return (StringView(nameList).substr(lhs.NameOffset, lhs.NameSize)
+                    < StringView(nameList).substr(rhs.NameOffset, rhs.NameSize));
+            }
+        );
+
+        writePadding(alignof(ArchiveEntry));
+
+        header.EntryListOffset = offset;
+        writeData(entryList.data(), entryList.size() * sizeof(ArchiveEntry));
+
+        header.NameListOffset = offset;
+        header.NameListSize = nameList.size();
+        writeData(nameList.data(), nameList.size());
+
+        fseek(file, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, file);
+
+        return true;
+    });
+}
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include <Ryme/AssetManager.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Map.hpp>
+#include <Ryme/Profiler.hpp>
+#include <Ryme/SamplerCache.hpp>
+#include <Ryme/TextureLoader.hpp>
+#include <Ryme/VFS.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace ryme {
+
+namespace AssetManager {
+
+struct Entry
+{
+    std::shared_ptr<Asset> Ref;
+
+    // The last frame the asset was requested or referenced outside of the manager
+    uint64_t LastUsedFrame;
+
+}; // struct Entry
+
+// Recursive, as loading an asset can request the assets it depends on
+std::recursive_mutex _assetMutex;
+
+Map<TypeIndex, Map<String, Entry>> _assetMap;
+
+uint64_t _frame = 0;
+
+size_t _memoryBudget = 0;
+
+size_t _hitCount = 0;
+
+size_t _missCount = 0;
+
+size_t _evictedCount = 0;
+
+size_t getMemoryUsage()
+{
+    size_t memoryUsage = 0;
+
+    for (const auto& [type, entryMap] : _assetMap) {
+        for (const auto& [key, entry] : entryMap) {
+            memoryUsage += entry.Ref->GetMemorySize();
+        }
+    }
+
+    return memoryUsage;
+}
+
+// Unload unused assets, least recently used first, until the assets use no more than budget
+void evictUnused(size_t budget)
+{
+    struct Unused
+    {
+        Map<String, Entry> * EntryMap;
+
+        Map<String, Entry>::iterator It;
+
+        size_t MemorySize;
+
+    }; // struct Unused
+
+    List<Unused> unusedList;
+    size_t memoryUsage = 0;
+
+    for (auto& [type, entryMap] : _assetMap) {
+        for (auto it = entryMap.begin(); it != entryMap.end(); ++it) {
+            size_t memorySize = it->second.Ref->GetMemorySize();
+            memoryUsage += memorySize;
+
+            if (it->second.Ref.use_count() > 1) {
+                it->second.LastUsedFrame = _frame;
+            }
+            else {
+                unusedList.push_back({ &entryMap, it, memorySize });
+            }
+        }
+    }
+
+    std::sort(unusedList.begin(), unusedList.end(), [](const auto& a, const auto& b) {
+        return (a.It->second.LastUsedFrame < b.It->second.LastUsedFrame);
+    });
+
+    for (const auto& unused : unusedList) {
+        if (budget > 0 and memoryUsage <= budget) {
+            break;
+        }
+
+        // Dropping the last reference frees the asset, which defers destroying anything the GPU may still be using
+        unused.EntryMap->erase(unused.It);
+        memoryUsage -= unused.MemorySize;
+        ++_evictedCount;
+    }
+}
+
+RYME_API
+Path GetCanonicalPath(const Path& path, bool search /*= true*/)
+{
+    Path fullPath = path;
+
+    if (search) {
+        Path indexedPath = VFS::Resolve(path);
+        if (not indexedPath.IsEmpty()) {
+            fullPath = indexedPath;
+        }
+    }
+
+    if (fullPath.IsRelative()) {
+        fullPath = GetCurrentPath() / fullPath;
+    }
+
+    return fullPath;
+}
+
+RYME_API
+std::shared_ptr<Asset> GetOrLoad(TypeIndex type, const String& key, LoadFunc loadFunc)
+{
+    std::lock_guard<std::recursive_mutex> lock(_assetMutex);
+
+    auto& entryMap = _assetMap[type];
+
+    auto it = entryMap.find(key);
+    if (it != entryMap.end()) {
+        it->second.LastUsedFrame = _frame;
+        ++_hitCount;
+        return it->second.Ref;
+    }
+
+    ++_missCount;
+
+    auto asset = loadFunc();
+    if (asset) {
+        // Loading may have added other assets, invalidating the reference to entryMap
+        _assetMap[type][key] = Entry{
+            .Ref = asset,
+            .LastUsedFrame = _frame,
+        };
+    }
+
+    return asset;
+}
+
+RYME_API
+std::shared_ptr<Model> LoadModel(const Path& path, bool search /*= true*/)
+{
+    // The model is loaded without searching, so the cooked file has to be found here
+    Path loadPath = (search ? VFS::GetCookedPath(path, "rmesh") : path);
+    Path fullPath = GetCanonicalPath(loadPath, search);
+
+    return GetOrLoad<Model>(fullPath.ToString(), [&]() {
+        return std::make_shared<Model>(fullPath, false);
+    });
+}
+
+RYME_API
+std::shared_ptr<Texture> LoadTexture(const Path& path, vk::SamplerCreateInfo samplerCreateInfo /*= {}*/, bool search /*= true*/)
+{
+    Path loadPath = (search ? VFS::GetCookedPath(path, "ktx2") : path);
+    Path fullPath = GetCanonicalPath(loadPath, search);
+
+    if (samplerCreateInfo.pNext) {
+        return TextureLoader::LoadAsync(fullPath, samplerCreateInfo, {}, false);
+    }
+
+    String key = fmt::format("{}|{}", fullPath, fmt::join(SamplerCache::GetKey(samplerCreateInfo), "|"));
+
+    return GetOrLoad<Texture>(key, [&]() {
+        return TextureLoader::LoadAsync(fullPath, samplerCreateInfo, {}, false);
+    });
+}
+
+RYME_API
+std::shared_ptr<Shader> LoadShader(const List<Path>& pathList, bool search /*= true*/)
+{
+    List<Path> fullPathList;
+    String key;
+
+    for (const auto& path : pathList) {
+        fullPathList.push_back(GetCanonicalPath(path, search));
+
+        key += fullPathList.back().ToString();
+        key += Path::ListSeparator;
+    }
+
+    return GetOrLoad<Shader>(key, [&]() {
+        return std::make_shared<Shader>(fullPathList, false);
+    });
+}
+
+RYME_API
+void Update()
+{
+    RYME_PROFILE_FUNCTION();
+
+    std::lock_guard<std::recursive_mutex> lock(_assetMutex);
+
+    ++_frame;
+
+    evictUnused(_memoryBudget);
+}
+
+RYME_API
+void UnloadUnused()
+{
+    std::lock_guard<std::recursive_mutex> lock(_assetMutex);
+
+    evictUnused(0);
+}
+
+RYME_API
+void Term()
+{
+    std::lock_guard<std::recursive_mutex> lock(_assetMutex);
+
+    _assetMap.clear();
+}
+
+RYME_API
+void SetMemoryBudget(size_t bytes)
+{
+    std::lock_guard<std::recursive_mutex> lock(_assetMutex);
+
+    _memoryBudget = bytes;
+}
+
+RYME_API
+size_t GetMemoryBudget()
+{
+    std::lock_guard<std::recursive_mutex> lock(_assetMutex);
+
+    return _memoryBudget;
+}
+
+RYME_API
+Stats GetStats()
+{
+    std::lock_guard<std::recursive_mutex> lock(_assetMutex);
+
+    Stats stats = {
+        .AssetCount = 0,
+        .UnusedCount = 0,
+        .MemoryUsage = getMemoryUsage(),
+        .HitCount = _hitCount,
+        .MissCount = _missCount,
+        .EvictedCount = _evictedCount,
+    };
+
+    for (const auto& [type, entryMap] : _assetMap) {
+        stats.AssetCount += entryMap.size();
+
+        for (const auto& [key, entry] : entryMap) {
+            if (entry.Ref.use_count() == 1) {
+                ++stats.UnusedCount;
+            }
+        }
+    }
+
+    return stats;
+}
+
+} // namespace AssetManager
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,762 @@
+#include <Ryme/AsyncIO.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Profiler.hpp>
+#include <Ryme/Queue.hpp>
+#include <Ryme/ThreadPool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(RYME_PLATFORM_WINDOWS)
+
+    #include <Ryme/UTF.hpp>
+
+    #include <Windows.h>
+
+#else
+
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+#endif
+
+#if defined(RYME_PLATFORM_LINUX)
+
+    #include <linux/io_uring.h>
+    #include <sys/eventfd.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+
+#endif
+
+namespace ryme {
+
+namespace AsyncIO {
+
+// Enough reads in flight to keep an NVMe drive busy, without holding thousands of files open
+const unsigned MaxReadsInFlight = 128;
+
+const unsigned IOThreadCount = 4;
+
+// Linux reads at most just under 2 GiB at once, larger reads are split
+const uint64_t MaxReadChunkSize = 1 << 30;
+
+struct ReadOperation
+{
+    ReadRequest Request;
+
+    size_t Index;
+
+    // Shared by every request in the same call to Read()
+    std::shared_ptr<AsyncIO::CompleteFunc> CompleteFunc;
+
+    ReadResult Result;
+
+    uint8_t * Data = nullptr;
+
+    uint64_t Size = 0;
+
+    uint64_t ReadSize = 0;
+
+#if defined(RYME_PLATFORM_WINDOWS)
+
+    HANDLE FileHandle = INVALID_HANDLE_VALUE;
+
+#else
+
+    int FileDescriptor = -1;
+
+#endif
+
+}; // struct ReadOperation
+
+std::mutex _ioMutex;
+
+std::condition_variable _idleCondition;
+
+Backend _backend = Backend::None;
+
+bool _isStopping = false;
+
+std::atomic_size_t _pendingCount = 0;
+
+std::unique_ptr<ThreadPool> _ioThreadPool;
+
+// Open the file and find the size of the read, setting Result.Error if that fails
+bool openFile(ReadOperation& operation)
+{
+    const auto& request = operation.Request;
+
+    uint64_t fileSize = 0;
+
+    #if defined(RYME_PLATFORM_WINDOWS)
+
+        operation.FileHandle = CreateFileW(
+            UTF::ToWideString(request.Path.ToString()).c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        );
+
+        if (operation.FileHandle == INVALID_HANDLE_VALUE) {
+            operation.Result.Error = ENOENT;
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (not GetFileSizeEx(operation.FileHandle, &size)) {
+            operation.Result.Error = EIO;
+            return false;
+        }
+
+        fileSize = static_cast<uint64_t>(size.QuadPart);
+
+    #else
+
+        operation.FileDescriptor = open(request.Path.ToCString(), O_RDONLY | O_CLOEXEC);
+        if (operation.FileDescriptor < 0) {
+            operation.Result.Error = errno;
+            return false;
+        }
+
+        struct stat status;
+        if (fstat(operation.FileDescriptor, &status) < 0) {
+            operation.Result.Error = errno;
+            return false;
+        }
+
+        if (not S_ISREG(status.st_mode)) {
+            operation.Result.Error = EISDIR;
+            return false;
+        }
+
+        fileSize = static_cast<uint64_t>(status.st_size);
+
+    #endif
+
+    if (request.Offset > fileSize or request.Size > fileSize - request.Offset) {
+        operation.Result.Error = EINVAL;
+        return false;
+    }
+
+    operation.Size = (request.Size == 0 ? fileSize - request.Offset : request.Size);
+
+    if (request.Destination) {
+        if (request.Size == 0) {
+            operation.Result.Error = EINVAL;
+            return false;
+        }
+
+        operation.Data = request.Destination;
+    }
+    else {
+        operation.Result.Buffer.resize(operation.Size);
+        operation.Data = operation.Result.Buffer.data();
+    }
+
+    return true;
+}
+
+void closeFile(ReadOperation& operation)
+{
+    #if defined(RYME_PLATFORM_WINDOWS)
+
+        if (operation.FileHandle != INVALID_HANDLE_VALUE) {
+            CloseHandle(operation.FileHandle);
+            operation.FileHandle = INVALID_HANDLE_VALUE;
+        }
+
+    #else
+
+        if (operation.FileDescriptor >= 0) {
+            close(operation.FileDescriptor);
+            operation.FileDescriptor = -1;
+        }
+
+    #endif
+}
+
+// Read the rest of the operation on the calling thread
+void readBlocking(ReadOperation& operation)
+{
+    while (operation.ReadSize < operation.Size) {
+        uint64_t offset = operation.Request.Offset + operation.ReadSize;
+        uint64_t size = std::min(operation.Size - operation.ReadSize, MaxReadChunkSize);
+
+        #if defined(RYME_PLATFORM_WINDOWS)
+
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+            DWORD readSize = 0;
+            if (not ReadFile(operation.FileHandle, operation.Data + operation.ReadSize, static_cast<DWORD>(size), &readSize, &overlapped)) {
+                operation.Result.Error = EIO;
+                return;
+            }
+
+        #else
+
+            ssize_t readSize = pread(operation.FileDescriptor, operation.Data + operation.ReadSize, size, offset);
+            if (readSize < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                operation.Result.Error = errno;
+                return;
+            }
+
+        #endif
+
+        // The file was truncated since it was opened
+        if (readSize == 0) {
+            operation.Result.Error = EIO;
+            return;
+        }
+
+        operation.ReadSize += readSize;
+    }
+}
+
+void completeOperation(ReadOperation& operation)
+{
+    closeFile(operation);
+
+    auto& result = operation.Result;
+    result.Path = operation.Request.Path;
+    result.Index = operation.Index;
+
+    if (result.Error == 0) {
+        result.Data = { operation.Data, operation.Size };
+    }
+    else {
+        result.Buffer = {};
+    }
+
+    try {
+        (*operation.CompleteFunc)(std::move(result));
+    }
+    catch (const std::exception& e) {
+        Log(RYME_ANCHOR, "Failed to complete read of '{}': {}", operation.Request.Path, e.what());
+    }
+
+    // Locked so that Wait() can't miss the notification between checking the count and waiting
+    if (--_pendingCount == 0) {
+        std::lock_guard<std::mutex> lock(_ioMutex);
+        _idleCondition.notify_all();
+    }
+}
+
+#if defined(RYME_PLATFORM_LINUX)
+
+///
+/// The submission and completion queues shared with the kernel, set up with the raw system calls so
+/// that liburing isn't needed
+///
+class IOURing
+{
+public:
+
+    ///
+    /// @return False if io_uring isn't supported, or is too old to support IORING_OP_READ
+    ///
+    bool Init(unsigned entryCount) {
+        io_uring_params params = {};
+
+        int ring = static_cast<int>(syscall(__NR_io_uring_setup, entryCount, &params));
+        if (ring < 0) {
+            return false;
+        }
+
+        // IORING_OP_READ was added in 5.6, along with this feature
+        if (not (params.features & IORING_FEAT_RW_CUR_POS)) {
+            close(ring);
+            return false;
+        }
+
+        _ring = ring;
+
+        _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        bool isSingleMapping = (params.features & IORING_FEAT_SINGLE_MMAP);
+        if (isSingleMapping) {
+            _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+        }
+
+        _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQ_RING);
+        if (_sqRing == MAP_FAILED) {
+            _sqRing = nullptr;
+            Term();
+            return false;
+        }
+
+        if (isSingleMapping) {
+            _cqRing = _sqRing;
+        }
+        else {
+            _cqRing = mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_CQ_RING);
+            if (_cqRing == MAP_FAILED) {
+                _cqRing = nullptr;
+                Term();
+                return false;
+            }
+        }
+
+        _sqeListSize = params.sq_entries * sizeof(io_uring_sqe);
+
+        void * sqeList = mmap(nullptr, _sqeListSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQES);
+        if (sqeList == MAP_FAILED) {
+            Term();
+            return false;
+        }
+
+        _sqeList = static_cast<io_uring_sqe *>(sqeList);
+
+        uint8_t * sqRing = static_cast<uint8_t *>(_sqRing);
+        _sqHead = reinterpret_cast<uint32_t *>(sqRing + params.sq_off.head);
+        _sqTail = reinterpret_cast<uint32_t *>(sqRing + params.sq_off.tail);
+        _sqMask = *reinterpret_cast<uint32_t *>(sqRing + params.sq_off.ring_mask);
+        _sqEntryCount = params.sq_entries;
+
+        // Ring slots always map to the entry with the same index
+        uint32_t * sqArray = reinterpret_cast<uint32_t *>(sqRing + params.sq_off.array);
+        for (uint32_t i = 0; i < params.sq_entries; ++i) {
+            sqArray[i] = i;
+        }
+
+        uint8_t * cqRing = static_cast<uint8_t *>(_cqRing);
+        _cqHead = reinterpret_cast<uint32_t *>(cqRing + params.cq_off.head);
+        _cqTail = reinterpret_cast<uint32_t *>(cqRing + params.cq_off.tail);
+        _cqMask = *reinterpret_cast<uint32_t *>(cqRing + params.cq_off.ring_mask);
+        _cqeList = reinterpret_cast<io_uring_cqe *>(cqRing + params.cq_off.cqes);
+
+        _localSQTail = *_sqTail;
+
+        return true;
+    }
+
+    void Term() {
+        if (_sqeList) {
+            munmap(_sqeList, _sqeListSize);
+            _sqeList = nullptr;
+        }
+
+        if (_cqRing and _cqRing != _sqRing) {
+            munmap(_cqRing, _cqRingSize);
+        }
+
+        if (_sqRing) {
+            munmap(_sqRing, _sqRingSize);
+        }
+
+        _sqRing = nullptr;
+        _cqRing = nullptr;
+
+        if (_ring >= 0) {
+            close(_ring);
+            _ring = -1;
+        }
+    }
+
+    ///
+    /// @return An empty submission queue entry, or nullptr if the queue is full
+    ///
+    io_uring_sqe * GetSQE() {
+        uint32_t head = std::atomic_ref<uint32_t>(*_sqHead).load(std::memory_order_acquire);
+        if (_localSQTail - head >= _sqEntryCount) {
+            return nullptr;
+        }
+
+        io_uring_sqe * sqe = &_sqeList[_localSQTail & _sqMask];
+        memset(sqe, 0, sizeof(*sqe));
+
+        ++_localSQTail;
+
+        return sqe;
+    }
+
+    ///
+    /// Submit every entry from GetSQE(), and wait for waitCount completions
+    ///
+    /// @return False if the wait was interrupted
+    ///
+    bool Submit(unsigned waitCount) {
+        std::atomic_ref<uint32_t>(*_sqTail).store(_localSQTail, std::memory_order_release);
+
+        unsigned submitCount = _localSQTail - std::atomic_ref<uint32_t>(*_sqHead).load(std::memory_order_acquire);
+        unsigned flags = (waitCount > 0 ? IORING_ENTER_GETEVENTS : 0);
+
+        return (syscall(__NR_io_uring_enter, _ring, submitCount, waitCount, flags, nullptr, 0) >= 0);
+    }
+
+    template <class Func>
+    void ForEachCompletion(Func&& func) {
+        uint32_t head = *_cqHead;
+        uint32_t tail = std::atomic_ref<uint32_t>(*_cqTail).load(std::memory_order_acquire);
+
+        for (; head != tail; ++head) {
+            func(_cqeList[head & _cqMask]);
+        }
+
+        std::atomic_ref<uint32_t>(*_cqHead).store(head, std::memory_order_release);
+    }
+
+private:
+
+    int _ring = -1;
+
+    void * _sqRing = nullptr;
+
+    void * _cqRing = nullptr;
+
+    size_t _sqRingSize = 0;
+
+    size_t _cqRingSize = 0;
+
+    size_t _sqeListSize = 0;
+
+    io_uring_sqe * _sqeList = nullptr;
+
+    io_uring_cqe * _cqeList = nullptr;
+
+    uint32_t * _sqHead = nullptr;
+
+    uint32_t * _sqTail = nullptr;
+
+    uint32_t _sqMask = 0;
+
+    uint32_t _sqEntryCount = 0;
+
+    // Entries from GetSQE() that haven't been published to the kernel yet
+    uint32_t _localSQTail = 0;
+
+    uint32_t * _cqHead = nullptr;
+
+    uint32_t * _cqTail = nullptr;
+
+    uint32_t _cqMask = 0;
+
+}; // class IOURing
+
+IOURing _ioURing;
+
+std::thread _ioThread;
+
+// Written to wake the I/O thread, which always has a read of it in flight
+int _wakeEvent = -1;
+
+Queue<std::unique_ptr<ReadOperation>> _requestQueue;
+
+void wakeIOThread()
+{
+    uint64_t value = 1;
+    [[maybe_unused]] ssize_t result = write(_wakeEvent, &value, sizeof(value));
+}
+
+void ioThreadMain()
+{
+    Profiler::SetThreadName("IO");
+
+    // Requests waiting to be opened, and reads waiting to be continued after a short read
+    Queue<std::unique_ptr<ReadOperation>> openQueue;
+    Queue<std::unique_ptr<ReadOperation>> readQueue;
+
+    unsigned inFlightCount = 0;
+
+    uint64_t wakeValue = 0;
+    bool isWakeInFlight = false;
+
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(_ioMutex);
+
+            while (not _requestQueue.empty()) {
+                openQueue.push_back(std::move(_requestQueue.front()));
+                _requestQueue.pop_front();
+            }
+
+            if (_isStopping and openQueue.empty() and readQueue.empty() and inFlightCount == 0) {
+                break;
+            }
+        }
+
+        RYME_PROFILE_ZONE("AsyncIO::Submit");
+
+        io_uring_sqe * wakeSQE = (isWakeInFlight ? nullptr : _ioURing.GetSQE());
+        if (wakeSQE) {
+            wakeSQE->opcode = IORING_OP_READ;
+            wakeSQE->fd = _wakeEvent;
+            wakeSQE->addr = reinterpret_cast<uint64_t>(&wakeValue);
+            wakeSQE->len = sizeof(wakeValue);
+            wakeSQE->user_data = 0;
+
+            isWakeInFlight = true;
+        }
+
+        while (inFlightCount < MaxReadsInFlight) {
+            std::unique_ptr<ReadOperation> operation;
+
+            // Continuing reads first, so files are finished and closed as soon as possible
+            if (not readQueue.empty()) {
+                operation = std::move(readQueue.front());
+                readQueue.pop_front();
+            }
+            else if (not openQueue.empty()) {
+                operation = std::move(openQueue.front());
+                openQueue.pop_front();
+
+                if (not openFile(*operation) or operation->Size == 0) {
+                    completeOperation(*operation);
+                    continue;
+                }
+            }
+            else {
+                break;
+            }
+
+            io_uring_sqe * sqe = _ioURing.GetSQE();
+            if (not sqe) {
+                readQueue.push_front(std::move(operation));
+                break;
+            }
+
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = operation->FileDescriptor;
+            sqe->off = operation->Request.Offset + operation->ReadSize;
+            sqe->addr = reinterpret_cast<uint64_t>(operation->Data + operation->ReadSize);
+            sqe->len = static_cast<uint32_t>(std::min(operation->Size - operation->ReadSize, MaxReadChunkSize));
+
+            // Owned by the ring until it completes
+            sqe->user_data = reinterpret_cast<uint64_t>(operation.release());
+
+            ++inFlightCount;
+        }
+
+        // Sleeps until a read completes, or more are requested
+        if (not _ioURing.Submit(1) and errno != EINTR) {
+            Log(RYME_ANCHOR, "io_uring_enter() failed: {}", strerror(errno));
+        }
+
+        _ioURing.ForEachCompletion([&](const io_uring_cqe& cqe) {
+            if (cqe.user_data == 0) {
+                isWakeInFlight = false;
+                return;
+            }
+
+            std::unique_ptr<ReadOperation> operation(reinterpret_cast<ReadOperation *>(cqe.user_data));
+            --inFlightCount;
+
+            if (cqe.res == -EINTR or cqe.res == -EAGAIN) {
+                readQueue.push_back(std::move(operation));
+                return;
+            }
+
+            if (cqe.res < 0) {
+                operation->Result.Error = -cqe.res;
+            }
+            else if (cqe.res == 0) {
+                // The file was truncated since it was opened
+                operation->Result.Error = EIO;
+            }
+            else {
+                operation->ReadSize += cqe.res;
+
+                if (operation->ReadSize < operation->Size) {
+                    readQueue.push_back(std::move(operation));
+                    return;
+                }
+            }
+
+            completeOperation(*operation);
+        });
+    }
+}
+
+#endif // defined(RYME_PLATFORM_LINUX)
+
+void initialize(bool useIOURing)
+{
+    if (_backend != Backend::None) {
+        return;
+    }
+
+    #if defined(RYME_PLATFORM_LINUX)
+
+        if (useIOURing) {
+            _wakeEvent = eventfd(0, EFD_CLOEXEC);
+
+            if (_wakeEvent >= 0 and _ioURing.Init(MaxReadsInFlight * 2)) {
+                _backend = Backend::IOURing;
+                _ioThread = std::thread(ioThreadMain);
+
+                Log(RYME_ANCHOR, "Using io_uring for asynchronous I/O");
+                return;
+            }
+
+            Log(RYME_ANCHOR, "io_uring is not supported, using a thread pool for asynchronous I/O");
+
+            if (_wakeEvent >= 0) {
+                close(_wakeEvent);
+                _wakeEvent = -1;
+            }
+        }
+
+    #endif
+
+    _backend = Backend::ThreadPool;
+    _ioThreadPool = std::make_unique<ThreadPool>(IOThreadCount, "IO");
+}
+
+RYME_API
+void Init(bool useIOURing /*= true*/)
+{
+    std::lock_guard<std::mutex> lock(_ioMutex);
+
+    initialize(useIOURing);
+}
+
+RYME_API
+void Term()
+{
+    Backend backend;
+
+    {
+        std::lock_guard<std::mutex> lock(_ioMutex);
+
+        backend = _backend;
+        _isStopping = true;
+    }
+
+    #if defined(RYME_PLATFORM_LINUX)
+
+        if (backend == Backend::IOURing) {
+            wakeIOThread();
+            _ioThread.join();
+
+            _ioURing.Term();
+
+            close(_wakeEvent);
+            _wakeEvent = -1;
+        }
+
+    #endif
+
+    // Finishes every read that was submitted
+    if (backend == Backend::ThreadPool) {
+        _ioThreadPool.reset();
+    }
+
+    std::lock_guard<std::mutex> lock(_ioMutex);
+
+    _backend = Backend::None;
+    _isStopping = false;
+}
+
+RYME_API
+Backend GetBackend()
+{
+    std::lock_guard<std::mutex> lock(_ioMutex);
+
+    return _backend;
+}
+
+RYME_API
+void Read(ReadRequest request, CompleteFunc completeFunc)
+{
+    List<ReadRequest> requestList;
+    requestList.push_back(std::move(request));
+
+    Read(std::move(requestList), std::move(completeFunc));
+}
+
+RYME_API
+void Read(List<ReadRequest> requestList, CompleteFunc completeFunc)
+{
+    if (requestList.empty()) {
+        return;
+    }
+
+    auto sharedCompleteFunc = std::make_shared<CompleteFunc>(std::move(completeFunc));
+
+    List<std::unique_ptr<ReadOperation>> operationList;
+    operationList.reserve(requestList.size());
+
+    for (size_t i = 0; i < requestList.size(); ++i) {
+        auto operation = std::make_unique<ReadOperation>();
+        operation->Request = std::move(requestList[i]);
+        operation->Index = i;
+        operation->CompleteFunc = sharedCompleteFunc;
+
+        operationList.push_back(std::move(operation));
+    }
+
+    _pendingCount += operationList.size();
+
+    std::unique_lock<std::mutex> lock(_ioMutex);
+
+    initialize(true);
+
+    #if defined(RYME_PLATFORM_LINUX)
+
+        if (_backend == Backend::IOURing) {
+            for (auto& operation : operationList) {
+                _requestQueue.push_back(std::move(operation));
+            }
+
+            lock.unlock();
+
+            // One wake for the whole batch, which is then submitted together
+            wakeIOThread();
+            return;
+        }
+
+    #endif
+
+    lock.unlock();
+
+    for (auto& operation : operationList) {
+        std::shared_ptr<ReadOperation> sharedOperation = std::move(operation);
+
+        _ioThreadPool->Submit([sharedOperation]() {
+            RYME_PROFILE_ZONE("AsyncIO::Read");
+
+            if (openFile(*sharedOperation)) {
+                readBlocking(*sharedOperation);
+            }
+
+            completeOperation(*sharedOperation);
+        });
+    }
+}
+
+RYME_API
+void Wait()
+{
+    std::unique_lock<std::mutex> lock(_ioMutex);
+
+    _idleCondition.wait(lock, []() {
+        return (_pendingCount == 0);
+    });
+}
+
+RYME_API
+size_t GetPendingCount()
+{
+    return _pendingCount;
+}
+
+} // namespace AsyncIO
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,895 @@
+#include <Ryme/BlockCompression.hpp>
+#include <Ryme/Exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ryme {
+
+///
+/// Shared
+///
+
+inline int square(int value)
+{
+    return value * value;
+}
+
+// Copy a 4x4 block of RGBA8 pixels, edges of the image are clamped
+void fetchBlock(const uint8_t * src, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t * pixels)
+{
+    for (uint32_t y = 0; y < 4; ++y) {
+        uint32_t srcY = std::min(blockY * 4 + y, height - 1);
+
+        for (uint32_t x = 0; x < 4; ++x) {
+            uint32_t srcX = std::min(blockX * 4 + x, width - 1);
+
+            memcpy(pixels + (y * 4 + x) * 4, src + (size_t(srcY) * width + srcX) * 4, 4);
+        }
+    }
+}
+
+// Write a 4x4 block of RGBA8 pixels, discarding any that fall outside of the image
+void storeBlock(const uint8_t * pixels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t * dst)
+{
+    uint32_t blockWidth = std::min(width - blockX * 4, 4u);
+    uint32_t blockHeight = std::min(height - blockY * 4, 4u);
+
+    for (uint32_t y = 0; y < blockHeight; ++y) {
+        size_t dstOffset = (size_t(blockY * 4 + y) * width + blockX * 4) * 4;
+        memcpy(dst + dstOffset, pixels + y * 16, blockWidth * 4);
+    }
+}
+
+///
+/// BC1
+///
+
+inline void unpack565(uint16_t color, uint8_t * rgb)
+{
+    uint8_t r = (color >> 11) & 0x1F;
+    uint8_t g = (color >> 5) & 0x3F;
+    uint8_t b = color & 0x1F;
+
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+inline uint16_t pack565(const uint8_t * rgb)
+{
+    uint16_t r = (rgb[0] * 31 + 127) / 255;
+    uint16_t g = (rgb[1] * 63 + 127) / 255;
+    uint16_t b = (rgb[2] * 31 + 127) / 255;
+
+    return (r << 11) | (g << 5) | b;
+}
+
+// BC3 always uses four colors, BC1 uses three and transparent black when color0 <= color1
+void buildColorPalette(uint16_t color0, uint16_t color1, bool fourColors, uint8_t palette[4][4])
+{
+    unpack565(color0, palette[0]);
+    unpack565(color1, palette[1]);
+
+    palette[0][3] = 255;
+    palette[1][3] = 255;
+
+    for (unsigned c = 0; c < 3; ++c) {
+        if (fourColors or color0 > color1) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+        }
+        else {
+            palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+            palette[3][c] = 0;
+        }
+    }
+
+    palette[2][3] = 255;
+    palette[3][3] = (fourColors or color0 > color1 ? 255 : 0);
+}
+
+void decodeColorBlock(const uint8_t * block, bool fourColors, bool hasAlpha, uint8_t * pixels)
+{
+    uint16_t color0 = block[0] | (block[1] << 8);
+    uint16_t color1 = block[2] | (block[3] << 8);
+
+    uint8_t palette[4][4];
+    buildColorPalette(color0, color1, fourColors, palette);
+
+    uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (uint32_t(block[7]) << 24);
+
+    for (unsigned i = 0; i < 16; ++i) {
+        memcpy(pixels + i * 4, palette[(indices >> (i * 2)) & 0x3], 3);
+
+        if (hasAlpha) {
+            pixels[i * 4 + 3] = palette[(indices >> (i * 2)) & 0x3][3];
+        }
+    }
+}
+
+void encodeColorBlock(const uint8_t * pixels, uint8_t * block)
+{
+    uint8_t min[3] = { 255, 255, 255 };
+    uint8_t max[3] = { 0, 0, 0 };
+
+    for (unsigned i = 0; i < 16; ++i) {
+        for (unsigned c = 0; c < 3; ++c) {
+            min[c] = std::min(min[c], pixels[i * 4 + c]);
+            max[c] = std::max(max[c], pixels[i * 4 + c]);
+        }
+    }
+
+    // Pull the endpoints in slightly, the extremes are rarely the best fit for the rest of the block
+    for (unsigned c = 0; c < 3; ++c) {
+        uint8_t inset = (max[c] - min[c]) / 16;
+        min[c] += inset;
+        max[c] -= inset;
+    }
+
+    // Packing is monotonic, so color0 >= color1 and the block decodes with four colors
+    uint16_t color0 = pack565(max);
+    uint16_t color1 = pack565(min);
+
+    uint8_t palette[4][4];
+    buildColorPalette(color0, color1, true, palette);
+
+    uint32_t indices = 0;
+
+    if (color0 != color1) {
+        for (unsigned i = 0; i < 16; ++i) {
+            const uint8_t * pixel = pixels + i * 4;
+
+            int bestError = INT32_MAX;
+            uint32_t bestIndex = 0;
+
+            for (uint32_t index = 0; index < 4; ++index) {
+                int error = square(pixel[0] - palette[index][0])
+                    + square(pixel[1] - palette[index][1])
+                    + square(pixel[2] - palette[index][2]);
+
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = index;
+                }
+            }
+
+            indices |= bestIndex << (i * 2);
+        }
+    }
+
+    block[0] = color0 & 0xFF;
+    block[1] = color0 >> 8;
+    block[2] = color1 & 0xFF;
+    block[3] = color1 >> 8;
+    block[4] = indices & 0xFF;
+    block[5] = (indices >> 8) & 0xFF;
+    block[6] = (indices >> 16) & 0xFF;
+    block[7] = indices >> 24;
+}
+
+///
+/// BC4, also used for the alpha of BC3 and both channels of BC5
+///
+
+void buildChannelPalette(uint8_t value0, uint8_t value1, uint8_t palette[8])
+{
+    palette[0] = value0;
+    palette[1] = value1;
+
+    if (value0 > value1) {
+        for (unsigned i = 1; i < 7; ++i) {
+            palette[i + 1] = ((7 - i) * value0 + i * value1 + 3) / 7;
+        }
+    }
+    else {
+        for (unsigned i = 1; i < 5; ++i) {
+            palette[i + 1] = ((5 - i) * value0 + i * value1 + 2) / 5;
+        }
+
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+void decodeChannelBlock(const uint8_t * block, unsigned channel, uint8_t * pixels)
+{
+    uint8_t palette[8];
+    buildChannelPalette(block[0], block[1], palette);
+
+    uint64_t indices = 0;
+    for (unsigned i = 0; i < 6; ++i) {
+        indices |= uint64_t(block[i + 2]) << (i * 8);
+    }
+
+    for (unsigned i = 0; i < 16; ++i) {
+        pixels[i * 4 + channel] = palette[(indices >> (i * 3)) & 0x7];
+    }
+}
+
+void encodeChannelBlock(const uint8_t * pixels, unsigned channel, uint8_t * block)
+{
+    uint8_t min = 255;
+    uint8_t max = 0;
+
+    for (unsigned i = 0; i < 16; ++i) {
+        min = std::min(min, pixels[i * 4 + channel]);
+        max = std::max(max, pixels[i * 4 + channel]);
+    }
+
+    // value0 > value1 selects the mode with eight interpolated values
+    uint8_t palette[8];
+    buildChannelPalette(max, min, palette);
+
+    uint64_t indices = 0;
+
+    if (max != min) {
+        for (unsigned i = 0; i < 16; ++i) {
+            int value = pixels[i * 4 + channel];
+
+            int bestError = INT32_MAX;
+            uint64_t bestIndex = 0;
+
+            for (uint64_t index = 0; index < 8; ++index) {
+                int error = std::abs(value - palette[index]);
+
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = index;
+                }
+            }
+
+            indices |= bestIndex << (i * 3);
+        }
+    }
+
+    block[0] = max;
+    block[1] = min;
+
+    for (unsigned i = 0; i < 6; ++i) {
+        block[i + 2] = (indices >> (i * 8)) & 0xFF;
+    }
+}
+
+///
+/// BC7
+///
+
+struct BC7ModeInfo
+{
+    uint8_t SubsetCount;
+
+    uint8_t PartitionBits;
+
+    uint8_t RotationBits;
+
+    uint8_t IndexSelectionBits;
+
+    uint8_t ColorBits;
+
+    uint8_t AlphaBits;
+
+    // One P-bit per endpoint, or one shared by both endpoints of a subset
+    uint8_t EndpointPBits;
+
+    uint8_t SharedPBits;
+
+    uint8_t IndexBits;
+
+    uint8_t SecondaryIndexBits;
+
+}; // struct BC7ModeInfo
+
+static const BC7ModeInfo bc7ModeInfoList[] = {
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+};
+
+static const uint8_t bc7WeightList2[] = { 0, 21, 43, 64 };
+
+static const uint8_t bc7WeightList3[] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+
+static const uint8_t bc7WeightList4[] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// Bit N is the subset of pixel N
+static const uint16_t bc7PartitionList2[64] = {
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+static const uint8_t bc7PartitionList3[64][16] = {
+    { 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2 },
+    { 0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1 },
+    { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2 },
+    { 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1 },
+    { 0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2 },
+    { 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2 },
+    { 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2 },
+    { 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0 },
+    { 0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2 },
+    { 0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0 },
+    { 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1 },
+    { 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2 },
+    { 0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2 },
+    { 0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0 },
+    { 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0 },
+    { 0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2 },
+    { 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0 },
+    { 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1 },
+    { 0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1 },
+    { 0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2 },
+    { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2 },
+    { 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0 },
+    { 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0 },
+    { 0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0 },
+    { 0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1 },
+    { 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1 },
+    { 0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1 },
+    { 0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1 },
+    { 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1 },
+    { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2 },
+    { 0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1 },
+    { 0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2 },
+    { 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2 },
+    { 0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2 },
+    { 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1 },
+    { 0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0 },
+};
+
+// The anchor pixel of each subset stores its index with one less bit, subset 0 always uses pixel 0
+static const uint8_t bc7AnchorList2[64] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+static const uint8_t bc7AnchorList3[2][64] = {
+    {
+         3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+         3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+         8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+         3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+    },
+    {
+        15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+        15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+        15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+        15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+    },
+};
+
+class BC7BitReader
+{
+public:
+
+    BC7BitReader(const uint8_t * block)
+        : _block(block)
+    { }
+
+    uint32_t Read(unsigned count)
+    {
+        uint32_t value = 0;
+
+        for (unsigned i = 0; i < count; ++i, ++_offset) {
+            value |= ((_block[_offset >> 3] >> (_offset & 7)) & 1) << i;
+        }
+
+        return value;
+    }
+
+private:
+
+    const uint8_t * _block;
+
+    unsigned _offset = 0;
+
+}; // class BC7BitReader
+
+class BC7BitWriter
+{
+public:
+
+    BC7BitWriter(uint8_t * block)
+        : _block(block)
+    {
+        memset(_block, 0, 16);
+    }
+
+    void Write(uint32_t value, unsigned count)
+    {
+        for (unsigned i = 0; i < count; ++i, ++_offset) {
+            _block[_offset >> 3] |= ((value >> i) & 1) << (_offset & 7);
+        }
+    }
+
+private:
+
+    uint8_t * _block;
+
+    unsigned _offset = 0;
+
+}; // class BC7BitWriter
+
+inline uint8_t bc7Interpolate(uint8_t endpoint0, uint8_t endpoint1, unsigned index, unsigned indexBits)
+{
+    const uint8_t * weightList = (
+        indexBits == 2 ? bc7WeightList2 :
+        indexBits == 3 ? bc7WeightList3 :
+        bc7WeightList4
+    );
+
+    unsigned weight = weightList[index];
+    return ((64 - weight) * endpoint0 + weight * endpoint1 + 32) >> 6;
+}
+
+void decodeBC7Block(const uint8_t * block, uint8_t * pixels)
+{
+    BC7BitReader reader(block);
+
+    // The mode is the number of 0 bits before the first 1
+    unsigned mode = 0;
+    while (mode < 8 and reader.Read(1) == 0) {
+        ++mode;
+    }
+
+    // Reserved, decodes to transparent black
+    if (mode == 8) {
+        memset(pixels, 0, 64);
+        return;
+    }
+
+    const auto& info = bc7ModeInfoList[mode];
+
+    unsigned partition = reader.Read(info.PartitionBits);
+    unsigned rotation = reader.Read(info.RotationBits);
+    unsigned indexSelection = reader.Read(info.IndexSelectionBits);
+
+    // [subset][endpoint][channel]
+    uint8_t endpoints[3][2][4] = {};
+
+    for (unsigned c = 0; c < 3; ++c) {
+        for (unsigned s = 0; s < info.SubsetCount; ++s) {
+            endpoints[s][0][c] = reader.Read(info.ColorBits);
+            endpoints[s][1][c] = reader.Read(info.ColorBits);
+        }
+    }
+
+    if (info.AlphaBits > 0) {
+        for (unsigned s = 0; s < info.SubsetCount; ++s) {
+            endpoints[s][0][3] = reader.Read(info.AlphaBits);
+            endpoints[s][1][3] = reader.Read(info.AlphaBits);
+        }
+    }
+
+    unsigned colorBits = info.ColorBits;
+    unsigned alphaBits = info.AlphaBits;
+
+    if (info.EndpointPBits or info.SharedPBits) {
+        for (unsigned s = 0; s < info.SubsetCount; ++s) {
+            uint8_t pBits[2];
+            pBits[0] = reader.Read(1);
+            pBits[1] = (info.SharedPBits ? pBits[0] : reader.Read(1));
+
+            for (unsigned e = 0; e < 2; ++e) {
+                for (unsigned c = 0; c < 4; ++c) {
+                    endpoints[s][e][c] = (endpoints[s][e][c] << 1) | pBits[e];
+                }
+            }
+        }
+
+        ++colorBits;
+
+        if (alphaBits > 0) {
+            ++alphaBits;
+        }
+    }
+
+    // Expand to 8 bits by replicating the high bits into the low bits
+    for (unsigned s = 0; s < info.SubsetCount; ++s) {
+        for (unsigned e = 0; e < 2; ++e) {
+            for (unsigned c = 0; c < 3; ++c) {
+                uint8_t value = endpoints[s][e][c] << (8 - colorBits);
+                endpoints[s][e][c] = value | (value >> colorBits);
+            }
+
+            if (alphaBits > 0) {
+                uint8_t value = endpoints[s][e][3] << (8 - alphaBits);
+                endpoints[s][e][3] = value | (value >> alphaBits);
+            }
+            else {
+                endpoints[s][e][3] = 255;
+            }
+        }
+    }
+
+    uint8_t subsetList[16] = {};
+    uint8_t anchorList[3] = { 0, 0, 0 };
+
+    if (info.SubsetCount == 2) {
+        for (unsigned i = 0; i < 16; ++i) {
+            subsetList[i] = (bc7PartitionList2[partition] >> i) & 1;
+        }
+
+        anchorList[1] = bc7AnchorList2[partition];
+    }
+    else if (info.SubsetCount == 3) {
+        memcpy(subsetList, bc7PartitionList3[partition], 16);
+
+        anchorList[1] = bc7AnchorList3[0][partition];
+        anchorList[2] = bc7AnchorList3[1][partition];
+    }
+
+    uint8_t indexList[16];
+    uint8_t secondaryIndexList[16] = {};
+
+    for (unsigned i = 0; i < 16; ++i) {
+        bool isAnchor = (i == anchorList[subsetList[i]]);
+        indexList[i] = reader.Read(info.IndexBits - (isAnchor ? 1 : 0));
+    }
+
+    if (info.SecondaryIndexBits > 0) {
+        for (unsigned i = 0; i < 16; ++i) {
+            secondaryIndexList[i] = reader.Read(info.SecondaryIndexBits - (i == 0 ? 1 : 0));
+        }
+    }
+
+    for (unsigned i = 0; i < 16; ++i) {
+        const auto& endpoint0 = endpoints[subsetList[i]][0];
+        const auto& endpoint1 = endpoints[subsetList[i]][1];
+
+        unsigned colorIndex = indexList[i];
+        unsigned colorIndexBits = info.IndexBits;
+        unsigned alphaIndex = indexList[i];
+        unsigned alphaIndexBits = info.IndexBits;
+
+        // Modes 4 and 5 have separate color and alpha indices, mode 4 can swap which is which
+        if (info.SecondaryIndexBits > 0) {
+            if (indexSelection) {
+                colorIndex = secondaryIndexList[i];
+                colorIndexBits = info.SecondaryIndexBits;
+            }
+            else {
+                alphaIndex = secondaryIndexList[i];
+                alphaIndexBits = info.SecondaryIndexBits;
+            }
+        }
+
+        uint8_t * pixel = pixels + i * 4;
+
+        for (unsigned c = 0; c < 3; ++c) {
+            pixel[c] = bc7Interpolate(endpoint0[c], endpoint1[c], colorIndex, colorIndexBits);
+        }
+
+        pixel[3] = bc7Interpolate(endpoint0[3], endpoint1[3], alphaIndex, alphaIndexBits);
+
+        if (rotation > 0) {
+            std::swap(pixel[3], pixel[rotation - 1]);
+        }
+    }
+}
+
+// Mode 6 has a single subset with 7-bit RGBA endpoints, a P-bit per endpoint, and 4-bit indices
+void encodeBC7Block(const uint8_t * pixels, uint8_t * block)
+{
+    uint8_t endpoints[2][4] = {
+        { 255, 255, 255, 255 },
+        { 0, 0, 0, 0 },
+    };
+
+    for (unsigned i = 0; i < 16; ++i) {
+        for (unsigned c = 0; c < 4; ++c) {
+            endpoints[0][c] = std::min(endpoints[0][c], pixels[i * 4 + c]);
+            endpoints[1][c] = std::max(endpoints[1][c], pixels[i * 4 + c]);
+        }
+    }
+
+    uint8_t quantized[2][4];
+    uint8_t pBits[2];
+
+    // Pick the P-bit that best reconstructs each endpoint
+    for (unsigned e = 0; e < 2; ++e) {
+        int bestError = INT32_MAX;
+
+        for (uint8_t pBit = 0; pBit < 2; ++pBit) {
+            uint8_t candidate[4];
+            int error = 0;
+
+            for (unsigned c = 0; c < 4; ++c) {
+                candidate[c] = std::clamp((endpoints[e][c] - pBit + 1) >> 1, 0, 127);
+                error += square(endpoints[e][c] - ((candidate[c] << 1) | pBit));
+            }
+
+            if (error < bestError) {
+                bestError = error;
+                memcpy(quantized[e], candidate, 4);
+                pBits[e] = pBit;
+            }
+        }
+
+        for (unsigned c = 0; c < 4; ++c) {
+            endpoints[e][c] = (quantized[e][c] << 1) | pBits[e];
+        }
+    }
+
+    uint8_t palette[16][4];
+    for (unsigned index = 0; index < 16; ++index) {
+        for (unsigned c = 0; c < 4; ++c) {
+            palette[index][c] = bc7Interpolate(endpoints[0][c], endpoints[1][c], index, 4);
+        }
+    }
+
+    uint8_t indexList[16];
+
+    for (unsigned i = 0; i < 16; ++i) {
+        const uint8_t * pixel = pixels + i * 4;
+
+        int bestError = INT32_MAX;
+
+        for (unsigned index = 0; index < 16; ++index) {
+            int error = square(pixel[0] - palette[index][0])
+                + square(pixel[1] - palette[index][1])
+                + square(pixel[2] - palette[index][2])
+                + square(pixel[3] - palette[index][3]);
+
+            if (error < bestError) {
+                bestError = error;
+                indexList[i] = index;
+            }
+        }
+    }
+
+    // The anchor index is stored without its high bit, the weights are symmetric so swapping the
+    // endpoints and inverting the indices decodes to the same colors
+    if (indexList[0] & 0x8) {
+        std::swap(quantized[0], quantized[1]);
+        std::swap(pBits[0], pBits[1]);
+
+        for (unsigned i = 0; i < 16; ++i) {
+            indexList[i] = 15 - indexList[i];
+        }
+    }
+
+    BC7BitWriter writer(block);
+
+    writer.Write(1 << 6, 7);
+
+    for (unsigned c = 0; c < 4; ++c) {
+        writer.Write(quantized[0][c], 7);
+        writer.Write(quantized[1][c], 7);
+    }
+
+    writer.Write(pBits[0], 1);
+    writer.Write(pBits[1], 1);
+
+    writer.Write(indexList[0], 3);
+
+    for (unsigned i = 1; i < 16; ++i) {
+        writer.Write(indexList[i], 4);
+    }
+}
+
+///
+/// Public
+///
+
+RYME_API
+bool IsBlockCompressedFormat(vk::Format format)
+{
+    return (GetBlockSize(format) > 0);
+}
+
+RYME_API
+uint32_t GetBlockSize(vk::Format format)
+{
+    switch (format) {
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc1RgbSrgbBlock:
+    case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc1RgbaSrgbBlock:
+    case vk::Format::eBc4UnormBlock:
+        return 8;
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc3SrgbBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+RYME_API
+size_t GetImageSize(vk::Format format, uint32_t width, uint32_t height)
+{
+    uint32_t blockSize = GetBlockSize(format);
+    if (blockSize > 0) {
+        return size_t((width + 3) / 4) * size_t((height + 3) / 4) * blockSize;
+    }
+
+    switch (format) {
+    case vk::Format::eR8Unorm:
+        return size_t(width) * height;
+    case vk::Format::eR8G8Unorm:
+        return size_t(width) * height * 2;
+    case vk::Format::eR8G8B8A8Unorm:
+    case vk::Format::eR8G8B8A8Srgb:
+    case vk::Format::eB8G8R8A8Unorm:
+    case vk::Format::eB8G8R8A8Srgb:
+        return size_t(width) * height * 4;
+    default:
+        throw Exception("Unsupported image format {}", vk::to_string(format));
+    }
+}
+
+RYME_API
+vk::Format GetDecompressedFormat(vk::Format format)
+{
+    switch (format) {
+    case vk::Format::eBc1RgbSrgbBlock:
+    case vk::Format::eBc1RgbaSrgbBlock:
+    case vk::Format::eBc3SrgbBlock:
+    case vk::Format::eBc7SrgbBlock:
+        return vk::Format::eR8G8B8A8Srgb;
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc4UnormBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc7UnormBlock:
+        return vk::Format::eR8G8B8A8Unorm;
+    default:
+        return format;
+    }
+}
+
+RYME_API
+void DecompressImage(vk::Format format, const uint8_t * src, uint32_t width, uint32_t height, uint8_t * dst)
+{
+    uint32_t blockSize = GetBlockSize(format);
+    if (blockSize == 0) {
+        throw Exception("Unable to decompress image format {}", vk::to_string(format));
+    }
+
+    uint32_t blockCountX = (width + 3) / 4;
+    uint32_t blockCountY = (height + 3) / 4;
+
+    uint8_t pixels[16 * 4];
+
+    for (uint32_t blockY = 0; blockY < blockCountY; ++blockY) {
+        for (uint32_t blockX = 0; blockX < blockCountX; ++blockX) {
+            const uint8_t * block = src + (size_t(blockY) * blockCountX + blockX) * blockSize;
+
+            switch (format) {
+            case vk::Format::eBc1RgbUnormBlock:
+            case vk::Format::eBc1RgbSrgbBlock:
+                decodeColorBlock(block, false, false, pixels);
+                for (unsigned i = 0; i < 16; ++i) {
+                    pixels[i * 4 + 3] = 255;
+                }
+                break;
+            case vk::Format::eBc1RgbaUnormBlock:
+            case vk::Format::eBc1RgbaSrgbBlock:
+                decodeColorBlock(block, false, true, pixels);
+                break;
+            case vk::Format::eBc3UnormBlock:
+            case vk::Format::eBc3SrgbBlock:
+                decodeChannelBlock(block, 3, pixels);
+                decodeColorBlock(block + 8, true, false, pixels);
+                break;
+            case vk::Format::eBc4UnormBlock:
+            case vk::Format::eBc5UnormBlock:
+                memset(pixels, 0, sizeof(pixels));
+                for (unsigned i = 0; i < 16; ++i) {
+                    pixels[i * 4 + 3] = 255;
+                }
+
+                decodeChannelBlock(block, 0, pixels);
+                if (format == vk::Format::eBc5UnormBlock) {
+                    decodeChannelBlock(block + 8, 1, pixels);
+                }
+                break;
+            case vk::Format::eBc7UnormBlock:
+            case vk::Format::eBc7SrgbBlock:
+                decodeBC7Block(block, pixels);
+                break;
+            default:
+                break;
+            }
+
+            storeBlock(pixels, width, height, blockX, blockY, dst);
+        }
+    }
+}
+
+RYME_API
+void CompressImage(vk::Format format, const uint8_t * src, uint32_t width, uint32_t height, uint8_t * dst)
+{
+    uint32_t blockSize = GetBlockSize(format);
+    if (blockSize == 0) {
+        throw Exception("Unable to compress to image format {}", vk::to_string(format));
+    }
+
+    uint32_t blockCountX = (width + 3) / 4;
+    uint32_t blockCountY = (height + 3) / 4;
+
+    uint8_t pixels[16 * 4];
+
+    for (uint32_t blockY = 0; blockY < blockCountY; ++blockY) {
+        for (uint32_t blockX = 0; blockX < blockCountX; ++blockX) {
+            uint8_t * block = dst + (size_t(blockY) * blockCountX + blockX) * blockSize;
+
+            fetchBlock(src, width, height, blockX, blockY, pixels);
+
+            switch (format) {
+            case vk::Format::eBc1RgbUnormBlock:
+            case vk::Format::eBc1RgbSrgbBlock:
+            case vk::Format::eBc1RgbaUnormBlock:
+            case vk::Format::eBc1RgbaSrgbBlock:
+                encodeColorBlock(pixels, block);
+                break;
+            case vk::Format::eBc3UnormBlock:
+            case vk::Format::eBc3SrgbBlock:
+                encodeChannelBlock(pixels, 3, block);
+                encodeColorBlock(pixels, block + 8);
+                break;
+            case vk::Format::eBc4UnormBlock:
+                encodeChannelBlock(pixels, 0, block);
+                break;
+            case vk::Format::eBc5UnormBlock:
+                encodeChannelBlock(pixels, 0, block);
+                encodeChannelBlock(pixels, 1, block + 8);
+                break;
+            case vk::Format::eBc7UnormBlock:
+            case vk::Format::eBc7SrgbBlock:
+                encodeBC7Block(pixels, block);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+} // namespace ryme
\ No newline at end of file
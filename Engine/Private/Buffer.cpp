@@ -1,9 +1,46 @@
 #include <Ryme/Buffer.hpp>
+#include <Ryme/Defragmenter.hpp>
 #include <Ryme/Graphics.hpp>
 #include <Ryme/Exception.hpp>
 
 namespace ryme {
 
+Graphics::MemoryCategory getMemoryCategory(vk::BufferUsageFlags bufferUsage)
+{
+    if (bufferUsage & (vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer)) {
+        return Graphics::MemoryCategory::Mesh;
+    }
+
+    if (bufferUsage & vk::BufferUsageFlagBits::eUniformBuffer) {
+        return Graphics::MemoryCategory::Uniform;
+    }
+
+    if (bufferUsage == vk::BufferUsageFlagBits::eTransferSrc) {
+        return Graphics::MemoryCategory::Staging;
+    }
+
+    return Graphics::MemoryCategory::Other;
+}
+
+RYME_API
+Buffer::Buffer(Buffer&& rhs)
+    : _size(rhs._size)
+    , _bufferUsage(rhs._bufferUsage)
+    , _memoryUsage(rhs._memoryUsage)
+    , _buffer(rhs._buffer)
+    , _allocation(rhs._allocation)
+    , _mappedBufferMemory(rhs._mappedBufferMemory)
+{
+    // Vulkan handles are copied when moved, so clear them to avoid destroying them twice
+    rhs._size = 0;
+    rhs._buffer = nullptr;
+    rhs._allocation = nullptr;
+    rhs._mappedBufferMemory = nullptr;
+
+    // The move function refers to the buffer it was registered with
+    registerMovable();
+}
+
 RYME_API
 Buffer::~Buffer()
 {
@@ -37,15 +74,13 @@ void Buffer::Create(vk::DeviceSize size, uint8_t * data, vk::BufferUsageFlagBits
         auto[stagingBuffer, stagingAllocation] = Graphics::CreateBuffer(
             stagingBufferCreateInfo,
             stagingAllocationCreateInfo,
-            &stagingAllocationInfo
+            &stagingAllocationInfo,
+            Graphics::MemoryCategory::Staging
         );
 
         memcpy(stagingAllocationInfo.pMappedData, data, _size);
 
-        auto bufferCreateInfo = vk::BufferCreateInfo()
-            .setSize(_size)
-            .setUsage(vk::BufferUsageFlagBits::eTransferDst | _bufferUsage)
-            .setSharingMode(vk::SharingMode::eExclusive);
+        auto bufferCreateInfo = getBufferCreateInfo();
 
         auto allocationCreateInfo = VmaAllocationCreateInfo{
             .usage = _memoryUsage,
@@ -56,7 +91,8 @@ void Buffer::Create(vk::DeviceSize size, uint8_t * data, vk::BufferUsageFlagBits
         std::tie(_buffer, _allocation) = Graphics::CreateBuffer(
             bufferCreateInfo,
             allocationCreateInfo,
-            &allocationInfo
+            &allocationInfo,
+            getMemoryCategory(_bufferUsage)
         );
 
         auto region = vk::BufferCopy()
@@ -64,7 +100,9 @@ void Buffer::Create(vk::DeviceSize size, uint8_t * data, vk::BufferUsageFlagBits
 
         Graphics::CopyBuffer(stagingBuffer, _buffer, region);
 
-        vmaFreeMemory(Graphics::Allocator, stagingAllocation);
+        registerMovable();
+
+        Graphics::FreeMemory(stagingAllocation);
         
         Graphics::Device.destroyBuffer(stagingBuffer);
     }
@@ -83,7 +121,8 @@ void Buffer::Create(vk::DeviceSize size, uint8_t * data, vk::BufferUsageFlagBits
         std::tie(_buffer, _allocation) = Graphics::CreateBuffer(
             bufferCreateInfo,
             allocationCreateInfo,
-            &allocationInfo
+            &allocationInfo,
+            getMemoryCategory(_bufferUsage)
         );
 
         _mappedBufferMemory = reinterpret_cast<uint8_t *>(allocationInfo.pMappedData);
@@ -99,18 +138,50 @@ void Buffer::Destroy()
 {
     _size = 0;
 
-    if (_mappedBufferMemory) {
-        vmaUnmapMemory(Graphics::Allocator, _allocation);
-        _mappedBufferMemory = nullptr;
+    if (not _buffer) {
+        return;
     }
 
-    Graphics::Device.destroyBuffer(_buffer);
-    _buffer = nullptr;
+    // Persistently mapped memory is unmapped when it is freed
+    _mappedBufferMemory = nullptr;
+
+    Defragmenter::Unregister(_allocation);
+
+    // Vertex, index and indirect buffers are bound by the recorded frame command buffers
+    Graphics::InvalidateCommandBuffers();
 
-    vmaFreeMemory(Graphics::Allocator, _allocation);
+    Graphics::DeferDestroy(
+        [buffer = _buffer, allocation = _allocation]() {
+            Graphics::Device.destroyBuffer(buffer);
+            Graphics::FreeMemory(allocation);
+        }
+    );
+
+    _buffer = nullptr;
     _allocation = nullptr;
 }
 
+vk::BufferCreateInfo Buffer::getBufferCreateInfo() const
+{
+    // GPU only buffers can be copied elsewhere by the Defragmenter
+    return vk::BufferCreateInfo()
+        .setSize(_size)
+        .setUsage(vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst | _bufferUsage)
+        .setSharingMode(vk::SharingMode::eExclusive);
+}
+
+void Buffer::registerMovable()
+{
+    // Mapped buffers can't be moved, as the CPU writes to them at any time
+    if (not _allocation or _memoryUsage != VMA_MEMORY_USAGE_GPU_ONLY) {
+        return;
+    }
+
+    Defragmenter::RegisterBuffer(_allocation, _buffer, getBufferCreateInfo(), [this](vk::Buffer buffer) {
+        _buffer = buffer;
+    });
+}
+
 RYME_API
 void Buffer::ReadFrom(size_t offset, size_t length, uint8_t * data)
 {
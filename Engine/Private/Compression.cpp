@@ -0,0 +1,222 @@
+#include <Ryme/Compression.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ryme {
+
+// https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+// Each sequence is a token, literals, and a match copied from earlier in the output
+
+const size_t LZMinMatch = 4;
+
+// The last bytes are always literals, and the last match must start before this many bytes from the end
+const size_t LZLastLiterals = 5;
+
+const size_t LZMatchFindLimit = 12;
+
+const size_t LZMaxOffset = 65535;
+
+const uint32_t LZHashBits = 16;
+
+inline uint32_t readLZ32(const uint8_t * data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint32_t hashLZ32(uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - LZHashBits);
+}
+
+// Lengths of 15 or more are continued in bytes of 255, ending with a byte less than 255
+inline void writeLZLength(List<uint8_t>& output, size_t length)
+{
+    for (; length >= 255; length -= 255) {
+        output.push_back(255);
+    }
+
+    output.push_back(static_cast<uint8_t>(length));
+}
+
+inline void writeLZSequence(List<uint8_t>& output, const uint8_t * literals, size_t literalLength, size_t offset, size_t matchLength)
+{
+    size_t matchCode = (matchLength > 0 ? matchLength - LZMinMatch : 0);
+
+    output.push_back(static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15)));
+
+    if (literalLength >= 15) {
+        writeLZLength(output, literalLength - 15);
+    }
+
+    output.insert(output.end(), literals, literals + literalLength);
+
+    // The last sequence only has literals
+    if (matchLength == 0) {
+        return;
+    }
+
+    output.push_back(static_cast<uint8_t>(offset));
+    output.push_back(static_cast<uint8_t>(offset >> 8));
+
+    if (matchCode >= 15) {
+        writeLZLength(output, matchCode - 15);
+    }
+}
+
+RYME_API
+size_t GetMaxCompressedSizeLZ(size_t size)
+{
+    return size + (size / 255) + 16;
+}
+
+RYME_API
+List<uint8_t> CompressLZ(Span<const uint8_t> data)
+{
+    const uint8_t * src = data.data();
+    const size_t size = data.size();
+
+    List<uint8_t> output;
+    output.reserve(GetMaxCompressedSizeLZ(size));
+
+    size_t anchor = 0;
+
+    if (size > LZMatchFindLimit) {
+        // The position of the last occurrence of each hash of four bytes, or 0
+        List<uint32_t> hashTable(size_t(1) << LZHashBits, 0);
+
+        const size_t matchLimit = size - LZLastLiterals;
+        const size_t searchLimit = size - LZMatchFindLimit;
+
+        size_t position = 1;
+
+        while (position < searchLimit) {
+            uint32_t sequence = readLZ32(src + position);
+            uint32_t hash = hashLZ32(sequence);
+
+            size_t candidate = hashTable[hash];
+            hashTable[hash] = static_cast<uint32_t>(position);
+
+            if (candidate == 0
+                or position - candidate > LZMaxOffset
+                or readLZ32(src + candidate) != sequence) {
+                ++position;
+                continue;
+            }
+
+            // Extend the match backwards over literals that also match
+            while (position > anchor and candidate > 0 and src[position - 1] == src[candidate - 1]) {
+                --position;
+                --candidate;
+            }
+
+            size_t matchLength = LZMinMatch;
+            while (position + matchLength < matchLimit and src[candidate + matchLength] == src[position + matchLength]) {
+                ++matchLength;
+            }
+
+            writeLZSequence(output, src + anchor, position - anchor, position - candidate, matchLength);
+
+            position += matchLength;
+            anchor = position;
+
+            // Start searching again with the end of the match in the table
+            if (position - 2 < searchLimit) {
+                hashTable[hashLZ32(readLZ32(src + position - 2))] = static_cast<uint32_t>(position - 2);
+            }
+        }
+    }
+
+    writeLZSequence(output, src + anchor, size - anchor, 0, 0);
+
+    return output;
+}
+
+RYME_API
+bool DecompressLZ(Span<const uint8_t> src, Span<uint8_t> dst)
+{
+    const uint8_t * input = src.data();
+    const uint8_t * inputEnd = input + src.size();
+
+    uint8_t * output = dst.data();
+    uint8_t * outputEnd = output + dst.size();
+
+    auto readLength = [&](size_t& length) {
+        uint8_t byte;
+        do {
+            if (input == inputEnd) {
+                return false;
+            }
+
+            byte = *input++;
+            length += byte;
+        } while (byte == 255);
+
+        return true;
+    };
+
+    while (input < inputEnd) {
+        uint8_t token = *input++;
+
+        size_t literalLength = (token >> 4);
+        if (literalLength == 15 and not readLength(literalLength)) {
+            return false;
+        }
+
+        if (size_t(inputEnd - input) < literalLength or size_t(outputEnd - output) < literalLength) {
+            return false;
+        }
+
+        if (literalLength > 0) {
+            memcpy(output, input, literalLength);
+            input += literalLength;
+            output += literalLength;
+        }
+
+        // The last sequence ends after its literals
+        if (input == inputEnd) {
+            break;
+        }
+
+        if (inputEnd - input < 2) {
+            return false;
+        }
+
+        size_t offset = size_t(input[0]) | (size_t(input[1]) << 8);
+        input += 2;
+
+        if (offset == 0 or offset > size_t(output - dst.data())) {
+            return false;
+        }
+
+        size_t matchLength = (token & 15);
+        if (matchLength == 15 and not readLength(matchLength)) {
+            return false;
+        }
+
+        matchLength += LZMinMatch;
+
+        if (size_t(outputEnd - output) < matchLength) {
+            return false;
+        }
+
+        const uint8_t * match = output - offset;
+
+        if (offset >= matchLength) {
+            memcpy(output, match, matchLength);
+            output += matchLength;
+        }
+        else {
+            // The match overlaps the output, repeating the last offset bytes
+            for (size_t i = 0; i < matchLength; ++i) {
+                *output++ = *match++;
+            }
+        }
+    }
+
+    return (output == outputEnd);
+}
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,630 @@
+#include <Ryme/Defragmenter.hpp>
+#include <Ryme/Array.hpp>
+#include <Ryme/Graphics.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+namespace ryme {
+
+namespace Defragmenter {
+
+struct Movable
+{
+    vk::Buffer Buffer;
+
+    vk::BufferCreateInfo BufferCreateInfo;
+
+    Defragmenter::BufferMoveFunc BufferMoveFunc;
+
+    vk::Image Image;
+
+    vk::ImageCreateInfo ImageCreateInfo;
+
+    Defragmenter::ImageMoveFunc ImageMoveFunc;
+
+}; // struct Movable
+
+struct Move
+{
+    // The source allocation, which VMA points at the new memory when the pass ends
+    VmaAllocation Allocation;
+
+    bool IsImage = false;
+
+    // Created by the Defragmenter and bound to the new memory, until they are handed to the owner
+    vk::Buffer NewBuffer;
+
+    vk::Image NewImage;
+
+    // Taken from the owner once the move function has been called
+    vk::Buffer OldBuffer;
+
+    vk::Image OldImage;
+
+    bool IsMoved = false;
+
+    // The owner unregistered the allocation before it was moved
+    bool IsUnregistered = false;
+
+    // The owner freed the allocation during the pass
+    bool IsFreed = false;
+
+}; // struct Move
+
+struct Pass
+{
+    // Owned by VMA until vmaEndDefragmentationPass()
+    VmaDefragmentationPassMoveInfo PassMoveInfo;
+
+    // Indexed the same as PassMoveInfo.pMoves, null for moves that are ignored
+    List<std::unique_ptr<Move>> MoveList;
+
+    // Signalled once the contents have been copied
+    uint64_t CopyTimelineValue = 0;
+
+    // Signalled once every frame that could be using the old handles has finished
+    uint64_t RetireTimelineValue = 0;
+
+    bool IsMoved = false;
+
+}; // struct Pass
+
+bool _enabled = true;
+
+float _fragmentationThreshold = 0.5f;
+
+uint32_t _maxMovesPerPass = 64;
+
+vk::DeviceSize _maxBytesPerPass = 64 * 1024 * 1024;
+
+// Checking the fragmentation walks every block, so it is only done every so often
+constexpr uint64_t CheckInterval = 256;
+
+uint64_t _framesSinceCheck = 0;
+
+bool _startRequested = false;
+
+std::unordered_map<VmaAllocation, Movable> _movableMap;
+
+VmaDefragmentationContext _context = nullptr;
+
+std::unique_ptr<Pass> _pass;
+
+Move * findMove(VmaAllocation allocation)
+{
+    if (not _pass) {
+        return nullptr;
+    }
+
+    for (auto& move : _pass->MoveList) {
+        if (move and move->Allocation == allocation) {
+            return move.get();
+        }
+    }
+
+    return nullptr;
+}
+
+bool isFragmented()
+{
+    auto stats = Graphics::GetMemoryStats();
+
+    for (const auto& heapStats : stats.HeapList) {
+        if (heapStats.IsDeviceLocal and heapStats.Fragmentation > _fragmentationThreshold) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void recordBufferMove(vk::CommandBuffer commandBuffer, const Movable& movable, Move& move)
+{
+    auto region = vk::BufferCopy()
+        .setSize(movable.BufferCreateInfo.size);
+
+    commandBuffer.copyBuffer(movable.Buffer, move.NewBuffer, region);
+}
+
+void recordImageMove(vk::CommandBuffer commandBuffer, const Movable& movable, Move& move)
+{
+    const auto& imageCreateInfo = movable.ImageCreateInfo;
+
+    auto subresourceRange = vk::ImageSubresourceRange()
+        .setAspectMask(vk::ImageAspectFlagBits::eColor)
+        .setBaseMipLevel(0)
+        .setLevelCount(imageCreateInfo.mipLevels)
+        .setBaseArrayLayer(0)
+        .setLayerCount(imageCreateInfo.arrayLayers);
+
+    Array<vk::ImageMemoryBarrier, 2> barrierList = {
+        vk::ImageMemoryBarrier()
+            .setOldLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+            .setNewLayout(vk::ImageLayout::eTransferSrcOptimal)
+            .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setImage(movable.Image)
+            .setSubresourceRange(subresourceRange)
+            .setSrcAccessMask(vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eTransferRead),
+        vk::ImageMemoryBarrier()
+            .setOldLayout(vk::ImageLayout::eUndefined)
+            .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setImage(move.NewImage)
+            .setSubresourceRange(subresourceRange)
+            .setSrcAccessMask({})
+            .setDstAccessMask(vk::AccessFlagBits::eTransferWrite),
+    };
+
+    commandBuffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::PipelineStageFlagBits::eTransfer,
+        {},
+        nullptr,
+        nullptr,
+        barrierList
+    );
+
+    List<vk::ImageCopy> regionList;
+    regionList.reserve(imageCreateInfo.mipLevels);
+
+    for (uint32_t level = 0; level < imageCreateInfo.mipLevels; ++level) {
+        auto subresourceLayers = vk::ImageSubresourceLayers()
+            .setAspectMask(vk::ImageAspectFlagBits::eColor)
+            .setMipLevel(level)
+            .setBaseArrayLayer(0)
+            .setLayerCount(imageCreateInfo.arrayLayers);
+
+        auto extent = vk::Extent3D(
+            std::max(imageCreateInfo.extent.width >> level, 1u),
+            std::max(imageCreateInfo.extent.height >> level, 1u),
+            std::max(imageCreateInfo.extent.depth >> level, 1u)
+        );
+
+        regionList.push_back(vk::ImageCopy()
+            .setSrcSubresource(subresourceLayers)
+            .setDstSubresource(subresourceLayers)
+            .setExtent(extent)
+        );
+    }
+
+    commandBuffer.copyImage(
+        movable.Image,
+        vk::ImageLayout::eTransferSrcOptimal,
+        move.NewImage,
+        vk::ImageLayout::eTransferDstOptimal,
+        regionList
+    );
+
+    // The old image is still sampled until the owner switches to the new one
+    barrierList[0]
+        .setOldLayout(vk::ImageLayout::eTransferSrcOptimal)
+        .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .setSrcAccessMask({})
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+
+    barrierList[1]
+        .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+        .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+
+    commandBuffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eAllCommands,
+        {},
+        nullptr,
+        nullptr,
+        barrierList
+    );
+}
+
+///
+/// @return Whether a pass was started, false once there is nothing left to move
+///
+bool beginPass()
+{
+    RYME_PROFILE_FUNCTION();
+
+    auto pass = std::make_unique<Pass>();
+
+    auto vkResult = (vk::Result)vmaBeginDefragmentationPass(Graphics::Allocator, _context, &pass->PassMoveInfo);
+    if (vkResult == vk::Result::eSuccess) {
+        return false;
+    }
+
+    vk::resultCheck(vkResult, "vmaBeginDefragmentationPass", { vk::Result::eIncomplete });
+
+    auto& passMoveInfo = pass->PassMoveInfo;
+    pass->MoveList.resize(passMoveInfo.moveCount);
+
+    for (uint32_t i = 0; i < passMoveInfo.moveCount; ++i) {
+        auto& vmaMove = passMoveInfo.pMoves[i];
+
+        auto it = _movableMap.find(vmaMove.srcAllocation);
+        if (it == _movableMap.end()) {
+            vmaMove.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+            continue;
+        }
+
+        const auto& movable = it->second;
+
+        auto move = std::make_unique<Move>();
+        move->Allocation = vmaMove.srcAllocation;
+        move->IsImage = bool(movable.Image);
+
+        vk::Result bindResult;
+
+        if (move->IsImage) {
+            move->NewImage = Graphics::Device.createImage(movable.ImageCreateInfo);
+
+            bindResult = (vk::Result)vmaBindImageMemory(
+                Graphics::Allocator,
+                vmaMove.dstTmpAllocation,
+                move->NewImage
+            );
+        }
+        else {
+            move->NewBuffer = Graphics::Device.createBuffer(movable.BufferCreateInfo);
+
+            bindResult = (vk::Result)vmaBindBufferMemory(
+                Graphics::Allocator,
+                vmaMove.dstTmpAllocation,
+                move->NewBuffer
+            );
+        }
+
+        vk::resultCheck(bindResult, "vmaBindMemory");
+
+        pass->MoveList[i] = std::move(move);
+    }
+
+    pass->CopyTimelineValue = Graphics::SubmitCommands([&](vk::CommandBuffer commandBuffer) {
+        // Make any writes to the buffers visible to the copies, such as from their uploads
+        auto memoryBarrier = vk::MemoryBarrier()
+            .setSrcAccessMask(vk::AccessFlagBits::eMemoryWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eTransferRead);
+
+        commandBuffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eAllCommands,
+            vk::PipelineStageFlagBits::eTransfer,
+            {},
+            memoryBarrier,
+            nullptr,
+            nullptr
+        );
+
+        for (auto& move : pass->MoveList) {
+            if (not move) {
+                continue;
+            }
+
+            const auto& movable = _movableMap[move->Allocation];
+
+            if (move->IsImage) {
+                recordImageMove(commandBuffer, movable, *move);
+            }
+            else {
+                recordBufferMove(commandBuffer, movable, *move);
+            }
+        }
+
+        memoryBarrier
+            .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eMemoryRead);
+
+        commandBuffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eAllCommands,
+            {},
+            memoryBarrier,
+            nullptr,
+            nullptr
+        );
+    });
+
+    _pass = std::move(pass);
+
+    return true;
+}
+
+void handOverMoves()
+{
+    RYME_PROFILE_FUNCTION();
+
+    for (auto& move : _pass->MoveList) {
+        if (not move or move->IsUnregistered) {
+            continue;
+        }
+
+        auto& movable = _movableMap[move->Allocation];
+
+        if (move->IsImage) {
+            move->OldImage = movable.Image;
+            movable.Image = move->NewImage;
+            movable.ImageMoveFunc(move->NewImage);
+        }
+        else {
+            move->OldBuffer = movable.Buffer;
+            movable.Buffer = move->NewBuffer;
+            movable.BufferMoveFunc(move->NewBuffer);
+        }
+
+        move->IsMoved = true;
+    }
+
+    // Frames submitted before now may still use the old handles
+    _pass->RetireTimelineValue = Graphics::GetSubmittedTimelineValue();
+    _pass->IsMoved = true;
+
+    Graphics::InvalidateCommandBuffers();
+}
+
+///
+/// @return Whether there are more passes to run
+///
+bool endPass()
+{
+    RYME_PROFILE_FUNCTION();
+
+    auto& passMoveInfo = _pass->PassMoveInfo;
+
+    for (uint32_t i = 0; i < passMoveInfo.moveCount; ++i) {
+        auto& move = _pass->MoveList[i];
+        if (not move) {
+            continue;
+        }
+
+        auto& vmaMove = passMoveInfo.pMoves[i];
+
+        if (move->IsFreed) {
+            vmaMove.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_DESTROY;
+        }
+        else if (not move->IsMoved) {
+            vmaMove.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+        }
+
+        // Whichever handle the owner doesn't have, is ours to destroy
+        if (move->IsMoved) {
+            if (move->IsImage) {
+                Graphics::Device.destroyImage(move->OldImage);
+            }
+            else {
+                Graphics::Device.destroyBuffer(move->OldBuffer);
+            }
+        }
+        else {
+            if (move->IsImage) {
+                Graphics::Device.destroyImage(move->NewImage);
+            }
+            else {
+                Graphics::Device.destroyBuffer(move->NewBuffer);
+            }
+        }
+    }
+
+    auto vkResult = (vk::Result)vmaEndDefragmentationPass(Graphics::Allocator, _context, &passMoveInfo);
+
+    _pass.reset();
+
+    return (vkResult == vk::Result::eIncomplete);
+}
+
+void endDefragmentation()
+{
+    VmaDefragmentationStats defragmentationStats;
+    vmaEndDefragmentation(Graphics::Allocator, _context, &defragmentationStats);
+    _context = nullptr;
+
+    Log(RYME_ANCHOR, "Defragmented {} in {} allocations, freed {} in {} blocks",
+        FormatBytesHumanReadable(defragmentationStats.bytesMoved),
+        defragmentationStats.allocationsMoved,
+        FormatBytesHumanReadable(defragmentationStats.bytesFreed),
+        defragmentationStats.deviceMemoryBlocksFreed
+    );
+}
+
+RYME_API
+void RegisterBuffer(
+    VmaAllocation allocation,
+    vk::Buffer buffer,
+    const vk::BufferCreateInfo& bufferCreateInfo,
+    BufferMoveFunc moveFunc
+)
+{
+    _movableMap[allocation] = Movable{
+        .Buffer = buffer,
+        .BufferCreateInfo = bufferCreateInfo,
+        .BufferMoveFunc = moveFunc,
+    };
+}
+
+RYME_API
+void RegisterImage(
+    VmaAllocation allocation,
+    vk::Image image,
+    const vk::ImageCreateInfo& imageCreateInfo,
+    ImageMoveFunc moveFunc
+)
+{
+    _movableMap[allocation] = Movable{
+        .Image = image,
+        .ImageCreateInfo = imageCreateInfo,
+        .ImageMoveFunc = moveFunc,
+    };
+}
+
+RYME_API
+void Unregister(VmaAllocation allocation)
+{
+    _movableMap.erase(allocation);
+
+    Move * move = findMove(allocation);
+    if (move and not move->IsMoved) {
+        move->IsUnregistered = true;
+    }
+}
+
+RYME_API
+bool ReleaseAllocation(VmaAllocation allocation)
+{
+    Move * move = findMove(allocation);
+    if (not move) {
+        return false;
+    }
+
+    move->IsFreed = true;
+    return true;
+}
+
+RYME_API
+void Update()
+{
+    RYME_PROFILE_FUNCTION();
+
+    if (_pass) {
+        if (not _pass->IsMoved and Graphics::IsTimelineValueComplete(_pass->CopyTimelineValue)) {
+            handOverMoves();
+        }
+
+        if (_pass->IsMoved and Graphics::IsTimelineValueComplete(_pass->RetireTimelineValue)) {
+            if (not endPass()) {
+                endDefragmentation();
+            }
+        }
+
+        return;
+    }
+
+    if (not _context) {
+        if (not _enabled) {
+            return;
+        }
+
+        if (not _startRequested) {
+            if (++_framesSinceCheck < CheckInterval) {
+                return;
+            }
+
+            _framesSinceCheck = 0;
+
+            if (not isFragmented()) {
+                return;
+            }
+        }
+
+        _startRequested = false;
+
+        auto defragmentationInfo = VmaDefragmentationInfo{
+            .flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT,
+            .maxBytesPerPass = _maxBytesPerPass,
+            .maxAllocationsPerPass = _maxMovesPerPass,
+        };
+
+        auto vkResult = (vk::Result)vmaBeginDefragmentation(Graphics::Allocator, &defragmentationInfo, &_context);
+        vk::resultCheck(vkResult, "vmaBeginDefragmentation");
+    }
+
+    if (not beginPass()) {
+        endDefragmentation();
+    }
+}
+
+RYME_API
+void Term()
+{
+    if (_pass) {
+        Graphics::WaitForTimelineValue(_pass->CopyTimelineValue);
+
+        // Nothing has been handed over yet, so every move is ignored
+        if (not _pass->IsMoved) {
+            for (auto& move : _pass->MoveList) {
+                if (move) {
+                    move->IsUnregistered = true;
+                }
+            }
+        }
+        else {
+            Graphics::WaitForTimelineValue(_pass->RetireTimelineValue);
+        }
+
+        endPass();
+    }
+
+    if (_context) {
+        endDefragmentation();
+    }
+
+    _movableMap.clear();
+}
+
+RYME_API
+void Start()
+{
+    _startRequested = true;
+}
+
+RYME_API
+bool IsRunning()
+{
+    return (_context != nullptr);
+}
+
+RYME_API
+void SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+RYME_API
+bool IsEnabled()
+{
+    return _enabled;
+}
+
+RYME_API
+void SetFragmentationThreshold(float threshold)
+{
+    _fragmentationThreshold = threshold;
+}
+
+RYME_API
+float GetFragmentationThreshold()
+{
+    return _fragmentationThreshold;
+}
+
+RYME_API
+void SetMaxMovesPerPass(uint32_t moves)
+{
+    _maxMovesPerPass = std::max(moves, 1u);
+}
+
+RYME_API
+uint32_t GetMaxMovesPerPass()
+{
+    return _maxMovesPerPass;
+}
+
+RYME_API
+void SetMaxBytesPerPass(vk::DeviceSize bytes)
+{
+    _maxBytesPerPass = bytes;
+}
+
+RYME_API
+vk::DeviceSize GetMaxBytesPerPass()
+{
+    return _maxBytesPerPass;
+}
+
+} // namespace Defragmenter
+
+} // namespace ryme
\ No newline at end of file
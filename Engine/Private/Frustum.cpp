@@ -0,0 +1,66 @@
+#include <Ryme/Frustum.hpp>
+
+namespace ryme {
+
+RYME_API
+Frustum Frustum::FromMatrix(const Mat4& matrix)
+{
+    // Gribb and Hartmann, "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix"
+    Vec4 row0 = glm::row(matrix, 0);
+    Vec4 row1 = glm::row(matrix, 1);
+    Vec4 row2 = glm::row(matrix, 2);
+    Vec4 row3 = glm::row(matrix, 3);
+
+    Frustum frustum;
+    frustum.PlaneList = {
+        row3 + row0,
+        row3 - row0,
+        row3 + row1,
+        row3 - row1,
+        row2,
+        row3 - row2,
+    };
+
+    // Normalized so the planes give distances, even when the matrix contains a scale
+    for (auto& plane : frustum.PlaneList) {
+        float length = glm::length(Vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+
+    return frustum;
+}
+
+RYME_API
+bool Frustum::IntersectsSphere(const Vec3& center, float radius) const
+{
+    for (const auto& plane : PlaneList) {
+        if (glm::dot(Vec3(plane), center) + plane.w < -radius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+RYME_API
+bool Frustum::IntersectsBox(const Vec3& min, const Vec3& max) const
+{
+    for (const auto& plane : PlaneList) {
+        // The corner furthest along the normal is the last one to leave the plane
+        Vec3 corner = {
+            (plane.x >= 0.0f ? max.x : min.x),
+            (plane.y >= 0.0f ? max.y : min.y),
+            (plane.z >= 0.0f ? max.z : min.z),
+        };
+
+        if (glm::dot(Vec3(plane), corner) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace ryme
\ No newline at end of file
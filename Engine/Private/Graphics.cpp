@@ -1,6 +1,9 @@
 #include <Ryme/Graphics.hpp>
 #include <Ryme/Buffer.hpp>
 #include <Ryme/Color.hpp>
+#include <Ryme/Defragmenter.hpp>
+#include <Ryme/Queue.hpp>
+#include <Ryme/RenderGraph.hpp>
 #include <Ryme/Ryme.hpp>
 #include <Ryme/Set.hpp>
 #include <Ryme/Shader.hpp>
@@ -10,6 +13,11 @@
 
 #include <SDL_vulkan.h>
 
+#include <pybind11/stl.h>
+
+#include <atomic>
+#include <mutex>
+
 RYME_DISABLE_WARNINGS()
 
     #define VMA_IMPLEMENTATION
@@ -55,6 +63,8 @@ vk::PhysicalDeviceFeatures _physicalDeviceFeatures;
 
 vk::PhysicalDevice _physicalDevice;
 
+bool _drawIndirectCountSupported = false;
+
 // Vulkan Queues
 
 uint32_t _graphicsQueueFamilyIndex;
@@ -75,12 +85,28 @@ vk::Device Device;
 
 VmaAllocator Allocator;
 
+// Memory Stats
+
+// Indexed by MemoryCategory, tracked allocations store their category + 1 as their user data
+std::atomic_size_t _categoryAllocationCountList[MemoryCategoryCount] = {};
+
+std::atomic_uint64_t _categoryBytesList[MemoryCategoryCount] = {};
+
 // Vulkan Command Buffer
 
 vk::CommandPool _commandPool;
 
+// For short lived command buffers submitted with SubmitCommands()
+vk::CommandPool _transientCommandPool;
+
 List<vk::CommandBuffer> _commandBufferList;
 
+// Indexed by swapchain image, whether the command buffer needs to be recorded again before it is used
+List<bool> _commandBufferOutOfDateList;
+
+// Set by InvalidateCommandBuffers() from any thread, and applied to every command buffer by Render()
+std::atomic<bool> _commandBuffersInvalidated = false;
+
 // Swap Chain
 
 vk::Extent2D _swapchainExtent;
@@ -95,19 +121,15 @@ List<vk::Image> _swapchainImageList;
 
 List<vk::ImageView> _swapchainImageViewList;
 
-List<VkFramebuffer> _framebufferList;
-
 // Depth Buffer
 
 vk::Format _depthImageFormat;
 
-vk::Image _depthImage;
-
-VmaAllocation _depthImageAllocation;
+// Render Graph
 
-vk::ImageView _depthImageView;
+RenderGraph _renderGraph;
 
-// Render Pass
+std::function<void(RenderGraph&)> _renderGraphFunc;
 
 vk::RenderPass RenderPass;
 
@@ -115,15 +137,81 @@ vk::RenderPass RenderPass;
 
 vk::DescriptorPool _descriptorPool;
 
+// Timeline Semaphore
+
+// Signalled with an increasing value by every submission to the graphics queue
+vk::Semaphore _graphicsTimelineSemaphore;
+
+// The value signalled by the most recent submission, read by DeferDestroy() from any thread
+std::atomic<uint64_t> _graphicsTimelineValue = 0;
+
+// The most recent value known to be complete
+uint64_t _graphicsCompletedValue = 0;
+
+// Deferred Destruction
+
+struct DeferredDestroy
+{
+    // The timeline value that must complete before the object can be destroyed
+    uint64_t TimelineValue;
+
+    std::function<void()> DestroyFunc;
+
+}; // struct DeferredDestroy
+
+// Objects are released by whichever thread drops the last reference to them, such as the
+// deleters of the SamplerCache and PipelineCache
+std::mutex _deferredDestroyMutex;
+
+// Ordered by TimelineValue, as values only ever increase
+Queue<DeferredDestroy> _deferredDestroyQueue;
+
 // Sync Objects
 
 unsigned _currentFrame;
 
+unsigned _framesInFlight;
+
+// Indexed by frame in flight
 List<vk::Semaphore> _imageAvailableSemaphoreList;
 
+// Indexed by swapchain image
 List<vk::Semaphore> _renderingFinishedSemaphoreList;
 
-List<vk::Fence> _inFlightFenceList;
+// Indexed by frame in flight, the timeline value signalled by that frame
+List<uint64_t> _frameTimelineValueList;
+
+// Indexed by swapchain image, the timeline value of the last frame that rendered to that image
+List<uint64_t> _imageTimelineValueList;
+
+// Present Mode
+
+vk::PresentModeKHR _requestedPresentMode;
+
+vk::PresentModeKHR _presentMode;
+
+unsigned _requestedSwapchainImageCount;
+
+bool _swapchainOutOfDate = false;
+
+// Frame Stats
+
+FrameStats _frameStats = {};
+
+// Timestamp of the oldest input event that has not been presented yet, or 0
+uint64_t _pendingInputTimestamp = 0;
+
+uint64_t _statsPeriodStart = 0;
+
+uint64_t _statsPeriodFrameCount = 0;
+
+uint64_t _statsPeriodFrameWait = 0;
+
+uint64_t _statsPeriodInputCount = 0;
+
+uint64_t _statsPeriodInputLatency = 0;
+
+uint64_t _statsPeriodMaxInputLatency = 0;
 
 
 std::function<void(vk::CommandBuffer)> _renderFunc;
@@ -304,7 +392,7 @@ void initInstance()
         .setApplicationVersion(applicationVersion.ToVkVersion())
         .setPEngineName(RYME_PROJECT_NAME)
         .setEngineVersion(engineVersion.ToVkVersion())
-        .setApiVersion(VK_API_VERSION_1_1);
+        .setApiVersion(VK_API_VERSION_1_2);
 
     // Instance
     
@@ -380,19 +468,41 @@ void initDevice()
     Log(RYME_ANCHOR, "Available Physical Devices:");
 
     for (const auto& physicalDevice : Instance.enumeratePhysicalDevices()) {
-        _physicalDeviceProperties = physicalDevice.getProperties();
-        _physicalDeviceFeatures = physicalDevice.getFeatures();
+        auto properties = physicalDevice.getProperties();
+        auto features = physicalDevice.getFeatures();
 
-        Log(RYME_ANCHOR, "\t{}", _physicalDeviceProperties.deviceName.data());
+        Log(RYME_ANCHOR, "\t{}", properties.deviceName.data());
         
+        bool hasTimelineSemaphore = false;
+
+        // Timeline Semaphores are core in Vulkan 1.2
+        if (properties.apiVersion >= VK_API_VERSION_1_2) {
+            auto featuresChain = physicalDevice.getFeatures2<
+                vk::PhysicalDeviceFeatures2,
+                vk::PhysicalDeviceVulkan12Features
+            >();
+
+            hasTimelineSemaphore = featuresChain.get<vk::PhysicalDeviceVulkan12Features>().timelineSemaphore;
+        }
+
         bool isSuitable = (
-            _physicalDeviceProperties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu and
-            _physicalDeviceFeatures.geometryShader
+            features.geometryShader and
+            hasTimelineSemaphore
         );
 
-        if (isSuitable) {
+        if (not isSuitable) {
+            continue;
+        }
+
+        // Discrete GPUs are preferred, but integrated GPUs and software implementations such as
+        // lavapipe are used when there is none
+        bool isDiscrete = (properties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu);
+        bool isChosenDiscrete = (_physicalDeviceProperties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu);
+
+        if (not _physicalDevice or (isDiscrete and not isChosenDiscrete)) {
             _physicalDevice = physicalDevice;
-            break;
+            _physicalDeviceProperties = properties;
+            _physicalDeviceFeatures = features;
         }
     }
 
@@ -505,7 +615,25 @@ void initDevice()
 
     // Device
 
+    auto supportedFeatures = _physicalDevice.getFeatures2<
+        vk::PhysicalDeviceFeatures2,
+        vk::PhysicalDeviceVulkan12Features
+    >();
+
+    _drawIndirectCountSupported = supportedFeatures.get<vk::PhysicalDeviceVulkan12Features>().drawIndirectCount;
+
+    // Both are optional, as not every implementation supports them, and their users fall back to
+    // recording one draw at a time
+    auto features = vk::PhysicalDeviceFeatures()
+        .setMultiDrawIndirect(_physicalDeviceFeatures.multiDrawIndirect);
+
+    auto vulkan12Features = vk::PhysicalDeviceVulkan12Features()
+        .setTimelineSemaphore(true)
+        .setDrawIndirectCount(_drawIndirectCountSupported);
+
     auto deviceCreateInfo = vk::DeviceCreateInfo()
+        .setPNext(&vulkan12Features)
+        .setPEnabledFeatures(&features)
         .setQueueCreateInfos(queueCreateInfoList)
         .setPEnabledExtensionNames(requiredDeviceExtensionNameList);
 
@@ -535,7 +663,7 @@ void initAllocator()
         .physicalDevice = _physicalDevice,
         .device = Device,
         .instance = Instance,
-        .vulkanApiVersion = VK_API_VERSION_1_1,
+        .vulkanApiVersion = VK_API_VERSION_1_2,
     };
 
     auto vkResult = (vk::Result)vmaCreateAllocator(&allocatorCreateInfo, &Allocator);
@@ -566,7 +694,47 @@ void initAllocator()
     }
 }
 
-void initDepthBuffer()
+void initTimeline()
+{
+    auto semaphoreTypeCreateInfo = vk::SemaphoreTypeCreateInfo()
+        .setSemaphoreType(vk::SemaphoreType::eTimeline)
+        .setInitialValue(0);
+
+    auto semaphoreCreateInfo = vk::SemaphoreCreateInfo()
+        .setPNext(&semaphoreTypeCreateInfo);
+
+    _graphicsTimelineSemaphore = Device.createSemaphore(semaphoreCreateInfo);
+
+    _graphicsTimelineValue = 0;
+    _graphicsCompletedValue = 0;
+}
+
+void processDeferredDestroyQueue()
+{
+    List<std::function<void()>> destroyFuncList;
+
+    {
+        std::lock_guard<std::mutex> lock(_deferredDestroyMutex);
+
+        while (not _deferredDestroyQueue.empty()) {
+            auto& deferredDestroy = _deferredDestroyQueue.front();
+
+            if (not IsTimelineValueComplete(deferredDestroy.TimelineValue)) {
+                break;
+            }
+
+            destroyFuncList.push_back(std::move(deferredDestroy.DestroyFunc));
+            _deferredDestroyQueue.pop_front();
+        }
+    }
+
+    // Called without the lock, as destroying an object can release others that defer their own destruction
+    for (auto& destroyFunc : destroyFuncList) {
+        destroyFunc();
+    }
+}
+
+void initDepthImageFormat()
 {
     List<vk::Format> potentialFormatList = {
         vk::Format::eD32Sfloat,
@@ -594,108 +762,62 @@ void initDepthBuffer()
     Log(RYME_ANCHOR, "Vulkan Depth Buffer Image Format: {}",
         vk::to_string(_depthImageFormat)
     );
-    
-    vmaFreeMemory(Allocator, _depthImageAllocation);
-
-    Device.destroyImage(_depthImage);
-
-    auto imageCreateInfo = vk::ImageCreateInfo()
-        .setImageType(vk::ImageType::e2D)
-        .setFormat(_depthImageFormat)
-        .setExtent(vk::Extent3D(_swapchainExtent, 1))
-        .setMipLevels(1)
-        .setArrayLayers(1)
-        .setTiling(vk::ImageTiling::eOptimal)
-        .setUsage(vk::ImageUsageFlagBits::eDepthStencilAttachment);
+}
 
-    auto allocationCreateInfo = VmaAllocationCreateInfo{
-        .usage = VMA_MEMORY_USAGE_GPU_ONLY,
-    };
-    
-    std::tie(_depthImage, _depthImageAllocation) = CreateImage(
-        imageCreateInfo,
-        allocationCreateInfo
-    );
+Vec4 getClearColor()
+{
+    Vec4 clearColor = _clearColor;
 
-    Device.destroyImageView(_depthImageView);
+    // If our surface is sRGB, Vulkan will try to convert our color to sRGB
+    // This fails and washes out the color, so we convert to linear to account for it        
+    if (_swapchainColorSpace == vk::ColorSpaceKHR::eSrgbNonlinear) {
+        clearColor = Color::ToLinear(clearColor);
+    }
 
-    auto imageViewCreateInfo = vk::ImageViewCreateInfo()
-        .setImage(_depthImage)
-        .setViewType(vk::ImageViewType::e2D)
-        .setFormat(_depthImageFormat)
-        .setSubresourceRange({ vk::ImageAspectFlagBits::eDepth, 0, 1, 0, 1 });
+    return clearColor;
+}
 
-    _depthImageView = Device.createImageView(imageViewCreateInfo);
+void defaultRenderGraphFunc(RenderGraph& renderGraph)
+{
+    auto depthImage = renderGraph.CreateImage("Depth", {
+        .Format = _depthImageFormat,
+    });
+
+    auto& mainPass = renderGraph.AddPass("Main");
+    mainPass.AddColorAttachment(RenderGraph::Backbuffer, getClearColor());
+    mainPass.SetDepthAttachment(depthImage, 1.0f);
+    mainPass.SetExecuteFunc(
+        [](vk::CommandBuffer commandBuffer) {
+            if (_renderFunc) {
+                _renderFunc(commandBuffer);
+            }
+        }
+    );
 }
 
-void initRenderPass()
+void initRenderGraph()
 {
-    auto colorAttachmentDescription = vk::AttachmentDescription()
-        .setFormat(_swapchainImageFormat)
-        .setSamples(vk::SampleCountFlagBits::e1)
-        .setLoadOp(vk::AttachmentLoadOp::eClear)
-        .setStoreOp(vk::AttachmentStoreOp::eStore)
-        .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
-        .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
-        .setInitialLayout(vk::ImageLayout::eUndefined)
-        .setFinalLayout(vk::ImageLayout::ePresentSrcKHR);
-
-    auto colorAttachmentReference = vk::AttachmentReference()
-        .setAttachment(0)
-        .setLayout(vk::ImageLayout::eColorAttachmentOptimal);
-
-    auto depthAttachmentDescription = vk::AttachmentDescription()
-        .setFormat(_depthImageFormat)
-        .setSamples(vk::SampleCountFlagBits::e1)
-        .setLoadOp(vk::AttachmentLoadOp::eClear)
-        .setStoreOp(vk::AttachmentStoreOp::eDontCare)
-        .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
-        .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
-        .setInitialLayout(vk::ImageLayout::eUndefined)
-        .setFinalLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
-
-    auto depthAttachmentReference = vk::AttachmentReference()
-        .setAttachment(1)
-        .setLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
-
-    auto subpassDescription = vk::SubpassDescription()
-        .setPipelineBindPoint(vk::PipelineBindPoint::eGraphics)
-        .setColorAttachmentCount(1)
-        .setPColorAttachments(&colorAttachmentReference)
-        .setPDepthStencilAttachment(&depthAttachmentReference);
-
-    auto subpassDependency = vk::SubpassDependency()
-        .setSrcSubpass(VK_SUBPASS_EXTERNAL)
-        .setDstSubpass(0)
-        .setSrcStageMask(
-            vk::PipelineStageFlagBits::eColorAttachmentOutput |
-            vk::PipelineStageFlagBits::eEarlyFragmentTests
-        )
-        .setDstStageMask(
-            vk::PipelineStageFlagBits::eColorAttachmentOutput |
-            vk::PipelineStageFlagBits::eEarlyFragmentTests
-        )
-        .setSrcAccessMask({})
-        .setDstAccessMask(
-            vk::AccessFlagBits::eColorAttachmentWrite |
-            vk::AccessFlagBits::eDepthStencilAttachmentWrite
-        );
+    _renderGraph.Reset();
 
-    Array<vk::AttachmentDescription, 2> attachmentList = {
-        colorAttachmentDescription,
-        depthAttachmentDescription,
-    };
+    _renderGraph.SetBackbuffer(
+        _swapchainImageFormat,
+        _swapchainExtent,
+        _swapchainImageList,
+        _swapchainImageViewList
+    );
 
-    Device.destroyRenderPass(RenderPass);
+    if (_renderGraphFunc) {
+        _renderGraphFunc(_renderGraph);
+    }
+    else {
+        defaultRenderGraphFunc(_renderGraph);
+    }
 
-    auto renderPassCreateInfo = vk::RenderPassCreateInfo()
-        .setAttachments(attachmentList)
-        .setSubpassCount(1)
-        .setPSubpasses(&subpassDescription)
-        .setDependencyCount(1)
-        .setPDependencies(&subpassDependency);
+    _renderGraph.Compile();
 
-    RenderPass = Device.createRenderPass(renderPassCreateInfo);
+    // Pipelines are created against the "Main" pass unless told otherwise
+    auto mainPass = _renderGraph.FindPass("Main");
+    RenderPass = (mainPass ? mainPass->GetVkRenderPass() : nullptr);
 }
 
 void initUniformBuffers()
@@ -710,34 +832,6 @@ void initUniformBuffers()
 
 }
 
-void initFramebufferList()
-{
-    for (auto& framebuffer : _framebufferList) {
-        Device.destroyFramebuffer(framebuffer);
-        framebuffer = nullptr;
-    }
-
-    size_t backbufferCount = _swapchainImageViewList.size();
-
-    _framebufferList.resize(_swapchainImageViewList.size());
-
-    for (unsigned i = 0; i < backbufferCount; ++i) {
-        Array<vk::ImageView, 2> attachmentList = {
-            _swapchainImageViewList[i],
-            _depthImageView,
-        };
-
-        auto framebufferCreateInfo = vk::FramebufferCreateInfo()
-            .setRenderPass(RenderPass)
-            .setAttachments(attachmentList)
-            .setWidth(_swapchainExtent.width)
-            .setHeight(_swapchainExtent.height)
-            .setLayers(1);
-
-        _framebufferList[i] = Device.createFramebuffer(framebufferCreateInfo);
-    }
-}
-
 void initCommandBufferList()
 {
     if (not _commandBufferList.empty()) {
@@ -746,8 +840,9 @@ void initCommandBufferList()
 
     Device.destroyCommandPool(_commandPool);
 
+    // Command buffers are recorded again individually after InvalidateCommandBuffers()
     _commandPool = Device.createCommandPool(
-        vk::CommandPoolCreateInfo({}, _graphicsQueueFamilyIndex)
+        vk::CommandPoolCreateInfo(vk::CommandPoolCreateFlagBits::eResetCommandBuffer, _graphicsQueueFamilyIndex)
     );
 
     _commandBufferList = Device.allocateCommandBuffers(
@@ -757,15 +852,19 @@ void initCommandBufferList()
             _swapchainImageList.size()
         )
     );
+
+    _commandBufferOutOfDateList.assign(_commandBufferList.size(), false);
 }
 
-void initSyncObjects()
+void initTransientCommandPool()
 {
-    for (auto fence : _inFlightFenceList) {
-        Device.destroyFence(fence);
-        fence = nullptr;
-    }
+    _transientCommandPool = Device.createCommandPool(
+        vk::CommandPoolCreateInfo(vk::CommandPoolCreateFlagBits::eTransient, _graphicsQueueFamilyIndex)
+    );
+}
 
+void termSyncObjects()
+{
     for (auto& semaphore : _imageAvailableSemaphoreList) {
         Device.destroySemaphore(semaphore);
         semaphore = nullptr;
@@ -776,66 +875,58 @@ void initSyncObjects()
         semaphore = nullptr;
     }
 
+    _frameTimelineValueList.clear();
+    _imageTimelineValueList.clear();
+}
+
+void initSyncObjects()
+{
+    termSyncObjects();
+
     size_t backbufferCount = _swapchainImageViewList.size();
 
-    _imageAvailableSemaphoreList.resize(backbufferCount);
+    Log(RYME_ANCHOR, "Vulkan Frames In Flight: {}", _framesInFlight);
+
+    // The acquire and present operations only support binary semaphores
+    _imageAvailableSemaphoreList.resize(_framesInFlight);
     _renderingFinishedSemaphoreList.resize(backbufferCount);
-    _inFlightFenceList.resize(backbufferCount);
+
+    // Everything up to the current value has been waited on during swapchain recreation
+    _frameTimelineValueList.assign(_framesInFlight, _graphicsTimelineValue);
+    _imageTimelineValueList.assign(backbufferCount, _graphicsTimelineValue);
 
     auto semaphoreCreateInfo = vk::SemaphoreCreateInfo();
 
-    auto fenceCreateInfo = vk::FenceCreateInfo()
-        .setFlags(vk::FenceCreateFlagBits::eSignaled);
+    for (unsigned i = 0; i < _framesInFlight; ++i) {
+        _imageAvailableSemaphoreList[i] = Device.createSemaphore(semaphoreCreateInfo);
+    }
 
     for (unsigned i = 0; i < backbufferCount; ++i) {
-        _imageAvailableSemaphoreList[i] = Device.createSemaphore(semaphoreCreateInfo);
         _renderingFinishedSemaphoreList[i] = Device.createSemaphore(semaphoreCreateInfo);
-        _inFlightFenceList[i] = Device.createFence(fenceCreateInfo);
     }
+
+    _currentFrame = 0;
 }
 
-void fillCommandBuffers()
+void fillCommandBuffer(uint32_t imageIndex)
 {
-    for (size_t i = 0; i < _commandBufferList.size(); ++i) {
-        auto& commandBuffer = _commandBufferList[i];
+    auto& commandBuffer = _commandBufferList[imageIndex];
 
-        auto commandBufferBeginInfo = vk::CommandBufferBeginInfo();
-        commandBuffer.begin(commandBufferBeginInfo);
+    // Implicitly resets the command buffer if it was recorded before
+    auto commandBufferBeginInfo = vk::CommandBufferBeginInfo();
+    commandBuffer.begin(commandBufferBeginInfo);
 
-        Vec4 clearColor = _clearColor;
+    _renderGraph.Execute(commandBuffer, imageIndex);
 
-        // If our surface is sRGB, Vulkan will try to convert our color to sRGB
-        // This fails and washes out the color, so we convert to linear to account for it        
-        if (_swapchainColorSpace == vk::ColorSpaceKHR::eSrgbNonlinear) {
-            clearColor = Color::ToLinear(clearColor);
-        }
-
-        auto clearValueArray = Color::ToArray(clearColor);
-
-        Array<vk::ClearValue, 2> clearValueList = {
-            vk::ClearValue(clearValueArray),
-            vk::ClearValue({ 1.0f, 0 }),
-        };
-
-        auto renderArea = vk::Rect2D()
-            .setOffset({ 0, 0 })
-            .setExtent(_swapchainExtent);
-
-        auto renderPassBeginInfo = vk::RenderPassBeginInfo()
-            .setRenderPass(RenderPass)
-            .setFramebuffer(_framebufferList[i])
-            .setRenderArea(renderArea)
-            .setClearValues(clearValueList);
-
-        commandBuffer.beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
-
-        if (_renderFunc) {
-            _renderFunc(commandBuffer);
-        }
+    commandBuffer.end();
 
-        commandBuffer.endRenderPass();
+    _commandBufferOutOfDateList[imageIndex] = false;
+}
 
-        commandBuffer.end();
+void fillCommandBuffers()
+{
+    for (size_t i = 0; i < _commandBufferList.size(); ++i) {
+        fillCommandBuffer(static_cast<uint32_t>(i));
     }
 }
 
@@ -919,20 +1010,45 @@ void initSwapchain()
         Log(RYME_ANCHOR, "\t{}", vk::to_string(mode));
     }
     
-    // Mailbox is like FIFO, but discards extra images
-    if (ListContains(presentModeList, vk::PresentModeKHR::eMailbox)) {
-        presentMode = vk::PresentModeKHR::eMailbox;
+    if (ListContains(presentModeList, _requestedPresentMode)) {
+        presentMode = _requestedPresentMode;
     }
+    else {
+        Log(RYME_ANCHOR, "Vulkan Present Mode {} is not supported, falling back to {}",
+            vk::to_string(_requestedPresentMode),
+            vk::to_string(presentMode)
+        );
+    }
+
+    _presentMode = presentMode;
 
     Log(RYME_ANCHOR, "Vulkan Swap Chain Present Mode: {}", vk::to_string(presentMode));
 
+    /// Image Count
+
+    uint32_t imageCount = surfaceCapabilities.minImageCount;
+
+    if (_requestedSwapchainImageCount > 0) {
+        // A maxImageCount of 0 means there is no limit
+        uint32_t maxImageCount = surfaceCapabilities.maxImageCount;
+        if (maxImageCount == 0) {
+            maxImageCount = UINT32_MAX;
+        }
+
+        imageCount = std::clamp(
+            static_cast<uint32_t>(_requestedSwapchainImageCount),
+            surfaceCapabilities.minImageCount,
+            maxImageCount
+        );
+    }
+
     /// Swap Chain
 
     auto oldSwapChain = _swapchain;
 
     auto swapChainCreateInfo = vk::SwapchainCreateInfoKHR()
         .setSurface(_surface)
-        .setMinImageCount(surfaceCapabilities.minImageCount)
+        .setMinImageCount(imageCount)
         .setImageFormat(imageFormat.format)
         .setImageColorSpace(imageFormat.colorSpace)
         .setImageExtent(_swapchainExtent)
@@ -963,7 +1079,7 @@ void initSwapchain()
         swapChainCreateInfo.setQueueFamilyIndices(queueFamilyIndexList);
     }
 
-    Log(RYME_ANCHOR, "Vulkan Swap Chain Image Count: {}",
+    Log(RYME_ANCHOR, "Vulkan Swap Chain Minimum Image Count: {}",
         swapChainCreateInfo.minImageCount
     );
 
@@ -987,6 +1103,8 @@ void initSwapchain()
 
     _swapchainImageList = Device.getSwapchainImagesKHR(_swapchain);
 
+    Log(RYME_ANCHOR, "Vulkan Swap Chain Image Count: {}", _swapchainImageList.size());
+
     for (auto& imageView : _swapchainImageViewList) {
         Device.destroyImageView(imageView);
     }
@@ -1006,9 +1124,7 @@ void initSwapchain()
         );
     }
 
-    initDepthBuffer();
-    initRenderPass();
-    initFramebufferList();
+    initRenderGraph();
     initCommandBufferList();
     fillCommandBuffers(); // TODO:
     initSyncObjects();
@@ -1025,6 +1141,10 @@ void Init(const InitInfo& initInfo)
     _windowTitle = initInfo.WindowTitle;
     _clearColor = initInfo.ClearColor;
 
+    _requestedPresentMode = initInfo.PresentMode;
+    _requestedSwapchainImageCount = initInfo.SwapchainImageCount;
+    _framesInFlight = std::max(initInfo.FramesInFlight, 1u);
+
     _currentFrame = 0;
     
     initWindow();
@@ -1032,6 +1152,9 @@ void Init(const InitInfo& initInfo)
     initSurface();
     initDevice();
     initAllocator();
+    initTimeline();
+    initTransientCommandPool();
+    initDepthImageFormat();
 
     initSwapchain();
     initSwapchain(); // Test swap chain recreation
@@ -1047,47 +1170,41 @@ void Term()
 
     Device.waitIdle();
 
-    // termSyncObjects
+    _renderGraph.Reset();
+    RenderPass = nullptr;
 
-    for (auto fence : _inFlightFenceList) {
-        Device.destroyFence(fence);
-        fence = nullptr;
-    }
+    // termDeferredDestroyQueue
 
-    for (auto semaphore : _renderingFinishedSemaphoreList) {
-        Device.destroySemaphore(semaphore);
-        semaphore = nullptr;
-    }
+    for (;;) {
+        std::unique_lock<std::mutex> lock(_deferredDestroyMutex);
 
-    for (auto semaphore : _imageAvailableSemaphoreList) {
-        Device.destroySemaphore(semaphore);
-        semaphore = nullptr;
-    }
+        if (_deferredDestroyQueue.empty()) {
+            break;
+        }
 
-    // termCommandBufferList
+        auto destroyFunc = std::move(_deferredDestroyQueue.front().DestroyFunc);
+        _deferredDestroyQueue.pop_front();
 
-    Device.freeCommandBuffers(_commandPool, _commandBufferList);
+        lock.unlock();
 
-    Device.destroyCommandPool(_commandPool);
+        destroyFunc();
+    }
 
-    // termFramebufferList
+    // termTransientCommandPool
 
-    for (auto framebuffer : _framebufferList) {
-        Device.destroyFramebuffer(framebuffer);
-        framebuffer = nullptr;
-    }
+    Device.destroyCommandPool(_transientCommandPool);
 
-    // termRenderPass
+    termSyncObjects();
 
-    Device.destroyRenderPass(RenderPass);
+    // termTimeline
 
-    // termDepthBuffer
+    Device.destroySemaphore(_graphicsTimelineSemaphore);
 
-    Device.destroyImageView(_depthImageView);
-    
-    Device.destroyImage(_depthImage);
+    // termCommandBufferList
 
-    vmaFreeMemory(Allocator, _depthImageAllocation);
+    Device.freeCommandBuffers(_commandPool, _commandBufferList);
+
+    Device.destroyCommandPool(_commandPool);
 
     // termSwapchain
 
@@ -1127,27 +1244,76 @@ void Term()
     RYME_BENCHMARK_END();
 }
 
+void updateFrameStats(uint64_t frameWait, uint64_t inputTimestamp)
+{
+    uint64_t now = Profiler::GetTimestamp();
+
+    ++_frameStats.FrameCount;
+
+    ++_statsPeriodFrameCount;
+    _statsPeriodFrameWait += frameWait;
+
+    if (inputTimestamp > 0 and now > inputTimestamp) {
+        uint64_t inputLatency = now - inputTimestamp;
+
+        ++_statsPeriodInputCount;
+        _statsPeriodInputLatency += inputLatency;
+        _statsPeriodMaxInputLatency = std::max(_statsPeriodMaxInputLatency, inputLatency);
+    }
+
+    if (_statsPeriodStart == 0) {
+        _statsPeriodStart = now;
+        return;
+    }
+
+    constexpr uint64_t StatsPeriod = 1'000'000'000; // 1s
+
+    uint64_t elapsed = now - _statsPeriodStart;
+    if (elapsed < StatsPeriod) {
+        return;
+    }
+
+    double frameCount = static_cast<double>(_statsPeriodFrameCount);
+
+    _frameStats.FramesPerSecond = frameCount / (elapsed / 1.0e9);
+    _frameStats.FrameMilliseconds = (elapsed / 1.0e6) / frameCount;
+    _frameStats.FrameWaitMilliseconds = (_statsPeriodFrameWait / 1.0e6) / frameCount;
+
+    if (_statsPeriodInputCount > 0) {
+        _frameStats.InputLatencyMilliseconds = (_statsPeriodInputLatency / 1.0e6) / _statsPeriodInputCount;
+        _frameStats.MaxInputLatencyMilliseconds = _statsPeriodMaxInputLatency / 1.0e6;
+    }
+
+    _statsPeriodStart = now;
+    _statsPeriodFrameCount = 0;
+    _statsPeriodFrameWait = 0;
+    _statsPeriodInputCount = 0;
+    _statsPeriodInputLatency = 0;
+    _statsPeriodMaxInputLatency = 0;
+}
+
 RYME_API
 void Render()
 {
-    static bool updateSwapchain = false;
+    RYME_PROFILE_FUNCTION();
 
-    if (updateSwapchain) {
+    if (_swapchainOutOfDate) {
         Log(RYME_ANCHOR, "Regenerating Swapchain");
         initSwapchain();
-        updateSwapchain = false;
+        _swapchainOutOfDate = false;
     }
 
     constexpr uint64_t MaxTimeout = std::numeric_limits<uint64_t>::max();
 
     vk::Result vkResult;
 
-    vmaSetCurrentFrameIndex(Allocator, _currentFrame);
+    vmaSetCurrentFrameIndex(Allocator, static_cast<uint32_t>(_frameStats.FrameCount));
 
-    vkResult = Device.waitForFences(1, &_inFlightFenceList[_currentFrame], true, MaxTimeout);
-    vk::resultCheck(vkResult, "vk::Device::waitForFences");
+    uint64_t frameWaitStart = Profiler::GetTimestamp();
 
-    vkResult = Device.resetFences(1, &_inFlightFenceList[_currentFrame]);
+    WaitForTimelineValue(_frameTimelineValueList[_currentFrame]);
+
+    processDeferredDestroyQueue();
 
     uint32_t imageIndex;
 
@@ -1162,19 +1328,51 @@ void Render()
     );
 
     if (vkResult == vk::Result::eErrorOutOfDateKHR) {
-        updateSwapchain = true;
+        _swapchainOutOfDate = true;
         return;
     }
 
     vk::resultCheck(vkResult, "vk::Device::acquireNextImageKHR",
         { vk::Result::eSuccess, vk::Result::eSuboptimalKHR });
 
+    // With more swapchain images than frames in flight, the image can still be in use by an older frame
+    WaitForTimelineValue(_imageTimelineValueList[imageIndex]);
+
+    if (_commandBuffersInvalidated.exchange(false)) {
+        std::fill(_commandBufferOutOfDateList.begin(), _commandBufferOutOfDateList.end(), true);
+    }
+
+    // The last frame to use the command buffer has finished, so it can be recorded again
+    if (_commandBufferOutOfDateList[imageIndex]) {
+        fillCommandBuffer(imageIndex);
+    }
+
+    uint64_t frameWait = Profiler::GetTimestamp() - frameWaitStart;
+
+    uint64_t signalValue = ++_graphicsTimelineValue;
+    _frameTimelineValueList[_currentFrame] = signalValue;
+    _imageTimelineValueList[imageIndex] = signalValue;
+
+    // Any input received before this point will be visible in this frame
+    uint64_t inputTimestamp = _pendingInputTimestamp;
+    _pendingInputTimestamp = 0;
+
     Array<vk::Semaphore, 1> waitSemaphoreList = {
         _imageAvailableSemaphoreList[_currentFrame],
     };
 
-    Array<vk::Semaphore, 1> signalSemaphoreList = {
-        _renderingFinishedSemaphoreList[_currentFrame],
+    Array<uint64_t, 1> waitValueList = {
+        0, // Ignored for binary semaphores
+    };
+
+    Array<vk::Semaphore, 2> signalSemaphoreList = {
+        _renderingFinishedSemaphoreList[imageIndex],
+        _graphicsTimelineSemaphore,
+    };
+
+    Array<uint64_t, 2> signalValueList = {
+        0, // Ignored for binary semaphores
+        signalValue,
     };
 
     Array<vk::PipelineStageFlags, 1> waitStageList = {
@@ -1185,13 +1383,24 @@ void Render()
         _commandBufferList[imageIndex],
     };
 
+    auto timelineSubmitInfo = vk::TimelineSemaphoreSubmitInfo()
+        .setWaitSemaphoreValues(waitValueList)
+        .setSignalSemaphoreValues(signalValueList);
+
     auto submitInfo = vk::SubmitInfo()
+        .setPNext(&timelineSubmitInfo)
         .setWaitSemaphores(waitSemaphoreList)
         .setWaitDstStageMask(waitStageList)
         .setCommandBuffers(commandBufferList)
         .setSignalSemaphores(signalSemaphoreList);
 
-    _graphicsQueue.submit(submitInfo, _inFlightFenceList[_currentFrame]);
+    _graphicsQueue.submit(submitInfo, nullptr);
+
+    Array<vk::Semaphore, 1> presentWaitSemaphoreList = {
+        _renderingFinishedSemaphoreList[imageIndex],
+    };
+
+    _currentFrame = (_currentFrame + 1) % _framesInFlight;
 
     Array<vk::SwapchainKHR, 1> swapchainList = {
         _swapchain,
@@ -1203,31 +1412,51 @@ void Render()
 
     auto presentInfo = vk::PresentInfoKHR()
         .setSwapchains(swapchainList)
-        .setWaitSemaphores(signalSemaphoreList)
+        .setWaitSemaphores(presentWaitSemaphoreList)
         .setImageIndices(imageIndexList);
 
     // We explicitly invoke the nothrow version of this function, since the enhanced version throws vk::OutOfDateKHRError
     // https://github.com/KhronosGroup/Vulkan-Hpp/issues/599
-    // https://github.com/KhronosGroup/Vulkan-Hpp/issues/599
     vkResult = _presentQueue.presentKHR(&presentInfo);
     if (vkResult == vk::Result::eErrorOutOfDateKHR) {
-        updateSwapchain = true;
+        _swapchainOutOfDate = true;
         return;
     }
 
     vk::resultCheck(vkResult, "vk::Queue::presentKHR",
         { vk::Result::eSuccess, vk::Result::eSuboptimalKHR });
 
-    _currentFrame = (_currentFrame + 1) % _inFlightFenceList.size();
+    updateFrameStats(frameWait, inputTimestamp);
 }
 
 RYME_API
 void HandleEvent(SDL_Event& event)
 {
-    if (event.type == SDL_WINDOWEVENT) {
-        if (event.window.type == SDL_WINDOWEVENT_RESIZED) {
+    switch (event.type) {
+    case SDL_WINDOWEVENT:
+        if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
             _windowSize = { event.window.data1, event.window.data2 };
         }
+        break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+    case SDL_TEXTINPUT:
+    case SDL_MOUSEMOTION:
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+    case SDL_MOUSEWHEEL:
+    case SDL_CONTROLLERAXISMOTION:
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+    case SDL_FINGERDOWN:
+    case SDL_FINGERUP:
+    case SDL_FINGERMOTION:
+        if (_pendingInputTimestamp == 0) {
+            // SDL timestamps events in milliseconds when they are queued, account for the time spent in the queue
+            uint64_t queuedMilliseconds = SDL_GetTicks() - event.common.timestamp;
+            _pendingInputTimestamp = Profiler::GetTimestamp() - (queuedMilliseconds * 1'000'000);
+        }
+        break;
     }
 }
 
@@ -1261,11 +1490,91 @@ Vec2i GetWindowSize()
     return _windowSize;
 }
 
+RYME_API
+void SetPresentMode(vk::PresentModeKHR presentMode)
+{
+    _requestedPresentMode = presentMode;
+    _swapchainOutOfDate = true;
+}
+
+RYME_API
+vk::PresentModeKHR GetPresentMode()
+{
+    return _presentMode;
+}
+
+RYME_API
+void SetSwapchainImageCount(unsigned swapchainImageCount)
+{
+    _requestedSwapchainImageCount = swapchainImageCount;
+    _swapchainOutOfDate = true;
+}
+
+RYME_API
+unsigned GetSwapchainImageCount()
+{
+    return _swapchainImageList.size();
+}
+
+RYME_API
+void SetFramesInFlight(unsigned framesInFlight)
+{
+    _framesInFlight = std::max(framesInFlight, 1u);
+    _swapchainOutOfDate = true;
+}
+
+RYME_API
+unsigned GetFramesInFlight()
+{
+    return _framesInFlight;
+}
+
+RYME_API
+FrameStats GetFrameStats()
+{
+    return _frameStats;
+}
+
+RYME_API
+void SetRenderGraphFunc(std::function<void(RenderGraph&)> func)
+{
+    _renderGraphFunc = func;
+    _swapchainOutOfDate = true;
+}
+
+RYME_API
+vk::Format GetDepthImageFormat()
+{
+    return _depthImageFormat;
+}
+
+RYME_API
+StringView GetMemoryCategoryName(MemoryCategory category)
+{
+    switch (category) {
+    case MemoryCategory::Other:
+        return "Other";
+    case MemoryCategory::Mesh:
+        return "Mesh";
+    case MemoryCategory::Texture:
+        return "Texture";
+    case MemoryCategory::Uniform:
+        return "Uniform";
+    case MemoryCategory::Staging:
+        return "Staging";
+    case MemoryCategory::RenderTarget:
+        return "RenderTarget";
+    }
+
+    return "Unknown";
+}
+
 RYME_API
 Tuple<vk::Buffer, VmaAllocation> CreateBuffer(
     vk::BufferCreateInfo& bufferCreateInfo,
     VmaAllocationCreateInfo& allocationCreateInfo,
-    VmaAllocationInfo * allocationInfo /*= nullptr*/
+    VmaAllocationInfo * allocationInfo /*= nullptr*/,
+    MemoryCategory category /*= MemoryCategory::Other*/
 )
 {
     vk::Buffer buffer;
@@ -1282,6 +1591,8 @@ Tuple<vk::Buffer, VmaAllocation> CreateBuffer(
 
     vk::resultCheck(vkResult, "vmaCreateBuffer");
 
+    TrackAllocation(allocation, category);
+
     return { buffer, allocation };
 }
 
@@ -1289,7 +1600,8 @@ RYME_API
 Tuple<vk::Image, VmaAllocation> CreateImage(
     vk::ImageCreateInfo& imageCreateInfo,
     VmaAllocationCreateInfo& allocationCreateInfo,
-    VmaAllocationInfo * allocationInfo /*= nullptr*/
+    VmaAllocationInfo * allocationInfo /*= nullptr*/,
+    MemoryCategory category /*= MemoryCategory::Other*/
 )
 {
     vk::Image image;
@@ -1306,9 +1618,219 @@ Tuple<vk::Image, VmaAllocation> CreateImage(
 
     vk::resultCheck(vkResult, "vmaCreateImage");
 
+    TrackAllocation(allocation, category);
+
     return { image, allocation };
 }
 
+RYME_API
+void TrackAllocation(VmaAllocation allocation, MemoryCategory category)
+{
+    size_t index = static_cast<size_t>(category);
+
+    VmaAllocationInfo allocationInfo;
+    vmaGetAllocationInfo(Allocator, allocation, &allocationInfo);
+
+    vmaSetAllocationUserData(Allocator, allocation, reinterpret_cast<void *>(uintptr_t(index + 1)));
+
+    ++_categoryAllocationCountList[index];
+    _categoryBytesList[index] += allocationInfo.size;
+}
+
+RYME_API
+void FreeMemory(VmaAllocation allocation)
+{
+    if (not allocation) {
+        return;
+    }
+
+    VmaAllocationInfo allocationInfo;
+    vmaGetAllocationInfo(Allocator, allocation, &allocationInfo);
+
+    // Allocations made directly with VMA and never tracked have no user data
+    uintptr_t tag = reinterpret_cast<uintptr_t>(allocationInfo.pUserData);
+    if (tag > 0) {
+        size_t index = tag - 1;
+
+        --_categoryAllocationCountList[index];
+        _categoryBytesList[index] -= allocationInfo.size;
+    }
+
+    if (Defragmenter::ReleaseAllocation(allocation)) {
+        return;
+    }
+
+    vmaFreeMemory(Allocator, allocation);
+}
+
+RYME_API
+MemoryStats GetMemoryStats()
+{
+    const VkPhysicalDeviceMemoryProperties * memoryProperties;
+    vmaGetMemoryProperties(Allocator, &memoryProperties);
+
+    VmaBudget budgetList[VK_MAX_MEMORY_HEAPS];
+    vmaGetHeapBudgets(Allocator, budgetList);
+
+    VmaTotalStatistics totalStatistics;
+    vmaCalculateStatistics(Allocator, &totalStatistics);
+
+    MemoryStats stats;
+
+    for (uint32_t heap = 0; heap < memoryProperties->memoryHeapCount; ++heap) {
+        const auto& memoryHeap = memoryProperties->memoryHeaps[heap];
+        const auto& detailedStatistics = totalStatistics.memoryHeap[heap];
+        const auto& statistics = detailedStatistics.statistics;
+
+        vk::DeviceSize unusedBytes = statistics.blockBytes - statistics.allocationBytes;
+
+        // With no allocations, unusedRangeSizeMax is left at its initial value of 0
+        float fragmentation = 0.0f;
+        if (unusedBytes > 0 and detailedStatistics.unusedRangeCount > 0) {
+            fragmentation = 1.0f - float(detailedStatistics.unusedRangeSizeMax) / float(unusedBytes);
+        }
+
+        stats.HeapList.push_back(MemoryHeapStats{
+            .Size = memoryHeap.size,
+            .IsDeviceLocal = ((memoryHeap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0),
+            .Usage = budgetList[heap].usage,
+            .Budget = budgetList[heap].budget,
+            .BlockCount = statistics.blockCount,
+            .AllocationCount = statistics.allocationCount,
+            .BlockBytes = statistics.blockBytes,
+            .AllocationBytes = statistics.allocationBytes,
+            .UnusedRangeCount = detailedStatistics.unusedRangeCount,
+            .LargestUnusedRange = detailedStatistics.unusedRangeSizeMax,
+            .Fragmentation = fragmentation,
+        });
+    }
+
+    for (size_t index = 0; index < MemoryCategoryCount; ++index) {
+        stats.CategoryList.push_back(MemoryCategoryStats{
+            .Category = static_cast<MemoryCategory>(index),
+            .AllocationCount = _categoryAllocationCountList[index],
+            .Bytes = _categoryBytesList[index],
+        });
+    }
+
+    return stats;
+}
+
+RYME_API
+String GetMemoryStatsJSON(bool detailed /*= false*/)
+{
+    char * statsString = nullptr;
+    vmaBuildStatsString(Allocator, &statsString, detailed);
+
+    String json = statsString;
+
+    vmaFreeStatsString(Allocator, statsString);
+
+    return json;
+}
+
+RYME_API
+void LogMemoryStats()
+{
+    auto stats = GetMemoryStats();
+
+    for (size_t heap = 0; heap < stats.HeapList.size(); ++heap) {
+        const auto& heapStats = stats.HeapList[heap];
+
+        Log(RYME_ANCHOR, "Vulkan Memory Heap #{}: {} / {}, {} allocations in {} blocks, {:.0f}% fragmented",
+            heap,
+            FormatBytesHumanReadable(heapStats.Usage),
+            FormatBytesHumanReadable(heapStats.Budget),
+            heapStats.AllocationCount,
+            heapStats.BlockCount,
+            heapStats.Fragmentation * 100.0f
+        );
+    }
+
+    for (const auto& categoryStats : stats.CategoryList) {
+        if (categoryStats.AllocationCount == 0) {
+            continue;
+        }
+
+        Log(RYME_ANCHOR, "Vulkan Memory {}: {} in {} allocations",
+            GetMemoryCategoryName(categoryStats.Category),
+            FormatBytesHumanReadable(categoryStats.Bytes),
+            categoryStats.AllocationCount
+        );
+    }
+}
+
+RYME_API
+uint64_t Submit(vk::CommandBuffer commandBuffer)
+{
+    uint64_t signalValue = ++_graphicsTimelineValue;
+
+    auto timelineSubmitInfo = vk::TimelineSemaphoreSubmitInfo()
+        .setSignalSemaphoreValues(signalValue);
+
+    auto submitInfo = vk::SubmitInfo()
+        .setPNext(&timelineSubmitInfo)
+        .setCommandBuffers(commandBuffer)
+        .setSignalSemaphores(_graphicsTimelineSemaphore);
+
+    _graphicsQueue.submit(submitInfo, nullptr);
+
+    return signalValue;
+}
+
+RYME_API
+uint64_t GetSubmittedTimelineValue()
+{
+    return _graphicsTimelineValue;
+}
+
+RYME_API
+uint64_t GetCompletedTimelineValue()
+{
+    _graphicsCompletedValue = Device.getSemaphoreCounterValue(_graphicsTimelineSemaphore);
+    return _graphicsCompletedValue;
+}
+
+RYME_API
+bool IsTimelineValueComplete(uint64_t value)
+{
+    if (value <= _graphicsCompletedValue) {
+        return true;
+    }
+
+    return (value <= GetCompletedTimelineValue());
+}
+
+RYME_API
+void WaitForTimelineValue(uint64_t value)
+{
+    if (value <= _graphicsCompletedValue) {
+        return;
+    }
+
+    auto semaphoreWaitInfo = vk::SemaphoreWaitInfo()
+        .setSemaphores(_graphicsTimelineSemaphore)
+        .setValues(value);
+
+    auto vkResult = Device.waitSemaphores(semaphoreWaitInfo, std::numeric_limits<uint64_t>::max());
+    vk::resultCheck(vkResult, "vk::Device::waitSemaphores");
+
+    _graphicsCompletedValue = value;
+}
+
+RYME_API
+void DeferDestroy(std::function<void()> destroyFunc)
+{
+    std::lock_guard<std::mutex> lock(_deferredDestroyMutex);
+
+    // One past the most recent submission, as a frame that was recorded before the command buffers
+    // were invalidated can still be on its way to being submitted, when called from another thread
+    _deferredDestroyQueue.push_back(DeferredDestroy{
+        .TimelineValue = _graphicsTimelineValue + 1,
+        .DestroyFunc = std::move(destroyFunc),
+    });
+}
+
 RYME_API
 void CopyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::BufferCopy region)
 {
@@ -1329,12 +1851,7 @@ void CopyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::BufferCopy regio
 
     commandBuffer.end();
 
-    auto submitInfo = vk::SubmitInfo()
-        .setCommandBuffers(commandBufferList);
-
-    _graphicsQueue.submit({ submitInfo }, nullptr);
-
-    _graphicsQueue.waitIdle();
+    WaitForTimelineValue(Submit(commandBuffer));
 
     Device.freeCommandBuffers(_commandPool, commandBufferList);
 }
@@ -1391,19 +1908,241 @@ void CopyBufferToImage(vk::Buffer src, vk::Image dst, vk::BufferImageCopy region
 
     commandBuffer.end();
 
-    auto submitInfo = vk::SubmitInfo()
-        .setCommandBuffers(commandBufferList);
+    WaitForTimelineValue(Submit(commandBuffer));
 
-    _graphicsQueue.submit({ submitInfo }, nullptr);
+    Device.freeCommandBuffers(_commandPool, commandBufferList);
+}
 
-    _graphicsQueue.waitIdle();
+void recordTextureUpload(
+    vk::CommandBuffer commandBuffer,
+    vk::Buffer src,
+    vk::Image dst,
+    const List<vk::BufferImageCopy>& regionList,
+    uint32_t mipLevels
+)
+{
+    auto barrier = vk::ImageMemoryBarrier()
+        .setOldLayout(vk::ImageLayout::eUndefined)
+        .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setImage(dst)
+        .setSubresourceRange({ vk::ImageAspectFlagBits::eColor, 0, mipLevels, 0, 1 })
+        .setSrcAccessMask({})
+        .setDstAccessMask(vk::AccessFlagBits::eTransferWrite);
 
-    Device.freeCommandBuffers(_commandPool, commandBufferList);
+    commandBuffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTopOfPipe,
+        vk::PipelineStageFlagBits::eTransfer,
+        {},
+        nullptr,
+        nullptr,
+        barrier
+    );
+
+    commandBuffer.copyBufferToImage(
+        src,
+        dst,
+        vk::ImageLayout::eTransferDstOptimal,
+        regionList
+    );
+
+    uint32_t copiedLevels = regionList.size();
+
+    auto extent = regionList.back().imageExtent;
+    int32_t width = extent.width;
+    int32_t height = extent.height;
+
+    // Each remaining level is blitted from the one before it, which is then used as a transfer source
+    for (uint32_t level = copiedLevels; level < mipLevels; ++level) {
+        barrier
+            .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setNewLayout(vk::ImageLayout::eTransferSrcOptimal)
+            .setSubresourceRange({ vk::ImageAspectFlagBits::eColor, level - 1, 1, 0, 1 })
+            .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eTransferRead);
+
+        commandBuffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eTransfer,
+            {},
+            nullptr,
+            nullptr,
+            barrier
+        );
+
+        int32_t nextWidth = std::max(width / 2, 1);
+        int32_t nextHeight = std::max(height / 2, 1);
+
+        auto imageBlit = vk::ImageBlit()
+            .setSrcSubresource({ vk::ImageAspectFlagBits::eColor, level - 1, 0, 1 })
+            .setSrcOffsets({ vk::Offset3D(0, 0, 0), vk::Offset3D(width, height, 1) })
+            .setDstSubresource({ vk::ImageAspectFlagBits::eColor, level, 0, 1 })
+            .setDstOffsets({ vk::Offset3D(0, 0, 0), vk::Offset3D(nextWidth, nextHeight, 1) });
+
+        commandBuffer.blitImage(
+            dst,
+            vk::ImageLayout::eTransferSrcOptimal,
+            dst,
+            vk::ImageLayout::eTransferDstOptimal,
+            imageBlit,
+            vk::Filter::eLinear
+        );
+
+        width = nextWidth;
+        height = nextHeight;
+    }
+
+    List<vk::ImageMemoryBarrier> barrierList;
+    barrierList.reserve(mipLevels);
+
+    for (uint32_t level = 0; level < mipLevels; ++level) {
+        bool isBlitSource = (level + 1 >= copiedLevels and level + 1 < mipLevels);
+
+        barrierList.push_back(vk::ImageMemoryBarrier()
+            .setOldLayout(isBlitSource ? vk::ImageLayout::eTransferSrcOptimal : vk::ImageLayout::eTransferDstOptimal)
+            .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+            .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setImage(dst)
+            .setSubresourceRange({ vk::ImageAspectFlagBits::eColor, level, 1, 0, 1 })
+            .setSrcAccessMask(isBlitSource ? vk::AccessFlagBits::eTransferRead : vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eShaderRead)
+        );
+    }
+
+    commandBuffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eAllCommands,
+        {},
+        nullptr,
+        nullptr,
+        barrierList
+    );
+}
+
+RYME_API
+void UploadTexture(
+    vk::Buffer src,
+    vk::Image dst,
+    const List<vk::BufferImageCopy>& regionList,
+    uint32_t mipLevels
+)
+{
+    auto upload = TextureUpload{
+        .Image = dst,
+        .RegionList = regionList,
+        .MipLevels = mipLevels,
+    };
+
+    WaitForTimelineValue(SubmitTextureUploadList(src, { upload }));
+}
+
+RYME_API
+uint64_t SubmitTextureUploadList(vk::Buffer src, const List<TextureUpload>& uploadList)
+{
+    return SubmitCommands([&](vk::CommandBuffer commandBuffer) {
+        for (const auto& upload : uploadList) {
+            recordTextureUpload(commandBuffer, src, upload.Image, upload.RegionList, upload.MipLevels);
+        }
+    });
+}
+
+RYME_API
+uint64_t SubmitCommands(std::function<void(vk::CommandBuffer)> recordFunc)
+{
+    auto allocateInfo = vk::CommandBufferAllocateInfo()
+        .setCommandPool(_transientCommandPool)
+        .setLevel(vk::CommandBufferLevel::ePrimary)
+        .setCommandBufferCount(1);
+
+    auto commandBufferList = Device.allocateCommandBuffers(allocateInfo);
+    auto commandBuffer = commandBufferList.front();
+
+    auto beginInfo = vk::CommandBufferBeginInfo()
+        .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+    commandBuffer.begin(beginInfo);
+
+    recordFunc(commandBuffer);
+
+    commandBuffer.end();
+
+    uint64_t timelineValue = Submit(commandBuffer);
+
+    // Freed once the commands have finished, instead of waiting for them here
+    DeferDestroy([commandBuffer]() {
+        Device.freeCommandBuffers(_transientCommandPool, commandBuffer);
+    });
+
+    return timelineValue;
+}
+
+RYME_API
+void InvalidateCommandBuffers()
+{
+    _commandBuffersInvalidated = true;
+}
+
+RYME_API
+bool IsFormatFeatureSupported(vk::Format format, vk::FormatFeatureFlags formatFeatures)
+{
+    auto formatProperties = _physicalDevice.getFormatProperties(format);
+    return ((formatProperties.optimalTilingFeatures & formatFeatures) == formatFeatures);
+}
+
+RYME_API
+bool IsMultiDrawIndirectSupported()
+{
+    return _physicalDeviceFeatures.multiDrawIndirect;
+}
+
+RYME_API
+bool IsDrawIndirectCountSupported()
+{
+    return _drawIndirectCountSupported;
 }
 
 RYME_API
 void ScriptInit(py::module m)
 {
+    auto graphics = m.def_submodule("Graphics");
+
+    py::enum_<MemoryCategory>(graphics, "MemoryCategory")
+        .value("Other", MemoryCategory::Other)
+        .value("Mesh", MemoryCategory::Mesh)
+        .value("Texture", MemoryCategory::Texture)
+        .value("Uniform", MemoryCategory::Uniform)
+        .value("Staging", MemoryCategory::Staging)
+        .value("RenderTarget", MemoryCategory::RenderTarget);
+
+    py::class_<MemoryHeapStats>(graphics, "MemoryHeapStats")
+        .def_readonly("Size", &MemoryHeapStats::Size)
+        .def_readonly("IsDeviceLocal", &MemoryHeapStats::IsDeviceLocal)
+        .def_readonly("Usage", &MemoryHeapStats::Usage)
+        .def_readonly("Budget", &MemoryHeapStats::Budget)
+        .def_readonly("BlockCount", &MemoryHeapStats::BlockCount)
+        .def_readonly("AllocationCount", &MemoryHeapStats::AllocationCount)
+        .def_readonly("BlockBytes", &MemoryHeapStats::BlockBytes)
+        .def_readonly("AllocationBytes", &MemoryHeapStats::AllocationBytes)
+        .def_readonly("UnusedRangeCount", &MemoryHeapStats::UnusedRangeCount)
+        .def_readonly("LargestUnusedRange", &MemoryHeapStats::LargestUnusedRange)
+        .def_readonly("Fragmentation", &MemoryHeapStats::Fragmentation);
+
+    py::class_<MemoryCategoryStats>(graphics, "MemoryCategoryStats")
+        .def_readonly("Category", &MemoryCategoryStats::Category)
+        .def_readonly("AllocationCount", &MemoryCategoryStats::AllocationCount)
+        .def_readonly("Bytes", &MemoryCategoryStats::Bytes);
+
+    py::class_<MemoryStats>(graphics, "MemoryStats")
+        .def_readonly("HeapList", &MemoryStats::HeapList)
+        .def_readonly("CategoryList", &MemoryStats::CategoryList);
+
+    graphics
+        .def("GetMemoryStats", &GetMemoryStats)
+        .def("GetMemoryStatsJSON", &GetMemoryStatsJSON, py::arg("detailed") = false)
+        .def("LogMemoryStats", &LogMemoryStats);
+
     // m.def_submodule("Graphics")
     //     .def("GetWindowSize", []() {
     //         int width, height;
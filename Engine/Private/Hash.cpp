@@ -0,0 +1,111 @@
+#include <Ryme/Hash.hpp>
+
+#include <cstring>
+
+namespace ryme {
+
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+// All reads are little-endian, which matches every platform we support
+
+const uint64_t XXH64Prime1 = 0x9E3779B185EBCA87ull;
+const uint64_t XXH64Prime2 = 0xC2B2AE3D27D4EB4Full;
+const uint64_t XXH64Prime3 = 0x165667B19E3779F9ull;
+const uint64_t XXH64Prime4 = 0x85EBCA77C2B2AE63ull;
+const uint64_t XXH64Prime5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t rotateLeft64(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t read64(const uint8_t * data)
+{
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint32_t read32(const uint8_t * data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint64_t xxh64Round(uint64_t accumulator, uint64_t lane)
+{
+    accumulator += lane * XXH64Prime2;
+    accumulator = rotateLeft64(accumulator, 31);
+    return accumulator * XXH64Prime1;
+}
+
+inline uint64_t xxh64Merge(uint64_t hash, uint64_t accumulator)
+{
+    hash ^= xxh64Round(0, accumulator);
+    return hash * XXH64Prime1 + XXH64Prime4;
+}
+
+RYME_API
+uint64_t Hash64(Span<const uint8_t> data, uint64_t seed /*= 0*/)
+{
+    const uint8_t * it = data.data();
+    const uint8_t * end = it + data.size();
+
+    uint64_t hash;
+
+    if (data.size() >= 32) {
+        uint64_t accumulator1 = seed + XXH64Prime1 + XXH64Prime2;
+        uint64_t accumulator2 = seed + XXH64Prime2;
+        uint64_t accumulator3 = seed;
+        uint64_t accumulator4 = seed - XXH64Prime1;
+
+        // Four independent lanes of 8 bytes, so they can be calculated in parallel
+        for (; end - it >= 32; it += 32) {
+            accumulator1 = xxh64Round(accumulator1, read64(it + 0));
+            accumulator2 = xxh64Round(accumulator2, read64(it + 8));
+            accumulator3 = xxh64Round(accumulator3, read64(it + 16));
+            accumulator4 = xxh64Round(accumulator4, read64(it + 24));
+        }
+
+        hash = rotateLeft64(accumulator1, 1)
+            + rotateLeft64(accumulator2, 7)
+            + rotateLeft64(accumulator3, 12)
+            + rotateLeft64(accumulator4, 18);
+
+        hash = xxh64Merge(hash, accumulator1);
+        hash = xxh64Merge(hash, accumulator2);
+        hash = xxh64Merge(hash, accumulator3);
+        hash = xxh64Merge(hash, accumulator4);
+    }
+    else {
+        hash = seed + XXH64Prime5;
+    }
+
+    hash += data.size();
+
+    for (; end - it >= 8; it += 8) {
+        hash ^= xxh64Round(0, read64(it));
+        hash = rotateLeft64(hash, 27) * XXH64Prime1 + XXH64Prime4;
+    }
+
+    if (end - it >= 4) {
+        hash ^= read32(it) * XXH64Prime1;
+        hash = rotateLeft64(hash, 23) * XXH64Prime2 + XXH64Prime3;
+        it += 4;
+    }
+
+    for (; it < end; ++it) {
+        hash ^= (*it) * XXH64Prime5;
+        hash = rotateLeft64(hash, 11) * XXH64Prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= XXH64Prime2;
+    hash ^= hash >> 29;
+    hash *= XXH64Prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include <Ryme/ImageData.hpp>
+#include <Ryme/BlockCompression.hpp>
+#include <Ryme/Exception.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace ryme {
+
+// https://learn.microsoft.com/en-us/windows/win32/direct3ddds/dds-header
+// All values are little-endian, which matches every platform we support
+
+constexpr uint32_t makeFourCC(char a, char b, char c, char d)
+{
+    return uint32_t(a) | (uint32_t(b) << 8) | (uint32_t(c) << 16) | (uint32_t(d) << 24);
+}
+
+struct DDSPixelFormat
+{
+    uint32_t Size;
+
+    uint32_t Flags;
+
+    uint32_t FourCC;
+
+    uint32_t RGBBitCount;
+
+    uint32_t RBitMask;
+
+    uint32_t GBitMask;
+
+    uint32_t BBitMask;
+
+    uint32_t ABitMask;
+
+}; // struct DDSPixelFormat
+
+struct DDSHeader
+{
+    uint32_t Magic;
+
+    uint32_t Size;
+
+    uint32_t Flags;
+
+    uint32_t Height;
+
+    uint32_t Width;
+
+    uint32_t PitchOrLinearSize;
+
+    uint32_t Depth;
+
+    uint32_t MipMapCount;
+
+    uint32_t Reserved1[11];
+
+    DDSPixelFormat PixelFormat;
+
+    uint32_t Caps;
+
+    uint32_t Caps2;
+
+    uint32_t Caps3;
+
+    uint32_t Caps4;
+
+    uint32_t Reserved2;
+
+}; // struct DDSHeader
+
+static_assert(sizeof(DDSHeader) == 128);
+
+struct DDSHeaderDX10
+{
+    uint32_t DXGIFormat;
+
+    uint32_t ResourceDimension;
+
+    uint32_t MiscFlag;
+
+    uint32_t ArraySize;
+
+    uint32_t MiscFlags2;
+
+}; // struct DDSHeaderDX10
+
+static_assert(sizeof(DDSHeaderDX10) == 20);
+
+// DDSD_MIPMAPCOUNT
+constexpr uint32_t DDSMipMapCountFlag = 0x20000;
+
+// DDPF_FOURCC
+constexpr uint32_t DDSFourCCFlag = 0x4;
+
+// DDSCAPS2_CUBEMAP
+constexpr uint32_t DDSCubemapFlag = 0x200;
+
+vk::Format getFormatFromDXGIFormat(uint32_t dxgiFormat)
+{
+    switch (dxgiFormat) {
+    case 71: // DXGI_FORMAT_BC1_UNORM
+        return vk::Format::eBc1RgbaUnormBlock;
+    case 72: // DXGI_FORMAT_BC1_UNORM_SRGB
+        return vk::Format::eBc1RgbaSrgbBlock;
+    case 77: // DXGI_FORMAT_BC3_UNORM
+        return vk::Format::eBc3UnormBlock;
+    case 78: // DXGI_FORMAT_BC3_UNORM_SRGB
+        return vk::Format::eBc3SrgbBlock;
+    case 80: // DXGI_FORMAT_BC4_UNORM
+        return vk::Format::eBc4UnormBlock;
+    case 83: // DXGI_FORMAT_BC5_UNORM
+        return vk::Format::eBc5UnormBlock;
+    case 98: // DXGI_FORMAT_BC7_UNORM
+        return vk::Format::eBc7UnormBlock;
+    case 99: // DXGI_FORMAT_BC7_UNORM_SRGB
+        return vk::Format::eBc7SrgbBlock;
+    default:
+        return vk::Format::eUndefined;
+    }
+}
+
+// Legacy files have no notion of sRGB, color textures are assumed to be sRGB like the ones
+// loaded with stb_image
+vk::Format getFormatFromFourCC(uint32_t fourCC)
+{
+    switch (fourCC) {
+    case makeFourCC('D', 'X', 'T', '1'):
+        return vk::Format::eBc1RgbaSrgbBlock;
+    case makeFourCC('D', 'X', 'T', '5'):
+        return vk::Format::eBc3SrgbBlock;
+    case makeFourCC('A', 'T', 'I', '1'):
+    case makeFourCC('B', 'C', '4', 'U'):
+        return vk::Format::eBc4UnormBlock;
+    case makeFourCC('A', 'T', 'I', '2'):
+    case makeFourCC('B', 'C', '5', 'U'):
+        return vk::Format::eBc5UnormBlock;
+    default:
+        return vk::Format::eUndefined;
+    }
+}
+
+RYME_API
+bool LoadDDS(Span<const uint8_t> data, const Path& path, ImageData& imageData)
+{
+    auto ddsError = [&](StringView message) {
+        throw Exception("{} in DDS file '{}'", message, path);
+    };
+
+    size_t dataOffset = sizeof(DDSHeader);
+
+    DDSHeader header;
+    if (data.size() < sizeof(header)) {
+        ddsError("Truncated header");
+    }
+
+    memcpy(&header, data.data(), sizeof(header));
+
+    if (header.Magic != makeFourCC('D', 'D', 'S', ' ') or header.Size != 124) {
+        ddsError("Invalid header");
+    }
+
+    if (not (header.PixelFormat.Flags & DDSFourCCFlag)) {
+        ddsError("Unsupported uncompressed format");
+    }
+
+    if (header.Caps2 & DDSCubemapFlag) {
+        ddsError("Unsupported cubemap");
+    }
+
+    vk::Format format = vk::Format::eUndefined;
+
+    if (header.PixelFormat.FourCC == makeFourCC('D', 'X', '1', '0')) {
+        DDSHeaderDX10 headerDX10;
+        if (data.size() - dataOffset < sizeof(headerDX10)) {
+            ddsError("Truncated DX10 header");
+        }
+
+        memcpy(&headerDX10, data.data() + dataOffset, sizeof(headerDX10));
+        dataOffset += sizeof(headerDX10);
+
+        if (headerDX10.ArraySize > 1) {
+            ddsError("Unsupported array");
+        }
+
+        format = getFormatFromDXGIFormat(headerDX10.DXGIFormat);
+    }
+    else {
+        format = getFormatFromFourCC(header.PixelFormat.FourCC);
+    }
+
+    if (format == vk::Format::eUndefined) {
+        ddsError("Unsupported format");
+    }
+
+    if (header.Width == 0 or header.Height == 0) {
+        ddsError("Invalid dimensions");
+    }
+
+    imageData.Format = format;
+    imageData.Width = header.Width;
+    imageData.Height = header.Height;
+
+    uint32_t levelCount = 1;
+    if (header.Flags & DDSMipMapCountFlag) {
+        levelCount = std::max(header.MipMapCount, 1u);
+    }
+
+    uint32_t maxLevelCount = static_cast<uint32_t>(std::bit_width(std::max(header.Width, header.Height)));
+    if (levelCount > maxLevelCount) {
+        ddsError("Too many levels");
+    }
+
+    imageData.MipLevelList.clear();
+    imageData.MipLevelList.reserve(levelCount);
+
+    size_t offset = 0;
+
+    // Unlike KTX2, levels are stored consecutively starting at level 0
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        uint32_t width = std::max(imageData.Width >> level, 1u);
+        uint32_t height = std::max(imageData.Height >> level, 1u);
+
+        size_t size = GetImageSize(format, width, height);
+
+        imageData.MipLevelList.push_back(MipLevel{
+            .Width = width,
+            .Height = height,
+            .Offset = offset,
+            .Size = size,
+        });
+
+        offset += size;
+    }
+
+    if (data.size() - dataOffset < offset) {
+        ddsError("Truncated level data");
+    }
+
+    imageData.Data.assign(data.data() + dataOffset, data.data() + dataOffset + offset);
+
+    return true;
+}
+
+} // namespace ryme
\ No newline at end of file
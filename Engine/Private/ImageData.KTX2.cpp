@@ -0,0 +1,375 @@
+#include <Ryme/ImageData.hpp>
+#include <Ryme/BlockCompression.hpp>
+#include <Ryme/Exception.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+
+namespace ryme {
+
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+// All values are little-endian, which matches every platform we support
+
+static const uint8_t KTX2Identifier[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+};
+
+struct KTX2Header
+{
+    uint8_t Identifier[12];
+
+    uint32_t VkFormat;
+
+    uint32_t TypeSize;
+
+    uint32_t PixelWidth;
+
+    uint32_t PixelHeight;
+
+    uint32_t PixelDepth;
+
+    uint32_t LayerCount;
+
+    uint32_t FaceCount;
+
+    uint32_t LevelCount;
+
+    uint32_t SupercompressionScheme;
+
+    uint32_t DFDByteOffset;
+
+    uint32_t DFDByteLength;
+
+    uint32_t KVDByteOffset;
+
+    uint32_t KVDByteLength;
+
+    uint64_t SGDByteOffset;
+
+    uint64_t SGDByteLength;
+
+}; // struct KTX2Header
+
+static_assert(sizeof(KTX2Header) == 80);
+
+struct KTX2LevelIndex
+{
+    uint64_t ByteOffset;
+
+    uint64_t ByteLength;
+
+    uint64_t UncompressedByteLength;
+
+}; // struct KTX2LevelIndex
+
+// Basic Data Format Descriptor, required by the spec but only used to describe the data to other tools
+// https://registry.khronos.org/DataFormat/specs/1.3/dataformat.1.3.html
+List<uint32_t> buildDataFormatDescriptor(vk::Format format)
+{
+    struct Sample
+    {
+        uint32_t BitOffset;
+
+        uint32_t BitLength;
+
+        uint32_t ChannelType;
+
+    }; // struct Sample
+
+    // KHR_DF_MODEL_*
+    uint32_t colorModel = 0;
+
+    List<Sample> sampleList;
+
+    // KHR_DF_CHANNEL_*_ALPHA, and KHR_DF_SAMPLE_DATATYPE_LINEAR for alpha in sRGB formats
+    const uint32_t alphaChannel = 15;
+    const uint32_t linearFlag = 0x10;
+
+    bool isSRGB = (GetDecompressedFormat(format) == vk::Format::eR8G8B8A8Srgb)
+        or format == vk::Format::eB8G8R8A8Srgb;
+
+    uint32_t alphaChannelType = alphaChannel | (isSRGB ? linearFlag : 0);
+
+    switch (format) {
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc1RgbSrgbBlock:
+        colorModel = 128;
+        sampleList = { { 0, 64, 0 } };
+        break;
+    case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc1RgbaSrgbBlock:
+        colorModel = 128;
+        sampleList = { { 0, 64, 1 } };
+        break;
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc3SrgbBlock:
+        colorModel = 130;
+        sampleList = { { 0, 64, alphaChannelType }, { 64, 64, 0 } };
+        break;
+    case vk::Format::eBc4UnormBlock:
+        colorModel = 131;
+        sampleList = { { 0, 64, 0 } };
+        break;
+    case vk::Format::eBc5UnormBlock:
+        colorModel = 132;
+        sampleList = { { 0, 64, 0 }, { 64, 64, 1 } };
+        break;
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+        colorModel = 134;
+        sampleList = { { 0, 128, 0 } };
+        break;
+    case vk::Format::eR8Unorm:
+        colorModel = 1;
+        sampleList = { { 0, 8, 0 } };
+        break;
+    case vk::Format::eR8G8Unorm:
+        colorModel = 1;
+        sampleList = { { 0, 8, 0 }, { 8, 8, 1 } };
+        break;
+    case vk::Format::eR8G8B8A8Unorm:
+    case vk::Format::eR8G8B8A8Srgb:
+        colorModel = 1;
+        sampleList = { { 0, 8, 0 }, { 8, 8, 1 }, { 16, 8, 2 }, { 24, 8, alphaChannelType } };
+        break;
+    case vk::Format::eB8G8R8A8Unorm:
+    case vk::Format::eB8G8R8A8Srgb:
+        colorModel = 1;
+        sampleList = { { 0, 8, 2 }, { 8, 8, 1 }, { 16, 8, 0 }, { 24, 8, alphaChannelType } };
+        break;
+    default:
+        throw Exception("Unsupported KTX2 format {}", vk::to_string(format));
+    }
+
+    bool isCompressed = IsBlockCompressedFormat(format);
+
+    uint32_t blockDimension = (isCompressed ? 4 : 1);
+    uint32_t bytesPerBlock = GetImageSize(format, blockDimension, blockDimension);
+
+    uint32_t descriptorBlockSize = 24 + 16 * sampleList.size();
+
+    // KHR_DF_PRIMARIES_BT709, KHR_DF_TRANSFER_SRGB or KHR_DF_TRANSFER_LINEAR
+    uint32_t colorPrimaries = 1;
+    uint32_t transferFunction = (isSRGB ? 2 : 1);
+
+    List<uint32_t> dfd = {
+        4 + descriptorBlockSize,
+        0, // Khronos vendor, basic descriptor type
+        2 | (descriptorBlockSize << 16),
+        colorModel | (colorPrimaries << 8) | (transferFunction << 16),
+        (blockDimension - 1) | ((blockDimension - 1) << 8),
+        bytesPerBlock,
+        0,
+    };
+
+    for (const auto& sample : sampleList) {
+        // Compressed formats cover the full range of their storage, uncompressed ones are 0-255
+        uint32_t sampleUpper = (isCompressed ? UINT32_MAX : 255);
+
+        dfd.push_back(sample.BitOffset | ((sample.BitLength - 1) << 16) | (sample.ChannelType << 24));
+        dfd.push_back(0);
+        dfd.push_back(0);
+        dfd.push_back(sampleUpper);
+    }
+
+    return dfd;
+}
+
+// The block compressed formats the DDS loader accepts, and the formats SaveKTX2() writes, all of
+// which GetImageSize() and DecompressImageData() support
+bool isSupportedKTX2Format(vk::Format format)
+{
+    switch (format) {
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc1RgbSrgbBlock:
+    case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc1RgbaSrgbBlock:
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc3SrgbBlock:
+    case vk::Format::eBc4UnormBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+    case vk::Format::eR8Unorm:
+    case vk::Format::eR8G8Unorm:
+    case vk::Format::eR8G8B8A8Unorm:
+    case vk::Format::eR8G8B8A8Srgb:
+    case vk::Format::eB8G8R8A8Unorm:
+    case vk::Format::eB8G8R8A8Srgb:
+        return true;
+    default:
+        return false;
+    }
+}
+
+RYME_API
+bool LoadKTX2(Span<const uint8_t> data, const Path& path, ImageData& imageData)
+{
+    auto ktx2Error = [&](StringView message) {
+        throw Exception("{} in KTX2 file '{}'", message, path);
+    };
+
+    KTX2Header header;
+    if (data.size() < sizeof(header)) {
+        ktx2Error("Truncated header");
+    }
+
+    memcpy(&header, data.data(), sizeof(header));
+
+    if (memcmp(header.Identifier, KTX2Identifier, sizeof(KTX2Identifier)) != 0) {
+        ktx2Error("Invalid identifier");
+    }
+
+    if (header.SupercompressionScheme != 0) {
+        ktx2Error("Unsupported supercompression scheme");
+    }
+
+    if (header.PixelDepth > 1 or header.LayerCount > 1 or header.FaceCount != 1) {
+        ktx2Error("Unsupported array, cubemap or 3D image");
+    }
+
+    vk::Format format = static_cast<vk::Format>(header.VkFormat);
+    if (not isSupportedKTX2Format(format)) {
+        ktx2Error("Unsupported format");
+    }
+
+    if (header.PixelWidth == 0) {
+        ktx2Error("Invalid width");
+    }
+
+    uint32_t width = header.PixelWidth;
+    uint32_t height = std::max(header.PixelHeight, 1u);
+
+    // A level count of 0 asks for mips to be generated on load
+    uint32_t levelCount = std::max(header.LevelCount, 1u);
+
+    uint32_t maxLevelCount = static_cast<uint32_t>(std::bit_width(std::max(width, height)));
+    if (levelCount > maxLevelCount) {
+        ktx2Error("Too many levels");
+    }
+
+    List<KTX2LevelIndex> levelIndexList(levelCount);
+    if (data.size() - sizeof(header) < sizeof(KTX2LevelIndex) * levelIndexList.size()) {
+        ktx2Error("Truncated level index");
+    }
+
+    memcpy(levelIndexList.data(), data.data() + sizeof(header), sizeof(KTX2LevelIndex) * levelIndexList.size());
+
+    imageData.Format = format;
+    imageData.Width = width;
+    imageData.Height = height;
+
+    imageData.MipLevelList.clear();
+    imageData.MipLevelList.reserve(levelCount);
+
+    size_t offset = 0;
+
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        uint32_t levelWidth = std::max(width >> level, 1u);
+        uint32_t levelHeight = std::max(height >> level, 1u);
+
+        // Anything else would be read past by decompression or the upload to the GPU
+        size_t size = GetImageSize(format, levelWidth, levelHeight);
+        if (levelIndexList[level].ByteLength != size) {
+            ktx2Error("Invalid level size");
+        }
+
+        imageData.MipLevelList.push_back(MipLevel{
+            .Width = levelWidth,
+            .Height = levelHeight,
+            .Offset = offset,
+            .Size = size,
+        });
+
+        offset += size;
+    }
+
+    imageData.Data.resize(offset);
+
+    // Levels are stored smallest first in the file, but level 0 comes first in memory
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const auto& mipLevel = imageData.MipLevelList[level];
+
+        uint64_t byteOffset = levelIndexList[level].ByteOffset;
+
+        if (byteOffset > data.size() or data.size() - byteOffset < mipLevel.Size) {
+            ktx2Error("Truncated level data");
+        }
+
+        memcpy(imageData.Data.data() + mipLevel.Offset, data.data() + byteOffset, mipLevel.Size);
+    }
+
+    return true;
+}
+
+RYME_API
+bool SaveKTX2(const Path& path, const ImageData& imageData)
+{
+    List<uint32_t> dfd = buildDataFormatDescriptor(imageData.Format);
+
+    uint32_t levelCount = imageData.MipLevelList.size();
+
+    // Each level must be aligned to lcm(texel block size, 4), which is max(texel block size, 4) for
+    // every format we support
+    uint64_t alignment = std::max<uint64_t>(GetImageSize(imageData.Format, 1, 1), 4);
+
+    KTX2Header header = {};
+    memcpy(header.Identifier, KTX2Identifier, sizeof(KTX2Identifier));
+
+    header.VkFormat = static_cast<uint32_t>(imageData.Format);
+    header.TypeSize = 1;
+    header.PixelWidth = imageData.Width;
+    header.PixelHeight = imageData.Height;
+    header.PixelDepth = 0;
+    header.LayerCount = 0;
+    header.FaceCount = 1;
+    header.LevelCount = levelCount;
+    header.SupercompressionScheme = 0;
+    header.DFDByteOffset = sizeof(KTX2Header) + sizeof(KTX2LevelIndex) * levelCount;
+    header.DFDByteLength = dfd.size() * sizeof(uint32_t);
+
+    List<KTX2LevelIndex> levelIndexList(levelCount);
+
+    uint64_t offset = header.DFDByteOffset + header.DFDByteLength;
+
+    for (int level = levelCount - 1; level >= 0; --level) {
+        offset = (offset + alignment - 1) / alignment * alignment;
+
+        levelIndexList[level] = KTX2LevelIndex{
+            .ByteOffset = offset,
+            .ByteLength = imageData.MipLevelList[level].Size,
+            .UncompressedByteLength = imageData.MipLevelList[level].Size,
+        };
+
+        offset += imageData.MipLevelList[level].Size;
+    }
+
+    FILE * file = fopen(path.ToCString(), "wb");
+    if (not file) {
+        return false;
+    }
+
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(levelIndexList.data(), sizeof(KTX2LevelIndex), levelCount, file);
+    fwrite(dfd.data(), sizeof(uint32_t), dfd.size(), file);
+
+    for (int level = levelCount - 1; level >= 0; --level) {
+        const auto& mipLevel = imageData.MipLevelList[level];
+
+        // Pad up to the aligned offset
+        static const uint8_t padding[16] = {};
+        fwrite(padding, 1, levelIndexList[level].ByteOffset - ftell(file), file);
+
+        fwrite(imageData.Data.data() + mipLevel.Offset, 1, mipLevel.Size, file);
+    }
+
+    bool written = (ferror(file) == 0);
+
+    fclose(file);
+
+    return written;
+}
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include <Ryme/ImageData.hpp>
+#include <Ryme/BlockCompression.hpp>
+#include <Ryme/Exception.hpp>
+#include <Ryme/VFS.hpp>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+namespace ryme {
+
+RYME_API
+bool LoadImageData(const Path& path, ImageData& imageData, bool search /*= false*/)
+{
+    VFS::File file = VFS::Open(path, search);
+    if (not file.IsOpen()) {
+        return false;
+    }
+
+    return LoadImageData(file.GetSpan(), file.GetPath(), imageData);
+}
+
+RYME_API
+bool LoadImageData(Span<const uint8_t> data, const Path& path, ImageData& imageData)
+{
+    const Path& ext = path.GetExtension();
+
+    if (ext == "ktx2") {
+        return LoadKTX2(data, path, imageData);
+    }
+    else if (ext == "dds") {
+        return LoadDDS(data, path, imageData);
+    }
+
+    int width;
+    int height;
+    int components;
+
+    uint8_t * pixels = stbi_load_from_memory(
+        data.data(),
+        static_cast<int>(data.size()),
+        &width,
+        &height,
+        &components,
+        STBI_rgb_alpha
+    );
+
+    if (not pixels) {
+        return false;
+    }
+
+    imageData.Format = vk::Format::eR8G8B8A8Srgb;
+    imageData.Width = width;
+    imageData.Height = height;
+
+    size_t size = size_t(width) * size_t(height) * STBI_rgb_alpha;
+
+    imageData.MipLevelList = {
+        MipLevel{
+            .Width = imageData.Width,
+            .Height = imageData.Height,
+            .Offset = 0,
+            .Size = size,
+        },
+    };
+
+    imageData.Data.assign(pixels, pixels + size);
+
+    stbi_image_free(pixels);
+
+    return true;
+}
+
+RYME_API
+List<vk::BufferImageCopy> GetCopyRegionList(const ImageData& imageData, vk::DeviceSize bufferOffset /*= 0*/)
+{
+    List<vk::BufferImageCopy> regionList;
+    regionList.reserve(imageData.MipLevelList.size());
+
+    for (uint32_t level = 0; level < imageData.MipLevelList.size(); ++level) {
+        const auto& mipLevel = imageData.MipLevelList[level];
+
+        auto subresourceLayers = vk::ImageSubresourceLayers()
+            .setAspectMask(vk::ImageAspectFlagBits::eColor)
+            .setMipLevel(level)
+            .setBaseArrayLayer(0)
+            .setLayerCount(1);
+
+        regionList.push_back(vk::BufferImageCopy()
+            .setBufferOffset(bufferOffset + mipLevel.Offset)
+            .setBufferRowLength(0)
+            .setBufferImageHeight(0)
+            .setImageSubresource(subresourceLayers)
+            .setImageOffset(vk::Offset3D(0, 0, 0))
+            .setImageExtent(vk::Extent3D(mipLevel.Width, mipLevel.Height, 1))
+        );
+    }
+
+    return regionList;
+}
+
+RYME_API
+void GenerateMipmaps(ImageData& imageData)
+{
+    if (imageData.Format != vk::Format::eR8G8B8A8Srgb and imageData.Format != vk::Format::eR8G8B8A8Unorm) {
+        throw Exception("Unable to generate mipmaps for image format {}", vk::to_string(imageData.Format));
+    }
+
+    imageData.MipLevelList = GetMipLevelList(imageData.Width, imageData.Height, 4);
+
+    const auto& lastLevel = imageData.MipLevelList.back();
+    imageData.Data.resize(lastLevel.Offset + lastLevel.Size);
+
+    for (size_t level = 1; level < imageData.MipLevelList.size(); ++level) {
+        const auto& previous = imageData.MipLevelList[level - 1];
+
+        DownsampleRGBA8(
+            imageData.Data.data() + previous.Offset,
+            previous.Width,
+            previous.Height,
+            imageData.Data.data() + imageData.MipLevelList[level].Offset
+        );
+    }
+}
+
+RYME_API
+void DecompressImageData(ImageData& imageData)
+{
+    vk::Format format = GetDecompressedFormat(imageData.Format);
+
+    List<MipLevel> mipLevelList;
+    mipLevelList.reserve(imageData.MipLevelList.size());
+
+    size_t offset = 0;
+
+    for (const auto& mipLevel : imageData.MipLevelList) {
+        size_t size = GetImageSize(format, mipLevel.Width, mipLevel.Height);
+
+        mipLevelList.push_back(MipLevel{
+            .Width = mipLevel.Width,
+            .Height = mipLevel.Height,
+            .Offset = offset,
+            .Size = size,
+        });
+
+        offset += size;
+    }
+
+    List<uint8_t> data(offset);
+
+    for (size_t level = 0; level < mipLevelList.size(); ++level) {
+        const auto& mipLevel = mipLevelList[level];
+
+        DecompressImage(
+            imageData.Format,
+            imageData.Data.data() + imageData.MipLevelList[level].Offset,
+            mipLevel.Width,
+            mipLevel.Height,
+            data.data() + mipLevel.Offset
+        );
+    }
+
+    imageData.Format = format;
+    imageData.MipLevelList = std::move(mipLevelList);
+    imageData.Data = std::move(data);
+}
+
+RYME_API
+void CompressImageData(ImageData& imageData, vk::Format format)
+{
+    if (imageData.Format != vk::Format::eR8G8B8A8Srgb and imageData.Format != vk::Format::eR8G8B8A8Unorm) {
+        throw Exception("Unable to compress image format {}", vk::to_string(imageData.Format));
+    }
+
+    List<MipLevel> mipLevelList;
+    mipLevelList.reserve(imageData.MipLevelList.size());
+
+    size_t offset = 0;
+
+    for (const auto& mipLevel : imageData.MipLevelList) {
+        size_t size = GetImageSize(format, mipLevel.Width, mipLevel.Height);
+
+        mipLevelList.push_back(MipLevel{
+            .Width = mipLevel.Width,
+            .Height = mipLevel.Height,
+            .Offset = offset,
+            .Size = size,
+        });
+
+        offset += size;
+    }
+
+    List<uint8_t> data(offset);
+
+    for (size_t level = 0; level < mipLevelList.size(); ++level) {
+        const auto& mipLevel = mipLevelList[level];
+
+        CompressImage(
+            format,
+            imageData.Data.data() + imageData.MipLevelList[level].Offset,
+            mipLevel.Width,
+            mipLevel.Height,
+            data.data() + mipLevel.Offset
+        );
+    }
+
+    imageData.Format = format;
+    imageData.MipLevelList = std::move(mipLevelList);
+    imageData.Data = std::move(data);
+}
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include <Ryme/MappedFile.hpp>
+
+#include <utility>
+
+#if defined(RYME_PLATFORM_WINDOWS)
+
+    #include <Ryme/UTF.hpp>
+
+    #include <Windows.h>
+
+#else
+
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+#endif
+
+namespace ryme {
+
+RYME_API
+MappedFile::MappedFile(const Path& path)
+{
+    Open(path);
+}
+
+RYME_API
+MappedFile::MappedFile(MappedFile&& rhs)
+{
+    *this = std::move(rhs);
+}
+
+RYME_API
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+RYME_API
+MappedFile& MappedFile::operator=(MappedFile&& rhs)
+{
+    if (this != &rhs) {
+        Close();
+
+        std::swap(_isOpen, rhs._isOpen);
+        std::swap(_data, rhs._data);
+        std::swap(_size, rhs._size);
+
+        #if defined(RYME_PLATFORM_WINDOWS)
+            std::swap(_fileHandle, rhs._fileHandle);
+            std::swap(_mappingHandle, rhs._mappingHandle);
+        #endif
+    }
+
+    return *this;
+}
+
+RYME_API
+bool MappedFile::Open(const Path& path)
+{
+    Close();
+
+    #if defined(RYME_PLATFORM_WINDOWS)
+
+        HANDLE file = CreateFileW(
+            UTF::ToWideString(path.ToString()).c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        );
+
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (not GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            return false;
+        }
+
+        _fileHandle = file;
+        _size = static_cast<size_t>(size.QuadPart);
+        _isOpen = true;
+
+        // Empty files can't be mapped
+        if (_size == 0) {
+            return true;
+        }
+
+        _mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (not _mappingHandle) {
+            Close();
+            return false;
+        }
+
+        _data = static_cast<const uint8_t *>(MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (not _data) {
+            Close();
+            return false;
+        }
+
+    #else
+
+        int file = open(path.ToCString(), O_RDONLY | O_CLOEXEC);
+        if (file < 0) {
+            return false;
+        }
+
+        struct stat status;
+        if (fstat(file, &status) < 0 or not S_ISREG(status.st_mode)) {
+            close(file);
+            return false;
+        }
+
+        _size = static_cast<size_t>(status.st_size);
+        _isOpen = true;
+
+        // Empty files can't be mapped
+        if (_size == 0) {
+            close(file);
+            return true;
+        }
+
+        int flags = MAP_PRIVATE;
+
+        #if defined(RYME_PLATFORM_LINUX)
+            // Read the whole file in now, instead of one page fault at a time
+            flags |= MAP_POPULATE;
+        #endif
+
+        void * data = mmap(nullptr, _size, PROT_READ, flags, file, 0);
+
+        // The mapping keeps its own reference to the file
+        close(file);
+
+        if (data == MAP_FAILED) {
+            _isOpen = false;
+            _size = 0;
+            return false;
+        }
+
+        _data = static_cast<const uint8_t *>(data);
+
+    #endif
+
+    return true;
+}
+
+RYME_API
+void MappedFile::Close()
+{
+    #if defined(RYME_PLATFORM_WINDOWS)
+
+        if (_data) {
+            UnmapViewOfFile(_data);
+        }
+
+        if (_mappingHandle) {
+            CloseHandle(_mappingHandle);
+            _mappingHandle = nullptr;
+        }
+
+        if (_fileHandle) {
+            CloseHandle(_fileHandle);
+            _fileHandle = nullptr;
+        }
+
+    #else
+
+        if (_data) {
+            munmap(const_cast<uint8_t *>(_data), _size);
+        }
+
+    #endif
+
+    _data = nullptr;
+    _size = 0;
+    _isOpen = false;
+}
+
+} // namespace ryme
\ No newline at end of file
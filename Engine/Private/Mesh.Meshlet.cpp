@@ -0,0 +1,341 @@
+#include <Ryme/Mesh.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace ryme {
+
+constexpr uint32_t NoMeshlet = UINT32_MAX;
+
+// Normal cones that spread wider than this are never able to cull anything
+constexpr float MinConeDot = 0.1f;
+
+MeshletBounds getMeshletBounds(
+    const List<Vertex>& vertexList,
+    const List<uint32_t>& indexList,
+    const Meshlet& meshlet,
+    const List<uint32_t>& meshletVertexList
+)
+{
+    MeshletBounds bounds = {
+        .Center = Vec3(0.0f),
+        .Radius = 0.0f,
+        .ConeApex = Vec3(0.0f),
+        .Padding = 0.0f,
+        .ConeAxis = Vec3(0.0f),
+        .ConeCutoff = 1.0f,
+    };
+
+    if (meshlet.VertexCount == 0) {
+        return bounds;
+    }
+
+    /// Bounding Sphere
+
+    Vec3 boundsMin = Vec3(vertexList[meshletVertexList[meshlet.FirstVertex]].Position);
+    Vec3 boundsMax = boundsMin;
+
+    for (uint32_t i = 0; i < meshlet.VertexCount; ++i) {
+        Vec3 position = Vec3(vertexList[meshletVertexList[meshlet.FirstVertex + i]].Position);
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
+
+    bounds.Center = (boundsMin + boundsMax) * 0.5f;
+
+    for (uint32_t i = 0; i < meshlet.VertexCount; ++i) {
+        Vec3 position = Vec3(vertexList[meshletVertexList[meshlet.FirstVertex + i]].Position);
+        bounds.Radius = std::max(bounds.Radius, glm::length(position - bounds.Center));
+    }
+
+    /// Normal Cone
+
+    List<Vec3> normalList;
+    List<Vec3> cornerList;
+    normalList.reserve(meshlet.IndexCount / 3);
+    cornerList.reserve(meshlet.IndexCount / 3);
+
+    Vec3 axis = Vec3(0.0f);
+
+    for (uint32_t i = 0; i < meshlet.IndexCount; i += 3) {
+        Vec3 p0 = Vec3(vertexList[indexList[meshlet.FirstIndex + i + 0]].Position);
+        Vec3 p1 = Vec3(vertexList[indexList[meshlet.FirstIndex + i + 1]].Position);
+        Vec3 p2 = Vec3(vertexList[indexList[meshlet.FirstIndex + i + 2]].Position);
+
+        Vec3 normal = glm::cross(p1 - p0, p2 - p0);
+
+        float area = glm::length(normal);
+        if (area <= 0.0f) {
+            continue;
+        }
+
+        normal /= area;
+
+        normalList.push_back(normal);
+        cornerList.push_back(p0);
+
+        axis += normal;
+    }
+
+    float axisLength = glm::length(axis);
+    if (normalList.empty() or axisLength <= 0.0f) {
+        return bounds;
+    }
+
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (const auto& normal : normalList) {
+        minDot = std::min(minDot, glm::dot(normal, axis));
+    }
+
+    if (minDot <= MinConeDot) {
+        return bounds;
+    }
+
+    // Move the apex back along the axis until it is behind the plane of every triangle, so any camera
+    // in front of the cone sees all of their backs
+    float maxDistance = 0.0f;
+
+    for (size_t i = 0; i < normalList.size(); ++i) {
+        float distance = glm::dot(cornerList[i] - bounds.Center, normalList[i]) / glm::dot(normalList[i], axis);
+        maxDistance = std::max(maxDistance, distance);
+    }
+
+    bounds.ConeApex = bounds.Center - axis * maxDistance;
+    bounds.ConeAxis = axis;
+    bounds.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+
+    return bounds;
+}
+
+RYME_API
+MeshletData MeshData::BuildMeshlets(uint32_t maxVertexCount /*= 64*/, uint32_t maxTriangleCount /*= 124*/)
+{
+    RYME_PROFILE_FUNCTION();
+
+    MeshletData meshletData;
+
+    if (PrimitiveTopology != vk::PrimitiveTopology::eTriangleList) {
+        return meshletData;
+    }
+
+    GenerateIndexList();
+
+    const size_t vertexCount = VertexList.size();
+    const size_t triangleCount = IndexList.size() / 3;
+
+    /// Adjacency
+
+    List<uint32_t> adjacencyOffsetList(vertexCount + 1, 0);
+    List<uint32_t> adjacencyList(IndexList.size());
+
+    for (uint32_t index : IndexList) {
+        ++adjacencyOffsetList[index + 1];
+    }
+
+    for (size_t i = 0; i < vertexCount; ++i) {
+        adjacencyOffsetList[i + 1] += adjacencyOffsetList[i];
+    }
+
+    {
+        List<uint32_t> fillList(adjacencyOffsetList.begin(), adjacencyOffsetList.end() - 1);
+
+        for (size_t i = 0; i < IndexList.size(); ++i) {
+            adjacencyList[fillList[IndexList[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    // Triangles that have not been added to a meshlet yet, around each vertex
+    List<uint32_t> liveCountList(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        liveCountList[i] = adjacencyOffsetList[i + 1] - adjacencyOffsetList[i];
+    }
+
+    List<Vec3> normalList(triangleCount);
+
+    for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        Vec3 p0 = Vec3(VertexList[IndexList[triangle * 3 + 0]].Position);
+        Vec3 p1 = Vec3(VertexList[IndexList[triangle * 3 + 1]].Position);
+        Vec3 p2 = Vec3(VertexList[IndexList[triangle * 3 + 2]].Position);
+
+        Vec3 normal = glm::cross(p1 - p0, p2 - p0);
+
+        float area = glm::length(normal);
+        normalList[triangle] = (area > 0.0f ? normal / area : Vec3(0.0f));
+    }
+
+    /// Meshlets
+
+    List<uint32_t> meshletIndexList;
+    meshletIndexList.reserve(IndexList.size());
+
+    List<uint8_t> emittedList(triangleCount, 0);
+
+    // The meshlet each vertex was last added to, to find whether it is in the current one
+    List<uint32_t> vertexMeshletList(vertexCount, NoMeshlet);
+
+    List<uint32_t> meshletTriangleList;
+    List<uint32_t> meshletVertexList;
+    List<uint32_t> candidateList;
+
+    Vec3 normalSum = Vec3(0.0f);
+
+    size_t emittedCount = 0;
+    size_t nextUnemitted = 0;
+
+    auto currentMeshlet = [&]() {
+        return static_cast<uint32_t>(meshletData.MeshletList.size());
+    };
+
+    auto getNewVertexCount = [&](uint32_t triangle) {
+        uint32_t count = 0;
+        for (size_t k = 0; k < 3; ++k) {
+            if (vertexMeshletList[IndexList[triangle * 3 + k]] != currentMeshlet()) {
+                ++count;
+            }
+        }
+        return count;
+    };
+
+    auto finishMeshlet = [&]() {
+        meshletData.MeshletList.push_back(Meshlet{
+            .FirstIndex = static_cast<uint32_t>(meshletIndexList.size()),
+            .IndexCount = static_cast<uint32_t>(meshletTriangleList.size() * 3),
+            .FirstVertex = static_cast<uint32_t>(meshletData.VertexList.size()),
+            .VertexCount = static_cast<uint32_t>(meshletVertexList.size()),
+        });
+
+        for (uint32_t triangle : meshletTriangleList) {
+            for (size_t k = 0; k < 3; ++k) {
+                meshletIndexList.push_back(IndexList[triangle * 3 + k]);
+            }
+        }
+
+        meshletData.VertexList.insert(meshletData.VertexList.end(), meshletVertexList.begin(), meshletVertexList.end());
+
+        meshletTriangleList.clear();
+        meshletVertexList.clear();
+        normalSum = Vec3(0.0f);
+    };
+
+    while (emittedCount < triangleCount) {
+        // Start next to the previous meshlet, on the triangle that has the fewest neighbours left, so
+        // corners are filled in before they become isolated fragments
+        uint32_t seed = UINT32_MAX;
+        uint32_t seedScore = UINT32_MAX;
+
+        for (uint32_t triangle : candidateList) {
+            if (emittedList[triangle]) {
+                continue;
+            }
+
+            uint32_t score = 0;
+            for (size_t k = 0; k < 3; ++k) {
+                score += liveCountList[IndexList[triangle * 3 + k]];
+            }
+
+            if (score < seedScore) {
+                seed = triangle;
+                seedScore = score;
+            }
+        }
+
+        if (seed == UINT32_MAX) {
+            while (emittedList[nextUnemitted]) {
+                ++nextUnemitted;
+            }
+
+            seed = static_cast<uint32_t>(nextUnemitted);
+        }
+
+        candidateList.clear();
+
+        uint32_t triangle = seed;
+
+        while (triangle != UINT32_MAX) {
+            emittedList[triangle] = 1;
+            ++emittedCount;
+
+            meshletTriangleList.push_back(triangle);
+            normalSum += normalList[triangle];
+
+            for (size_t k = 0; k < 3; ++k) {
+                uint32_t index = IndexList[triangle * 3 + k];
+                --liveCountList[index];
+
+                if (vertexMeshletList[index] != currentMeshlet()) {
+                    vertexMeshletList[index] = currentMeshlet();
+                    meshletVertexList.push_back(index);
+
+                    for (uint32_t a = adjacencyOffsetList[index]; a < adjacencyOffsetList[index + 1]; ++a) {
+                        if (not emittedList[adjacencyList[a]]) {
+                            candidateList.push_back(adjacencyList[a]);
+                        }
+                    }
+                }
+            }
+
+            if (meshletTriangleList.size() >= maxTriangleCount) {
+                break;
+            }
+
+            // Prefer triangles that add the fewest vertices, then the ones facing the same way as the
+            // rest of the meshlet, which keeps the normal cone narrow
+            Vec3 axis = normalSum;
+            float axisLength = glm::length(axis);
+            if (axisLength > 0.0f) {
+                axis /= axisLength;
+            }
+
+            triangle = UINT32_MAX;
+            float bestScore = FLT_MAX;
+
+            size_t writeIndex = 0;
+
+            for (size_t i = 0; i < candidateList.size(); ++i) {
+                uint32_t candidate = candidateList[i];
+                if (emittedList[candidate]) {
+                    continue;
+                }
+
+                candidateList[writeIndex++] = candidate;
+
+                uint32_t newVertexCount = getNewVertexCount(candidate);
+                if (meshletVertexList.size() + newVertexCount > maxVertexCount) {
+                    continue;
+                }
+
+                float score = float(newVertexCount) + (1.0f - glm::dot(normalList[candidate], axis)) * 0.5f;
+
+                if (score < bestScore) {
+                    triangle = candidate;
+                    bestScore = score;
+                }
+            }
+
+            candidateList.resize(writeIndex);
+        }
+
+        finishMeshlet();
+    }
+
+    meshletData.BoundsList.reserve(meshletData.MeshletList.size());
+
+    for (const auto& meshlet : meshletData.MeshletList) {
+        meshletData.BoundsList.push_back(getMeshletBounds(
+            VertexList,
+            meshletIndexList,
+            meshlet,
+            meshletData.VertexList
+        ));
+    }
+
+    IndexList = std::move(meshletIndexList);
+
+    return meshletData;
+}
+
+} // namespace ryme
\ No newline at end of file
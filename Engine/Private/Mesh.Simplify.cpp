@@ -0,0 +1,623 @@
+#include <Ryme/Mesh.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ryme {
+
+// Quadric Error Metric Simplification, based on "Surface Simplification Using Quadric Error Metrics"
+// by Garland and Heckbert. Edges are collapsed onto one of their existing vertices instead of an
+// optimal position, so every LOD can share the original vertex buffer.
+
+enum class VertexKind : uint8_t
+{
+    // Surrounded by triangles, with the same attributes in all of them
+    Manifold,
+
+    // On an open edge of the mesh
+    Border,
+
+    // Split into two vertices by an attribute discontinuity, such as a UV seam or a hard edge
+    Seam,
+
+    // Anything more complicated, never moved
+    Locked,
+
+}; // enum class VertexKind
+
+// Indexed by [from][to]
+constexpr bool CanCollapse[4][4] = {
+    { true,  true,  true,  true  },
+    { false, true,  false, false },
+    { false, false, true,  false },
+    { false, false, false, false },
+};
+
+constexpr uint32_t NoEdge = UINT32_MAX;
+
+constexpr uint32_t ManyEdges = UINT32_MAX - 1;
+
+// Open edges are weighted more heavily than the surface, so they keep their shape
+constexpr float BorderEdgeWeight = 10.0f;
+
+constexpr float SeamEdgeWeight = 1.0f;
+
+///
+/// The sum of the squared distances to a set of weighted planes
+///
+struct Quadric
+{
+    float A00 = 0.0f;
+    float A11 = 0.0f;
+    float A22 = 0.0f;
+    float A01 = 0.0f;
+    float A02 = 0.0f;
+    float A12 = 0.0f;
+
+    float B0 = 0.0f;
+    float B1 = 0.0f;
+    float B2 = 0.0f;
+
+    float C = 0.0f;
+
+    float Weight = 0.0f;
+
+}; // struct Quadric
+
+struct Collapse
+{
+    uint32_t From;
+
+    uint32_t To;
+
+    float Error;
+
+}; // struct Collapse
+
+Quadric getPlaneQuadric(const Vec3& normal, float distance, float weight)
+{
+    return Quadric{
+        .A00 = weight * normal.x * normal.x,
+        .A11 = weight * normal.y * normal.y,
+        .A22 = weight * normal.z * normal.z,
+        .A01 = weight * normal.x * normal.y,
+        .A02 = weight * normal.x * normal.z,
+        .A12 = weight * normal.y * normal.z,
+        .B0 = weight * normal.x * distance,
+        .B1 = weight * normal.y * distance,
+        .B2 = weight * normal.z * distance,
+        .C = weight * distance * distance,
+        .Weight = weight,
+    };
+}
+
+void addQuadric(Quadric& quadric, const Quadric& other)
+{
+    quadric.A00 += other.A00;
+    quadric.A11 += other.A11;
+    quadric.A22 += other.A22;
+    quadric.A01 += other.A01;
+    quadric.A02 += other.A02;
+    quadric.A12 += other.A12;
+    quadric.B0 += other.B0;
+    quadric.B1 += other.B1;
+    quadric.B2 += other.B2;
+    quadric.C += other.C;
+    quadric.Weight += other.Weight;
+}
+
+// The weighted average of the squared distances from point to the planes
+float getQuadricError(const Quadric& quadric, const Vec3& point)
+{
+    float x = quadric.A00 * point.x + quadric.A01 * point.y + quadric.A02 * point.z + quadric.B0 * 2.0f;
+    float y = quadric.A01 * point.x + quadric.A11 * point.y + quadric.A12 * point.z + quadric.B1 * 2.0f;
+    float z = quadric.A02 * point.x + quadric.A12 * point.y + quadric.A22 * point.z + quadric.B2 * 2.0f;
+
+    float error = point.x * x + point.y * y + point.z * z + quadric.C;
+
+    return std::fabs(error) / (quadric.Weight > 0.0f ? quadric.Weight : 1.0f);
+}
+
+uint64_t getEdgeKey(uint32_t from, uint32_t to)
+{
+    return (uint64_t(from) << 32) | to;
+}
+
+MeshLOD simplify(
+    const List<Vertex>& vertexList,
+    const List<uint32_t>& sourceIndexList,
+    size_t targetIndexCount,
+    float maxError
+)
+{
+    RYME_PROFILE_FUNCTION();
+
+    List<uint32_t> indexList = sourceIndexList;
+
+    const size_t vertexCount = vertexList.size();
+
+    if (vertexCount == 0 or indexList.size() <= targetIndexCount) {
+        return MeshLOD{ .IndexList = std::move(indexList) };
+    }
+
+    /// Positions
+
+    // Errors are measured in a unit cube, so maxError does not depend on the scale of the mesh
+    Vec3 boundsMin = Vec3(vertexList[0].Position);
+    Vec3 boundsMax = Vec3(vertexList[0].Position);
+
+    for (const auto& vertex : vertexList) {
+        boundsMin = glm::min(boundsMin, Vec3(vertex.Position));
+        boundsMax = glm::max(boundsMax, Vec3(vertex.Position));
+    }
+
+    Vec3 size = boundsMax - boundsMin;
+    float extent = std::max(size.x, std::max(size.y, size.z));
+    float scale = (extent > 0.0f ? 1.0f / extent : 0.0f);
+
+    List<Vec3> positionList(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        positionList[i] = (Vec3(vertexList[i].Position) - boundsMin) * scale;
+    }
+
+    /// Welding
+
+    struct PositionHash
+    {
+        size_t operator()(const Vec3& position) const {
+            uint32_t words[3];
+            memcpy(words, &position, sizeof(words));
+            return (words[0] * 73856093u) ^ (words[1] * 19349663u) ^ (words[2] * 83492791u);
+        }
+    };
+
+    struct PositionEqual
+    {
+        bool operator()(const Vec3& a, const Vec3& b) const {
+            return (memcmp(&a, &b, sizeof(Vec3)) == 0);
+        }
+    };
+
+    // Each vertex is remapped to the first vertex with the same position, and the vertices that share
+    // a position are linked in a circular list of wedges
+    List<uint32_t> remapList(vertexCount);
+    List<uint32_t> wedgeList(vertexCount);
+
+    std::unordered_map<Vec3, uint32_t, PositionHash, PositionEqual> positionMap;
+    positionMap.reserve(vertexCount);
+
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        auto[it, inserted] = positionMap.emplace(Vec3(vertexList[i].Position), i);
+
+        uint32_t first = it->second;
+        remapList[i] = first;
+
+        if (inserted) {
+            wedgeList[i] = i;
+        }
+        else {
+            wedgeList[i] = wedgeList[first];
+            wedgeList[first] = i;
+        }
+    }
+
+    /// Classification
+
+    // An edge is open if no triangle uses the same vertices in the opposite direction, which is the
+    // case for borders, but also for seams, where the other side uses different vertices
+    std::unordered_set<uint64_t> edgeSet;
+    edgeSet.reserve(indexList.size());
+
+    for (size_t i = 0; i < indexList.size(); i += 3) {
+        for (size_t e = 0; e < 3; ++e) {
+            edgeSet.insert(getEdgeKey(indexList[i + e], indexList[i + (e + 1) % 3]));
+        }
+    }
+
+    List<uint32_t> openOutList(vertexCount, NoEdge);
+    List<uint32_t> openInList(vertexCount, NoEdge);
+
+    for (size_t i = 0; i < indexList.size(); i += 3) {
+        for (size_t e = 0; e < 3; ++e) {
+            uint32_t from = indexList[i + e];
+            uint32_t to = indexList[i + (e + 1) % 3];
+
+            if (not edgeSet.contains(getEdgeKey(to, from))) {
+                openOutList[from] = (openOutList[from] == NoEdge ? to : ManyEdges);
+                openInList[to] = (openInList[to] == NoEdge ? from : ManyEdges);
+            }
+        }
+    }
+
+    auto isSingleEdge = [](uint32_t edge) {
+        return (edge < ManyEdges);
+    };
+
+    List<VertexKind> kindList(vertexCount, VertexKind::Locked);
+
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        uint32_t sibling = wedgeList[i];
+
+        if (sibling == i) {
+            if (openInList[i] == NoEdge and openOutList[i] == NoEdge) {
+                kindList[i] = VertexKind::Manifold;
+            }
+            else if (isSingleEdge(openInList[i]) and isSingleEdge(openOutList[i])) {
+                kindList[i] = VertexKind::Border;
+            }
+        }
+        else if (wedgeList[sibling] == i) {
+            // Both wedges have one open edge on each side, which meet the other wedge's open edges
+            bool isSeam = isSingleEdge(openInList[i])
+                and isSingleEdge(openOutList[i])
+                and isSingleEdge(openInList[sibling])
+                and isSingleEdge(openOutList[sibling])
+                and remapList[openOutList[i]] == remapList[openInList[sibling]]
+                and remapList[openInList[i]] == remapList[openOutList[sibling]];
+
+            if (isSeam) {
+                kindList[i] = VertexKind::Seam;
+            }
+        }
+    }
+
+    /// Quadrics
+
+    List<Quadric> quadricList(vertexCount);
+
+    for (size_t i = 0; i < indexList.size(); i += 3) {
+        uint32_t index[3] = { indexList[i + 0], indexList[i + 1], indexList[i + 2] };
+
+        const Vec3& p0 = positionList[index[0]];
+        const Vec3& p1 = positionList[index[1]];
+        const Vec3& p2 = positionList[index[2]];
+
+        Vec3 normal = glm::cross(p1 - p0, p2 - p0);
+
+        float area = glm::length(normal);
+        if (area <= 0.0f) {
+            continue;
+        }
+
+        normal /= area;
+
+        Quadric quadric = getPlaneQuadric(normal, -glm::dot(normal, p0), area);
+
+        for (size_t e = 0; e < 3; ++e) {
+            addQuadric(quadricList[remapList[index[e]]], quadric);
+        }
+
+        // Open edges get a plane perpendicular to the triangle, to keep them from moving sideways
+        for (size_t e = 0; e < 3; ++e) {
+            uint32_t from = index[e];
+            uint32_t to = index[(e + 1) % 3];
+
+            if (edgeSet.contains(getEdgeKey(to, from))) {
+                continue;
+            }
+
+            Vec3 edge = positionList[to] - positionList[from];
+
+            float length = glm::length(edge);
+            if (length <= 0.0f) {
+                continue;
+            }
+
+            Vec3 edgeNormal = glm::normalize(glm::cross(edge, normal));
+
+            bool isSeam = (kindList[from] == VertexKind::Seam or kindList[to] == VertexKind::Seam);
+            float weight = length * length * (isSeam ? SeamEdgeWeight : BorderEdgeWeight);
+
+            Quadric edgeQuadric = getPlaneQuadric(edgeNormal, -glm::dot(edgeNormal, positionList[from]), weight);
+
+            addQuadric(quadricList[remapList[from]], edgeQuadric);
+            addQuadric(quadricList[remapList[to]], edgeQuadric);
+        }
+    }
+
+    /// Collapses
+
+    List<uint32_t> adjacencyOffsetList(vertexCount + 1);
+    List<uint32_t> adjacencyList;
+
+    List<Collapse> collapseList;
+
+    List<uint8_t> lockedList(vertexCount);
+
+    float maxErrorSquared = maxError * maxError;
+    float resultErrorSquared = 0.0f;
+
+    auto isDegenerate = [&](size_t triangle) {
+        uint32_t r0 = remapList[indexList[triangle * 3 + 0]];
+        uint32_t r1 = remapList[indexList[triangle * 3 + 1]];
+        uint32_t r2 = remapList[indexList[triangle * 3 + 2]];
+        return (r0 == r1 or r1 == r2 or r2 == r0);
+    };
+
+    // Moving a vertex must not turn any of the triangles that remain around it inside out
+    auto hasFlip = [&](uint32_t from, uint32_t to) {
+        uint32_t fromRemap = remapList[from];
+        uint32_t toRemap = remapList[to];
+
+        const Vec3& target = positionList[toRemap];
+
+        for (uint32_t a = adjacencyOffsetList[fromRemap]; a < adjacencyOffsetList[fromRemap + 1]; ++a) {
+            size_t triangle = adjacencyList[a];
+
+            if (isDegenerate(triangle)) {
+                continue;
+            }
+
+            uint32_t corner[3];
+            for (size_t k = 0; k < 3; ++k) {
+                corner[k] = remapList[indexList[triangle * 3 + k]];
+            }
+
+            if (corner[0] == toRemap or corner[1] == toRemap or corner[2] == toRemap) {
+                continue;
+            }
+
+            size_t k = (corner[0] == fromRemap ? 0 : (corner[1] == fromRemap ? 1 : 2));
+
+            const Vec3& p0 = positionList[corner[k]];
+            const Vec3& p1 = positionList[corner[(k + 1) % 3]];
+            const Vec3& p2 = positionList[corner[(k + 2) % 3]];
+
+            Vec3 before = glm::cross(p1 - p0, p2 - p0);
+            Vec3 after = glm::cross(p1 - target, p2 - target);
+
+            if (glm::dot(before, after) <= 1e-2f * glm::length(before) * glm::length(after)) {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    // Seam and border collapses must follow the open edge, so the other side of a seam can follow
+    auto isOpenEdge = [&](uint32_t from, uint32_t to) {
+        return (openOutList[from] == to or openInList[from] == to);
+    };
+
+    // Move the open edges that ended at a collapsed vertex over to the vertex it collapsed onto
+    auto moveOpenEdges = [&](uint32_t from, uint32_t to) {
+        if (openOutList[from] == to) {
+            uint32_t previous = openInList[from];
+            if (isSingleEdge(previous) and openOutList[previous] == from) {
+                openOutList[previous] = to;
+                openInList[to] = previous;
+            }
+        }
+        else {
+            uint32_t next = openOutList[from];
+            if (isSingleEdge(next) and openInList[next] == from) {
+                openInList[next] = to;
+                openOutList[to] = next;
+            }
+        }
+    };
+
+    while (indexList.size() > targetIndexCount) {
+        size_t triangleCount = indexList.size() / 3;
+
+        // Triangles around each welded vertex
+        std::fill(adjacencyOffsetList.begin(), adjacencyOffsetList.end(), 0);
+
+        for (uint32_t index : indexList) {
+            ++adjacencyOffsetList[remapList[index] + 1];
+        }
+
+        for (size_t i = 0; i < vertexCount; ++i) {
+            adjacencyOffsetList[i + 1] += adjacencyOffsetList[i];
+        }
+
+        adjacencyList.resize(indexList.size());
+
+        {
+            List<uint32_t> fillList(adjacencyOffsetList.begin(), adjacencyOffsetList.end() - 1);
+
+            for (size_t i = 0; i < indexList.size(); ++i) {
+                adjacencyList[fillList[remapList[indexList[i]]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        // Every direction of every edge that is allowed to collapse, cheapest first
+        collapseList.clear();
+
+        for (size_t i = 0; i < indexList.size(); i += 3) {
+            for (size_t e = 0; e < 3; ++e) {
+                uint32_t a = indexList[i + e];
+                uint32_t b = indexList[i + (e + 1) % 3];
+
+                for (auto[from, to] : { std::pair(a, b), std::pair(b, a) }) {
+                    VertexKind fromKind = kindList[from];
+                    VertexKind toKind = kindList[to];
+
+                    if (not CanCollapse[size_t(fromKind)][size_t(toKind)]) {
+                        continue;
+                    }
+
+                    if (fromKind != VertexKind::Manifold and not isOpenEdge(from, to)) {
+                        continue;
+                    }
+
+                    Quadric quadric = quadricList[remapList[from]];
+                    addQuadric(quadric, quadricList[remapList[to]]);
+
+                    collapseList.push_back(Collapse{
+                        .From = from,
+                        .To = to,
+                        .Error = getQuadricError(quadric, positionList[to]),
+                    });
+                }
+            }
+        }
+
+        std::sort(collapseList.begin(), collapseList.end(), [](const Collapse& a, const Collapse& b) {
+            return a.Error < b.Error;
+        });
+
+        // Most collapses remove two triangles, stopping halfway keeps from overshooting the target
+        size_t collapseGoal = std::max<size_t>(1, (triangleCount - targetIndexCount / 3 + 1) / 2);
+        size_t collapseCount = 0;
+
+        // Collapses are skipped when their vertices have already moved in this pass, but that must not
+        // lead to taking ones that are much worse than the goal, they may be cheaper in the next pass
+        float passErrorLimit = maxErrorSquared;
+        if (collapseGoal < collapseList.size()) {
+            passErrorLimit = std::min(passErrorLimit, collapseList[collapseGoal].Error * 1.5f);
+        }
+
+        std::fill(lockedList.begin(), lockedList.end(), 0);
+
+        for (const auto& collapse : collapseList) {
+            if (collapseCount >= collapseGoal or collapse.Error > passErrorLimit) {
+                break;
+            }
+
+            uint32_t from = collapse.From;
+            uint32_t to = collapse.To;
+
+            uint32_t fromRemap = remapList[from];
+            uint32_t toRemap = remapList[to];
+
+            // Vertices already moved in this pass have stale adjacency
+            if (lockedList[fromRemap] or lockedList[toRemap]) {
+                continue;
+            }
+
+            // The other wedge of a seam collapses onto the other wedge across the same edge
+            uint32_t sibling = wedgeList[from];
+            uint32_t siblingTo = to;
+
+            if (kindList[from] == VertexKind::Seam) {
+                siblingTo = (openOutList[from] == to ? openInList[sibling] : openOutList[sibling]);
+
+                if (not isSingleEdge(siblingTo) or remapList[siblingTo] != toRemap) {
+                    continue;
+                }
+            }
+
+            if (hasFlip(from, to)) {
+                continue;
+            }
+
+            for (uint32_t a = adjacencyOffsetList[fromRemap]; a < adjacencyOffsetList[fromRemap + 1]; ++a) {
+                size_t triangle = adjacencyList[a];
+
+                for (size_t k = 0; k < 3; ++k) {
+                    uint32_t& index = indexList[triangle * 3 + k];
+
+                    if (remapList[index] == fromRemap) {
+                        index = (index == from ? to : siblingTo);
+                    }
+                }
+            }
+
+            if (kindList[from] == VertexKind::Border) {
+                moveOpenEdges(from, to);
+            }
+            else if (kindList[from] == VertexKind::Seam) {
+                moveOpenEdges(from, to);
+                moveOpenEdges(sibling, siblingTo);
+            }
+
+            addQuadric(quadricList[toRemap], quadricList[fromRemap]);
+
+            lockedList[fromRemap] = 1;
+            lockedList[toRemap] = 1;
+
+            resultErrorSquared = std::max(resultErrorSquared, collapse.Error);
+
+            ++collapseCount;
+        }
+
+        if (collapseCount == 0) {
+            break;
+        }
+
+        size_t writeIndex = 0;
+
+        for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+            if (isDegenerate(triangle)) {
+                continue;
+            }
+
+            for (size_t k = 0; k < 3; ++k) {
+                indexList[writeIndex++] = indexList[triangle * 3 + k];
+            }
+        }
+
+        indexList.resize(writeIndex);
+    }
+
+    return MeshLOD{
+        .IndexList = std::move(indexList),
+        .Error = std::sqrt(resultErrorSquared) * extent,
+    };
+}
+
+RYME_API
+MeshLOD MeshData::Simplify(float targetRatio, float maxError /*= 1.0f*/) const
+{
+    if (PrimitiveTopology != vk::PrimitiveTopology::eTriangleList) {
+        return MeshLOD{ .IndexList = IndexList };
+    }
+
+    List<uint32_t> indexList = IndexList;
+
+    // Without indices every triangle has its own vertices, and nothing can collapse
+    if (indexList.empty()) {
+        indexList.resize(VertexList.size());
+        for (uint32_t i = 0; i < indexList.size(); ++i) {
+            indexList[i] = i;
+        }
+    }
+
+    size_t targetIndexCount = static_cast<size_t>(indexList.size() / 3 * targetRatio) * 3;
+
+    return simplify(VertexList, indexList, targetIndexCount, maxError);
+}
+
+RYME_API
+void MeshData::GenerateLODs(const List<float>& ratioList /*= { 0.5f, 0.25f, 0.125f }*/, float maxError /*= 1.0f*/)
+{
+    RYME_PROFILE_FUNCTION();
+
+    LODList.clear();
+
+    if (PrimitiveTopology != vk::PrimitiveTopology::eTriangleList) {
+        return;
+    }
+
+    GenerateIndexList();
+
+    const size_t triangleCount = IndexList.size() / 3;
+
+    for (float ratio : ratioList) {
+        const List<uint32_t>& sourceIndexList = (LODList.empty() ? IndexList : LODList.back().IndexList);
+        float sourceError = (LODList.empty() ? 0.0f : LODList.back().Error);
+
+        size_t targetIndexCount = static_cast<size_t>(triangleCount * ratio) * 3;
+        if (targetIndexCount >= sourceIndexList.size()) {
+            continue;
+        }
+
+        MeshLOD lod = simplify(VertexList, sourceIndexList, targetIndexCount, maxError);
+
+        if (lod.IndexList.size() > sourceIndexList.size() / 10 * 9) {
+            break;
+        }
+
+        // Each LOD is measured against the one it was simplified from, so the errors add up
+        lod.Error += sourceError;
+
+        LODList.push_back(std::move(lod));
+    }
+}
+
+} // namespace ryme
\ No newline at end of file
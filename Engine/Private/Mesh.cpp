@@ -1,12 +1,24 @@
 #include <Ryme/Mesh.hpp>
 
+#include <cstring>
+#include <unordered_map>
+
 namespace ryme {
 
 RYME_API
 Mesh::Mesh(MeshData&& data)
-    : _count(data.VertexList.size())
-    , _primitiveTopology(data.PrimitiveTopology)
+    : _primitiveTopology(data.PrimitiveTopology)
 {
+    if (not data.VertexList.empty()) {
+        _boundsMin = Vec3(data.VertexList[0].Position);
+        _boundsMax = Vec3(data.VertexList[0].Position);
+
+        for (const auto& vertex : data.VertexList) {
+            _boundsMin = glm::min(_boundsMin, Vec3(vertex.Position));
+            _boundsMax = glm::max(_boundsMax, Vec3(vertex.Position));
+        }
+    }
+
     _vertexBuffer.Create(
         data.VertexList.size() * sizeof(Vertex),
         reinterpret_cast<uint8_t *>(data.VertexList.data()),
@@ -14,21 +26,60 @@ Mesh::Mesh(MeshData&& data)
         VMA_MEMORY_USAGE_GPU_ONLY
     );
 
-    if (not data.IndexList.empty()) {
-        _indexed = true;
-        _count = data.IndexList.size();
+    if (data.IndexList.empty()) {
+        _lodList.push_back(LOD{
+            .FirstIndex = 0,
+            .Count = static_cast<uint32_t>(data.VertexList.size()),
+            .Error = 0.0f,
+        });
+
+        return;
+    }
+
+    _indexed = true;
+
+    _lodList.push_back(LOD{
+        .FirstIndex = 0,
+        .Count = static_cast<uint32_t>(data.IndexList.size()),
+        .Error = 0.0f,
+    });
 
-        _indexBuffer.Create(
-            data.IndexList.size() * sizeof(uint32_t),
-            reinterpret_cast<uint8_t *>(data.IndexList.data()),
-            vk::BufferUsageFlagBits::eIndexBuffer,
-            VMA_MEMORY_USAGE_GPU_ONLY
-        );
+    // Every LOD shares the vertex buffer, and is stored after the full detail indices in one index buffer
+    for (auto& lod : data.LODList) {
+        _lodList.push_back(LOD{
+            .FirstIndex = static_cast<uint32_t>(data.IndexList.size()),
+            .Count = static_cast<uint32_t>(lod.IndexList.size()),
+            .Error = lod.Error,
+        });
+
+        data.IndexList.insert(data.IndexList.end(), lod.IndexList.begin(), lod.IndexList.end());
     }
+
+    _indexBuffer.Create(
+        data.IndexList.size() * sizeof(uint32_t),
+        reinterpret_cast<uint8_t *>(data.IndexList.data()),
+        vk::BufferUsageFlagBits::eIndexBuffer,
+        VMA_MEMORY_USAGE_GPU_ONLY
+    );
 }
 
 RYME_API
-void Mesh::GenerateCommands(vk::CommandBuffer buffer)
+void Mesh::GenerateCommands(vk::CommandBuffer buffer, uint32_t lod /*= 0*/)
+{
+    const auto& range = _lodList[std::min(lod, GetLODCount() - 1)];
+
+    Bind(buffer);
+
+    if (_indexed) {
+        buffer.drawIndexed(range.Count, 1, range.FirstIndex, 0, 0);
+    }
+    else {
+        buffer.draw(range.Count, 1, 0, 0);
+    }
+}
+
+RYME_API
+void Mesh::Bind(vk::CommandBuffer buffer)
 {
     if (_indexed) {
         buffer.bindIndexBuffer(_indexBuffer.GetVkBuffer(), 0, vk::IndexType::eUint32);
@@ -40,13 +91,16 @@ void Mesh::GenerateCommands(vk::CommandBuffer buffer)
     vk::Buffer buffers[] = { _vertexBuffer.GetVkBuffer() };
     vk::DeviceSize offsets[] = { 0 };
     buffer.bindVertexBuffers(0, buffers, offsets);
+}
 
-    if (_indexed) {
-        buffer.drawIndexed(_count, 1, 0, 0, 0);
-    }
-    else {
-        buffer.draw(_count, 1, 0, 0);
+RYME_API
+uint32_t Mesh::GetTriangleCount(uint32_t lod /*= 0*/) const
+{
+    if (_primitiveTopology != vk::PrimitiveTopology::eTriangleList) {
+        return 0;
     }
+
+    return _lodList[std::min(lod, GetLODCount() - 1)].Count / 3;
 }
 
 RYME_API
@@ -101,4 +155,52 @@ void MeshData::CalculateTangents()
     }
 }
 
+RYME_API
+void MeshData::GenerateIndexList()
+{
+    if (not IndexList.empty()) {
+        return;
+    }
+
+    struct VertexHash
+    {
+        size_t operator()(const Vertex& vertex) const {
+            const uint32_t * words = reinterpret_cast<const uint32_t *>(&vertex);
+
+            size_t hash = 0;
+            for (size_t i = 0; i < sizeof(Vertex) / sizeof(uint32_t); ++i) {
+                hash = hash * 31 + words[i];
+            }
+
+            return hash;
+        }
+    };
+
+    struct VertexEqual
+    {
+        bool operator()(const Vertex& a, const Vertex& b) const {
+            return (memcmp(&a, &b, sizeof(Vertex)) == 0);
+        }
+    };
+
+    std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual> indexMap;
+    indexMap.reserve(VertexList.size());
+
+    List<Vertex> vertexList;
+    vertexList.reserve(VertexList.size());
+
+    IndexList.reserve(VertexList.size());
+
+    for (const auto& vertex : VertexList) {
+        auto[it, inserted] = indexMap.emplace(vertex, static_cast<uint32_t>(vertexList.size()));
+        if (inserted) {
+            vertexList.push_back(vertex);
+        }
+
+        IndexList.push_back(it->second);
+    }
+
+    VertexList = std::move(vertexList);
+}
+
 } // namespace ryme
\ No newline at end of file
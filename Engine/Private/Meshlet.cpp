@@ -0,0 +1,119 @@
+#include <Ryme/Meshlet.hpp>
+#include <Ryme/Profiler.hpp>
+
+namespace ryme {
+
+enum class MeshletVisibility
+{
+    Visible,
+    FrustumCulled,
+    ConeCulled,
+
+}; // enum class MeshletVisibility
+
+MeshletVisibility getMeshletVisibility(const MeshletBounds& bounds, const Frustum& frustum, const Vec3& cameraPosition)
+{
+    if (not frustum.IntersectsSphere(bounds.Center, bounds.Radius)) {
+        return MeshletVisibility::FrustumCulled;
+    }
+
+    // Inside the cone, every triangle is facing away from the camera
+    Vec3 direction = bounds.ConeApex - cameraPosition;
+
+    float length = glm::length(direction);
+    if (length > 0.0f and glm::dot(direction / length, bounds.ConeAxis) >= bounds.ConeCutoff) {
+        return MeshletVisibility::ConeCulled;
+    }
+
+    return MeshletVisibility::Visible;
+}
+
+// Call visibleFunc with each meshlet that survives culling, in order
+template <class VisibleFunc>
+MeshletCullStats cullMeshlets(
+    const MeshletData& meshletData,
+    const Frustum& frustum,
+    const Vec3& cameraPosition,
+    VisibleFunc visibleFunc
+)
+{
+    MeshletCullStats stats;
+    stats.MeshletCount = meshletData.MeshletList.size();
+
+    for (size_t i = 0; i < meshletData.MeshletList.size(); ++i) {
+        const auto& meshlet = meshletData.MeshletList[i];
+
+        switch (getMeshletVisibility(meshletData.BoundsList[i], frustum, cameraPosition)) {
+        case MeshletVisibility::Visible:
+            stats.VisibleTriangleCount += meshlet.IndexCount / 3;
+            visibleFunc(meshlet);
+            break;
+        case MeshletVisibility::FrustumCulled:
+            ++stats.FrustumCulledCount;
+            break;
+        case MeshletVisibility::ConeCulled:
+            ++stats.ConeCulledCount;
+            break;
+        }
+    }
+
+    return stats;
+}
+
+RYME_API
+bool IsMeshletVisible(const MeshletBounds& bounds, const Frustum& frustum, const Vec3& cameraPosition)
+{
+    return (getMeshletVisibility(bounds, frustum, cameraPosition) == MeshletVisibility::Visible);
+}
+
+RYME_API
+MeshletCullStats CullMeshlets(
+    const MeshletData& meshletData,
+    const Frustum& frustum,
+    const Vec3& cameraPosition,
+    List<vk::DrawIndexedIndirectCommand>& drawList
+)
+{
+    RYME_PROFILE_FUNCTION();
+
+    drawList.clear();
+
+    return cullMeshlets(meshletData, frustum, cameraPosition, [&](const Meshlet& meshlet) {
+        if (not drawList.empty()) {
+            auto& draw = drawList.back();
+            if (draw.firstIndex + draw.indexCount == meshlet.FirstIndex) {
+                draw.indexCount += meshlet.IndexCount;
+                return;
+            }
+        }
+
+        drawList.push_back(vk::DrawIndexedIndirectCommand()
+            .setIndexCount(meshlet.IndexCount)
+            .setInstanceCount(1)
+            .setFirstIndex(meshlet.FirstIndex)
+            .setVertexOffset(0)
+            .setFirstInstance(0)
+        );
+    });
+}
+
+RYME_API
+MeshletCullStats CullMeshlets(
+    const MeshletData& meshletData,
+    Span<const uint32_t> indexList,
+    const Frustum& frustum,
+    const Vec3& cameraPosition,
+    List<uint32_t>& visibleIndexList
+)
+{
+    RYME_PROFILE_FUNCTION();
+
+    visibleIndexList.clear();
+
+    return cullMeshlets(meshletData, frustum, cameraPosition, [&](const Meshlet& meshlet) {
+        auto first = indexList.begin() + meshlet.FirstIndex;
+        visibleIndexList.insert(visibleIndexList.end(), first, first + meshlet.IndexCount);
+    });
+}
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include <Ryme/MeshletCuller.hpp>
+#include <Ryme/Exception.hpp>
+#include <Ryme/Graphics.hpp>
+#include <Ryme/Profiler.hpp>
+
+namespace ryme {
+
+const uint32_t MeshletCullGroupSize = 64;
+
+const vk::DeviceSize DrawStride = sizeof(vk::DrawIndexedIndirectCommand);
+
+RYME_API
+MeshletCuller::~MeshletCuller()
+{
+    Destroy();
+}
+
+RYME_API
+void MeshletCuller::Create(const MeshletData& meshletData)
+{
+    RYME_PROFILE_FUNCTION();
+
+    Destroy();
+
+    _meshletCount = static_cast<uint32_t>(meshletData.MeshletList.size());
+
+    if (_meshletCount == 0) {
+        return;
+    }
+
+    // Only ever read by the GPU, but kept mapped so the Defragmenter never moves them out from under
+    // the descriptor set
+    _meshletBuffer.Create(
+        _meshletCount * sizeof(Meshlet),
+        reinterpret_cast<uint8_t *>(const_cast<Meshlet *>(meshletData.MeshletList.data())),
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        VMA_MEMORY_USAGE_CPU_TO_GPU
+    );
+
+    _boundsBuffer.Create(
+        _meshletCount * sizeof(MeshletBounds),
+        reinterpret_cast<uint8_t *>(const_cast<MeshletBounds *>(meshletData.BoundsList.data())),
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        VMA_MEMORY_USAGE_CPU_TO_GPU
+    );
+
+    auto allocationCreateInfo = VmaAllocationCreateInfo{
+        .usage = VMA_MEMORY_USAGE_GPU_ONLY,
+    };
+
+    auto drawBufferCreateInfo = vk::BufferCreateInfo()
+        .setSize(_meshletCount * DrawStride)
+        .setUsage(
+            vk::BufferUsageFlagBits::eStorageBuffer |
+            vk::BufferUsageFlagBits::eIndirectBuffer |
+            vk::BufferUsageFlagBits::eTransferDst
+        );
+
+    std::tie(_drawBuffer, _drawAllocation) = Graphics::CreateBuffer(
+        drawBufferCreateInfo,
+        allocationCreateInfo
+    );
+
+    auto drawCountBufferCreateInfo = vk::BufferCreateInfo()
+        .setSize(sizeof(uint32_t))
+        .setUsage(
+            vk::BufferUsageFlagBits::eStorageBuffer |
+            vk::BufferUsageFlagBits::eIndirectBuffer |
+            vk::BufferUsageFlagBits::eTransferDst
+        );
+
+    std::tie(_drawCountBuffer, _drawCountAllocation) = Graphics::CreateBuffer(
+        drawCountBufferCreateInfo,
+        allocationCreateInfo
+    );
+
+    createPipeline();
+    createDescriptorSet();
+}
+
+RYME_API
+void MeshletCuller::Destroy()
+{
+    _meshletCount = 0;
+
+    _meshletBuffer.Destroy();
+    _boundsBuffer.Destroy();
+
+    if (_drawBuffer) {
+        Graphics::InvalidateCommandBuffers();
+
+        Graphics::DeferDestroy(
+            [
+                drawBuffer = _drawBuffer,
+                drawAllocation = _drawAllocation,
+                drawCountBuffer = _drawCountBuffer,
+                drawCountAllocation = _drawCountAllocation,
+                pipeline = _pipeline,
+                descriptorPool = _descriptorPool
+            ]() {
+                Graphics::Device.destroyBuffer(drawBuffer);
+                Graphics::FreeMemory(drawAllocation);
+
+                Graphics::Device.destroyBuffer(drawCountBuffer);
+                Graphics::FreeMemory(drawCountAllocation);
+
+                Graphics::Device.destroyPipeline(pipeline);
+
+                // Frees the descriptor set as well
+                Graphics::Device.destroyDescriptorPool(descriptorPool);
+            }
+        );
+    }
+
+    _drawBuffer = nullptr;
+    _drawAllocation = nullptr;
+    _drawCountBuffer = nullptr;
+    _drawCountAllocation = nullptr;
+    _pipeline = nullptr;
+    _descriptorPool = nullptr;
+    _descriptorSet = nullptr;
+
+    _shader.Free();
+}
+
+RYME_API
+void MeshletCuller::SetView(const Frustum& frustum, const Vec3& cameraPosition)
+{
+    if (frustum.PlaneList == _frustum.PlaneList and cameraPosition == _cameraPosition) {
+        return;
+    }
+
+    _frustum = frustum;
+    _cameraPosition = cameraPosition;
+
+    // The command buffers are pre-recorded, and would keep culling against the old view
+    Graphics::InvalidateCommandBuffers();
+}
+
+RYME_API
+void MeshletCuller::Cull(vk::CommandBuffer buffer)
+{
+    if (_meshletCount == 0) {
+        return;
+    }
+
+    // The previous draws must have been read before they are overwritten
+    buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eDrawIndirect,
+        vk::PipelineStageFlagBits::eTransfer,
+        {}, {}, {}, {}
+    );
+
+    buffer.fillBuffer(_drawCountBuffer, 0, VK_WHOLE_SIZE, 0);
+
+    // Without a draw count, every slot is drawn, so the ones past the end must have no instances
+    if (not Graphics::IsDrawIndirectCountSupported()) {
+        buffer.fillBuffer(_drawBuffer, 0, VK_WHOLE_SIZE, 0);
+    }
+
+    auto clearBarrier = vk::MemoryBarrier()
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+
+    buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eComputeShader,
+        {}, clearBarrier, {}, {}
+    );
+
+    PushConstants pushConstants = {
+        .FrustumPlanes = _frustum.PlaneList,
+        .CameraPosition = _cameraPosition,
+        .MeshletCount = _meshletCount,
+    };
+
+    buffer.bindPipeline(vk::PipelineBindPoint::eCompute, _pipeline);
+
+    buffer.bindDescriptorSets(
+        vk::PipelineBindPoint::eCompute,
+        _shader.GetPipelineLayout(),
+        0, _descriptorSet, {}
+    );
+
+    buffer.pushConstants(
+        _shader.GetPipelineLayout(),
+        vk::ShaderStageFlagBits::eCompute,
+        0, sizeof(PushConstants), &pushConstants
+    );
+
+    buffer.dispatch((_meshletCount + MeshletCullGroupSize - 1) / MeshletCullGroupSize, 1, 1);
+
+    auto cullBarrier = vk::MemoryBarrier()
+        .setSrcAccessMask(vk::AccessFlagBits::eShaderWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eIndirectCommandRead);
+
+    buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eComputeShader,
+        vk::PipelineStageFlagBits::eDrawIndirect,
+        {}, cullBarrier, {}, {}
+    );
+}
+
+RYME_API
+void MeshletCuller::Draw(vk::CommandBuffer buffer)
+{
+    if (_meshletCount == 0) {
+        return;
+    }
+
+    if (Graphics::IsDrawIndirectCountSupported()) {
+        buffer.drawIndexedIndirectCount(_drawBuffer, 0, _drawCountBuffer, 0, _meshletCount, DrawStride);
+    }
+    else if (Graphics::IsMultiDrawIndirectSupported()) {
+        buffer.drawIndexedIndirect(_drawBuffer, 0, _meshletCount, DrawStride);
+    }
+    else {
+        for (uint32_t i = 0; i < _meshletCount; ++i) {
+            buffer.drawIndexedIndirect(_drawBuffer, i * DrawStride, 1, DrawStride);
+        }
+    }
+}
+
+void MeshletCuller::createPipeline()
+{
+    if (not _shader.LoadFromFiles({ "Ryme/MeshletCull.comp" })) {
+        throw Exception("Failed to load 'Ryme/MeshletCull.comp'");
+    }
+
+    auto pipelineCreateInfo = vk::ComputePipelineCreateInfo()
+        .setStage(_shader.GetShaderStageList().front())
+        .setLayout(_shader.GetPipelineLayout());
+
+    vk::Result vkResult;
+    std::tie(vkResult, _pipeline) = Graphics::Device.createComputePipeline(nullptr, pipelineCreateInfo);
+
+    vk::resultCheck(vkResult, "vk::Device::createComputePipeline",
+        { vk::Result::eSuccess, vk::Result::ePipelineCompileRequired }
+    );
+}
+
+void MeshletCuller::createDescriptorSet()
+{
+    auto poolSize = vk::DescriptorPoolSize()
+        .setType(vk::DescriptorType::eStorageBuffer)
+        .setDescriptorCount(4);
+
+    auto descriptorPoolCreateInfo = vk::DescriptorPoolCreateInfo()
+        .setMaxSets(1)
+        .setPoolSizes(poolSize);
+
+    _descriptorPool = Graphics::Device.createDescriptorPool(descriptorPoolCreateInfo);
+
+    auto descriptorSetAllocateInfo = vk::DescriptorSetAllocateInfo()
+        .setDescriptorPool(_descriptorPool)
+        .setSetLayouts(_shader.GetDescriptorSetLayoutList().front());
+
+    _descriptorSet = Graphics::Device.allocateDescriptorSets(descriptorSetAllocateInfo).front();
+
+    Array<vk::DescriptorBufferInfo, 4> bufferInfoList = {
+        vk::DescriptorBufferInfo(_meshletBuffer.GetVkBuffer(), 0, VK_WHOLE_SIZE),
+        vk::DescriptorBufferInfo(_boundsBuffer.GetVkBuffer(), 0, VK_WHOLE_SIZE),
+        vk::DescriptorBufferInfo(_drawBuffer, 0, VK_WHOLE_SIZE),
+        vk::DescriptorBufferInfo(_drawCountBuffer, 0, VK_WHOLE_SIZE),
+    };
+
+    List<vk::WriteDescriptorSet> writeList;
+
+    for (uint32_t binding = 0; binding < bufferInfoList.size(); ++binding) {
+        writeList.push_back(
+            vk::WriteDescriptorSet()
+                .setDstSet(_descriptorSet)
+                .setDstBinding(binding)
+                .setDescriptorType(vk::DescriptorType::eStorageBuffer)
+                .setBufferInfo(bufferInfoList[binding])
+        );
+    }
+
+    Graphics::Device.updateDescriptorSets(writeList, {});
+}
+
+} // namespace ryme
\ No newline at end of file
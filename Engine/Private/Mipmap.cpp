@@ -0,0 +1,128 @@
+#include <Ryme/Mipmap.hpp>
+
+#include <algorithm>
+#include <bit>
+
+#if defined(RYME_SIMD_SSE2)
+    #include <emmintrin.h>
+#elif defined(RYME_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace ryme {
+
+// Rounds up, to match _mm_avg_epu8 and vrhaddq_u8
+inline uint8_t average(uint8_t a, uint8_t b)
+{
+    return static_cast<uint8_t>((a + b + 1) >> 1);
+}
+
+RYME_API
+uint32_t GetMipLevelCount(uint32_t width, uint32_t height)
+{
+    return static_cast<uint32_t>(std::bit_width(std::max({ width, height, 1u })));
+}
+
+RYME_API
+List<MipLevel> GetMipLevelList(uint32_t width, uint32_t height, uint32_t bytesPerTexel)
+{
+    uint32_t mipLevels = GetMipLevelCount(width, height);
+
+    List<MipLevel> mipLevelList;
+    mipLevelList.reserve(mipLevels);
+
+    size_t offset = 0;
+
+    for (uint32_t level = 0; level < mipLevels; ++level) {
+        size_t size = size_t(width) * size_t(height) * bytesPerTexel;
+
+        mipLevelList.push_back(MipLevel{
+            .Width = width,
+            .Height = height,
+            .Offset = offset,
+            .Size = size,
+        });
+
+        offset += size;
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+
+    return mipLevelList;
+}
+
+RYME_API
+void DownsampleRGBA8(const uint8_t * src, uint32_t width, uint32_t height, uint8_t * dst)
+{
+    uint32_t dstWidth = std::max(width / 2, 1u);
+    uint32_t dstHeight = std::max(height / 2, 1u);
+
+    size_t srcPitch = size_t(width) * 4;
+    size_t dstPitch = size_t(dstWidth) * 4;
+
+    // Each SIMD iteration reads 8 source pixels to write 4, the rest are handled one at a time
+    uint32_t simdWidth = 0;
+
+    #if defined(RYME_SIMD_SSE2) or defined(RYME_SIMD_NEON)
+
+        simdWidth = (width / 8) * 4;
+
+    #endif
+
+    for (uint32_t y = 0; y < dstHeight; ++y) {
+        const uint8_t * row0 = src + srcPitch * std::min(y * 2, height - 1);
+        const uint8_t * row1 = src + srcPitch * std::min(y * 2 + 1, height - 1);
+        uint8_t * dstRow = dst + dstPitch * y;
+
+        uint32_t x = 0;
+
+        #if defined(RYME_SIMD_SSE2)
+
+            for (; x < simdWidth; x += 4) {
+                __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 8));
+                __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 8 + 16));
+                __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 8));
+                __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 8 + 16));
+
+                // Average vertically, then split the pixels into even and odd to average horizontally
+                __m128 v0 = _mm_castsi128_ps(_mm_avg_epu8(a0, b0));
+                __m128 v1 = _mm_castsi128_ps(_mm_avg_epu8(a1, b1));
+
+                __m128i even = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+                __m128i odd = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dstRow + x * 4), _mm_avg_epu8(even, odd));
+            }
+
+        #elif defined(RYME_SIMD_NEON)
+
+            for (; x < simdWidth; x += 4) {
+                // Loading as 32-bit pairs splits the pixels into even and odd
+                uint32x4x2_t a = vld2q_u32(reinterpret_cast<const uint32_t *>(row0 + x * 8));
+                uint32x4x2_t b = vld2q_u32(reinterpret_cast<const uint32_t *>(row1 + x * 8));
+
+                uint8x16_t even = vrhaddq_u8(vreinterpretq_u8_u32(a.val[0]), vreinterpretq_u8_u32(b.val[0]));
+                uint8x16_t odd = vrhaddq_u8(vreinterpretq_u8_u32(a.val[1]), vreinterpretq_u8_u32(b.val[1]));
+
+                vst1q_u8(dstRow + x * 4, vrhaddq_u8(even, odd));
+            }
+
+        #endif
+
+        for (; x < dstWidth; ++x) {
+            const uint8_t * even0 = row0 + size_t(std::min(x * 2, width - 1)) * 4;
+            const uint8_t * even1 = row1 + size_t(std::min(x * 2, width - 1)) * 4;
+            const uint8_t * odd0 = row0 + size_t(std::min(x * 2 + 1, width - 1)) * 4;
+            const uint8_t * odd1 = row1 + size_t(std::min(x * 2 + 1, width - 1)) * 4;
+
+            for (unsigned c = 0; c < 4; ++c) {
+                dstRow[x * 4 + c] = average(
+                    average(even0[c], even1[c]),
+                    average(odd0[c], odd1[c])
+                );
+            }
+        }
+    }
+}
+
+} // namespace ryme
\ No newline at end of file
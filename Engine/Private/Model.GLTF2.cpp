@@ -1,12 +0,0 @@
-#include <Ryme/Model.hpp>
-#include <Ryme/Exception.hpp>
-
-namespace ryme {
-
-RYME_API
-bool Model::LoadGLTF2(const Path& path, bool search)
-{
-    return true;
-}
-
-} // namespace ryme
\ No newline at end of file
@@ -1,8 +1,13 @@
 #include <Ryme/Model.hpp>
 #include <Ryme/Exception.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/ModelData.hpp>
+#include <Ryme/VFS.hpp>
 
 namespace ryme {
 
+List<float> _lodRatioList = { 0.5f, 0.25f, 0.125f };
+
 RYME_API
 Model::Model(const Path& path, bool search /*= true*/)
 {
@@ -18,24 +23,55 @@ Model::~Model()
 RYME_API
 bool Model::LoadFromFile(const Path& path, bool search /*= true*/)
 {
-    const Path& ext = path.GetExtension();
+    Free();
 
-    if (ext == "obj") {
-        _isLoaded = LoadOBJ(path, search);
-    }
-    else if (ext == "gltf" or ext == "glb") {
-        _isLoaded = LoadGLTF2(path, search);
+    // Prefer the mesh cooked by RymeCook, which is already indexed and has its LODs
+    Path loadPath = (search ? VFS::GetCookedPath(path, "rmesh") : path);
+
+    VFS::File file = VFS::Open(loadPath, search);
+    if (not file.IsOpen()) {
+        return false;
     }
-    else {
-        throw Exception("Unknown Model file format '{}'", ext);
+
+    _path = file.GetPath();
+
+    ModelData modelData;
+    _isLoaded = LoadModelData(file.GetSpan(), _path, modelData);
+
+    for (auto& meshData : modelData.MeshList) {
+        if (meshData.LODList.empty() and not GetLODRatioList().empty()) {
+            meshData.GenerateLODs(GetLODRatioList());
+
+            for (const auto& lod : meshData.LODList) {
+                Log(RYME_ANCHOR, "Generated LOD with {} of {} triangles, error {}",
+                    lod.IndexList.size() / 3,
+                    meshData.IndexList.size() / 3,
+                    lod.Error
+                );
+            }
+        }
+
+        _occluderMesh.Append(meshData);
+        _triangleBVHList.emplace_back(meshData);
+
+        _meshList.emplace_back(std::move(meshData));
     }
 
+    CalculateLODs();
+
     return _isLoaded;
 }
 
 RYME_API
 void Model::Free()
 {
+    // The Mesh Buffers defer their destruction until the GPU is no longer using them, and have the
+    // frame command buffers recorded again without them
+    _meshList.clear();
+    _lodErrorList.clear();
+    _occluderMesh = {};
+    _triangleBVHList.clear();
+
     _isLoaded = false;
 }
 
@@ -47,10 +83,109 @@ bool Model::Reload()
 }
 
 RYME_API
-void Model::Render(vk::CommandBuffer buffer)
+size_t Model::GetMemorySize() const
+{
+    size_t memorySize = 0;
+
+    for (const auto& mesh : _meshList) {
+        memorySize += mesh.GetMemorySize();
+    }
+
+    return memorySize;
+}
+
+RYME_API
+void Model::Render(vk::CommandBuffer buffer, uint32_t lod /*= 0*/)
 {
     for (auto& mesh : _meshList) {
-        mesh.GenerateCommands(buffer);
+        mesh.GenerateCommands(buffer, lod);
+    }
+}
+
+RYME_API
+uint32_t Model::GetTriangleCount(uint32_t lod /*= 0*/) const
+{
+    uint32_t triangleCount = 0;
+
+    for (const auto& mesh : _meshList) {
+        triangleCount += mesh.GetTriangleCount(lod);
+    }
+
+    return triangleCount;
+}
+
+RYME_API
+bool Model::Intersect(const Ray& ray, RayHit& hit) const
+{
+    bool isHit = false;
+
+    for (size_t i = 0; i < _triangleBVHList.size(); ++i) {
+        if (_triangleBVHList[i].Intersect(ray, hit)) {
+            hit.Mesh = static_cast<uint32_t>(i);
+            isHit = true;
+        }
+    }
+
+    return isHit;
+}
+
+RYME_API
+bool Model::IntersectAny(const Ray& ray) const
+{
+    for (const auto& triangleBVH : _triangleBVHList) {
+        if (triangleBVH.IntersectAny(ray)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+RYME_API
+void Model::SetLODRatioList(const List<float>& ratioList)
+{
+    _lodRatioList = ratioList;
+}
+
+RYME_API
+const List<float>& Model::GetLODRatioList()
+{
+    return _lodRatioList;
+}
+
+RYME_API
+void Model::CalculateLODs()
+{
+    _lodErrorList.clear();
+
+    if (_meshList.empty()) {
+        return;
+    }
+
+    Vec3 boundsMin = _meshList[0].GetBoundsMin();
+    Vec3 boundsMax = _meshList[0].GetBoundsMax();
+
+    uint32_t lodCount = 1;
+
+    for (const auto& mesh : _meshList) {
+        boundsMin = glm::min(boundsMin, mesh.GetBoundsMin());
+        boundsMax = glm::max(boundsMax, mesh.GetBoundsMax());
+
+        lodCount = std::max(lodCount, mesh.GetLODCount());
+    }
+
+    _boundsMin = boundsMin;
+    _boundsMax = boundsMax;
+
+    _boundingCenter = (boundsMin + boundsMax) * 0.5f;
+    _boundingRadius = glm::length(boundsMax - boundsMin) * 0.5f;
+
+    _lodErrorList.resize(lodCount, 0.0f);
+
+    for (uint32_t lod = 0; lod < lodCount; ++lod) {
+        for (const auto& mesh : _meshList) {
+            _lodErrorList[lod] = std::max(_lodErrorList[lod], mesh.GetLODError(lod));
+        }
     }
 }
 
@@ -1,18 +1,14 @@
 #include <Ryme/ModelComponent.hpp>
 #include <Ryme/Scene.hpp>
 #include <Ryme/RenderSystem.hpp>
+#include <Ryme/SpatialSystem.hpp>
 
 namespace ryme {
 
-ModelComponent::ModelComponent(Model * model)
-    : _model(model)
+ModelComponent::ModelComponent(std::shared_ptr<Model> model)
+    : _model(std::move(model))
 { }
 
-ModelComponent::~ModelComponent()
-{
-    delete _model;
-}
-
 RYME_API
 void ModelComponent::Attach(Entity * entity)
 {
@@ -24,6 +20,11 @@ void ModelComponent::Attach(Entity * entity)
         if (rs) {
             rs->AddModelComponent(this);
         }
+
+        SpatialSystem * ss = scene->GetSystem<SpatialSystem>();
+        if (ss) {
+            ss->AddModelComponent(this);
+        }
     }
 }
 
@@ -36,6 +37,11 @@ void ModelComponent::Detach()
         if (rs) {
             rs->RemoveModelComponent(this);
         }
+
+        SpatialSystem * ss = scene->GetSystem<SpatialSystem>();
+        if (ss) {
+            ss->RemoveModelComponent(this);
+        }
     }
 
 
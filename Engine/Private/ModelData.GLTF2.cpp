@@ -0,0 +1,12 @@
+#include <Ryme/ModelData.hpp>
+#include <Ryme/Exception.hpp>
+
+namespace ryme {
+
+RYME_API
+bool LoadGLTF2(Span<const uint8_t> data, const Path& path, ModelData& modelData)
+{
+    return true;
+}
+
+} // namespace ryme
\ No newline at end of file
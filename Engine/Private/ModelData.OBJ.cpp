@@ -1,16 +1,37 @@
-#include <Ryme/Model.hpp>
+#include <Ryme/ModelData.hpp>
 #include <Ryme/Exception.hpp>
 #include <Ryme/Log.hpp>
 #include <Ryme/String.hpp>
 #include <Ryme/Vertex.hpp>
 #include <Ryme/UTF.hpp>
+#include <Ryme/VFS.hpp>
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 
 namespace ryme {
 
+// Copy the next line of text into buffer, terminated so it can be parsed with sscanf()
+bool readLine(StringView& text, List<char>& buffer)
+{
+    if (text.empty()) {
+        return false;
+    }
+
+    size_t end = text.find('\n');
+    end = (end == StringView::npos ? text.size() : end + 1);
+
+    buffer.resize(std::max(buffer.size(), end + 1));
+    memcpy(buffer.data(), text.data(), end);
+    buffer[end] = '\0';
+
+    text.remove_prefix(end);
+    return true;
+}
+
 RYME_API
-bool Model::LoadOBJ(const Path& path, bool search)
+bool LoadOBJ(Span<const uint8_t> data, const Path& path, ModelData& modelData)
 {
     // https://github.com/blender/blender-addons/blob/master/io_scene_obj/export_obj.py
 
@@ -53,29 +74,6 @@ bool Model::LoadOBJ(const Path& path, bool search)
         { }
     };
 
-    FILE * objFile = nullptr;
-    Path fullPath = path;
-
-    if (search) {
-        for (const auto& assetPath : GetAssetPathList()) {
-            fullPath = assetPath / path;
-
-            objFile = fopen(fullPath.ToCString(), "rt");
-            if (objFile) {
-                break;
-            }
-        }
-    }
-    else {
-        objFile = fopen(fullPath.ToCString(), "rt");
-    }
-
-    if (not objFile) {
-        return false;
-    }
-
-    _path = fullPath;
-
     List<_Material> materialList;
     List<_Object> objectList;
 
@@ -88,7 +86,7 @@ bool Model::LoadOBJ(const Path& path, bool search)
     int objLineNumber = -1;
 
     auto objError = [&]() {
-        throw Exception("Malformed OBJ file at '{}:{}'", fullPath, objLineNumber);
+        throw Exception("Malformed OBJ file at '{}:{}'", path, objLineNumber);
     };
     
     Path mtlPath;
@@ -98,8 +96,10 @@ bool Model::LoadOBJ(const Path& path, bool search)
         throw Exception("Malformed MTL file at '{}:{}'", mtlPath, mtlLineNumber);
     };
 
+    StringView objText(reinterpret_cast<const char *>(data.data()), data.size());
+
     List<char> buffer(1024);
-    while (fgets(buffer.data(), buffer.size(), objFile) != nullptr) {
+    while (readLine(objText, buffer)) {
         ++objLineNumber;
 
         StringView line(buffer.data());
@@ -252,17 +252,22 @@ bool Model::LoadOBJ(const Path& path, bool search)
         else if (key == "mtllib") {
             mtlPath = value;
             if (mtlPath.IsRelative()) {
-                mtlPath = fullPath.GetParentPath() / mtlPath;
+                mtlPath = path.GetParentPath() / mtlPath;
             }
 
-            FILE * mtlFile = fopen(mtlPath.ToCString(), "rt");
-            if (not mtlFile) {
+            // Next to the OBJ file, whether that is in a directory or an archive
+            VFS::File mtlFile = VFS::Open(mtlPath, false);
+            if (not mtlFile.IsOpen()) {
                 throw Exception("Failed to load MTL file '{}'", mtlPath);
             }
 
+            modelData.DependencyList.push_back(mtlFile.GetPath());
+
+            StringView mtlText = mtlFile.GetString();
+
             mtlLineNumber = -1;
 
-            while (fgets(buffer.data(), buffer.size(), mtlFile) != nullptr) {
+            while (readLine(mtlText, buffer)) {
                 ++mtlLineNumber;
 
                 line = StringView(buffer.data());
@@ -420,8 +425,6 @@ bool Model::LoadOBJ(const Path& path, bool search)
                 }
             }
 
-            fclose(mtlFile);
-            
             Log(RYME_ANCHOR, "Loaded '{}'", mtlPath);
         }
     }
@@ -429,18 +432,17 @@ bool Model::LoadOBJ(const Path& path, bool search)
     for (auto& object : objectList) {
         Log(RYME_ANCHOR, "Loaded MeshData with {} vertices", object.VertexList.size());
 
-        MeshData data = MeshData{
+        MeshData meshData = MeshData{
             .VertexList = std::move(object.VertexList),
         };
 
-        data.CalculateTangents();
+        meshData.GenerateIndexList();
+        meshData.CalculateTangents();
 
-        _meshList.emplace_back(std::move(data));
+        modelData.MeshList.emplace_back(std::move(meshData));
     }
 
-    fclose(objFile);
-    
-    Log(RYME_ANCHOR, "Loaded '{}'", _path);
+    Log(RYME_ANCHOR, "Loaded '{}'", path);
 
     return true;
 }
@@ -0,0 +1,220 @@
+#include <Ryme/ModelData.hpp>
+#include <Ryme/Exception.hpp>
+#include <Ryme/VFS.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+namespace ryme {
+
+RYME_API
+bool LoadModelData(const Path& path, ModelData& modelData, bool search /*= false*/)
+{
+    VFS::File file = VFS::Open(path, search);
+    if (not file.IsOpen()) {
+        return false;
+    }
+
+    return LoadModelData(file.GetSpan(), file.GetPath(), modelData);
+}
+
+RYME_API
+bool LoadModelData(Span<const uint8_t> data, const Path& path, ModelData& modelData)
+{
+    const Path& ext = path.GetExtension();
+
+    if (ext == "rmesh") {
+        return LoadRMESH(data, path, modelData);
+    }
+    else if (ext == "obj") {
+        return LoadOBJ(data, path, modelData);
+    }
+    else if (ext == "gltf" or ext == "glb") {
+        return LoadGLTF2(data, path, modelData);
+    }
+
+    throw Exception("Unknown Model file format '{}'", ext);
+}
+
+struct RMESHHeader
+{
+    uint32_t Magic;
+
+    uint32_t Version;
+
+    // Vertices are stored as they are in memory, so files written with a different layout can't be read
+    uint32_t VertexSize;
+
+    uint32_t MeshCount;
+
+}; // struct RMESHHeader
+
+// Followed by the vertices, the indices, then each LOD
+struct RMESHMesh
+{
+    uint32_t PrimitiveTopology;
+
+    uint32_t VertexCount;
+
+    uint32_t IndexCount;
+
+    uint32_t LODCount;
+
+}; // struct RMESHMesh
+
+// Followed by the indices
+struct RMESHLOD
+{
+    uint32_t IndexCount;
+
+    float Error;
+
+}; // struct RMESHLOD
+
+const uint32_t RMESHMagic = 0x48534D52; // RMSH
+
+const uint32_t RMESHVersion = 1;
+
+RYME_API
+bool LoadRMESH(Span<const uint8_t> data, const Path& path, ModelData& modelData)
+{
+    auto rmeshError = [&](StringView message) {
+        throw Exception("{} in RMESH file '{}'", message, path);
+    };
+
+    size_t offset = 0;
+
+    auto read = [&](void * destination, size_t size) {
+        if (data.size() - offset < size) {
+            rmeshError("Truncated data");
+        }
+
+        if (size > 0) {
+            memcpy(destination, data.data() + offset, size);
+            offset += size;
+        }
+    };
+
+    // Counts are checked against what is left before anything is allocated for them
+    auto checkCount = [&](uint32_t count, size_t elementSize) {
+        if (count > (data.size() - offset) / elementSize) {
+            rmeshError("Truncated data");
+        }
+    };
+
+    RMESHHeader header;
+    read(&header, sizeof(header));
+
+    if (header.Magic != RMESHMagic) {
+        rmeshError("Invalid magic number");
+    }
+
+    if (header.Version != RMESHVersion or header.VertexSize != sizeof(Vertex)) {
+        rmeshError("Unsupported version");
+    }
+
+    modelData.MeshList.clear();
+    modelData.MeshList.reserve(header.MeshCount);
+
+    for (uint32_t i = 0; i < header.MeshCount; ++i) {
+        RMESHMesh mesh;
+        read(&mesh, sizeof(mesh));
+
+        MeshData& meshData = modelData.MeshList.emplace_back();
+        meshData.PrimitiveTopology = static_cast<vk::PrimitiveTopology>(mesh.PrimitiveTopology);
+
+        checkCount(mesh.VertexCount, sizeof(Vertex));
+        meshData.VertexList.resize(mesh.VertexCount);
+        read(meshData.VertexList.data(), sizeof(Vertex) * meshData.VertexList.size());
+
+        checkCount(mesh.IndexCount, sizeof(uint32_t));
+        meshData.IndexList.resize(mesh.IndexCount);
+        read(meshData.IndexList.data(), sizeof(uint32_t) * meshData.IndexList.size());
+
+        checkCount(mesh.LODCount, sizeof(RMESHLOD));
+        meshData.LODList.resize(mesh.LODCount);
+
+        for (auto& lod : meshData.LODList) {
+            RMESHLOD lodHeader;
+            read(&lodHeader, sizeof(lodHeader));
+
+            lod.Error = lodHeader.Error;
+
+            checkCount(lodHeader.IndexCount, sizeof(uint32_t));
+            lod.IndexList.resize(lodHeader.IndexCount);
+            read(lod.IndexList.data(), sizeof(uint32_t) * lod.IndexList.size());
+        }
+
+        for (uint32_t index : meshData.IndexList) {
+            if (index >= mesh.VertexCount) {
+                rmeshError("Index out of bounds");
+            }
+        }
+
+        for (const auto& lod : meshData.LODList) {
+            for (uint32_t index : lod.IndexList) {
+                if (index >= mesh.VertexCount) {
+                    rmeshError("Index out of bounds");
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+RYME_API
+bool SaveRMESH(const Path& path, const ModelData& modelData)
+{
+    FILE * file = fopen(path.ToCString(), "wb");
+    if (not file) {
+        return false;
+    }
+
+    // Empty lists may not have any data to point to
+    auto write = [&](const void * data, size_t size) {
+        if (size > 0) {
+            fwrite(data, 1, size, file);
+        }
+    };
+
+    RMESHHeader header = {
+        .Magic = RMESHMagic,
+        .Version = RMESHVersion,
+        .VertexSize = sizeof(Vertex),
+        .MeshCount = static_cast<uint32_t>(modelData.MeshList.size()),
+    };
+
+    write(&header, sizeof(header));
+
+    for (const auto& meshData : modelData.MeshList) {
+        RMESHMesh mesh = {
+            .PrimitiveTopology = static_cast<uint32_t>(meshData.PrimitiveTopology),
+            .VertexCount = static_cast<uint32_t>(meshData.VertexList.size()),
+            .IndexCount = static_cast<uint32_t>(meshData.IndexList.size()),
+            .LODCount = static_cast<uint32_t>(meshData.LODList.size()),
+        };
+
+        write(&mesh, sizeof(mesh));
+        write(meshData.VertexList.data(), sizeof(Vertex) * meshData.VertexList.size());
+        write(meshData.IndexList.data(), sizeof(uint32_t) * meshData.IndexList.size());
+
+        for (const auto& lod : meshData.LODList) {
+            RMESHLOD lodHeader = {
+                .IndexCount = static_cast<uint32_t>(lod.IndexList.size()),
+                .Error = lod.Error,
+            };
+
+            write(&lodHeader, sizeof(lodHeader));
+            write(lod.IndexList.data(), sizeof(uint32_t) * lod.IndexList.size());
+        }
+    }
+
+    bool written = (ferror(file) == 0);
+
+    fclose(file);
+
+    return written;
+}
+
+} // namespace ryme
\ No newline at end of file
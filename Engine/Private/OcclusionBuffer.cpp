@@ -0,0 +1,576 @@
+#include <Ryme/OcclusionBuffer.hpp>
+#include <Ryme/Mesh.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+
+#if defined(RYME_SIMD_SSE2)
+    #include <emmintrin.h>
+#elif defined(RYME_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace ryme {
+
+// Occluders are split and merged into batches of this many triangles, so large ones are spread across
+// threads and small ones don't each need their own
+const uint32_t BatchTriangleCount = 2048;
+
+// Call func with every index up to count, on threadPool when there is one
+void parallelFor(ThreadPool * threadPool, size_t count, std::function<void(size_t)> func)
+{
+    if (threadPool) {
+        threadPool->ParallelFor(count, std::move(func));
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        func(i);
+    }
+}
+
+RYME_API
+void OccluderMesh::Append(const MeshData& data)
+{
+    if (data.PrimitiveTopology != vk::PrimitiveTopology::eTriangleList) {
+        return;
+    }
+
+    const auto& indexList = (data.LODList.empty() ? data.IndexList : data.LODList.back().IndexList);
+
+    uint32_t firstVertex = static_cast<uint32_t>(PositionList.size());
+
+    PositionList.reserve(PositionList.size() + data.VertexList.size());
+    for (const auto& vertex : data.VertexList) {
+        PositionList.push_back(Vec3(vertex.Position));
+    }
+
+    if (indexList.empty()) {
+        for (size_t i = 0; i < data.VertexList.size(); ++i) {
+            IndexList.push_back(firstVertex + static_cast<uint32_t>(i));
+        }
+    }
+    else {
+        for (uint32_t index : indexList) {
+            IndexList.push_back(firstVertex + index);
+        }
+    }
+}
+
+RYME_API
+OcclusionBuffer::OcclusionBuffer(uint32_t width /*= 256*/, uint32_t height /*= 128*/)
+{
+    Resize(width, height);
+}
+
+RYME_API
+void OcclusionBuffer::Resize(uint32_t width, uint32_t height)
+{
+    // Rows are drawn four pixels at a time
+    _width = (std::max(width, 1u) + 3) / 4 * 4;
+    _height = std::max(height, 1u);
+
+    _tileCountX = (_width + TileWidth - 1) / TileWidth;
+    _tileCountY = (_height + TileHeight - 1) / TileHeight;
+
+    _depthList.assign(size_t(_width) * _height, 1.0f);
+
+    _levelList.clear();
+
+    uint32_t levelWidth = _width;
+    uint32_t levelHeight = _height;
+
+    while (levelWidth > 1 or levelHeight > 1) {
+        levelWidth = std::max((levelWidth + 1) / 2, 1u);
+        levelHeight = std::max((levelHeight + 1) / 2, 1u);
+
+        _levelList.emplace_back(size_t(levelWidth) * levelHeight, 1.0f);
+    }
+}
+
+RYME_API
+void OcclusionBuffer::Clear(const Mat4& viewProjection)
+{
+    _viewProjection = viewProjection;
+
+    std::fill(_depthList.begin(), _depthList.end(), 1.0f);
+
+    for (auto& level : _levelList) {
+        std::fill(level.begin(), level.end(), 1.0f);
+    }
+
+    _occluderList.clear();
+
+    _stats = {};
+}
+
+RYME_API
+void OcclusionBuffer::AddOccluder(const OccluderMesh& mesh, const Mat4& model)
+{
+    _occluderList.push_back(Occluder{
+        .Mesh = &mesh,
+        .Transform = _viewProjection * model,
+    });
+
+    ++_stats.OccluderCount;
+    _stats.TriangleCount += mesh.IndexList.size() / 3;
+}
+
+RYME_API
+void OcclusionBuffer::Rasterize(ThreadPool * threadPool /*= nullptr*/)
+{
+    RYME_PROFILE_FUNCTION();
+
+    size_t batchCount = (_stats.TriangleCount + BatchTriangleCount - 1) / BatchTriangleCount;
+
+    // Batches are kept between frames, so their lists don't need to be allocated again
+    _batchList.resize(batchCount);
+
+    uint32_t occluder = 0;
+    uint32_t firstTriangle = 0;
+    size_t remainingCount = _stats.TriangleCount;
+
+    for (auto& batch : _batchList) {
+        batch.Occluder = occluder;
+        batch.FirstTriangle = firstTriangle;
+        batch.TriangleCount = static_cast<uint32_t>(std::min<size_t>(BatchTriangleCount, remainingCount));
+
+        remainingCount -= batch.TriangleCount;
+
+        // Find where the next batch starts
+        uint32_t skipCount = batch.TriangleCount;
+
+        while (skipCount > 0) {
+            uint32_t triangleCount = static_cast<uint32_t>(_occluderList[occluder].Mesh->IndexList.size() / 3);
+            uint32_t count = std::min(skipCount, triangleCount - firstTriangle);
+
+            skipCount -= count;
+            firstTriangle += count;
+
+            if (firstTriangle == triangleCount) {
+                ++occluder;
+                firstTriangle = 0;
+            }
+        }
+    }
+
+    parallelFor(threadPool, _batchList.size(), [&](size_t index) {
+        setupBatch(_batchList[index]);
+    });
+
+    for (const auto& batch : _batchList) {
+        _stats.RasterizedTriangleCount += batch.TriangleList.size();
+    }
+
+    // Tiles cover separate pixels, so they can be drawn at the same time without any locking
+    parallelFor(threadPool, size_t(_tileCountX) * _tileCountY, [&](size_t tile) {
+        rasterizeTile(static_cast<uint32_t>(tile));
+    });
+
+    buildHierarchy();
+}
+
+RYME_API
+bool OcclusionBuffer::IsBoxVisible(const Vec3& min, const Vec3& max, const Mat4& model) const
+{
+    Mat4 transform = _viewProjection * model;
+
+    float minX = FLT_MAX;
+    float minY = FLT_MAX;
+    float maxX = -FLT_MAX;
+    float maxY = -FLT_MAX;
+    float minZ = FLT_MAX;
+
+    for (unsigned i = 0; i < 8; ++i) {
+        Vec3 corner = {
+            (i & 1 ? max.x : min.x),
+            (i & 2 ? max.y : min.y),
+            (i & 4 ? max.z : min.z),
+        };
+
+        Vec4 clip = transform * Vec4(corner, 1.0f);
+
+        // Boxes crossing the near plane are too close to be hidden
+        if (clip.z < 0.0f or clip.w <= 0.0f) {
+            return true;
+        }
+
+        float x = (clip.x / clip.w * 0.5f + 0.5f) * _width;
+        float y = (clip.y / clip.w * 0.5f + 0.5f) * _height;
+
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+        minZ = std::min(minZ, clip.z / clip.w);
+    }
+
+    if (maxX < 0.0f or maxY < 0.0f or minX >= _width or minY >= _height or minZ > 1.0f) {
+        return false;
+    }
+
+    uint32_t x0 = static_cast<uint32_t>(std::max(minX, 0.0f));
+    uint32_t y0 = static_cast<uint32_t>(std::max(minY, 0.0f));
+    uint32_t x1 = static_cast<uint32_t>(std::min(maxX, float(_width - 1)));
+    uint32_t y1 = static_cast<uint32_t>(std::min(maxY, float(_height - 1)));
+
+    const float * level = _depthList.data();
+    uint32_t levelWidth = _width;
+
+    // Move up the hierarchy until the box covers only a few texels, so large boxes are as cheap to
+    // test as small ones
+    for (size_t i = 0; i < _levelList.size() and (x1 - x0 >= 4 or y1 - y0 >= 4); ++i) {
+        x0 /= 2;
+        y0 /= 2;
+        x1 /= 2;
+        y1 /= 2;
+
+        levelWidth = std::max((levelWidth + 1) / 2, 1u);
+        level = _levelList[i].data();
+    }
+
+    for (uint32_t y = y0; y <= y1; ++y) {
+        for (uint32_t x = x0; x <= x1; ++x) {
+            if (level[size_t(y) * levelWidth + x] >= minZ) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void OcclusionBuffer::setupBatch(Batch& batch)
+{
+    batch.TriangleList.clear();
+    batch.TileTriangleListList.resize(size_t(_tileCountX) * _tileCountY);
+
+    for (auto& tileTriangleList : batch.TileTriangleListList) {
+        tileTriangleList.clear();
+    }
+
+    uint32_t occluderIndex = batch.Occluder;
+    uint32_t triangle = batch.FirstTriangle;
+
+    for (uint32_t i = 0; i < batch.TriangleCount; ++i, ++triangle) {
+        // Move on to the next occluder once this one is finished, skipping any without triangles
+        while (triangle * 3 >= _occluderList[occluderIndex].Mesh->IndexList.size()) {
+            ++occluderIndex;
+            triangle = 0;
+        }
+
+        const auto& occluder = _occluderList[occluderIndex];
+        const auto& positionList = occluder.Mesh->PositionList;
+        const auto& indexList = occluder.Mesh->IndexList;
+
+        size_t first = size_t(triangle) * 3;
+
+        Array<Vec4, 3> clipList;
+        unsigned insideCount = 0;
+
+        for (unsigned k = 0; k < 3; ++k) {
+            clipList[k] = occluder.Transform * Vec4(positionList[indexList[first + k]], 1.0f);
+
+            if (clipList[k].z >= 0.0f) {
+                ++insideCount;
+            }
+        }
+
+        if (insideCount == 3) {
+            addScreenTriangle(batch, clipList[0], clipList[1], clipList[2]);
+            continue;
+        }
+
+        if (insideCount == 0) {
+            continue;
+        }
+
+        // Clip to the near plane, which leaves either one or two triangles
+        Array<Vec4, 4> polygon;
+        unsigned polygonSize = 0;
+
+        for (unsigned k = 0; k < 3; ++k) {
+            const Vec4& a = clipList[k];
+            const Vec4& b = clipList[(k + 1) % 3];
+
+            if (a.z >= 0.0f) {
+                polygon[polygonSize++] = a;
+            }
+
+            if ((a.z >= 0.0f) != (b.z >= 0.0f)) {
+                polygon[polygonSize++] = a + (b - a) * (a.z / (a.z - b.z));
+            }
+        }
+
+        addScreenTriangle(batch, polygon[0], polygon[1], polygon[2]);
+
+        if (polygonSize == 4) {
+            addScreenTriangle(batch, polygon[0], polygon[2], polygon[3]);
+        }
+    }
+}
+
+void OcclusionBuffer::addScreenTriangle(Batch& batch, const Vec4& v0, const Vec4& v1, const Vec4& v2)
+{
+    ScreenTriangle triangle;
+
+    Array<const Vec4 *, 3> clipList = { &v0, &v1, &v2 };
+
+    for (unsigned k = 0; k < 3; ++k) {
+        const Vec4& clip = *clipList[k];
+        if (clip.w <= 0.0f) {
+            return;
+        }
+
+        triangle.VertexList[k] = Vec3(
+            (clip.x / clip.w * 0.5f + 0.5f) * _width,
+            (clip.y / clip.w * 0.5f + 0.5f) * _height,
+            clip.z / clip.w
+        );
+    }
+
+    const Vec3& p0 = triangle.VertexList[0];
+    const Vec3& p1 = triangle.VertexList[1];
+    const Vec3& p2 = triangle.VertexList[2];
+
+    // Triangles past the far plane can't hide anything
+    if (p0.z > 1.0f and p1.z > 1.0f and p2.z > 1.0f) {
+        return;
+    }
+
+    float area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+    if (area == 0.0f or not std::isfinite(area)) {
+        return;
+    }
+
+    // The pixels whose centers could be inside of the triangle
+    float minX = std::max(std::ceil(std::min({ p0.x, p1.x, p2.x }) - 0.5f), 0.0f);
+    float minY = std::max(std::ceil(std::min({ p0.y, p1.y, p2.y }) - 0.5f), 0.0f);
+    float maxX = std::min(std::floor(std::max({ p0.x, p1.x, p2.x }) - 0.5f), float(_width - 1));
+    float maxY = std::min(std::floor(std::max({ p0.y, p1.y, p2.y }) - 0.5f), float(_height - 1));
+
+    if (minX > maxX or minY > maxY) {
+        return;
+    }
+
+    uint32_t index = static_cast<uint32_t>(batch.TriangleList.size());
+    batch.TriangleList.push_back(triangle);
+
+    uint32_t tileX0 = static_cast<uint32_t>(minX) / TileWidth;
+    uint32_t tileY0 = static_cast<uint32_t>(minY) / TileHeight;
+    uint32_t tileX1 = static_cast<uint32_t>(maxX) / TileWidth;
+    uint32_t tileY1 = static_cast<uint32_t>(maxY) / TileHeight;
+
+    for (uint32_t tileY = tileY0; tileY <= tileY1; ++tileY) {
+        for (uint32_t tileX = tileX0; tileX <= tileX1; ++tileX) {
+            batch.TileTriangleListList[tileY * _tileCountX + tileX].push_back(index);
+        }
+    }
+}
+
+void OcclusionBuffer::rasterizeTile(uint32_t tile)
+{
+    uint32_t tileX = tile % _tileCountX;
+    uint32_t tileY = tile / _tileCountX;
+
+    for (const auto& batch : _batchList) {
+        for (uint32_t index : batch.TileTriangleListList[tile]) {
+            rasterizeTriangle(batch.TriangleList[index], tileX, tileY);
+        }
+    }
+}
+
+void OcclusionBuffer::rasterizeTriangle(const ScreenTriangle& triangle, uint32_t tileX, uint32_t tileY)
+{
+    Vec3 v0 = triangle.VertexList[0];
+    Vec3 v1 = triangle.VertexList[1];
+    Vec3 v2 = triangle.VertexList[2];
+
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+
+    // Occluders are drawn from both sides
+    if (area < 0.0f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // Each edge function is positive inside of the triangle, and equal to the area at the opposite
+    // vertex, so dividing by the area gives the barycentric coordinates
+    float a0 = v1.y - v2.y;
+    float b0 = v2.x - v1.x;
+    float c0 = -(a0 * v1.x + b0 * v1.y);
+
+    float a1 = v2.y - v0.y;
+    float b1 = v0.x - v2.x;
+    float c1 = -(a1 * v2.x + b1 * v2.y);
+
+    float a2 = v0.y - v1.y;
+    float b2 = v1.x - v0.x;
+    float c2 = -(a2 * v0.x + b2 * v0.y);
+
+    float invArea = 1.0f / area;
+
+    float za = (a0 * v0.z + a1 * v1.z + a2 * v2.z) * invArea;
+    float zb = (b0 * v0.z + b1 * v1.z + b2 * v2.z) * invArea;
+    float zc = (c0 * v0.z + c1 * v1.z + c2 * v2.z) * invArea;
+
+    // The pixels whose centers could be inside of the triangle, within the tile
+    uint32_t tileMinX = tileX * TileWidth;
+    uint32_t tileMinY = tileY * TileHeight;
+    uint32_t tileMaxX = std::min(tileMinX + TileWidth, _width) - 1;
+    uint32_t tileMaxY = std::min(tileMinY + TileHeight, _height) - 1;
+
+    float minX = std::max(std::ceil(std::min({ v0.x, v1.x, v2.x }) - 0.5f), float(tileMinX));
+    float minY = std::max(std::ceil(std::min({ v0.y, v1.y, v2.y }) - 0.5f), float(tileMinY));
+    float maxX = std::min(std::floor(std::max({ v0.x, v1.x, v2.x }) - 0.5f), float(tileMaxX));
+    float maxY = std::min(std::floor(std::max({ v0.y, v1.y, v2.y }) - 0.5f), float(tileMaxY));
+
+    if (minX > maxX or minY > maxY) {
+        return;
+    }
+
+    // Tiles and the buffer are a multiple of 4 pixels wide, so rounding down stays inside the tile
+    uint32_t x0 = static_cast<uint32_t>(minX) & ~3u;
+    uint32_t x1 = static_cast<uint32_t>(maxX);
+    uint32_t y0 = static_cast<uint32_t>(minY);
+    uint32_t y1 = static_cast<uint32_t>(maxY);
+
+    #if defined(RYME_SIMD_SSE2)
+
+        const __m128 offset = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 zero = _mm_setzero_ps();
+
+        const __m128 a0x4 = _mm_set1_ps(a0);
+        const __m128 a1x4 = _mm_set1_ps(a1);
+        const __m128 a2x4 = _mm_set1_ps(a2);
+        const __m128 zax4 = _mm_set1_ps(za);
+
+    #elif defined(RYME_SIMD_NEON)
+
+        const float offsetData[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+        const float32x4_t offset = vld1q_f32(offsetData);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+
+        const float32x4_t a0x4 = vdupq_n_f32(a0);
+        const float32x4_t a1x4 = vdupq_n_f32(a1);
+        const float32x4_t a2x4 = vdupq_n_f32(a2);
+        const float32x4_t zax4 = vdupq_n_f32(za);
+
+    #endif
+
+    for (uint32_t y = y0; y <= y1; ++y) {
+        float py = float(y) + 0.5f;
+
+        float row0 = b0 * py + c0;
+        float row1 = b1 * py + c1;
+        float row2 = b2 * py + c2;
+        float rowZ = zb * py + zc;
+
+        float * depthRow = _depthList.data() + size_t(y) * _width;
+
+        uint32_t x = x0;
+
+        #if defined(RYME_SIMD_SSE2)
+
+            const __m128 row0x4 = _mm_set1_ps(row0);
+            const __m128 row1x4 = _mm_set1_ps(row1);
+            const __m128 row2x4 = _mm_set1_ps(row2);
+            const __m128 rowZx4 = _mm_set1_ps(rowZ);
+
+            for (; x <= x1; x += 4) {
+                __m128 px = _mm_add_ps(_mm_set1_ps(float(x)), offset);
+
+                __m128 e0 = _mm_add_ps(_mm_mul_ps(a0x4, px), row0x4);
+                __m128 e1 = _mm_add_ps(_mm_mul_ps(a1x4, px), row1x4);
+                __m128 e2 = _mm_add_ps(_mm_mul_ps(a2x4, px), row2x4);
+
+                __m128 inside = _mm_and_ps(
+                    _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+                    _mm_cmpge_ps(e2, zero)
+                );
+
+                __m128 z = _mm_add_ps(_mm_mul_ps(zax4, px), rowZx4);
+                __m128 depth = _mm_loadu_ps(depthRow + x);
+
+                depth = _mm_or_ps(
+                    _mm_and_ps(inside, _mm_min_ps(depth, z)),
+                    _mm_andnot_ps(inside, depth)
+                );
+
+                _mm_storeu_ps(depthRow + x, depth);
+            }
+
+        #elif defined(RYME_SIMD_NEON)
+
+            const float32x4_t row0x4 = vdupq_n_f32(row0);
+            const float32x4_t row1x4 = vdupq_n_f32(row1);
+            const float32x4_t row2x4 = vdupq_n_f32(row2);
+            const float32x4_t rowZx4 = vdupq_n_f32(rowZ);
+
+            for (; x <= x1; x += 4) {
+                float32x4_t px = vaddq_f32(vdupq_n_f32(float(x)), offset);
+
+                // Multiply and add separately, to match the other paths exactly
+                float32x4_t e0 = vaddq_f32(vmulq_f32(a0x4, px), row0x4);
+                float32x4_t e1 = vaddq_f32(vmulq_f32(a1x4, px), row1x4);
+                float32x4_t e2 = vaddq_f32(vmulq_f32(a2x4, px), row2x4);
+
+                uint32x4_t inside = vandq_u32(
+                    vandq_u32(vcgeq_f32(e0, zero), vcgeq_f32(e1, zero)),
+                    vcgeq_f32(e2, zero)
+                );
+
+                float32x4_t z = vaddq_f32(vmulq_f32(zax4, px), rowZx4);
+                float32x4_t depth = vld1q_f32(depthRow + x);
+
+                vst1q_f32(depthRow + x, vbslq_f32(inside, vminq_f32(depth, z), depth));
+            }
+
+        #endif
+
+        for (; x <= x1; ++x) {
+            float px = float(x) + 0.5f;
+
+            if (a0 * px + row0 >= 0.0f and a1 * px + row1 >= 0.0f and a2 * px + row2 >= 0.0f) {
+                depthRow[x] = std::min(depthRow[x], za * px + rowZ);
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::buildHierarchy()
+{
+    RYME_PROFILE_FUNCTION();
+
+    const float * src = _depthList.data();
+    uint32_t srcWidth = _width;
+    uint32_t srcHeight = _height;
+
+    for (auto& level : _levelList) {
+        uint32_t levelWidth = std::max((srcWidth + 1) / 2, 1u);
+        uint32_t levelHeight = std::max((srcHeight + 1) / 2, 1u);
+
+        for (uint32_t y = 0; y < levelHeight; ++y) {
+            const float * srcRow0 = src + size_t(std::min(y * 2, srcHeight - 1)) * srcWidth;
+            const float * srcRow1 = src + size_t(std::min(y * 2 + 1, srcHeight - 1)) * srcWidth;
+
+            for (uint32_t x = 0; x < levelWidth; ++x) {
+                uint32_t even = std::min(x * 2, srcWidth - 1);
+                uint32_t odd = std::min(x * 2 + 1, srcWidth - 1);
+
+                level[size_t(y) * levelWidth + x] = std::max({
+                    srcRow0[even], srcRow0[odd], srcRow1[even], srcRow1[odd]
+                });
+            }
+        }
+
+        src = level.data();
+        srcWidth = levelWidth;
+        srcHeight = levelHeight;
+    }
+}
+
+} // namespace ryme
\ No newline at end of file
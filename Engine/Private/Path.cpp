@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <climits>
+#include <filesystem>
 #include <sstream>
 
 #include <pybind11/stl.h>
@@ -249,17 +250,50 @@ void Path::ScriptInit(py::module m)
 }
 
 RYME_API
-List<Path> GetAssetPathList()
+bool WriteFileReplacing(const Path& path, std::function<bool(FILE * file)> writeFunc)
 {
-    static List<Path> assetPathList;
-    
-    if (assetPathList.empty()) {
-        char * env = getenv("RYME_ASSET_PATH");
-        if (env) {
-            assetPathList = Path::ParsePathList(env);
-        }
+    Path temporaryPath = path + ".tmp";
+
+    FILE * file = fopen(temporaryPath.ToCString(), "wb");
+    if (not file) {
+        return false;
+    }
+
+    bool written = (writeFunc(file) and ferror(file) == 0);
+
+    if (fclose(file) != 0) {
+        written = false;
     }
 
+    auto getFilesystemPath = [](const Path& path) {
+        const String& str = path.ToString();
+        return std::filesystem::path(std::u8string(reinterpret_cast<const char8_t *>(str.data()), str.size()));
+    };
+
+    std::error_code error;
+
+    // Unlike rename(), this replaces an existing file on every platform, so there is no moment where
+    // neither file exists
+    if (written) {
+        std::filesystem::rename(getFilesystemPath(temporaryPath), getFilesystemPath(path), error);
+        written = not error;
+    }
+
+    if (not written) {
+        std::filesystem::remove(getFilesystemPath(temporaryPath), error);
+    }
+
+    return written;
+}
+
+RYME_API
+const List<Path>& GetAssetPathList()
+{
+    static const List<Path> assetPathList = []() {
+        char * env = getenv("RYME_ASSET_PATH");
+        return (env ? Path::ParsePathList(env) : List<Path>());
+    }();
+
     return assetPathList;
 }
 
@@ -1,10 +1,45 @@
 #include <Ryme/Pipeline.hpp>
 #include <Ryme/Vertex.hpp>
 #include <Ryme/Graphics.hpp>
+#include <Ryme/Hash.hpp>
 #include <Ryme/Log.hpp>
 
+#include <algorithm>
+
 namespace ryme {
 
+RYME_API
+void SpecializationValues::SetBits(uint32_t constantID, uint32_t bits)
+{
+    auto it = std::lower_bound(_constantIDList.begin(), _constantIDList.end(), constantID);
+    size_t index = it - _constantIDList.begin();
+
+    if (it != _constantIDList.end() and *it == constantID) {
+        _valueList[index] = bits;
+    }
+    else {
+        _constantIDList.insert(it, constantID);
+        _valueList.insert(_valueList.begin() + index, bits);
+    }
+}
+
+RYME_API
+void SpecializationValues::Clear()
+{
+    _constantIDList.clear();
+    _valueList.clear();
+}
+
+RYME_API
+uint64_t SpecializationValues::GetHash() const
+{
+    auto getBytes = [](const List<uint32_t>& list) {
+        return Span<const uint8_t>(reinterpret_cast<const uint8_t *>(list.data()), list.size() * sizeof(uint32_t));
+    };
+
+    return Hash64(getBytes(_valueList), Hash64(getBytes(_constantIDList)));
+}
+
 RYME_API
 Pipeline::Pipeline(Shader * shader)
     : _shader(shader)
@@ -67,12 +102,87 @@ Pipeline::~Pipeline()
 
 RYME_API
 void Pipeline::Create()
+{
+    Free();
+
+    _pipelineRef = createPipeline(nullptr);
+    _pipeline = *_pipelineRef;
+}
+
+RYME_API
+vk::Pipeline Pipeline::GetVkPipeline(const SpecializationValues& values)
+{
+    if (values.IsEmpty()) {
+        return _pipeline;
+    }
+
+    auto it = _specializedPipelineMap.find(values);
+    if (it == _specializedPipelineMap.end()) {
+        it = _specializedPipelineMap.emplace(values, createPipeline(&values)).first;
+    }
+
+    return *it->second;
+}
+
+RYME_API
+void Pipeline::Free()
+{
+    // Pipelines are shared through the PipelineCache with every other Pipeline with the same state,
+    // which destroys them once none of them are using it and the GPU is done with it
+    if (_pipelineRef or not _specializedPipelineMap.empty()) {
+        Graphics::InvalidateCommandBuffers();
+    }
+
+    _pipelineRef.reset();
+    _pipeline = nullptr;
+
+    _specializedPipelineMap.clear();
+}
+
+RYME_API
+bool Pipeline::Reload()
+{
+    Create();
+    return true;
+}
+
+PipelineCache::PipelineRef Pipeline::createPipeline(const SpecializationValues * values)
 {
     assert(_shader); // TODO: Improve
 
     auto stageList = _shader->GetShaderStageList();
     auto pipelineLayout = _shader->GetPipelineLayout();
 
+    // One entry for every value, every stage can share them as constants that a stage doesn't
+    // declare are ignored
+    List<vk::SpecializationMapEntry> mapEntryList;
+    vk::SpecializationInfo specializationInfo;
+
+    if (values) {
+        auto constantIDList = values->GetConstantIDList();
+        auto valueList = values->GetValueList();
+
+        for (size_t i = 0; i < constantIDList.size(); ++i) {
+            mapEntryList.push_back(
+                vk::SpecializationMapEntry()
+                    .setConstantID(constantIDList[i])
+                    .setOffset(static_cast<uint32_t>(i * sizeof(uint32_t)))
+                    .setSize(sizeof(uint32_t))
+            );
+        }
+
+        specializationInfo = vk::SpecializationInfo()
+            .setMapEntries(mapEntryList)
+            .setDataSize(valueList.size_bytes())
+            .setPData(valueList.data());
+
+        for (auto& stage : stageList) {
+            stage.setPSpecializationInfo(&specializationInfo);
+        }
+    }
+
+    auto renderPass = (_renderPass ? _renderPass : Graphics::RenderPass);
+
     auto bindingList = GetVertexInputBindingDescriptionList();
     auto attributeList = GetVertexInputAttributeDescriptionList();
 
@@ -107,29 +217,10 @@ void Pipeline::Create()
         .setPDepthStencilState(&_depthStencilStateCreateInfo)
         .setPColorBlendState(&_colorBlendStateCreateInfo)
         .setPDynamicState(&dynamicStateCreateInfo)
-        .setRenderPass(Graphics::RenderPass)
+        .setRenderPass(renderPass)
         .setLayout(pipelineLayout);
-        
-    Free();
-
-    vk::Result vkResult;
-    std::tie(vkResult, _pipeline) = Graphics::Device.createGraphicsPipeline(nullptr, pipelineCreateInfo);
-
-    vk::resultCheck(vkResult, "vk::Device::createGraphicsPipeline",
-        { vk::Result::eSuccess, vk::Result::ePipelineCompileRequired }
-    );
-}
-
-RYME_API
-void Pipeline::Free()
-{
-    Graphics::Device.destroyPipeline(_pipeline);
-}
 
-RYME_API
-bool Pipeline::Reload()
-{
-    return true;
+    return PipelineCache::GetGraphicsPipeline(pipelineCreateInfo);
 }
 
 } // namespace ryme
\ No newline at end of file
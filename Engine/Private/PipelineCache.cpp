@@ -0,0 +1,502 @@
+#include <Ryme/PipelineCache.hpp>
+#include <Ryme/Graphics.hpp>
+#include <Ryme/Hash.hpp>
+#include <Ryme/List.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+namespace ryme {
+
+namespace PipelineCache {
+
+// The state of a request written out field by field, as padding and pointers are not part of it
+struct CacheKey
+{
+    List<uint8_t> Data;
+
+    uint64_t Hash;
+
+    inline bool operator==(const CacheKey& rhs) const {
+        return (Hash == rhs.Hash and Data == rhs.Data);
+    }
+
+}; // struct CacheKey
+
+struct CacheKeyHash
+{
+    size_t operator()(const CacheKey& key) const {
+        return static_cast<size_t>(key.Hash);
+    }
+
+}; // struct CacheKeyHash
+
+class CacheKeyWriter
+{
+public:
+
+    template <class T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        const uint8_t * bytes = reinterpret_cast<const uint8_t *>(&value);
+        _data.insert(_data.end(), bytes, bytes + sizeof(T));
+    }
+
+    // Written with the count first, so a list can't run into whatever is written after it
+    template <class T>
+    void WriteList(const T * list, uint32_t count) {
+        Write(count);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            Write(list[i]);
+        }
+    }
+
+    void WriteBytes(const void * data, size_t size) {
+        Write(static_cast<uint64_t>(size));
+
+        const uint8_t * bytes = static_cast<const uint8_t *>(data);
+        _data.insert(_data.end(), bytes, bytes + size);
+    }
+
+    void WriteString(const char * str) {
+        WriteBytes(str, (str ? strlen(str) : 0));
+    }
+
+    CacheKey Finish() {
+        uint64_t hash = Hash64(Span<const uint8_t>(_data.data(), _data.size()));
+        return CacheKey{ std::move(_data), hash };
+    }
+
+private:
+
+    List<uint8_t> _data;
+
+}; // class CacheKeyWriter
+
+template <class T>
+struct CacheEntry
+{
+    std::weak_ptr<const T> Ref;
+
+    // The handles in the key of objects that the cached object doesn't keep alive, once one of them
+    // is destroyed its handle can be given to a new object, which must not match this entry
+    List<uint64_t> DependencyList;
+
+}; // struct CacheEntry
+
+template <class T>
+using CacheMap = std::unordered_map<CacheKey, CacheEntry<T>, CacheKeyHash>;
+
+std::mutex _cacheMutex;
+
+CacheMap<vk::ShaderModule> _shaderModuleMap;
+
+CacheMap<vk::DescriptorSetLayout> _descriptorSetLayoutMap;
+
+CacheMap<vk::PipelineLayout> _pipelineLayoutMap;
+
+CacheMap<vk::Pipeline> _pipelineMap;
+
+size_t _hitCount = 0;
+
+size_t _missCount = 0;
+
+template <class T>
+uint64_t getHandleValue(T handle)
+{
+    static_assert(sizeof(T) == sizeof(uint64_t));
+
+    // Non-dispatchable handles are pointers or 64-bit integers, depending on the platform
+    uint64_t value;
+    memcpy(&value, &handle, sizeof(value));
+    return value;
+}
+
+template <class T>
+void eraseDependents(CacheMap<T>& map, uint64_t handle)
+{
+    std::erase_if(map, [handle](const auto& pair) {
+        const auto& dependencyList = pair.second.DependencyList;
+        return (std::find(dependencyList.begin(), dependencyList.end(), handle) != dependencyList.end());
+    });
+}
+
+// The objects that are still alive are left to whoever is using them, they just aren't shared anymore
+void eraseDependents(uint64_t handle)
+{
+    eraseDependents(_descriptorSetLayoutMap, handle);
+    eraseDependents(_pipelineLayoutMap, handle);
+    eraseDependents(_pipelineMap, handle);
+}
+
+///
+/// Find the object for key, or create a new one with create(). Once the last reference to it is
+/// dropped, it is removed from the map along with everything created with it, and destroy() is
+/// deferred until the GPU is done with it.
+///
+/// @param dependencyList The handles in key of objects the new object doesn't keep alive
+///
+template <class T, class Create, class Destroy>
+std::shared_ptr<const T> getOrCreate(
+    CacheMap<T>& map,
+    CacheKey&& key,
+    List<uint64_t>&& dependencyList,
+    Create create,
+    Destroy destroy)
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+
+    auto it = map.find(key);
+    if (it != map.end()) {
+        auto object = it->second.Ref.lock();
+        if (object) {
+            ++_hitCount;
+            return object;
+        }
+    }
+
+    ++_missCount;
+
+    auto objectPointer = new T(create());
+
+    auto object = std::shared_ptr<const T>(objectPointer, [&map, key, destroy](const T * object) {
+        {
+            std::lock_guard<std::mutex> lock(_cacheMutex);
+
+            // The entry may already have been replaced by a new object with the same state
+            auto it = map.find(key);
+            if (it != map.end() and it->second.Ref.expired()) {
+                map.erase(it);
+            }
+
+            eraseDependents(getHandleValue(*object));
+        }
+
+        Graphics::DeferDestroy([destroy, object = *object]() {
+            destroy(object);
+        });
+
+        delete object;
+    });
+
+    map[std::move(key)] = CacheEntry<T>{
+        .Ref = object,
+        .DependencyList = std::move(dependencyList),
+    };
+
+    return object;
+}
+
+RYME_API
+ShaderModuleRef GetShaderModule(Span<const uint32_t> code, uint64_t contentHash)
+{
+    CacheKeyWriter writer;
+    writer.Write(contentHash);
+    writer.Write(static_cast<uint64_t>(code.size_bytes()));
+
+    return getOrCreate(_shaderModuleMap, writer.Finish(), {},
+        [&]() {
+            auto shaderModuleCreateInfo = vk::ShaderModuleCreateInfo()
+                .setCodeSize(code.size_bytes())
+                .setPCode(code.data());
+
+            return Graphics::Device.createShaderModule(shaderModuleCreateInfo);
+        },
+        [](vk::ShaderModule shaderModule) {
+            Graphics::Device.destroyShaderModule(shaderModule);
+        }
+    );
+}
+
+RYME_API
+DescriptorSetLayoutRef GetDescriptorSetLayout(Span<const vk::DescriptorSetLayoutBinding> bindingList)
+{
+    CacheKeyWriter writer;
+    writer.Write(static_cast<uint32_t>(bindingList.size()));
+
+    List<uint64_t> dependencyList;
+
+    for (const auto& binding : bindingList) {
+        writer.Write(binding.binding);
+        writer.Write(binding.descriptorType);
+        writer.Write(binding.descriptorCount);
+        writer.Write(binding.stageFlags);
+
+        uint32_t immutableSamplerCount = (binding.pImmutableSamplers ? binding.descriptorCount : 0);
+        writer.WriteList(binding.pImmutableSamplers, immutableSamplerCount);
+
+        for (uint32_t i = 0; i < immutableSamplerCount; ++i) {
+            dependencyList.push_back(getHandleValue(binding.pImmutableSamplers[i]));
+        }
+    }
+
+    return getOrCreate(_descriptorSetLayoutMap, writer.Finish(), std::move(dependencyList),
+        [&]() {
+            auto descriptorSetLayoutCreateInfo = vk::DescriptorSetLayoutCreateInfo()
+                .setBindings(bindingList);
+
+            return Graphics::Device.createDescriptorSetLayout(descriptorSetLayoutCreateInfo);
+        },
+        [](vk::DescriptorSetLayout descriptorSetLayout) {
+            Graphics::Device.destroyDescriptorSetLayout(descriptorSetLayout);
+        }
+    );
+}
+
+RYME_API
+PipelineLayoutRef GetPipelineLayout(
+    Span<const DescriptorSetLayoutRef> descriptorSetLayoutList,
+    Span<const vk::PushConstantRange> pushConstantRangeList)
+{
+    List<vk::DescriptorSetLayout> setLayoutList;
+    List<DescriptorSetLayoutRef> setLayoutRefList;
+
+    for (const auto& descriptorSetLayout : descriptorSetLayoutList) {
+        setLayoutList.push_back(*descriptorSetLayout);
+        setLayoutRefList.push_back(descriptorSetLayout);
+    }
+
+    CacheKeyWriter writer;
+    writer.WriteList(setLayoutList.data(), static_cast<uint32_t>(setLayoutList.size()));
+    writer.WriteList(pushConstantRangeList.data(), static_cast<uint32_t>(pushConstantRangeList.size()));
+
+    // The set layouts are kept alive by the pipeline layout, so their handles can't be reused
+    return getOrCreate(_pipelineLayoutMap, writer.Finish(), {},
+        [&]() {
+            auto pipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo()
+                .setSetLayouts(setLayoutList)
+                .setPushConstantRanges(pushConstantRangeList);
+
+            return Graphics::Device.createPipelineLayout(pipelineLayoutCreateInfo);
+        },
+        // The set layouts are released once the pipeline layout is destroyed
+        [setLayoutRefList](vk::PipelineLayout pipelineLayout) {
+            Graphics::Device.destroyPipelineLayout(pipelineLayout);
+        }
+    );
+}
+
+///
+/// Write all of the state of a graphics pipeline into writer
+///
+/// @return False if any part of the state has a pNext chain, which can't be compared
+///
+bool writeGraphicsPipelineKey(CacheKeyWriter& writer, const vk::GraphicsPipelineCreateInfo& createInfo)
+{
+    if (createInfo.pNext) {
+        return false;
+    }
+
+    writer.Write(createInfo.flags);
+    writer.Write(createInfo.stageCount);
+
+    for (uint32_t i = 0; i < createInfo.stageCount; ++i) {
+        const auto& stage = createInfo.pStages[i];
+        if (stage.pNext) {
+            return false;
+        }
+
+        writer.Write(stage.flags);
+        writer.Write(stage.stage);
+        writer.Write(stage.module);
+        writer.WriteString(stage.pName);
+
+        const auto * specializationInfo = stage.pSpecializationInfo;
+        writer.Write(specializationInfo != nullptr);
+
+        if (specializationInfo) {
+            writer.WriteList(specializationInfo->pMapEntries, specializationInfo->mapEntryCount);
+            writer.WriteBytes(specializationInfo->pData, specializationInfo->dataSize);
+        }
+    }
+
+    // Each part of the state is optional, so whether it is there is written first
+    auto writeState = [&](const auto * state, auto writeFields) {
+        writer.Write(state != nullptr);
+
+        if (state) {
+            if (state->pNext) {
+                return false;
+            }
+
+            writer.Write(state->flags);
+            writeFields(*state);
+        }
+
+        return true;
+    };
+
+    bool canCompare = true;
+
+    canCompare = canCompare and writeState(createInfo.pVertexInputState, [&](const auto& state) {
+        writer.WriteList(state.pVertexBindingDescriptions, state.vertexBindingDescriptionCount);
+        writer.WriteList(state.pVertexAttributeDescriptions, state.vertexAttributeDescriptionCount);
+    });
+
+    canCompare = canCompare and writeState(createInfo.pInputAssemblyState, [&](const auto& state) {
+        writer.Write(state.topology);
+        writer.Write(state.primitiveRestartEnable);
+    });
+
+    canCompare = canCompare and writeState(createInfo.pTessellationState, [&](const auto& state) {
+        writer.Write(state.patchControlPoints);
+    });
+
+    canCompare = canCompare and writeState(createInfo.pViewportState, [&](const auto& state) {
+        // The viewports and scissors are usually dynamic, and left as nullptr
+        writer.WriteList(state.pViewports, (state.pViewports ? state.viewportCount : 0));
+        writer.WriteList(state.pScissors, (state.pScissors ? state.scissorCount : 0));
+        writer.Write(state.viewportCount);
+        writer.Write(state.scissorCount);
+    });
+
+    canCompare = canCompare and writeState(createInfo.pRasterizationState, [&](const auto& state) {
+        writer.Write(state.depthClampEnable);
+        writer.Write(state.rasterizerDiscardEnable);
+        writer.Write(state.polygonMode);
+        writer.Write(state.cullMode);
+        writer.Write(state.frontFace);
+        writer.Write(state.depthBiasEnable);
+        writer.Write(state.depthBiasConstantFactor);
+        writer.Write(state.depthBiasClamp);
+        writer.Write(state.depthBiasSlopeFactor);
+        writer.Write(state.lineWidth);
+    });
+
+    canCompare = canCompare and writeState(createInfo.pMultisampleState, [&](const auto& state) {
+        writer.Write(state.rasterizationSamples);
+        writer.Write(state.sampleShadingEnable);
+        writer.Write(state.minSampleShading);
+
+        // One bit for each sample
+        uint32_t sampleMaskCount = (static_cast<uint32_t>(state.rasterizationSamples) + 31) / 32;
+        writer.WriteList(state.pSampleMask, (state.pSampleMask ? sampleMaskCount : 0));
+
+        writer.Write(state.alphaToCoverageEnable);
+        writer.Write(state.alphaToOneEnable);
+    });
+
+    canCompare = canCompare and writeState(createInfo.pDepthStencilState, [&](const auto& state) {
+        writer.Write(state.depthTestEnable);
+        writer.Write(state.depthWriteEnable);
+        writer.Write(state.depthCompareOp);
+        writer.Write(state.depthBoundsTestEnable);
+        writer.Write(state.stencilTestEnable);
+        writer.Write(state.front);
+        writer.Write(state.back);
+        writer.Write(state.minDepthBounds);
+        writer.Write(state.maxDepthBounds);
+    });
+
+    canCompare = canCompare and writeState(createInfo.pColorBlendState, [&](const auto& state) {
+        writer.Write(state.logicOpEnable);
+        writer.Write(state.logicOp);
+        writer.WriteList(state.pAttachments, state.attachmentCount);
+        writer.Write(state.blendConstants);
+    });
+
+    canCompare = canCompare and writeState(createInfo.pDynamicState, [&](const auto& state) {
+        writer.WriteList(state.pDynamicStates, state.dynamicStateCount);
+    });
+
+    writer.Write(createInfo.layout);
+    writer.Write(createInfo.renderPass);
+    writer.Write(createInfo.subpass);
+    writer.Write(createInfo.basePipelineHandle);
+    writer.Write(createInfo.basePipelineIndex);
+
+    return canCompare;
+}
+
+vk::Pipeline createGraphicsPipeline(const vk::GraphicsPipelineCreateInfo& graphicsPipelineCreateInfo)
+{
+    vk::Result vkResult;
+    vk::Pipeline pipeline;
+    std::tie(vkResult, pipeline) = Graphics::Device.createGraphicsPipeline(nullptr, graphicsPipelineCreateInfo);
+
+    vk::resultCheck(vkResult, "vk::Device::createGraphicsPipeline",
+        { vk::Result::eSuccess, vk::Result::ePipelineCompileRequired }
+    );
+
+    return pipeline;
+}
+
+RYME_API
+PipelineRef GetGraphicsPipeline(const vk::GraphicsPipelineCreateInfo& graphicsPipelineCreateInfo)
+{
+    CacheKeyWriter writer;
+
+    if (not writeGraphicsPipelineKey(writer, graphicsPipelineCreateInfo)) {
+        auto pipeline = new vk::Pipeline(createGraphicsPipeline(graphicsPipelineCreateInfo));
+
+        return PipelineRef(pipeline, [](const vk::Pipeline * pipeline) {
+            Graphics::DeferDestroy([pipeline = *pipeline]() {
+                Graphics::Device.destroyPipeline(pipeline);
+            });
+
+            delete pipeline;
+        });
+    }
+
+    List<uint64_t> dependencyList;
+
+    for (uint32_t i = 0; i < graphicsPipelineCreateInfo.stageCount; ++i) {
+        dependencyList.push_back(getHandleValue(graphicsPipelineCreateInfo.pStages[i].module));
+    }
+
+    dependencyList.push_back(getHandleValue(graphicsPipelineCreateInfo.layout));
+    dependencyList.push_back(getHandleValue(graphicsPipelineCreateInfo.renderPass));
+
+    if (graphicsPipelineCreateInfo.basePipelineHandle) {
+        dependencyList.push_back(getHandleValue(graphicsPipelineCreateInfo.basePipelineHandle));
+    }
+
+    return getOrCreate(_pipelineMap, writer.Finish(), std::move(dependencyList),
+        [&]() {
+            return createGraphicsPipeline(graphicsPipelineCreateInfo);
+        },
+        [](vk::Pipeline pipeline) {
+            Graphics::Device.destroyPipeline(pipeline);
+        }
+    );
+}
+
+RYME_API
+void EraseDependents(vk::RenderPass renderPass)
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+
+    eraseDependents(getHandleValue(renderPass));
+}
+
+RYME_API
+void EraseDependents(vk::Sampler sampler)
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+
+    eraseDependents(getHandleValue(sampler));
+}
+
+RYME_API
+Stats GetStats()
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+
+    return Stats{
+        .ShaderModuleCount = _shaderModuleMap.size(),
+        .DescriptorSetLayoutCount = _descriptorSetLayoutMap.size(),
+        .PipelineLayoutCount = _pipelineLayoutMap.size(),
+        .PipelineCount = _pipelineMap.size(),
+        .HitCount = _hitCount,
+        .MissCount = _missCount,
+    };
+}
+
+} // namespace PipelineCache
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include <Ryme/Profiler.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Map.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+#include <pybind11/stl.h>
+
+namespace ryme {
+
+namespace Profiler {
+
+// Enough for several seconds of a busy thread, at 32 bytes per zone
+constexpr size_t ZoneCapacityPerThread = 1 << 16;
+
+struct Zone
+{
+    const char * Name;
+
+    uint64_t Start;
+
+    uint64_t End;
+
+}; // struct Zone
+
+// A Zone that can be read while its thread overwrites it, the copy is only kept if Sequence didn't
+// change while it was being read
+struct ZoneSlot
+{
+    // Twice the index of the zone in the slot + 1, or odd while the slot is being written
+    std::atomic_uint64_t Sequence = 0;
+
+    std::atomic<const char *> Name = nullptr;
+
+    std::atomic_uint64_t Start = 0;
+
+    std::atomic_uint64_t End = 0;
+
+}; // struct ZoneSlot
+
+struct ThreadTrack
+{
+    uint32_t ThreadIndex;
+
+    String Name;
+
+    std::unique_ptr<ZoneSlot[]> ZoneSlotList;
+
+    // Total number of zones ever written, the write position is Head % ZoneCapacityPerThread
+    std::atomic_uint64_t Head = 0;
+
+    // Zones before this were discarded by Clear(), which leaves Head to the thread that owns the track
+    std::atomic_uint64_t Tail = 0;
+
+}; // struct ThreadTrack
+
+std::atomic_bool _enabled = false;
+
+std::mutex _trackListMutex;
+
+List<std::unique_ptr<ThreadTrack>> _trackList;
+
+thread_local ThreadTrack * _threadTrack = nullptr;
+
+uint64_t _frameStart = 0;
+
+uint64_t _frameCount = 0;
+
+ThreadTrack * getThreadTrack()
+{
+    if (not _threadTrack) {
+        std::lock_guard<std::mutex> lock(_trackListMutex);
+
+        auto track = std::make_unique<ThreadTrack>();
+        track->ThreadIndex = _trackList.size();
+        track->Name = fmt::format("Thread #{}", track->ThreadIndex);
+        track->ZoneSlotList = std::make_unique<ZoneSlot[]>(ZoneCapacityPerThread);
+
+        // Tracks are kept until exit, so zones from finished threads can still be exported
+        _threadTrack = track.get();
+        _trackList.push_back(std::move(track));
+    }
+
+    return _threadTrack;
+}
+
+// Copy the zones that are still in the ring buffer, oldest first, skipping any that are overwritten
+// while they are being copied
+List<Zone> getZoneList(const ThreadTrack * track)
+{
+    uint64_t head = track->Head.load(std::memory_order_acquire);
+    uint64_t tail = track->Tail.load(std::memory_order_relaxed);
+
+    uint64_t first = std::max(tail, head - std::min<uint64_t>(head, ZoneCapacityPerThread));
+
+    List<Zone> zoneList;
+    zoneList.reserve(head - std::min(first, head));
+
+    for (uint64_t i = first; i < head; ++i) {
+        const ZoneSlot& slot = track->ZoneSlotList[i % ZoneCapacityPerThread];
+
+        uint64_t sequence = slot.Sequence.load(std::memory_order_acquire);
+
+        Zone zone = {
+            .Name = slot.Name.load(std::memory_order_relaxed),
+            .Start = slot.Start.load(std::memory_order_relaxed),
+            .End = slot.End.load(std::memory_order_relaxed),
+        };
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (sequence != (i + 1) * 2 or slot.Sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        zoneList.push_back(zone);
+    }
+
+    return zoneList;
+}
+
+String escapeJSON(StringView str)
+{
+    String result;
+    result.reserve(str.size());
+
+    for (char c : str) {
+        if (c == '"' or c == '\\') {
+            result += '\\';
+            result += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            result += fmt::format("\\u{:04x}", static_cast<int>(c));
+        }
+        else {
+            result += c;
+        }
+    }
+
+    return result;
+}
+
+RYME_API
+void SetEnabled(bool enabled)
+{
+    _frameStart = 0;
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+RYME_API
+void SetThreadName(StringView name)
+{
+    ThreadTrack * track = getThreadTrack();
+
+    std::lock_guard<std::mutex> lock(_trackListMutex);
+    track->Name = name;
+}
+
+RYME_API
+void RecordZone(const char * name, uint64_t start, uint64_t end)
+{
+    ThreadTrack * track = getThreadTrack();
+
+    // Only this thread writes to the track, so a relaxed load is enough
+    uint64_t head = track->Head.load(std::memory_order_relaxed);
+
+    ZoneSlot& slot = track->ZoneSlotList[head % ZoneCapacityPerThread];
+
+    // Readers copying the slot meanwhile see the sequence change, and discard their copy
+    slot.Sequence.store((head + 1) * 2 - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.Name.store(name, std::memory_order_relaxed);
+    slot.Start.store(start, std::memory_order_relaxed);
+    slot.End.store(end, std::memory_order_relaxed);
+
+    slot.Sequence.store((head + 1) * 2, std::memory_order_release);
+
+    track->Head.store(head + 1, std::memory_order_release);
+}
+
+RYME_API
+void MarkFrame()
+{
+    ++_frameCount;
+
+    if (not IsEnabled()) {
+        return;
+    }
+
+    uint64_t now = GetTimestamp();
+
+    if (_frameStart > 0) {
+        RecordZone("Frame", _frameStart, now);
+    }
+
+    _frameStart = now;
+}
+
+RYME_API
+uint64_t GetFrameCount()
+{
+    return _frameCount;
+}
+
+RYME_API
+void Clear()
+{
+    std::lock_guard<std::mutex> lock(_trackListMutex);
+
+    // Head is only ever written by the thread that owns the track
+    for (auto& track : _trackList) {
+        track->Tail.store(track->Head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+RYME_API
+List<ZoneStats> GetZoneStatsList()
+{
+    Map<StringView, ZoneStats> zoneStatsMap;
+
+    {
+        std::lock_guard<std::mutex> lock(_trackListMutex);
+
+        for (const auto& track : _trackList) {
+            for (const auto& zone : getZoneList(track.get())) {
+                double milliseconds = static_cast<double>(zone.End - zone.Start) / 1.0e6;
+
+                auto [it, inserted] = zoneStatsMap.try_emplace(zone.Name, ZoneStats{
+                    .Name = zone.Name,
+                    .Count = 0,
+                    .TotalMilliseconds = 0.0,
+                    .MinMilliseconds = milliseconds,
+                    .MaxMilliseconds = milliseconds,
+                });
+
+                auto& stats = it->second;
+                ++stats.Count;
+                stats.TotalMilliseconds += milliseconds;
+                stats.MinMilliseconds = std::min(stats.MinMilliseconds, milliseconds);
+                stats.MaxMilliseconds = std::max(stats.MaxMilliseconds, milliseconds);
+            }
+        }
+    }
+
+    List<ZoneStats> zoneStatsList;
+    zoneStatsList.reserve(zoneStatsMap.size());
+
+    for (auto& [name, stats] : zoneStatsMap) {
+        zoneStatsList.push_back(std::move(stats));
+    }
+
+    std::sort(
+        zoneStatsList.begin(),
+        zoneStatsList.end(),
+        [](const auto& a, const auto& b) {
+            return (a.TotalMilliseconds > b.TotalMilliseconds);
+        }
+    );
+
+    return zoneStatsList;
+}
+
+RYME_API
+bool WriteChromeTrace(const Path& path)
+{
+    FILE * file = fopen(path.ToCString(), "wt");
+    if (not file) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_trackListMutex);
+
+    List<List<Zone>> zoneListList;
+    zoneListList.reserve(_trackList.size());
+
+    // Timestamps are written relative to the oldest zone, to keep them readable
+    uint64_t epoch = UINT64_MAX;
+
+    for (const auto& track : _trackList) {
+        auto& zoneList = zoneListList.emplace_back(getZoneList(track.get()));
+        for (const auto& zone : zoneList) {
+            epoch = std::min(epoch, zone.Start);
+        }
+    }
+
+    fmt::print(file, "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    bool first = true;
+    for (size_t i = 0; i < _trackList.size(); ++i) {
+        const auto& track = _trackList[i];
+
+        fmt::print(file,
+            "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+            (first ? "" : ",\n"),
+            track->ThreadIndex,
+            escapeJSON(track->Name)
+        );
+        first = false;
+
+        for (const auto& zone : zoneListList[i]) {
+            // Chrome Trace Event timestamps are in microseconds
+            fmt::print(file,
+                ",\n{{\"name\":\"{}\",\"cat\":\"ryme\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+                escapeJSON(zone.Name),
+                static_cast<double>(zone.Start - epoch) / 1.0e3,
+                static_cast<double>(zone.End - zone.Start) / 1.0e3,
+                track->ThreadIndex
+            );
+        }
+    }
+
+    fmt::print(file, "\n]}}\n");
+
+    fclose(file);
+
+    Log(RYME_ANCHOR, "Wrote Chrome Trace '{}'", path);
+
+    return true;
+}
+
+RYME_API
+void ScriptInit(py::module m)
+{
+    auto profiler = m.def_submodule("Profiler");
+
+    py::class_<ZoneStats>(profiler, "ZoneStats")
+        .def_readonly("Name", &ZoneStats::Name)
+        .def_readonly("Count", &ZoneStats::Count)
+        .def_readonly("TotalMilliseconds", &ZoneStats::TotalMilliseconds)
+        .def_readonly("MinMilliseconds", &ZoneStats::MinMilliseconds)
+        .def_readonly("MaxMilliseconds", &ZoneStats::MaxMilliseconds);
+
+    profiler
+        .def("IsEnabled", &IsEnabled)
+        .def("SetEnabled", &SetEnabled)
+        .def("GetFrameCount", &GetFrameCount)
+        .def("Clear", &Clear)
+        .def("GetZoneStatsList", &GetZoneStatsList)
+        .def("WriteChromeTrace",
+            [](const String& path) {
+                return WriteChromeTrace(path);
+            });
+}
+
+} // namespace Profiler
+
+} // namespace ryme
\ No newline at end of file
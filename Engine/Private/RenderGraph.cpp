@@ -0,0 +1,954 @@
+#include <Ryme/RenderGraph.hpp>
+#include <Ryme/Color.hpp>
+#include <Ryme/Exception.hpp>
+#include <Ryme/Graphics.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/PipelineCache.hpp>
+
+#include <algorithm>
+
+namespace ryme {
+
+constexpr vk::AccessFlags WriteAccessMask = (
+    vk::AccessFlagBits::eColorAttachmentWrite |
+    vk::AccessFlagBits::eDepthStencilAttachmentWrite |
+    vk::AccessFlagBits::eShaderWrite |
+    vk::AccessFlagBits::eTransferWrite
+);
+
+inline bool hasStencilComponent(vk::Format format)
+{
+    return (
+        format == vk::Format::eS8Uint or
+        format == vk::Format::eD16UnormS8Uint or
+        format == vk::Format::eD24UnormS8Uint or
+        format == vk::Format::eD32SfloatS8Uint
+    );
+}
+
+inline bool isDepthFormat(vk::Format format)
+{
+    return (
+        format == vk::Format::eD16Unorm or
+        format == vk::Format::eX8D24UnormPack32 or
+        format == vk::Format::eD32Sfloat or
+        hasStencilComponent(format)
+    );
+}
+
+inline vk::ImageAspectFlags getImageAspectMask(vk::Format format)
+{
+    if (not isDepthFormat(format)) {
+        return vk::ImageAspectFlagBits::eColor;
+    }
+
+    // Without separateDepthStencilLayouts, both aspects must be transitioned together
+    if (hasStencilComponent(format)) {
+        return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+    }
+
+    return vk::ImageAspectFlagBits::eDepth;
+}
+
+RYME_API
+void RenderGraphPass::AddColorAttachment(RenderGraphImage image, std::optional<Vec4> clearColor /*= std::nullopt*/)
+{
+    std::optional<vk::ClearValue> clearValue;
+    if (clearColor) {
+        clearValue = vk::ClearValue(vk::ClearColorValue(Color::ToArray(*clearColor)));
+    }
+
+    _accessList.push_back(Access{
+        .Image = image,
+        .Type = AccessType::ColorAttachment,
+        .ClearValue = clearValue,
+        .StageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput,
+    });
+}
+
+RYME_API
+void RenderGraphPass::SetDepthAttachment(RenderGraphImage image, std::optional<float> clearDepth /*= std::nullopt*/)
+{
+    std::optional<vk::ClearValue> clearValue;
+    if (clearDepth) {
+        clearValue = vk::ClearValue(vk::ClearDepthStencilValue(*clearDepth, 0));
+    }
+
+    _accessList.push_back(Access{
+        .Image = image,
+        .Type = AccessType::DepthAttachment,
+        .ClearValue = clearValue,
+        .StageMask = (
+            vk::PipelineStageFlagBits::eEarlyFragmentTests |
+            vk::PipelineStageFlagBits::eLateFragmentTests
+        ),
+    });
+}
+
+RYME_API
+void RenderGraphPass::SetDepthInput(RenderGraphImage image)
+{
+    _accessList.push_back(Access{
+        .Image = image,
+        .Type = AccessType::DepthInput,
+        .ClearValue = std::nullopt,
+        .StageMask = (
+            vk::PipelineStageFlagBits::eEarlyFragmentTests |
+            vk::PipelineStageFlagBits::eLateFragmentTests
+        ),
+    });
+}
+
+RYME_API
+void RenderGraphPass::AddSampledImage(
+    RenderGraphImage image,
+    vk::PipelineStageFlags stageMask /*= vk::PipelineStageFlagBits::eFragmentShader*/
+)
+{
+    _accessList.push_back(Access{
+        .Image = image,
+        .Type = AccessType::Sampled,
+        .ClearValue = std::nullopt,
+        .StageMask = stageMask,
+    });
+}
+
+RYME_API
+RenderGraph::RenderGraph()
+{
+    Reset();
+}
+
+RYME_API
+RenderGraph::~RenderGraph()
+{
+    free();
+}
+
+RYME_API
+void RenderGraph::SetBackbuffer(
+    vk::Format format,
+    vk::Extent2D extent,
+    const List<vk::Image>& imageList,
+    const List<vk::ImageView>& imageViewList
+)
+{
+    auto& backbuffer = _imageList[Backbuffer];
+    backbuffer.Info.Format = format;
+    backbuffer.Info.Extent = extent;
+
+    _backbufferImageList = imageList;
+    _backbufferImageViewList = imageViewList;
+}
+
+RYME_API
+RenderGraphImage RenderGraph::CreateImage(StringView name, const RenderGraphImageInfo& info)
+{
+    _imageList.push_back(Image{
+        .Name = String(name),
+        .Info = info,
+    });
+
+    return static_cast<RenderGraphImage>(_imageList.size() - 1);
+}
+
+RYME_API
+RenderGraphPass& RenderGraph::AddPass(StringView name)
+{
+    _passList.push_back(std::make_unique<RenderGraphPass>(name));
+    return *_passList.back();
+}
+
+RYME_API
+RenderGraphPass * RenderGraph::FindPass(StringView name)
+{
+    for (auto& pass : _passList) {
+        if (pass->_name == name) {
+            return pass.get();
+        }
+    }
+
+    return nullptr;
+}
+
+RYME_API
+void RenderGraph::Compile()
+{
+    RYME_BENCHMARK_START();
+
+    free();
+
+    const auto& backbufferExtent = _imageList[Backbuffer].Info.Extent;
+
+    for (auto& image : _imageList) {
+        image.Extent = image.Info.Extent;
+
+        if (image.Extent.width == 0 or image.Extent.height == 0) {
+            image.Extent = vk::Extent2D(
+                std::max(static_cast<uint32_t>(backbufferExtent.width * image.Info.Scale), 1u),
+                std::max(static_cast<uint32_t>(backbufferExtent.height * image.Info.Scale), 1u)
+            );
+        }
+
+        image.Usage = {};
+        image.FirstPass = -1;
+        image.LastPass = -1;
+        image.IsLazilyAllocated = false;
+    }
+
+    cullPasses();
+    createImages();
+    compilePasses();
+
+    RYME_BENCHMARK_END();
+}
+
+RYME_API
+void RenderGraph::Execute(vk::CommandBuffer commandBuffer, uint32_t backbufferIndex)
+{
+    List<vk::ImageMemoryBarrier> imageMemoryBarrierList;
+
+    auto getImageMemoryBarrier = [&](const RenderGraphPass::Barrier& barrier) {
+        const auto& image = _imageList[barrier.Image];
+
+        vk::ImageSubresourceRange subresourceRange(
+            getImageAspectMask(image.Info.Format),
+            0, 1, 0, 1
+        );
+
+        return vk::ImageMemoryBarrier()
+            .setSrcAccessMask(barrier.SrcAccessMask)
+            .setDstAccessMask(barrier.DstAccessMask)
+            .setOldLayout(barrier.OldLayout)
+            .setNewLayout(barrier.NewLayout)
+            .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setImage(getVkImage(barrier.Image, backbufferIndex))
+            .setSubresourceRange(subresourceRange);
+    };
+
+    for (auto& pass : _passList) {
+        if (pass->_isCulled) {
+            continue;
+        }
+
+        if (not pass->_barrierList.empty()) {
+            imageMemoryBarrierList.clear();
+            for (const auto& barrier : pass->_barrierList) {
+                imageMemoryBarrierList.push_back(getImageMemoryBarrier(barrier));
+            }
+
+            commandBuffer.pipelineBarrier(
+                pass->_srcStageMask,
+                pass->_dstStageMask,
+                {},
+                nullptr,
+                nullptr,
+                imageMemoryBarrierList
+            );
+        }
+
+        if (pass->_renderPass) {
+            size_t framebufferIndex = 0;
+            if (pass->_framebufferList.size() > 1) {
+                framebufferIndex = backbufferIndex;
+            }
+
+            auto renderArea = vk::Rect2D()
+                .setOffset({ 0, 0 })
+                .setExtent(pass->_extent);
+
+            auto renderPassBeginInfo = vk::RenderPassBeginInfo()
+                .setRenderPass(pass->_renderPass)
+                .setFramebuffer(pass->_framebufferList[framebufferIndex])
+                .setRenderArea(renderArea)
+                .setClearValues(pass->_clearValueList);
+
+            commandBuffer.beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
+
+            auto viewport = vk::Viewport()
+                .setX(0.0f)
+                .setY(0.0f)
+                .setWidth(static_cast<float>(pass->_extent.width))
+                .setHeight(static_cast<float>(pass->_extent.height))
+                .setMinDepth(0.0f)
+                .setMaxDepth(1.0f);
+
+            commandBuffer.setViewport(0, viewport);
+            commandBuffer.setScissor(0, renderArea);
+        }
+
+        if (pass->_executeFunc) {
+            pass->_executeFunc(commandBuffer);
+        }
+
+        if (pass->_renderPass) {
+            commandBuffer.endRenderPass();
+        }
+    }
+
+    auto presentImageMemoryBarrier = getImageMemoryBarrier(_presentBarrier);
+
+    commandBuffer.pipelineBarrier(
+        _presentSrcStageMask,
+        vk::PipelineStageFlagBits::eBottomOfPipe,
+        {},
+        nullptr,
+        nullptr,
+        presentImageMemoryBarrier
+    );
+}
+
+RYME_API
+void RenderGraph::Reset()
+{
+    free();
+
+    _passList.clear();
+    _imageList.clear();
+
+    _imageList.push_back(Image{
+        .Name = "Backbuffer",
+    });
+}
+
+void RenderGraph::free()
+{
+    List<vk::Image> imageList;
+    List<vk::ImageView> imageViewList;
+    List<VmaAllocation> allocationList = std::move(_allocationList);
+    _allocationList.clear();
+
+    for (auto& image : _imageList) {
+        if (image.VkImageView) {
+            imageViewList.push_back(image.VkImageView);
+        }
+
+        if (image.VkImage) {
+            imageList.push_back(image.VkImage);
+        }
+
+        if (image.Allocation) {
+            allocationList.push_back(image.Allocation);
+        }
+
+        image.VkImageView = nullptr;
+        image.VkImage = nullptr;
+        image.Allocation = nullptr;
+    }
+
+    List<vk::RenderPass> renderPassList;
+    List<vk::Framebuffer> framebufferList;
+
+    for (auto& pass : _passList) {
+        if (pass->_renderPass) {
+            // The handle can be given to the next render pass, which must not share these pipelines
+            PipelineCache::EraseDependents(pass->_renderPass);
+            renderPassList.push_back(pass->_renderPass);
+        }
+
+        framebufferList.insert(
+            framebufferList.end(),
+            pass->_framebufferList.begin(),
+            pass->_framebufferList.end()
+        );
+
+        pass->_renderPass = nullptr;
+        pass->_framebufferList.clear();
+    }
+
+    if (imageList.empty() and renderPassList.empty()) {
+        return;
+    }
+
+    Graphics::DeferDestroy(
+        [
+            imageViewList = std::move(imageViewList),
+            imageList = std::move(imageList),
+            allocationList = std::move(allocationList),
+            framebufferList = std::move(framebufferList),
+            renderPassList = std::move(renderPassList)
+        ]() {
+            for (auto framebuffer : framebufferList) {
+                Graphics::Device.destroyFramebuffer(framebuffer);
+            }
+
+            for (auto renderPass : renderPassList) {
+                Graphics::Device.destroyRenderPass(renderPass);
+            }
+
+            for (auto imageView : imageViewList) {
+                Graphics::Device.destroyImageView(imageView);
+            }
+
+            for (auto image : imageList) {
+                Graphics::Device.destroyImage(image);
+            }
+
+            for (auto allocation : allocationList) {
+                Graphics::FreeMemory(allocation);
+            }
+        }
+    );
+}
+
+void RenderGraph::cullPasses()
+{
+    // Walk backwards from the backbuffer, keeping only the passes that write an image
+    // which is read by a pass that has already been kept
+    List<bool> isImageNeededList(_imageList.size(), false);
+    isImageNeededList[Backbuffer] = true;
+
+    for (auto it = _passList.rbegin(); it != _passList.rend(); ++it) {
+        auto& pass = *it;
+
+        bool isNeeded = not pass->_isCullable;
+
+        for (const auto& access : pass->_accessList) {
+            bool isWrite = (
+                access.Type == RenderGraphPass::AccessType::ColorAttachment or
+                access.Type == RenderGraphPass::AccessType::DepthAttachment
+            );
+
+            if (isWrite and isImageNeededList[access.Image]) {
+                isNeeded = true;
+            }
+        }
+
+        pass->_isCulled = not isNeeded;
+
+        if (pass->_isCulled) {
+            Log(RYME_ANCHOR, "Render Graph Pass '{}' was culled", pass->_name);
+            continue;
+        }
+
+        // Cleared images are completely overwritten, so any earlier writes to them are not needed
+        for (const auto& access : pass->_accessList) {
+            if (access.ClearValue) {
+                isImageNeededList[access.Image] = false;
+            }
+        }
+
+        // Everything else reads the previous contents, including attachments that are not cleared
+        for (const auto& access : pass->_accessList) {
+            if (not access.ClearValue) {
+                isImageNeededList[access.Image] = true;
+            }
+        }
+    }
+}
+
+void RenderGraph::createImages()
+{
+    for (size_t passIndex = 0; passIndex < _passList.size(); ++passIndex) {
+        const auto& pass = _passList[passIndex];
+
+        if (pass->_isCulled) {
+            continue;
+        }
+
+        for (const auto& access : pass->_accessList) {
+            if (access.Image >= _imageList.size()) {
+                throw Exception("Render Graph Pass '{}' uses an invalid image", pass->_name);
+            }
+
+            auto& image = _imageList[access.Image];
+
+            if (image.FirstPass < 0) {
+                image.FirstPass = static_cast<int>(passIndex);
+            }
+
+            image.LastPass = static_cast<int>(passIndex);
+
+            switch (access.Type) {
+            case RenderGraphPass::AccessType::ColorAttachment:
+                image.Usage |= vk::ImageUsageFlagBits::eColorAttachment;
+                break;
+            case RenderGraphPass::AccessType::DepthAttachment:
+            case RenderGraphPass::AccessType::DepthInput:
+                image.Usage |= vk::ImageUsageFlagBits::eDepthStencilAttachment;
+                break;
+            case RenderGraphPass::AccessType::Sampled:
+                image.Usage |= vk::ImageUsageFlagBits::eSampled;
+                break;
+            }
+        }
+    }
+
+    // Tile-based GPUs can keep attachments in on-chip memory and never back them with real memory
+    const VkPhysicalDeviceMemoryProperties * memoryProperties = nullptr;
+    vmaGetMemoryProperties(Graphics::Allocator, &memoryProperties);
+
+    bool hasLazilyAllocatedMemory = false;
+    for (uint32_t i = 0; i < memoryProperties->memoryTypeCount; ++i) {
+        if (memoryProperties->memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) {
+            hasLazilyAllocatedMemory = true;
+            break;
+        }
+    }
+
+    List<RenderGraphImage> aliasedImageList;
+    List<vk::MemoryRequirements> memoryRequirementsList(_imageList.size());
+
+    vk::DeviceSize requestedSize = 0;
+
+    // The backbuffer is owned by the swapchain
+    for (RenderGraphImage index = Backbuffer + 1; index < _imageList.size(); ++index) {
+        auto& image = _imageList[index];
+
+        if (image.FirstPass < 0) {
+            continue;
+        }
+
+        if (image.Info.Format == vk::Format::eUndefined) {
+            throw Exception("Render Graph Image '{}' has no format", image.Name);
+        }
+
+        // Images that never leave a single pass never need to be stored to memory
+        image.IsLazilyAllocated = (
+            hasLazilyAllocatedMemory and
+            image.FirstPass == image.LastPass and
+            not (image.Usage & vk::ImageUsageFlagBits::eSampled)
+        );
+
+        if (image.IsLazilyAllocated) {
+            image.Usage |= vk::ImageUsageFlagBits::eTransientAttachment;
+        }
+
+        auto imageCreateInfo = vk::ImageCreateInfo()
+            .setImageType(vk::ImageType::e2D)
+            .setFormat(image.Info.Format)
+            .setExtent(vk::Extent3D(image.Extent, 1))
+            .setMipLevels(1)
+            .setArrayLayers(1)
+            .setTiling(vk::ImageTiling::eOptimal)
+            .setUsage(image.Usage);
+
+        if (image.IsLazilyAllocated) {
+            auto allocationCreateInfo = VmaAllocationCreateInfo{
+                .usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED,
+            };
+
+            std::tie(image.VkImage, image.Allocation) = Graphics::CreateImage(
+                imageCreateInfo,
+                allocationCreateInfo,
+                nullptr,
+                Graphics::MemoryCategory::RenderTarget
+            );
+        }
+        else {
+            image.VkImage = Graphics::Device.createImage(imageCreateInfo);
+
+            memoryRequirementsList[index] = Graphics::Device.getImageMemoryRequirements(image.VkImage);
+            requestedSize += memoryRequirementsList[index].size;
+
+            aliasedImageList.push_back(index);
+        }
+    }
+
+    // Place the largest images first, so the smaller ones can fill the gaps in their lifetimes
+    std::sort(
+        aliasedImageList.begin(),
+        aliasedImageList.end(),
+        [&](auto a, auto b) {
+            return (memoryRequirementsList[a].size > memoryRequirementsList[b].size);
+        }
+    );
+
+    struct MemoryBlock
+    {
+        vk::MemoryRequirements MemoryRequirements;
+
+        List<RenderGraphImage> ImageList;
+
+    }; // struct MemoryBlock
+
+    List<MemoryBlock> memoryBlockList;
+
+    auto isOverlapping = [&](RenderGraphImage a, RenderGraphImage b) {
+        return not (
+            _imageList[a].LastPass < _imageList[b].FirstPass or
+            _imageList[b].LastPass < _imageList[a].FirstPass
+        );
+    };
+
+    for (auto index : aliasedImageList) {
+        const auto& memoryRequirements = memoryRequirementsList[index];
+
+        MemoryBlock * memoryBlock = nullptr;
+
+        for (auto& block : memoryBlockList) {
+            if (not (block.MemoryRequirements.memoryTypeBits & memoryRequirements.memoryTypeBits)) {
+                continue;
+            }
+
+            bool isAvailable = std::none_of(
+                block.ImageList.begin(),
+                block.ImageList.end(),
+                [&](auto other) {
+                    return isOverlapping(index, other);
+                }
+            );
+
+            if (isAvailable) {
+                memoryBlock = &block;
+                break;
+            }
+        }
+
+        if (not memoryBlock) {
+            memoryBlock = &memoryBlockList.emplace_back(MemoryBlock{
+                .MemoryRequirements = memoryRequirements,
+            });
+        }
+        else {
+            auto& blockRequirements = memoryBlock->MemoryRequirements;
+            blockRequirements.size = std::max(blockRequirements.size, memoryRequirements.size);
+            blockRequirements.alignment = std::max(blockRequirements.alignment, memoryRequirements.alignment);
+            blockRequirements.memoryTypeBits &= memoryRequirements.memoryTypeBits;
+        }
+
+        memoryBlock->ImageList.push_back(index);
+    }
+
+    vk::DeviceSize allocatedSize = 0;
+
+    for (const auto& block : memoryBlockList) {
+        auto allocationCreateInfo = VmaAllocationCreateInfo{
+            .usage = VMA_MEMORY_USAGE_GPU_ONLY,
+        };
+
+        VmaAllocation allocation;
+
+        auto vkResult = (vk::Result)vmaAllocateMemory(
+            Graphics::Allocator,
+            reinterpret_cast<const VkMemoryRequirements *>(&block.MemoryRequirements),
+            &allocationCreateInfo,
+            &allocation,
+            nullptr
+        );
+
+        vk::resultCheck(vkResult, "vmaAllocateMemory");
+
+        Graphics::TrackAllocation(allocation, Graphics::MemoryCategory::RenderTarget);
+
+        _allocationList.push_back(allocation);
+        allocatedSize += block.MemoryRequirements.size;
+
+        for (auto index : block.ImageList) {
+            vkResult = (vk::Result)vmaBindImageMemory(
+                Graphics::Allocator,
+                allocation,
+                _imageList[index].VkImage
+            );
+
+            vk::resultCheck(vkResult, "vmaBindImageMemory");
+        }
+    }
+
+    Log(RYME_ANCHOR, "Render Graph Transient Memory: {} KiB, {} KiB without aliasing",
+        allocatedSize / 1024,
+        requestedSize / 1024
+    );
+
+    // Image views can only be created once the image is bound to memory
+    for (RenderGraphImage index = Backbuffer + 1; index < _imageList.size(); ++index) {
+        auto& image = _imageList[index];
+
+        if (not image.VkImage) {
+            continue;
+        }
+
+        // Views of depth/stencil images used for sampling can only contain one aspect
+        auto aspectMask = getImageAspectMask(image.Info.Format);
+        if (aspectMask & vk::ImageAspectFlagBits::eDepth) {
+            aspectMask = vk::ImageAspectFlagBits::eDepth;
+        }
+
+        auto imageViewCreateInfo = vk::ImageViewCreateInfo()
+            .setImage(image.VkImage)
+            .setViewType(vk::ImageViewType::e2D)
+            .setFormat(image.Info.Format)
+            .setSubresourceRange({ aspectMask, 0, 1, 0, 1 });
+
+        image.VkImageView = Graphics::Device.createImageView(imageViewCreateInfo);
+    }
+}
+
+void RenderGraph::compilePasses()
+{
+    struct ImageState
+    {
+        bool IsFirstUse = true;
+
+        vk::ImageLayout Layout = vk::ImageLayout::eUndefined;
+
+        // Stages and accesses of the most recent write, or layout transition
+        vk::PipelineStageFlags WriteStageMask;
+
+        vk::AccessFlags WriteAccessMask;
+
+        // Stages that have read the image since it was last written
+        vk::PipelineStageFlags ReadStageMask;
+
+    }; // struct ImageState
+
+    List<ImageState> imageStateList(_imageList.size());
+
+    for (size_t passIndex = 0; passIndex < _passList.size(); ++passIndex) {
+        auto& pass = _passList[passIndex];
+
+        if (pass->_isCulled) {
+            continue;
+        }
+
+        pass->_barrierList.clear();
+        pass->_srcStageMask = {};
+        pass->_dstStageMask = {};
+        pass->_clearValueList.clear();
+        pass->_extent = vk::Extent2D(0, 0);
+
+        List<vk::AttachmentDescription> attachmentDescriptionList;
+        List<vk::AttachmentReference> colorAttachmentReferenceList;
+        std::optional<vk::AttachmentReference> depthAttachmentReference;
+        List<RenderGraphImage> attachmentImageList;
+
+        for (const auto& access : pass->_accessList) {
+            const auto& image = _imageList[access.Image];
+            auto& state = imageStateList[access.Image];
+
+            vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+            vk::AccessFlags accessMask;
+
+            switch (access.Type) {
+            case RenderGraphPass::AccessType::ColorAttachment:
+                layout = vk::ImageLayout::eColorAttachmentOptimal;
+                accessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+                if (not access.ClearValue) {
+                    accessMask |= vk::AccessFlagBits::eColorAttachmentRead;
+                }
+                break;
+            case RenderGraphPass::AccessType::DepthAttachment:
+                layout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+                accessMask = (
+                    vk::AccessFlagBits::eDepthStencilAttachmentRead |
+                    vk::AccessFlagBits::eDepthStencilAttachmentWrite
+                );
+                break;
+            case RenderGraphPass::AccessType::DepthInput:
+                layout = vk::ImageLayout::eDepthStencilReadOnlyOptimal;
+                accessMask = vk::AccessFlagBits::eDepthStencilAttachmentRead;
+                break;
+            case RenderGraphPass::AccessType::Sampled:
+                layout = vk::ImageLayout::eShaderReadOnlyOptimal;
+                accessMask = vk::AccessFlagBits::eShaderRead;
+                break;
+            }
+
+            bool isWrite = bool(accessMask & WriteAccessMask);
+            bool isFirstUse = state.IsFirstUse;
+
+            /// Barrier
+
+            std::optional<RenderGraphPass::Barrier> barrier;
+
+            if (state.IsFirstUse) {
+                // The previous contents are discarded, whether they are from the last frame or
+                // from another image sharing the same memory, so wait for anything before this
+                barrier = RenderGraphPass::Barrier{
+                    .Image = access.Image,
+                    .OldLayout = vk::ImageLayout::eUndefined,
+                    .NewLayout = layout,
+                    .SrcAccessMask = WriteAccessMask,
+                    .DstAccessMask = accessMask,
+                };
+
+                pass->_srcStageMask |= vk::PipelineStageFlagBits::eAllCommands;
+            }
+            else if (state.Layout != layout or isWrite) {
+                barrier = RenderGraphPass::Barrier{
+                    .Image = access.Image,
+                    .OldLayout = state.Layout,
+                    .NewLayout = layout,
+                    .SrcAccessMask = state.WriteAccessMask,
+                    .DstAccessMask = accessMask,
+                };
+
+                pass->_srcStageMask |= state.WriteStageMask | state.ReadStageMask;
+            }
+            else if (state.WriteStageMask and (access.StageMask & ~state.ReadStageMask)) {
+                // Already in the right layout, but the write has not been made visible to this stage
+                barrier = RenderGraphPass::Barrier{
+                    .Image = access.Image,
+                    .OldLayout = layout,
+                    .NewLayout = layout,
+                    .SrcAccessMask = state.WriteAccessMask,
+                    .DstAccessMask = accessMask,
+                };
+
+                pass->_srcStageMask |= state.WriteStageMask;
+            }
+
+            if (barrier) {
+                pass->_barrierList.push_back(*barrier);
+                pass->_dstStageMask |= access.StageMask;
+            }
+
+            if (isWrite) {
+                state.WriteStageMask = access.StageMask;
+                state.WriteAccessMask = accessMask & WriteAccessMask;
+                state.ReadStageMask = {};
+            }
+            else {
+                // Later readers in other stages must wait for the layout transition as well
+                if (state.Layout != layout) {
+                    state.WriteStageMask |= access.StageMask;
+                }
+
+                state.ReadStageMask |= access.StageMask;
+            }
+
+            state.IsFirstUse = false;
+            state.Layout = layout;
+
+            /// Attachment
+
+            if (access.Type == RenderGraphPass::AccessType::Sampled) {
+                continue;
+            }
+
+            if (pass->_extent.width == 0) {
+                pass->_extent = image.Extent;
+            }
+            else if (pass->_extent != image.Extent) {
+                throw Exception("Render Graph Pass '{}' has attachments of different sizes", pass->_name);
+            }
+
+            auto loadOp = vk::AttachmentLoadOp::eLoad;
+            if (access.ClearValue) {
+                loadOp = vk::AttachmentLoadOp::eClear;
+            }
+            else if (isFirstUse) {
+                loadOp = vk::AttachmentLoadOp::eDontCare;
+            }
+
+            // Read-only attachments are stored so the implementation does not treat them as written
+            bool isStored = (
+                access.Image == Backbuffer or
+                image.LastPass > static_cast<int>(passIndex) or
+                access.Type == RenderGraphPass::AccessType::DepthInput
+            );
+
+            auto storeOp = (isStored ? vk::AttachmentStoreOp::eStore : vk::AttachmentStoreOp::eDontCare);
+
+            bool hasStencil = hasStencilComponent(image.Info.Format);
+
+            // Layout transitions are handled by the barriers, so the render pass never changes them
+            attachmentDescriptionList.push_back(
+                vk::AttachmentDescription()
+                    .setFormat(image.Info.Format)
+                    .setSamples(vk::SampleCountFlagBits::e1)
+                    .setLoadOp(loadOp)
+                    .setStoreOp(storeOp)
+                    .setStencilLoadOp(hasStencil ? loadOp : vk::AttachmentLoadOp::eDontCare)
+                    .setStencilStoreOp(hasStencil ? storeOp : vk::AttachmentStoreOp::eDontCare)
+                    .setInitialLayout(layout)
+                    .setFinalLayout(layout)
+            );
+
+            auto attachmentReference = vk::AttachmentReference()
+                .setAttachment(static_cast<uint32_t>(attachmentImageList.size()))
+                .setLayout(layout);
+
+            if (access.Type == RenderGraphPass::AccessType::ColorAttachment) {
+                colorAttachmentReferenceList.push_back(attachmentReference);
+            }
+            else {
+                depthAttachmentReference = attachmentReference;
+            }
+
+            pass->_clearValueList.push_back(access.ClearValue.value_or(vk::ClearValue()));
+            attachmentImageList.push_back(access.Image);
+        }
+
+        if (attachmentImageList.empty()) {
+            continue;
+        }
+
+        /// Render Pass
+
+        auto subpassDescription = vk::SubpassDescription()
+            .setPipelineBindPoint(vk::PipelineBindPoint::eGraphics)
+            .setColorAttachments(colorAttachmentReferenceList);
+
+        if (depthAttachmentReference) {
+            subpassDescription.setPDepthStencilAttachment(&*depthAttachmentReference);
+        }
+
+        auto renderPassCreateInfo = vk::RenderPassCreateInfo()
+            .setAttachments(attachmentDescriptionList)
+            .setSubpasses(subpassDescription);
+
+        pass->_renderPass = Graphics::Device.createRenderPass(renderPassCreateInfo);
+
+        /// Framebuffer List
+
+        bool rendersToBackbuffer = ListContains(attachmentImageList, Backbuffer);
+
+        size_t framebufferCount = (rendersToBackbuffer ? _backbufferImageViewList.size() : 1);
+
+        List<vk::ImageView> attachmentList(attachmentImageList.size());
+
+        for (uint32_t i = 0; i < framebufferCount; ++i) {
+            for (size_t j = 0; j < attachmentImageList.size(); ++j) {
+                attachmentList[j] = getVkImageView(attachmentImageList[j], i);
+            }
+
+            auto framebufferCreateInfo = vk::FramebufferCreateInfo()
+                .setRenderPass(pass->_renderPass)
+                .setAttachments(attachmentList)
+                .setWidth(pass->_extent.width)
+                .setHeight(pass->_extent.height)
+                .setLayers(1);
+
+            pass->_framebufferList.push_back(
+                Graphics::Device.createFramebuffer(framebufferCreateInfo)
+            );
+        }
+    }
+
+    const auto& backbufferState = imageStateList[Backbuffer];
+
+    _presentBarrier = RenderGraphPass::Barrier{
+        .Image = Backbuffer,
+        .OldLayout = backbufferState.Layout,
+        .NewLayout = vk::ImageLayout::ePresentSrcKHR,
+        .SrcAccessMask = backbufferState.WriteAccessMask,
+        .DstAccessMask = {},
+    };
+
+    _presentSrcStageMask = backbufferState.WriteStageMask | backbufferState.ReadStageMask;
+    if (backbufferState.IsFirstUse) {
+        _presentSrcStageMask = vk::PipelineStageFlagBits::eAllCommands;
+    }
+}
+
+vk::Image RenderGraph::getVkImage(RenderGraphImage image, uint32_t backbufferIndex)
+{
+    if (image == Backbuffer) {
+        return _backbufferImageList[backbufferIndex];
+    }
+
+    return _imageList[image].VkImage;
+}
+
+vk::ImageView RenderGraph::getVkImageView(RenderGraphImage image, uint32_t backbufferIndex)
+{
+    if (image == Backbuffer) {
+        return _backbufferImageViewList[backbufferIndex];
+    }
+
+    return _imageList[image].VkImageView;
+}
+
+} // namespace ryme
\ No newline at end of file
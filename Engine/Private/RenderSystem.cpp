@@ -1,5 +1,10 @@
 #include <Ryme/RenderSystem.hpp>
+#include <Ryme/Graphics.hpp>
 #include <Ryme/Log.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
 
 namespace ryme {
 
@@ -17,4 +22,162 @@ void RenderSystem::RemoveModelComponent(ModelComponent * modelComponent)
     ListRemove(_modelComponentList, modelComponent);
 }
 
+void RenderSystem::SelectLODs(const Camera& camera, float viewportHeight)
+{
+    RYME_PROFILE_FUNCTION();
+
+    _lodStats = {};
+
+    // The projection maps tan(fov / 2) to the edge of the viewport, so it also gives the size of a
+    // unit on the screen at a distance of one
+    Mat4 projection = camera.GetProjection();
+    float pixelsPerUnitAtOne = std::fabs(projection[1][1]) * viewportHeight * 0.5f;
+
+    bool isPerspective = (camera.GetMode() == Camera::Mode::Perspective);
+    Vec3 cameraPosition = camera.GetWorldPosition();
+
+    for (auto modelComponent : _modelComponentList) {
+        Model * model = modelComponent->GetModel();
+        if (not model or not model->IsLoaded()) {
+            continue;
+        }
+
+        Entity * entity = modelComponent->GetEntity();
+
+        Vec3 scale = entity->GetWorldScale();
+        float maxScale = std::max(std::fabs(scale.x), std::max(std::fabs(scale.y), std::fabs(scale.z)));
+
+        float pixelsPerUnit = pixelsPerUnitAtOne;
+
+        if (isPerspective) {
+            Vec3 center = entity->GetWorldPosition()
+                + entity->GetWorldOrientation() * (model->GetBoundingCenter() * scale);
+
+            // The closest point of the bounds is the one with the largest error on the screen
+            float distance = glm::length(center - cameraPosition) - model->GetBoundingRadius() * maxScale;
+            pixelsPerUnit /= std::max(distance, camera.GetNear());
+        }
+
+        uint32_t currentLOD = modelComponent->GetLOD();
+        uint32_t lod = SelectLOD(
+            model->GetLODErrorList(),
+            pixelsPerUnit * maxScale,
+            currentLOD,
+            _lodThreshold,
+            _lodHysteresis
+        );
+
+        modelComponent->SetLOD(lod);
+
+        ++_lodStats.InstanceCount;
+        _lodStats.TriangleCount += model->GetTriangleCount(lod);
+        _lodStats.FullTriangleCount += model->GetTriangleCount(0);
+
+        if (lod != currentLOD) {
+            ++_lodStats.SwitchCount;
+        }
+    }
+
+    // The draws are pre-recorded with the LOD chosen at the time
+    if (_lodStats.SwitchCount > 0) {
+        Graphics::InvalidateCommandBuffers();
+    }
+}
+
+void RenderSystem::CullOccluded(const Camera& camera, ThreadPool * threadPool /*= nullptr*/)
+{
+    RYME_PROFILE_FUNCTION();
+
+    _occlusionStats = {};
+
+    _occlusionBuffer.Clear(camera.GetProjection() * camera.GetView());
+
+    // The matrices are needed again for testing, so they are only calculated once
+    List<Mat4> modelMatrixList;
+    modelMatrixList.reserve(_modelComponentList.size());
+
+    for (auto modelComponent : _modelComponentList) {
+        Model * model = modelComponent->GetModel();
+        Mat4 modelMatrix = modelComponent->GetEntity()->GetWorldTransform().ToMatrix();
+
+        modelMatrixList.push_back(modelMatrix);
+
+        if (modelComponent->IsOccluder() and model and model->IsLoaded()) {
+            _occlusionBuffer.AddOccluder(model->GetOccluderMesh(), modelMatrix);
+        }
+    }
+
+    _occlusionBuffer.Rasterize(threadPool);
+
+    const auto& stats = _occlusionBuffer.GetStats();
+    _occlusionStats.OccluderCount = stats.OccluderCount;
+    _occlusionStats.OccluderTriangleCount = stats.TriangleCount;
+
+    bool isChanged = false;
+
+    for (size_t i = 0; i < _modelComponentList.size(); ++i) {
+        auto modelComponent = _modelComponentList[i];
+
+        bool wasVisible = modelComponent->IsVisible();
+
+        Model * model = modelComponent->GetModel();
+        if (not model or not model->IsLoaded()) {
+            modelComponent->SetVisible(true);
+            isChanged |= not wasVisible;
+            continue;
+        }
+
+        bool visible = _occlusionBuffer.IsBoxVisible(
+            model->GetBoundsMin(),
+            model->GetBoundsMax(),
+            modelMatrixList[i]
+        );
+
+        modelComponent->SetVisible(visible);
+        isChanged |= (visible != wasVisible);
+
+        ++_occlusionStats.TestedCount;
+
+        if (not visible) {
+            ++_occlusionStats.OccludedCount;
+        }
+    }
+
+    // The draws are pre-recorded, skipping the models that were hidden at the time
+    if (isChanged) {
+        Graphics::InvalidateCommandBuffers();
+    }
+}
+
+uint32_t RenderSystem::SelectLOD(
+    Span<const float> lodErrorList,
+    float pixelsPerUnit,
+    uint32_t currentLOD,
+    float threshold,
+    float hysteresis
+)
+{
+    if (lodErrorList.empty()) {
+        return 0;
+    }
+
+    uint32_t lastLOD = static_cast<uint32_t>(lodErrorList.size() - 1);
+    currentLOD = std::min(currentLOD, lastLOD);
+
+    auto getLeastDetailedLOD = [&](float maxPixels) {
+        uint32_t lod = 0;
+        while (lod < lastLOD and lodErrorList[lod + 1] * pixelsPerUnit <= maxPixels) {
+            ++lod;
+        }
+        return lod;
+    };
+
+    // The current LOD is too coarse, switch to a more detailed one immediately
+    if (lodErrorList[currentLOD] * pixelsPerUnit > threshold) {
+        return getLeastDetailedLOD(threshold);
+    }
+
+    return std::max(currentLOD, getLeastDetailedLOD(threshold * (1.0f - hysteresis)));
+}
+
 } // namespace ryme
\ No newline at end of file
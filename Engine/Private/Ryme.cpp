@@ -1,5 +1,7 @@
 #include <Ryme/Ryme.hpp>
 
+#include <memory>
+
 namespace ryme {
 
 bool _isRunning = false;
@@ -8,11 +10,15 @@ String _applicationName;
 
 Version _applicationVersion;
 
+std::unique_ptr<ThreadPool> _threadPool;
+
 RYME_API
 void Init(const InitInfo& initInfo /*= {}*/)
 {
     RYME_BENCHMARK_START();
 
+    Profiler::SetThreadName("Main");
+
     _applicationName = initInfo.ApplicationName;
     _applicationVersion = initInfo.ApplicationVersion;
 
@@ -29,6 +35,10 @@ void Init(const InitInfo& initInfo /*= {}*/)
         GLM_VERSION_PATCH,
         GLM_VERSION_REVISION);
 
+    _threadPool = std::make_unique<ThreadPool>(initInfo.WorkerThreadCount);
+
+    Log(RYME_ANCHOR, "Worker Threads: {}", _threadPool->GetThreadCount());
+
     Script::Init();
 
     Graphics::Init(initInfo);
@@ -41,6 +51,20 @@ void Term()
 {
     RYME_BENCHMARK_START();
 
+    // Textures still being loaded need both the workers and the device
+    TextureLoader::Wait();
+
+    // Reads that are still pending may hand their results to the workers
+    AsyncIO::Term();
+
+    _threadPool.reset();
+
+    AssetManager::Term();
+
+    TextureStreamer::Term();
+
+    Defragmenter::Term();
+
     Graphics::Term();
 
     Script::Term();
@@ -55,15 +79,22 @@ void Run()
 
     SDL_Event e;
     while (_isRunning) {
+        Profiler::MarkFrame();
+
         while (SDL_PollEvent(&e)) {
             if (e.type == SDL_QUIT) {
                 _isRunning = false;
             }
-            else if (e.type == SDL_WINDOWEVENT) {
+            else {
                 Graphics::HandleEvent(e);
             }
         }
 
+        TextureLoader::Update();
+        TextureStreamer::Update();
+        AssetManager::Update();
+        Defragmenter::Update();
+
         Graphics::Render();
     }
 
@@ -82,6 +113,16 @@ void SetRunning(bool isRunning)
     _isRunning = isRunning;
 }
 
+RYME_API
+ThreadPool& GetThreadPool()
+{
+    if (not _threadPool) {
+        throw Exception("ryme::Init() must be called before using the engine ThreadPool");
+    }
+
+    return *_threadPool;
+}
+
 RYME_API
 Version GetVersion()
 {
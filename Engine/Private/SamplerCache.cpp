@@ -0,0 +1,103 @@
+#include <Ryme/SamplerCache.hpp>
+#include <Ryme/Graphics.hpp>
+#include <Ryme/Hash.hpp>
+#include <Ryme/PipelineCache.hpp>
+
+#include <bit>
+#include <mutex>
+#include <unordered_map>
+
+namespace ryme {
+
+namespace SamplerCache {
+
+struct SamplerKeyHash
+{
+    size_t operator()(const SamplerKey& key) const {
+        return Hash64(Span<const uint8_t>(reinterpret_cast<const uint8_t *>(key.data()), sizeof(key)));
+    }
+
+}; // struct SamplerKeyHash
+
+std::mutex _samplerMutex;
+
+std::unordered_map<SamplerKey, std::weak_ptr<const vk::Sampler>, SamplerKeyHash> _samplerMap;
+
+SamplerRef createSampler(const vk::SamplerCreateInfo& samplerCreateInfo, bool cached)
+{
+    auto sampler = new vk::Sampler(Graphics::Device.createSampler(samplerCreateInfo));
+
+    return SamplerRef(sampler, [key = GetKey(samplerCreateInfo), cached](const vk::Sampler * sampler) {
+        if (cached) {
+            std::lock_guard<std::mutex> lock(_samplerMutex);
+
+            // The entry may already have been replaced by a new sampler with the same state
+            auto it = _samplerMap.find(key);
+            if (it != _samplerMap.end() and it->second.expired()) {
+                _samplerMap.erase(it);
+            }
+        }
+
+        PipelineCache::EraseDependents(*sampler);
+
+        Graphics::DeferDestroy([sampler = *sampler]() {
+            Graphics::Device.destroySampler(sampler);
+        });
+
+        delete sampler;
+    });
+}
+
+RYME_API
+SamplerKey GetKey(const vk::SamplerCreateInfo& samplerCreateInfo)
+{
+    return SamplerKey{
+        VkSamplerCreateFlags(samplerCreateInfo.flags),
+        static_cast<uint32_t>(samplerCreateInfo.magFilter),
+        static_cast<uint32_t>(samplerCreateInfo.minFilter),
+        static_cast<uint32_t>(samplerCreateInfo.mipmapMode),
+        static_cast<uint32_t>(samplerCreateInfo.addressModeU),
+        static_cast<uint32_t>(samplerCreateInfo.addressModeV),
+        static_cast<uint32_t>(samplerCreateInfo.addressModeW),
+        std::bit_cast<uint32_t>(samplerCreateInfo.mipLodBias),
+        samplerCreateInfo.anisotropyEnable,
+        std::bit_cast<uint32_t>(samplerCreateInfo.maxAnisotropy),
+        samplerCreateInfo.compareEnable,
+        static_cast<uint32_t>(samplerCreateInfo.compareOp),
+        std::bit_cast<uint32_t>(samplerCreateInfo.minLod),
+        std::bit_cast<uint32_t>(samplerCreateInfo.maxLod),
+        static_cast<uint32_t>(samplerCreateInfo.borderColor),
+        samplerCreateInfo.unnormalizedCoordinates,
+    };
+}
+
+RYME_API
+SamplerRef Get(const vk::SamplerCreateInfo& samplerCreateInfo)
+{
+    if (samplerCreateInfo.pNext) {
+        return createSampler(samplerCreateInfo, false);
+    }
+
+    std::lock_guard<std::mutex> lock(_samplerMutex);
+
+    auto& weakSampler = _samplerMap[GetKey(samplerCreateInfo)];
+
+    auto sampler = weakSampler.lock();
+    if (not sampler) {
+        sampler = createSampler(samplerCreateInfo, true);
+        weakSampler = sampler;
+    }
+
+    return sampler;
+}
+
+RYME_API
+size_t GetCount()
+{
+    std::lock_guard<std::mutex> lock(_samplerMutex);
+    return _samplerMap.size();
+}
+
+} // namespace SamplerCache
+
+} // namespace ryme
\ No newline at end of file
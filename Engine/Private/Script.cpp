@@ -1,5 +1,8 @@
 #include <Ryme/Script.hpp>
 #include <Ryme/Ryme.hpp>
+#include <Ryme/SpatialSystem.hpp>
+#include <Ryme/Texture.hpp>
+#include <Ryme/TriangleBVH.hpp>
 
 PYBIND11_EMBEDDED_MODULE(ryme, m) {
     using namespace ryme;
@@ -20,6 +23,11 @@ PYBIND11_EMBEDDED_MODULE(ryme, m) {
     Path::ScriptInit(m);
     Color::ScriptInit(m);
     Graphics::ScriptInit(m);
+    Profiler::ScriptInit(m);
+    Texture::ScriptInit(m);
+    TextureStreamer::ScriptInit(m);
+    TriangleBVH::ScriptInit(m);
+    SpatialSystem::ScriptInit(m);
 
     // m.def("Init", Init);
     // m.def("Term", Term);
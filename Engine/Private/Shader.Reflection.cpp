@@ -0,0 +1,335 @@
+#include <Ryme/Shader.hpp>
+#include <Ryme/Exception.hpp>
+#include <Ryme/Hash.hpp>
+#include <Ryme/VFS.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+#include <spirv_cross/spirv_cross.hpp>
+
+namespace ryme {
+
+// The reflection cache is a header, then a ShaderReflectionCacheResource for each resource and a
+// ShaderReflectionCacheSpecializationConstant for each specialization constant, then the entry
+// point name followed by the name of each resource and specialization constant, without
+// terminators. All values are little-endian, which matches every platform we support
+
+// "RSRC"
+const uint32_t ShaderReflectionCacheMagic = 0x43525352;
+
+// Increment when the layout, or what is reflected, changes
+const uint32_t ShaderReflectionCacheVersion = 2;
+
+struct ShaderReflectionCacheHeader
+{
+    uint32_t Magic;
+
+    uint32_t Version;
+
+    uint64_t ContentHash;
+
+    uint32_t Stage;
+
+    uint32_t PushConstantSize;
+
+    uint32_t ResourceCount;
+
+    uint32_t EntryPointNameLength;
+
+    uint32_t SpecializationConstantCount;
+
+    uint32_t Reserved;
+
+}; // struct ShaderReflectionCacheHeader
+
+static_assert(sizeof(ShaderReflectionCacheHeader) == 40);
+
+struct ShaderReflectionCacheResource
+{
+    uint32_t Set;
+
+    uint32_t Binding;
+
+    uint32_t DescriptorType;
+
+    uint32_t NameLength;
+
+}; // struct ShaderReflectionCacheResource
+
+static_assert(sizeof(ShaderReflectionCacheResource) == 16);
+
+struct ShaderReflectionCacheSpecializationConstant
+{
+    uint32_t ConstantID;
+
+    uint32_t Type;
+
+    uint32_t DefaultValue;
+
+    uint32_t NameLength;
+
+}; // struct ShaderReflectionCacheSpecializationConstant
+
+static_assert(sizeof(ShaderReflectionCacheSpecializationConstant) == 16);
+
+RYME_API
+Shader::Reflection Shader::Reflect(Span<const uint32_t> code)
+{
+    spirv_cross::Compiler compiler(code.data(), code.size());
+
+    auto resources = compiler.get_shader_resources();
+    auto entryPointStage = compiler.get_entry_points_and_stages().front();
+
+    Reflection reflection;
+    reflection.EntryPointName = entryPointStage.name;
+
+    switch (entryPointStage.execution_model) {
+    case spv::ExecutionModel::ExecutionModelVertex:
+        reflection.Stage = vk::ShaderStageFlagBits::eVertex;
+        break;
+    case spv::ExecutionModel::ExecutionModelFragment:
+        reflection.Stage = vk::ShaderStageFlagBits::eFragment;
+        break;
+    case spv::ExecutionModel::ExecutionModelTessellationControl:
+        reflection.Stage = vk::ShaderStageFlagBits::eTessellationControl;
+        break;
+    case spv::ExecutionModel::ExecutionModelTessellationEvaluation:
+        reflection.Stage = vk::ShaderStageFlagBits::eTessellationEvaluation;
+        break;
+    case spv::ExecutionModel::ExecutionModelGeometry:
+        reflection.Stage = vk::ShaderStageFlagBits::eGeometry;
+        break;
+    case spv::ExecutionModel::ExecutionModelGLCompute:
+        reflection.Stage = vk::ShaderStageFlagBits::eCompute;
+        break;
+    default:
+        throw Exception("Invalid SPIR-V Execution Model: {}", (int)entryPointStage.execution_model);
+    }
+
+    auto addResourceList = [&](const auto& resourceList, vk::DescriptorType descriptorType) {
+        for (auto& resource : resourceList) {
+            reflection.ResourceList.push_back(Reflection::Resource{
+                .Set = compiler.get_decoration(resource.id, spv::Decoration::DecorationDescriptorSet),
+                .Binding = compiler.get_decoration(resource.id, spv::Decoration::DecorationBinding),
+                .DescriptorType = descriptorType,
+                .Name = resource.name,
+            });
+        }
+    };
+
+    addResourceList(resources.sampled_images, vk::DescriptorType::eCombinedImageSampler);
+    addResourceList(resources.uniform_buffers, vk::DescriptorType::eUniformBuffer);
+    addResourceList(resources.storage_buffers, vk::DescriptorType::eStorageBuffer);
+
+    if (not resources.push_constant_buffers.empty()) {
+        auto& resource = resources.push_constant_buffers.front();
+        const auto& type = compiler.get_type(resource.base_type_id);
+        reflection.PushConstantSize = static_cast<uint32_t>(compiler.get_declared_struct_size(type));
+    }
+
+    for (auto& specializationConstant : compiler.get_specialization_constants()) {
+        const auto& constant = compiler.get_constant(specializationConstant.id);
+        const auto& type = compiler.get_type(constant.constant_type);
+
+        SpecializationConstantType constantType;
+        switch (type.basetype) {
+        case spirv_cross::SPIRType::Boolean:
+            constantType = SpecializationConstantType::Bool;
+            break;
+        case spirv_cross::SPIRType::Int:
+            constantType = SpecializationConstantType::Int;
+            break;
+        case spirv_cross::SPIRType::UInt:
+            constantType = SpecializationConstantType::UInt;
+            break;
+        case spirv_cross::SPIRType::Float:
+            constantType = SpecializationConstantType::Float;
+            break;
+        default:
+            throw Exception("Unsupported type for specialization constant {}: {}",
+                specializationConstant.constant_id,
+                (int)type.basetype
+            );
+        }
+
+        reflection.SpecializationConstantList.push_back(SpecializationConstant{
+            .ConstantID = specializationConstant.constant_id,
+            .Type = constantType,
+            .DefaultValue = constant.scalar(),
+            .StageFlags = reflection.Stage,
+            .Name = compiler.get_name(specializationConstant.id),
+        });
+    }
+
+    return reflection;
+}
+
+RYME_API
+bool Shader::ReadReflectionCache(const Path& path, uint64_t contentHash, Reflection& reflection)
+{
+    // Opened through the VFS, as the cache may have been packed along with the shader
+    VFS::File file = VFS::Open(path, false);
+    if (not file.IsOpen()) {
+        return false;
+    }
+
+    const uint8_t * it = file.GetData();
+    const uint8_t * end = it + file.GetSize();
+
+    ShaderReflectionCacheHeader header;
+    if (size_t(end - it) < sizeof(header)) {
+        return false;
+    }
+
+    memcpy(&header, it, sizeof(header));
+    it += sizeof(header);
+
+    if (header.Magic != ShaderReflectionCacheMagic
+        or header.Version != ShaderReflectionCacheVersion
+        or header.ContentHash != contentHash) {
+        return false;
+    }
+
+    // Sizes are checked against what is left before anything is allocated for them
+    uint64_t resourceListSize = uint64_t(header.ResourceCount) * sizeof(ShaderReflectionCacheResource);
+    if (uint64_t(end - it) < resourceListSize) {
+        return false;
+    }
+
+    List<ShaderReflectionCacheResource> resourceList(header.ResourceCount);
+
+    memcpy(resourceList.data(), it, resourceListSize);
+    it += resourceListSize;
+
+    uint64_t specializationConstantListSize = uint64_t(header.SpecializationConstantCount) * sizeof(ShaderReflectionCacheSpecializationConstant);
+    if (uint64_t(end - it) < specializationConstantListSize) {
+        return false;
+    }
+
+    List<ShaderReflectionCacheSpecializationConstant> specializationConstantList(header.SpecializationConstantCount);
+
+    memcpy(specializationConstantList.data(), it, specializationConstantListSize);
+    it += specializationConstantListSize;
+
+    auto readString = [&](uint32_t length, String& str) {
+        if (size_t(end - it) < length) {
+            return false;
+        }
+
+        str.assign(reinterpret_cast<const char *>(it), length);
+        it += length;
+        return true;
+    };
+
+    reflection = {};
+    reflection.Stage = static_cast<vk::ShaderStageFlagBits>(header.Stage);
+    reflection.PushConstantSize = header.PushConstantSize;
+
+    if (not readString(header.EntryPointNameLength, reflection.EntryPointName)) {
+        return false;
+    }
+
+    reflection.ResourceList.resize(resourceList.size());
+
+    for (size_t i = 0; i < resourceList.size(); ++i) {
+        auto& resource = reflection.ResourceList[i];
+        resource.Set = resourceList[i].Set;
+        resource.Binding = resourceList[i].Binding;
+        resource.DescriptorType = static_cast<vk::DescriptorType>(resourceList[i].DescriptorType);
+
+        if (not readString(resourceList[i].NameLength, resource.Name)) {
+            return false;
+        }
+    }
+
+    reflection.SpecializationConstantList.resize(specializationConstantList.size());
+
+    for (size_t i = 0; i < specializationConstantList.size(); ++i) {
+        auto& specializationConstant = reflection.SpecializationConstantList[i];
+        specializationConstant.ConstantID = specializationConstantList[i].ConstantID;
+        specializationConstant.Type = static_cast<SpecializationConstantType>(specializationConstantList[i].Type);
+        specializationConstant.DefaultValue = specializationConstantList[i].DefaultValue;
+        specializationConstant.StageFlags = reflection.Stage;
+
+        if (not readString(specializationConstantList[i].NameLength, specializationConstant.Name)) {
+            return false;
+        }
+    }
+
+    return (it == end);
+}
+
+RYME_API
+bool Shader::WriteReflectionCache(const Path& path, uint64_t contentHash, const Reflection& reflection)
+{
+    ShaderReflectionCacheHeader header = {
+        .Magic = ShaderReflectionCacheMagic,
+        .Version = ShaderReflectionCacheVersion,
+        .ContentHash = contentHash,
+        .Stage = static_cast<uint32_t>(reflection.Stage),
+        .PushConstantSize = reflection.PushConstantSize,
+        .ResourceCount = static_cast<uint32_t>(reflection.ResourceList.size()),
+        .EntryPointNameLength = static_cast<uint32_t>(reflection.EntryPointName.size()),
+        .SpecializationConstantCount = static_cast<uint32_t>(reflection.SpecializationConstantList.size()),
+        .Reserved = 0,
+    };
+
+    List<ShaderReflectionCacheResource> resourceList;
+    resourceList.reserve(reflection.ResourceList.size());
+
+    for (const auto& resource : reflection.ResourceList) {
+        resourceList.push_back(ShaderReflectionCacheResource{
+            .Set = resource.Set,
+            .Binding = resource.Binding,
+            .DescriptorType = static_cast<uint32_t>(resource.DescriptorType),
+            .NameLength = static_cast<uint32_t>(resource.Name.size()),
+        });
+    }
+
+    List<ShaderReflectionCacheSpecializationConstant> specializationConstantList;
+    specializationConstantList.reserve(reflection.SpecializationConstantList.size());
+
+    for (const auto& specializationConstant : reflection.SpecializationConstantList) {
+        specializationConstantList.push_back(ShaderReflectionCacheSpecializationConstant{
+            .ConstantID = specializationConstant.ConstantID,
+            .Type = static_cast<uint32_t>(specializationConstant.Type),
+            .DefaultValue = specializationConstant.DefaultValue,
+            .NameLength = static_cast<uint32_t>(specializationConstant.Name.size()),
+        });
+    }
+
+    // Written to a temporary file first, so a shader loading at the same time never reads half of it
+    return WriteFileReplacing(path, [&](FILE * file) {
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(resourceList.data(), sizeof(ShaderReflectionCacheResource), resourceList.size(), file);
+        fwrite(specializationConstantList.data(), sizeof(ShaderReflectionCacheSpecializationConstant), specializationConstantList.size(), file);
+        fwrite(reflection.EntryPointName.data(), 1, reflection.EntryPointName.size(), file);
+
+        for (const auto& resource : reflection.ResourceList) {
+            fwrite(resource.Name.data(), 1, resource.Name.size(), file);
+        }
+
+        for (const auto& specializationConstant : reflection.SpecializationConstantList) {
+            fwrite(specializationConstant.Name.data(), 1, specializationConstant.Name.size(), file);
+        }
+
+        return true;
+    });
+}
+
+RYME_API
+bool Shader::CookReflectionCache(Span<const uint8_t> data, const Path& path, const Path& cachePath)
+{
+    if (data.empty() or data.size() % sizeof(uint32_t) != 0) {
+        throw Exception("Invalid SPIR-V file '{}'", path);
+    }
+
+    // Copied, as the data may not be aligned to words
+    List<uint32_t> code(data.size() / sizeof(uint32_t));
+    memcpy(code.data(), data.data(), data.size());
+
+    return WriteReflectionCache(cachePath, Hash64(data), Reflect(code));
+}
+
+} // namespace ryme
\ No newline at end of file
@@ -1,12 +1,12 @@
 #include <Ryme/Shader.hpp>
 #include <Ryme/Exception.hpp>
 #include <Ryme/Graphics.hpp>
+#include <Ryme/Hash.hpp>
 #include <Ryme/Log.hpp>
-#include <Ryme/Span.hpp>
+#include <Ryme/VFS.hpp>
 
-#include <fstream>
-
-#include <spirv_cross/spirv_cross.hpp>
+#include <algorithm>
+#include <cstring>
 
 namespace ryme {
 
@@ -27,6 +27,9 @@ bool Shader::LoadFromFiles(const List<Path>& pathList, bool search /*= true*/)
 {
     Free();
 
+    // The previous samplers were only needed by the layouts released by Free()
+    _immutableSamplerMap = _pendingImmutableSamplerMap;
+
     for (const auto& path : pathList) {
         if (not LoadSPV(path, search)) {
             if (not LoadSPV(path + ".spv", search)) {
@@ -35,38 +38,50 @@ bool Shader::LoadFromFiles(const List<Path>& pathList, bool search /*= true*/)
         }
     }
 
+    // Shaders with the same bindings share their layouts
     for (auto& bindingList : _descriptorSetLayoutBindingListList) {
-        auto descriptorSetLayoutCreateInfo = vk::DescriptorSetLayoutCreateInfo()
-            .setBindings(bindingList);
-
-        auto descriptorSetLayout = Graphics::Device.createDescriptorSetLayout(descriptorSetLayoutCreateInfo);
-        _descriptorSetLayoutList.push_back(descriptorSetLayout);
+        auto descriptorSetLayout = PipelineCache::GetDescriptorSetLayout(bindingList);
+        _descriptorSetLayoutRefList.push_back(descriptorSetLayout);
+        _descriptorSetLayoutList.push_back(*descriptorSetLayout);
     }
 
-    auto pipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo()
-        .setSetLayouts(_descriptorSetLayoutList)
-        .setPushConstantRanges(_pushConstantRangeList);
-
-    _pipelineLayout = Graphics::Device.createPipelineLayout(pipelineLayoutCreateInfo);
+    _pipelineLayoutRef = PipelineCache::GetPipelineLayout(_descriptorSetLayoutRefList, _pushConstantRangeList);
+    _pipelineLayout = *_pipelineLayoutRef;
 
     _isLoaded = true;
     return true;
 }
 
 RYME_API
-void Shader::Free()
+void Shader::SetImmutableSampler(const String& name, vk::SamplerCreateInfo samplerCreateInfo)
+{
+    // The current layouts have the samplers in _immutableSamplerMap baked in, so they are kept until
+    // the layouts are replaced
+    _pendingImmutableSamplerMap[name] = SamplerCache::Get(samplerCreateInfo);
+}
+
+RYME_API
+const SpecializationConstant * Shader::FindSpecializationConstant(StringView name) const
 {
-    for (auto& shaderModule : _shaderModuleList) {
-        Graphics::Device.destroyShaderModule(shaderModule);
+    for (const auto& specializationConstant : _specializationConstantList) {
+        if (specializationConstant.Name == name) {
+            return &specializationConstant;
+        }
     }
+
+    return nullptr;
+}
+
+RYME_API
+void Shader::Free()
+{
+    // The modules and layouts are shared through the PipelineCache, which destroys them once no
+    // other Shader is using them and the GPU is done with them
     _shaderModuleList.clear();
-    
-    for (auto& descriptorSetLayout : _descriptorSetLayoutList) {
-        Graphics::Device.destroyDescriptorSetLayout(descriptorSetLayout);
-    }
+    _descriptorSetLayoutRefList.clear();
     _descriptorSetLayoutList.clear();
-
-    Graphics::Device.destroyPipelineLayout(_pipelineLayout);
+    _pipelineLayoutRef.reset();
+    _pipelineLayout = nullptr;
 
     for (char * entryPointName : _entryPointNameList) {
         free(entryPointName);
@@ -79,6 +94,8 @@ void Shader::Free()
 
     _pushConstantRangeList.clear();
 
+    _specializationConstantList.clear();
+
     _isLoaded = false;
 }
 
@@ -94,175 +111,97 @@ bool Shader::Reload()
 RYME_API
 bool Shader::LoadSPV(const Path& path, bool search)
 {
-    std::ifstream file;
-    Path fullPath = path;
-
-    if (search) {
-        for (const auto& assetPath : GetAssetPathList()) {
-            fullPath = assetPath / path;
-
-            file.open(fullPath.ToString(), std::ios::binary);
-            if (file.is_open()) {
-                break;
-            }
-        }
-    }
-    else {
-        file.open(path.ToString(), std::ios::binary);
-    }
-
-    if (not file.is_open()) {
+    VFS::File file = VFS::Open(path, search);
+    if (not file.IsOpen()) {
         return false;
     }
 
-    file.unsetf(std::ios::skipws);
+    Path fullPath = file.GetPath();
 
-    List<uint8_t> rawData(
-        (std::istreambuf_iterator<char>(file)),
-        std::istreambuf_iterator<char>()
-    );
+    if (file.GetSize() == 0 or file.GetSize() % sizeof(uint32_t) != 0) {
+        throw Exception("Invalid SPIR-V file '{}'", fullPath);
+    }
 
-    Span<uint32_t> data(
-        reinterpret_cast<uint32_t *>(rawData.data()),
-        rawData.size() / sizeof(uint32_t)
+    // The data is aligned, so it can be used as words directly
+    Span<const uint32_t> code(
+        reinterpret_cast<const uint32_t *>(file.GetData()),
+        file.GetSize() / sizeof(uint32_t)
     );
 
-    spirv_cross::Compiler compiler(data.data(), data.size());
-
-    auto resources = compiler.get_shader_resources();
-    auto entryPointStage = compiler.get_entry_points_and_stages().front();
-
-    vk::ShaderStageFlagBits stage;
-    switch (entryPointStage.execution_model) {
-    case spv::ExecutionModel::ExecutionModelVertex:
-        stage = vk::ShaderStageFlagBits::eVertex;
-        break;
-    case spv::ExecutionModel::ExecutionModelFragment:
-        stage = vk::ShaderStageFlagBits::eFragment;
-        break;
-    case spv::ExecutionModel::ExecutionModelTessellationControl:
-        stage = vk::ShaderStageFlagBits::eTessellationControl;
-        break;
-    case spv::ExecutionModel::ExecutionModelTessellationEvaluation:
-        stage = vk::ShaderStageFlagBits::eTessellationEvaluation;
-        break;
-    case spv::ExecutionModel::ExecutionModelGeometry:
-        stage = vk::ShaderStageFlagBits::eGeometry;
-        break;
-    default:
-        throw Exception("Invalid SPIR-V Execution Model: {}", (int)entryPointStage.execution_model);
+    uint64_t contentHash = Hash64(file.GetSpan());
+    Path reflectionCachePath = fullPath + ".reflect";
+
+    Reflection reflection;
+    if (not ReadReflectionCache(reflectionCachePath, contentHash, reflection)) {
+        reflection = Reflect(code);
+
+        if (not WriteReflectionCache(reflectionCachePath, contentHash, reflection)) {
+            Log(RYME_ANCHOR, "Failed to write reflection cache '{}'", reflectionCachePath);
+        }
     }
 
-    auto shaderModuleCreateInfo = vk::ShaderModuleCreateInfo()
-        .setCodeSize(data.size_bytes())
-        .setPCode(data.data());
+    vk::ShaderStageFlagBits stage = reflection.Stage;
 
-    auto shaderModule = Graphics::Device.createShaderModule(shaderModuleCreateInfo);
+    auto shaderModule = PipelineCache::GetShaderModule(code, contentHash);
 
     _shaderModuleList.push_back(shaderModule);
 
     // TODO: Improve
-    char * entryPointName = strdup(entryPointStage.name.c_str());
+    char * entryPointName = strdup(reflection.EntryPointName.c_str());
     _entryPointNameList.push_back(entryPointName);
 
     auto shaderStageCreateInfo = vk::PipelineShaderStageCreateInfo()
         .setStage(stage)
-        .setModule(shaderModule)
+        .setModule(*shaderModule)
         .setPName(entryPointName)
         // .setPName("main")
         .setPSpecializationInfo(nullptr);
 
     _shaderStageCreateInfoList.push_back(shaderStageCreateInfo);
 
-    // for (auto& resource : resources.stage_inputs) {
-    //     auto location = compiler.get_decoration(resource.id, spv::Decoration::DecorationLocation);
-
-    //     Log(RYME_ANCHOR, "{} location={}", resource.name, location);
-    // }
-
-    // for (auto& resource : resources.stage_outputs) {
-    //     auto location = compiler.get_decoration(resource.id, spv::Decoration::DecorationLocation);
-
-    //     Log(RYME_ANCHOR, "{} location={}", resource.name, location);
-    // }
-
-    for (auto& resource : resources.sampled_images) {
-        uint32_t set = compiler.get_decoration(resource.id, spv::Decoration::DecorationDescriptorSet);
-        uint32_t binding = compiler.get_decoration(resource.id, spv::Decoration::DecorationBinding);
-        
-        if (set >= _descriptorSetLayoutBindingListList.size()) {
-            _descriptorSetLayoutBindingListList.resize(set + 1);
+    for (auto& resource : reflection.ResourceList) {
+        if (resource.Set >= _descriptorSetLayoutBindingListList.size()) {
+            _descriptorSetLayoutBindingListList.resize(resource.Set + 1);
         }
 
-        auto& bindingList = _descriptorSetLayoutBindingListList[set];
+        auto& bindingList = _descriptorSetLayoutBindingListList[resource.Set];
 
         auto it = std::find_if(
             bindingList.begin(),
             bindingList.end(),
             [&](auto& setLayoutBinding) {
-                return (setLayoutBinding.binding == binding);
+                return (setLayoutBinding.binding == resource.Binding);
             }
         );
 
         if (it == bindingList.end()) {
-            bindingList.push_back(
-                vk::DescriptorSetLayoutBinding()
-                    .setBinding(binding)
-                    .setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
-                    .setDescriptorCount(1)
-                    .setStageFlags(stage)
-            );
-        }
-        else {
-            (*it).stageFlags |= stage;
-        }
-    }
-
-    for (auto& resource : resources.uniform_buffers) {
-        // const auto& type = compiler.get_type(resource.base_type_id);
-        // size_t size = compiler.get_declared_struct_size(type);
-
-        uint32_t set = compiler.get_decoration(resource.id, spv::Decoration::DecorationDescriptorSet);
-        uint32_t binding = compiler.get_decoration(resource.id, spv::Decoration::DecorationBinding);
-        
-        if (set >= _descriptorSetLayoutBindingListList.size()) {
-            _descriptorSetLayoutBindingListList.resize(set + 1);
-        }
-
-        auto& bindingList = _descriptorSetLayoutBindingListList[set];
-
-        auto it = std::find_if(
-            bindingList.begin(),
-            bindingList.end(),
-            [&](auto& setLayoutBinding) {
-                return (setLayoutBinding.binding == binding);
+            auto setLayoutBinding = vk::DescriptorSetLayoutBinding()
+                .setBinding(resource.Binding)
+                .setDescriptorType(resource.DescriptorType)
+                .setDescriptorCount(1)
+                .setStageFlags(stage);
+
+            if (resource.DescriptorType == vk::DescriptorType::eCombinedImageSampler) {
+                // The sampler is kept alive by _immutableSamplerMap for as long as the layout exists
+                auto immutableSampler = _immutableSamplerMap.find(resource.Name);
+                if (immutableSampler != _immutableSamplerMap.end()) {
+                    setLayoutBinding.setPImmutableSamplers(immutableSampler->second.get());
+                }
             }
-        );
 
-        if (it == bindingList.end()) {
-            bindingList.push_back(
-                vk::DescriptorSetLayoutBinding()
-                    .setBinding(binding)
-                    .setDescriptorType(vk::DescriptorType::eUniformBuffer)
-                    .setDescriptorCount(1)
-                    .setStageFlags(stage)
-            );
+            bindingList.push_back(setLayoutBinding);
         }
         else {
             (*it).stageFlags |= stage;
         }
     }
 
-    if (not resources.push_constant_buffers.empty()) {
-        auto& resource = resources.push_constant_buffers.front();
-        const auto& type = compiler.get_type(resource.base_type_id);
-        size_t size = compiler.get_declared_struct_size(type);
-
+    if (reflection.PushConstantSize > 0) {
         if (_pushConstantRangeList.empty()) {
             _pushConstantRangeList.push_back(
                 vk::PushConstantRange()
                     .setOffset(0)
-                    .setSize(size)
+                    .setSize(reflection.PushConstantSize)
                     .setStageFlags(stage)
             );
         }
@@ -272,6 +211,31 @@ bool Shader::LoadSPV(const Path& path, bool search)
         }
     }
 
+    for (auto& specializationConstant : reflection.SpecializationConstantList) {
+        auto it = std::lower_bound(
+            _specializationConstantList.begin(),
+            _specializationConstantList.end(),
+            specializationConstant.ConstantID,
+            [](const auto& other, uint32_t constantID) {
+                return (other.ConstantID < constantID);
+            }
+        );
+
+        if (it == _specializationConstantList.end() or it->ConstantID != specializationConstant.ConstantID) {
+            _specializationConstantList.insert(it, specializationConstant);
+        }
+        else if (it->Type != specializationConstant.Type) {
+            throw Exception("Specialization constant {} '{}' has a different type in '{}'",
+                specializationConstant.ConstantID,
+                specializationConstant.Name,
+                fullPath
+            );
+        }
+        else {
+            it->StageFlags |= specializationConstant.StageFlags;
+        }
+    }
+
     _pathList.push_back(fullPath);
 
     Log(RYME_ANCHOR, "Loaded '{}'", fullPath);
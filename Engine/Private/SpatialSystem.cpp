@@ -0,0 +1,254 @@
+#include <Ryme/SpatialSystem.hpp>
+#include <Ryme/Entity.hpp>
+#include <Ryme/Exception.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Profiler.hpp>
+#include <Ryme/Scene.hpp>
+
+#include <pybind11/stl.h>
+
+#include <algorithm>
+
+namespace ryme {
+
+// The bounds of a box after it has been transformed, which contain all eight of its corners
+void transformBounds(const Mat4& matrix, Vec3& min, Vec3& max)
+{
+    Vec3 center = Vec3(matrix * Vec4((min + max) * 0.5f, 1.0f));
+    Vec3 extent = (max - min) * 0.5f;
+
+    Vec3 worldExtent = glm::abs(Vec3(matrix[0])) * extent.x
+        + glm::abs(Vec3(matrix[1])) * extent.y
+        + glm::abs(Vec3(matrix[2])) * extent.z;
+
+    min = center - worldExtent;
+    max = center + worldExtent;
+}
+
+RYME_API
+void SpatialSystem::AddModelComponent(ModelComponent * modelComponent)
+{
+    _proxyMap.emplace(modelComponent, AABBTree::NullNode);
+}
+
+RYME_API
+void SpatialSystem::RemoveModelComponent(ModelComponent * modelComponent)
+{
+    auto it = _proxyMap.find(modelComponent);
+    if (it == _proxyMap.end()) {
+        return;
+    }
+
+    if (it->second != AABBTree::NullNode) {
+        _tree.Remove(it->second);
+    }
+
+    _proxyMap.erase(it);
+}
+
+RYME_API
+void SpatialSystem::Update()
+{
+    RYME_PROFILE_FUNCTION();
+
+    for (auto& [modelComponent, proxy] : _proxyMap) {
+        Model * model = modelComponent->GetModel();
+        if (not model or not model->IsLoaded()) {
+            continue;
+        }
+
+        Vec3 min = model->GetBoundsMin();
+        Vec3 max = model->GetBoundsMax();
+
+        transformBounds(modelComponent->GetEntity()->GetWorldTransform().ToMatrix(), min, max);
+
+        if (proxy == AABBTree::NullNode) {
+            proxy = _tree.Insert(min, max, modelComponent);
+        }
+        else {
+            _tree.Move(proxy, min, max);
+        }
+    }
+
+    _tree.Update();
+}
+
+RYME_API
+void SpatialSystem::QueryFrustum(const Frustum& frustum, List<ModelComponent *>& modelComponentList) const
+{
+    List<uint32_t> proxyList;
+    _tree.QueryFrustum(frustum, proxyList);
+
+    getProxyComponentList(proxyList, modelComponentList);
+}
+
+RYME_API
+void SpatialSystem::QueryBox(const Vec3& min, const Vec3& max, List<ModelComponent *>& modelComponentList) const
+{
+    List<uint32_t> proxyList;
+    _tree.QueryBox(min, max, proxyList);
+
+    getProxyComponentList(proxyList, modelComponentList);
+}
+
+RYME_API
+void SpatialSystem::QuerySphere(const Vec3& center, float radius, List<ModelComponent *>& modelComponentList) const
+{
+    List<uint32_t> proxyList;
+    _tree.QuerySphere(center, radius, proxyList);
+
+    getProxyComponentList(proxyList, modelComponentList);
+}
+
+RYME_API
+void SpatialSystem::QueryRay(const Vec3& origin, const Vec3& direction, float maxDistance, List<BoundsHit>& hitList) const
+{
+    List<AABBTree::RayHit> proxyHitList;
+    _tree.QueryRay(origin, direction, maxDistance, proxyHitList);
+
+    std::sort(proxyHitList.begin(), proxyHitList.end(), [](const auto& a, const auto& b) {
+        return (a.Distance < b.Distance);
+    });
+
+    hitList.reserve(hitList.size() + proxyHitList.size());
+
+    for (const auto& hit : proxyHitList) {
+        hitList.push_back(BoundsHit{
+            .Component = static_cast<ModelComponent *>(_tree.GetUserData(hit.Proxy)),
+            .Distance = hit.Distance,
+        });
+    }
+}
+
+RYME_API
+bool SpatialSystem::Raycast(const Ray& ray, RayHit& hit) const
+{
+    List<BoundsHit> boundsHitList;
+    QueryRay(ray.Origin, ray.Direction, std::min(ray.MaxDistance, hit.Distance), boundsHitList);
+
+    bool isHit = false;
+
+    for (const auto& boundsHit : boundsHitList) {
+        // The rest of the models are farther than the closest triangle hit so far
+        if (boundsHit.Distance >= hit.Distance) {
+            break;
+        }
+
+        Model * model = boundsHit.Component->GetModel();
+        Mat4 inverse = glm::inverse(boundsHit.Component->GetEntity()->GetWorldTransform().ToMatrix());
+
+        // The direction is transformed without being normalized, so distances along the ray are
+        // the same in both spaces
+        Ray modelRay = {
+            .Origin = Vec3(inverse * Vec4(ray.Origin, 1.0f)),
+            .Direction = Vec3(inverse * Vec4(ray.Direction, 0.0f)),
+            .MaxDistance = ray.MaxDistance,
+        };
+
+        if (model->Intersect(modelRay, hit)) {
+            hit.Component = boundsHit.Component;
+            isHit = true;
+        }
+    }
+
+    return isHit;
+}
+
+RYME_API
+bool SpatialSystem::RaycastAny(const Ray& ray) const
+{
+    List<BoundsHit> boundsHitList;
+    QueryRay(ray.Origin, ray.Direction, ray.MaxDistance, boundsHitList);
+
+    for (const auto& boundsHit : boundsHitList) {
+        Model * model = boundsHit.Component->GetModel();
+        Mat4 inverse = glm::inverse(boundsHit.Component->GetEntity()->GetWorldTransform().ToMatrix());
+
+        Ray modelRay = {
+            .Origin = Vec3(inverse * Vec4(ray.Origin, 1.0f)),
+            .Direction = Vec3(inverse * Vec4(ray.Direction, 0.0f)),
+            .MaxDistance = ray.MaxDistance,
+        };
+
+        if (model->IntersectAny(modelRay)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+RYME_API
+void SpatialSystem::RaycastList(Span<const Ray> rayList, Span<RayHit> hitList, ThreadPool * threadPool /*= nullptr*/) const
+{
+    RYME_PROFILE_FUNCTION();
+
+    if (hitList.size() < rayList.size()) {
+        throw Exception("SpatialSystem::RaycastList() needs a hit for each of the {} rays, {} given",
+            rayList.size(),
+            hitList.size()
+        );
+    }
+
+    auto raycast = [&](size_t index) {
+        hitList[index] = {};
+        Raycast(rayList[index], hitList[index]);
+    };
+
+    if (threadPool) {
+        threadPool->ParallelFor(rayList.size(), raycast);
+    }
+    else {
+        for (size_t i = 0; i < rayList.size(); ++i) {
+            raycast(i);
+        }
+    }
+}
+
+void SpatialSystem::getProxyComponentList(const List<uint32_t>& proxyList, List<ModelComponent *>& modelComponentList) const
+{
+    modelComponentList.reserve(modelComponentList.size() + proxyList.size());
+
+    for (uint32_t proxy : proxyList) {
+        modelComponentList.push_back(static_cast<ModelComponent *>(_tree.GetUserData(proxy)));
+    }
+}
+
+RYME_API
+void SpatialSystem::ScriptInit(py::module m)
+{
+    auto getSpatialSystem = []() {
+        Scene * scene = GetCurrentScene();
+        SpatialSystem * spatialSystem = (scene ? scene->GetSystem<SpatialSystem>() : nullptr);
+
+        if (not spatialSystem) {
+            throw Exception("The current Scene has no SpatialSystem");
+        }
+
+        return spatialSystem;
+    };
+
+    m.def("Raycast",
+        [=](const Ray& ray) -> std::optional<RayHit> {
+            RayHit hit;
+            if (getSpatialSystem()->Raycast(ray, hit)) {
+                return hit;
+            }
+
+            return std::nullopt;
+        });
+
+    m.def("RaycastAny",
+        [=](const Ray& ray) {
+            return getSpatialSystem()->RaycastAny(ray);
+        });
+
+    m.def("RaycastList",
+        [=](const List<Ray>& rayList) {
+            List<RayHit> hitList(rayList.size());
+            getSpatialSystem()->RaycastList(rayList, hitList, &GetThreadPool());
+            return hitList;
+        });
+}
+
+} // namespace ryme
\ No newline at end of file
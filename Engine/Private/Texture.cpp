@@ -1,12 +1,20 @@
 #include <Ryme/Texture.hpp>
+#include <Ryme/BlockCompression.hpp>
+#include <Ryme/Defragmenter.hpp>
 #include <Ryme/Graphics.hpp>
 #include <Ryme/Log.hpp>
+#include <Ryme/Mipmap.hpp>
+#include <Ryme/Profiler.hpp>
+#include <Ryme/VFS.hpp>
 
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
+#include <cstring>
 
 namespace ryme {
     
+RYME_API
+Texture::Texture()
+{ }
+
 RYME_API
 Texture::Texture(const Path& path, vk::SamplerCreateInfo samplerCreateInfo /*= {}*/, bool search /*= true*/)
 {
@@ -22,34 +30,34 @@ Texture::~Texture()
 RYME_API
 bool Texture::LoadFromFile(const Path& path, vk::SamplerCreateInfo samplerCreateInfo /*= {}*/, bool search /*= true*/)
 {
-    int width;
-    int height;
-    int components;
-    uint8_t * data = nullptr;
-
-    Path fullPath = path;
+    // Prefer the image cooked by RymeCook, which is already compressed and has its mipmaps
+    Path loadPath = (search ? VFS::GetCookedPath(path, "ktx2") : path);
 
-    if (search) {
-        for (const auto& assetPath : GetAssetPathList()) {
-            fullPath = assetPath / path;
-
-            data = stbi_load(fullPath.ToCString(), &width, &height, &components, STBI_rgb_alpha);
-            if (data) {
-                break;
-            }
-        }
-    }
-    else {
-        data = stbi_load(path.ToCString(), &width, &height, &components, STBI_rgb_alpha);
+    VFS::File file = VFS::Open(loadPath, search);
+    if (not file.IsOpen()) {
+        return false;
     }
 
-    if (not data) {
+    ImageData imageData;
+    if (not LoadImageData(file.GetSpan(), file.GetPath(), imageData)) {
         return false;
     }
 
-    _path = fullPath;
-    
-    vk::DeviceSize size = width * height * STBI_rgb_alpha;
+    _path = file.GetPath();
+
+    return LoadFromImageData(imageData, samplerCreateInfo);
+}
+
+RYME_API
+bool Texture::LoadFromImageData(ImageData& imageData, vk::SamplerCreateInfo samplerCreateInfo /*= {}*/)
+{
+    // When reloading, the previous image is destroyed once the GPU is no longer using it
+    Free();
+
+    uint32_t mipLevels = PrepareImageData(imageData);
+
+    const auto& lastLevel = imageData.MipLevelList.back();
+    vk::DeviceSize size = lastLevel.Offset + lastLevel.Size;
 
     auto stagingBufferCreateInfo = vk::BufferCreateInfo()
         .setSize(size)
@@ -65,24 +73,73 @@ bool Texture::LoadFromFile(const Path& path, vk::SamplerCreateInfo samplerCreate
     auto[stagingBuffer, stagingAllocation] = Graphics::CreateBuffer(
         stagingBufferCreateInfo,
         stagingAllocationCreateInfo,
-        &stagingAllocationInfo
+        &stagingAllocationInfo,
+        Graphics::MemoryCategory::Staging
     );
-    
-    memcpy(stagingAllocationInfo.pMappedData, data, size);
 
-    stbi_image_free(data);
+    memcpy(stagingAllocationInfo.pMappedData, imageData.Data.data(), size);
 
-    auto imageCreateInfo = vk::ImageCreateInfo()
-        .setImageType(vk::ImageType::e2D)
-        .setFormat(vk::Format::eR8G8B8A8Srgb)
-        .setTiling(vk::ImageTiling::eOptimal)
-        .setExtent(vk::Extent3D(width, height, 1))
-        .setMipLevels(1) // TODO: Investigate
-        .setArrayLayers(1) // TODO: Investigate
-        .setUsage(vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled)
-        .setInitialLayout(vk::ImageLayout::eUndefined) // Preinitialized?
-        .setSharingMode(vk::SharingMode::eExclusive)
-        .setSamples(vk::SampleCountFlagBits::e1);
+    CreateImage(imageData, mipLevels, samplerCreateInfo);
+
+    Graphics::UploadTexture(stagingBuffer, _image, GetCopyRegionList(imageData), _mipLevels);
+
+    Graphics::FreeMemory(stagingAllocation);
+
+    Graphics::Device.destroyBuffer(stagingBuffer);
+
+    FinishLoading(_path);
+
+    return true;
+}
+
+RYME_API
+uint32_t Texture::PrepareImageData(ImageData& imageData)
+{
+    if (IsBlockCompressedFormat(imageData.Format)
+        and not Graphics::IsFormatFeatureSupported(imageData.Format, vk::FormatFeatureFlagBits::eSampledImage)) {
+        Log(RYME_ANCHOR, "Decompressing {} on the CPU, it is not supported by the device",
+            vk::to_string(imageData.Format)
+        );
+
+        DecompressImageData(imageData);
+    }
+
+    vk::Format format = imageData.Format;
+
+    // Images with a single level of RGBA8 get a full mip chain, anything else is uploaded as-is
+    bool generateMipmaps = (
+        imageData.MipLevelList.size() == 1
+        and (format == vk::Format::eR8G8B8A8Srgb or format == vk::Format::eR8G8B8A8Unorm)
+    );
+
+    if (not generateMipmaps) {
+        return imageData.MipLevelList.size();
+    }
+
+    // Blitting on the GPU is much faster, but requires the format to support linear filtering
+    bool generateMipmapsOnGPU = Graphics::IsFormatFeatureSupported(format,
+        vk::FormatFeatureFlagBits::eBlitSrc |
+        vk::FormatFeatureFlagBits::eBlitDst |
+        vk::FormatFeatureFlagBits::eSampledImageFilterLinear
+    );
+
+    if (not generateMipmapsOnGPU) {
+        // Staging memory is often uncached, so the levels are generated in system memory first
+        GenerateMipmaps(imageData);
+    }
+
+    return GetMipLevelCount(imageData.Width, imageData.Height);
+}
+
+RYME_API
+void Texture::CreateImage(const ImageData& imageData, uint32_t mipLevels, vk::SamplerCreateInfo samplerCreateInfo /*= {}*/)
+{
+    _format = imageData.Format;
+    _width = imageData.Width;
+    _height = imageData.Height;
+    _mipLevels = mipLevels;
+
+    auto imageCreateInfo = getImageCreateInfo();
 
     auto allocationCreateInfo = VmaAllocationCreateInfo{
         .usage = VMA_MEMORY_USAGE_GPU_ONLY,
@@ -90,75 +147,240 @@ bool Texture::LoadFromFile(const Path& path, vk::SamplerCreateInfo samplerCreate
 
     std::tie(_image, _allocation) = Graphics::CreateImage(
         imageCreateInfo,
-        allocationCreateInfo
+        allocationCreateInfo,
+        nullptr,
+        Graphics::MemoryCategory::Texture
     );
 
-    auto subresourceLayers = vk::ImageSubresourceLayers()
-        .setAspectMask(vk::ImageAspectFlagBits::eColor)
-        .setMipLevel(0)
-        .setBaseArrayLayer(0)
-        .setLayerCount(1);
+    createImageView();
 
-    auto region = vk::BufferImageCopy()
-        .setBufferOffset(0)
-        .setBufferRowLength(0)
-        .setBufferImageHeight(0)
-        .setImageSubresource(subresourceLayers)
-        .setImageOffset(vk::Offset3D(0, 0, 0))
-        .setImageExtent(vk::Extent3D(width, height, 1));
+    registerMovable();
 
-    Graphics::CopyBufferToImage(stagingBuffer, _image, region);
+    // A maxLod of 0 would restrict sampling to the first level, so treat it as unset
+    if (samplerCreateInfo.maxLod == 0.0f) {
+        samplerCreateInfo.setMaxLod(VK_LOD_CLAMP_NONE);
+    }
 
-    vmaFreeMemory(Graphics::Allocator, stagingAllocation);
+    _sampler = SamplerCache::Get(samplerCreateInfo);
+    _samplerCreateInfo = samplerCreateInfo;
+}
 
-    Graphics::Device.destroyBuffer(stagingBuffer);
+RYME_API
+uint64_t Texture::SubmitUploadList(const List<Upload>& uploadList)
+{
+    RYME_PROFILE_FUNCTION();
+
+    // Offsets must be a multiple of the texel block size, which is at most 16 bytes
+    const vk::DeviceSize alignment = 16;
+
+    List<vk::DeviceSize> offsetList;
+    offsetList.reserve(uploadList.size());
+
+    vk::DeviceSize size = 0;
+
+    for (const auto& upload : uploadList) {
+        offsetList.push_back(size);
+
+        size += upload.Data.size();
+        size = (size + alignment - 1) / alignment * alignment;
+    }
+
+    auto stagingBufferCreateInfo = vk::BufferCreateInfo()
+        .setSize(size)
+        .setUsage(vk::BufferUsageFlagBits::eTransferSrc);
+
+    auto stagingAllocationCreateInfo = VmaAllocationCreateInfo{
+        .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT,
+        .usage = VMA_MEMORY_USAGE_CPU_ONLY,
+    };
+
+    VmaAllocationInfo stagingAllocationInfo;
 
+    auto[stagingBuffer, stagingAllocation] = Graphics::CreateBuffer(
+        stagingBufferCreateInfo,
+        stagingAllocationCreateInfo,
+        &stagingAllocationInfo,
+        Graphics::MemoryCategory::Staging
+    );
+
+    uint8_t * stagingData = static_cast<uint8_t *>(stagingAllocationInfo.pMappedData);
+
+    List<Graphics::TextureUpload> textureUploadList;
+    textureUploadList.reserve(uploadList.size());
+
+    for (size_t i = 0; i < uploadList.size(); ++i) {
+        const auto& upload = uploadList[i];
+
+        memcpy(stagingData + offsetList[i], upload.Data.data(), upload.Data.size());
+
+        ImageData levels = {
+            .MipLevelList = upload.MipLevelList,
+        };
+
+        textureUploadList.push_back(Graphics::TextureUpload{
+            .Image = upload.Target->GetImage(),
+            .RegionList = GetCopyRegionList(levels, offsetList[i]),
+            .MipLevels = upload.Target->GetMipLevels(),
+        });
+    }
+
+    uint64_t timelineValue = Graphics::SubmitTextureUploadList(stagingBuffer, textureUploadList);
+
+    Graphics::DeferDestroy([stagingBuffer = stagingBuffer, stagingAllocation = stagingAllocation]() {
+        Graphics::FreeMemory(stagingAllocation);
+        Graphics::Device.destroyBuffer(stagingBuffer);
+    });
+
+    return timelineValue;
+}
+
+RYME_API
+void Texture::FinishLoading(const Path& path)
+{
+    _path = path;
+
+    Log(RYME_ANCHOR, "Loaded '{}' as {} with {} levels", _path, vk::to_string(_format), _mipLevels);
+
+    _isLoaded = true;
+}
+
+RYME_API
+void Texture::ReplaceImage(Texture& other)
+{
+    // Keep the loaded state and path, only the resources change
+    bool isLoaded = _isLoaded;
+    Free();
+    _isLoaded = isLoaded;
+
+    _format = other._format;
+    _width = other._width;
+    _height = other._height;
+    _mipLevels = other._mipLevels;
+    _samplerCreateInfo = other._samplerCreateInfo;
+
+    std::swap(_image, other._image);
+    std::swap(_allocation, other._allocation);
+    std::swap(_imageView, other._imageView);
+    std::swap(_sampler, other._sampler);
+
+    // The move function refers to the texture it was registered with
+    registerMovable();
+}
+
+RYME_API
+void Texture::Free()
+{
+    _isLoaded = false;
+
+    if (not _image) {
+        return;
+    }
+
+    Defragmenter::Unregister(_allocation);
+
+    // Descriptor sets bound by the recorded frame command buffers may refer to the image view
+    Graphics::InvalidateCommandBuffers();
+
+    // The sampler is destroyed by the cache, once no texture is using it
+    Graphics::DeferDestroy(
+        [imageView = _imageView, image = _image, allocation = _allocation]() {
+            Graphics::Device.destroyImageView(imageView);
+            Graphics::Device.destroyImage(image);
+            Graphics::FreeMemory(allocation);
+        }
+    );
+
+    _sampler.reset();
+    _imageView = nullptr;
+    _image = nullptr;
+    _allocation = nullptr;
+}
+
+vk::ImageCreateInfo Texture::getImageCreateInfo() const
+{
+    return vk::ImageCreateInfo()
+        .setImageType(vk::ImageType::e2D)
+        .setFormat(_format)
+        .setTiling(vk::ImageTiling::eOptimal)
+        .setExtent(vk::Extent3D(_width, _height, 1))
+        .setMipLevels(_mipLevels)
+        .setArrayLayers(1) // TODO: Investigate
+        .setUsage(
+            vk::ImageUsageFlagBits::eTransferSrc |
+            vk::ImageUsageFlagBits::eTransferDst |
+            vk::ImageUsageFlagBits::eSampled
+        )
+        .setInitialLayout(vk::ImageLayout::eUndefined) // Preinitialized?
+        .setSharingMode(vk::SharingMode::eExclusive)
+        .setSamples(vk::SampleCountFlagBits::e1);
+}
+
+void Texture::createImageView()
+{
     auto subresourceRange = vk::ImageSubresourceRange()
         .setAspectMask(vk::ImageAspectFlagBits::eColor)
         .setBaseMipLevel(0)
-        .setLevelCount(1)
+        .setLevelCount(_mipLevels)
         .setBaseArrayLayer(0)
         .setLayerCount(1);
 
     auto imageViewCreateInfo = vk::ImageViewCreateInfo()
         .setImage(_image)
         .setViewType(vk::ImageViewType::e2D)
-        .setFormat(vk::Format::eR8G8B8A8Srgb)
+        .setFormat(_format)
         .setSubresourceRange(subresourceRange);
 
     _imageView = Graphics::Device.createImageView(imageViewCreateInfo);
+}
 
-    _sampler = Graphics::Device.createSampler(samplerCreateInfo);
+void Texture::registerMovable()
+{
+    if (not _image) {
+        return;
+    }
 
-    // TODO: Improve?
-    _samplerCreateInfo = samplerCreateInfo;
-    
-    Log(RYME_ANCHOR, "Loaded '{}'", _path);
+    Defragmenter::RegisterImage(_allocation, _image, getImageCreateInfo(), [this](vk::Image image) {
+        // The view of the previous image may still be in use by frames in flight
+        Graphics::DeferDestroy([imageView = _imageView]() {
+            Graphics::Device.destroyImageView(imageView);
+        });
 
-    _isLoaded = true;
-    return true;
+        _image = image;
+        createImageView();
+    });
 }
 
 RYME_API
-void Texture::Free()
+bool Texture::Reload()
 {
-    Graphics::Device.destroySampler(_sampler);
-    _sampler = nullptr;
+    return LoadFromFile(_path, _samplerCreateInfo, false);
+}
 
-    Graphics::Device.destroyImageView(_imageView);
-    _imageView = nullptr;
+RYME_API
+size_t Texture::GetMemorySize() const
+{
+    if (not _allocation) {
+        return 0;
+    }
 
-    Graphics::Device.destroyImage(_image);
-    _image = nullptr;
+    VmaAllocationInfo allocationInfo;
+    vmaGetAllocationInfo(Graphics::Allocator, _allocation, &allocationInfo);
 
-    vmaFreeMemory(Graphics::Allocator, _allocation);
-    _allocation = nullptr;
+    return static_cast<size_t>(allocationInfo.size);
 }
 
 RYME_API
-bool Texture::Reload()
+void Texture::ScriptInit(py::module m)
 {
-    return LoadFromFile(_path, _samplerCreateInfo, false);
+    py::class_<Texture, std::shared_ptr<Texture>>(m, "Texture")
+        // Declared by Asset, which isn't bound
+        .def("IsLoaded",
+            [](const Texture& texture) {
+                return texture.IsLoaded();
+            })
+        .def("GetWidth", &Texture::GetWidth)
+        .def("GetHeight", &Texture::GetHeight)
+        .def("GetMipLevels", &Texture::GetMipLevels);
 }
 
 } // namespace ryme
\ No newline at end of file
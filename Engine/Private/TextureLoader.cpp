@@ -0,0 +1,353 @@
+#include <Ryme/TextureLoader.hpp>
+#include <Ryme/AsyncIO.hpp>
+#include <Ryme/Graphics.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Profiler.hpp>
+#include <Ryme/Queue.hpp>
+#include <Ryme/ThreadPool.hpp>
+#include <Ryme/VFS.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace ryme {
+
+namespace TextureLoader {
+
+struct LoadGroup
+{
+    size_t TotalCount = 0;
+
+    size_t CompletedCount = 0;
+
+    TextureLoader::ProgressFunc ProgressFunc;
+
+    std::function<void()> CompleteFunc;
+
+}; // struct LoadGroup
+
+struct LoadJob
+{
+    std::shared_ptr<ryme::Texture> Texture;
+
+    ryme::Path Path;
+
+    vk::SamplerCreateInfo SamplerCreateInfo;
+
+    bool Search;
+
+    // Path resolved through the VFS, if searching
+    ryme::Path FullPath;
+
+    TextureLoader::CompleteFunc CompleteFunc;
+
+    std::shared_ptr<LoadGroup> Group;
+
+    // Filled in by the worker
+
+    bool IsDecoded = false;
+
+    ryme::ImageData ImageData;
+
+    uint32_t MipLevels = 0;
+
+}; // struct LoadJob
+
+struct PendingUpload
+{
+    uint64_t TimelineValue;
+
+    List<std::shared_ptr<LoadJob>> JobList;
+
+}; // struct PendingUpload
+
+// Large enough to not hold back a loading screen, small enough to not cause a hitch while playing
+size_t _uploadBudget = 64 * 1024 * 1024;
+
+std::atomic_size_t _pendingCount = 0;
+
+std::mutex _decodedJobMutex;
+
+std::condition_variable _decodedJobCondition;
+
+Queue<std::shared_ptr<LoadJob>> _decodedJobQueue;
+
+Queue<PendingUpload> _pendingUploadQueue;
+
+void decodeJob(std::shared_ptr<LoadJob> job, AsyncIO::ReadResult&& result)
+{
+    RYME_PROFILE_ZONE("TextureLoader::decodeJob");
+
+    try {
+        if (result.Error == 0) {
+            job->IsDecoded = LoadImageData(result.Data, job->FullPath, job->ImageData);
+        }
+        else {
+            // Files in archives are already mapped, so they are read through the VFS instead
+            VFS::File file = VFS::Open(job->FullPath, false);
+
+            if (file.IsOpen()) {
+                job->IsDecoded = LoadImageData(file.GetSpan(), file.GetPath(), job->ImageData);
+            }
+        }
+
+        if (job->IsDecoded) {
+            job->MipLevels = Texture::PrepareImageData(job->ImageData);
+        }
+        else {
+            Log(RYME_ANCHOR, "Failed to load '{}'", job->Path);
+        }
+    }
+    catch (const std::exception& e) {
+        Log(RYME_ANCHOR, "Failed to load '{}': {}", job->Path, e.what());
+        job->IsDecoded = false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_decodedJobMutex);
+        _decodedJobQueue.push_back(std::move(job));
+    }
+
+    _decodedJobCondition.notify_one();
+}
+
+std::shared_ptr<LoadJob> createJob(const Path& path, vk::SamplerCreateInfo samplerCreateInfo, bool search)
+{
+    auto job = std::make_shared<LoadJob>();
+    job->Texture = std::make_shared<Texture>();
+    job->Path = path;
+    job->SamplerCreateInfo = samplerCreateInfo;
+    job->Search = search;
+
+    return job;
+}
+
+// Read every file in one batch, then decode each on the engine ThreadPool as soon as it has been read
+void submitJobList(List<std::shared_ptr<LoadJob>> jobList)
+{
+    List<AsyncIO::ReadRequest> requestList;
+    requestList.reserve(jobList.size());
+
+    for (auto& job : jobList) {
+        ++_pendingCount;
+
+        job->FullPath = (job->Search ? VFS::Resolve(VFS::GetCookedPath(job->Path, "ktx2")) : job->Path);
+
+        requestList.push_back(AsyncIO::ReadRequest{
+            .Path = job->FullPath,
+        });
+    }
+
+    // Each job is moved out of the list as soon as its read completes, and on through to the decoded
+    // queue, so the main thread holds the last reference and the Texture is never destroyed on an I/O
+    // or worker thread
+    AsyncIO::Read(std::move(requestList), [jobList = std::move(jobList)](AsyncIO::ReadResult&& result) mutable {
+        auto job = std::move(jobList[result.Index]);
+
+        GetThreadPool().Submit([job = std::move(job), result = std::move(result)]() mutable {
+            decodeJob(std::move(job), std::move(result));
+        });
+    });
+}
+
+void completeJob(LoadJob& job)
+{
+    if (job.IsDecoded) {
+        job.Texture->FinishLoading(job.FullPath);
+    }
+
+    if (job.CompleteFunc) {
+        job.CompleteFunc(*job.Texture);
+    }
+
+    if (job.Group) {
+        auto& group = *job.Group;
+        ++group.CompletedCount;
+
+        if (group.ProgressFunc) {
+            group.ProgressFunc(group.CompletedCount, group.TotalCount);
+        }
+
+        if (group.CompletedCount == group.TotalCount and group.CompleteFunc) {
+            group.CompleteFunc();
+        }
+    }
+
+    --_pendingCount;
+}
+
+void uploadJobs(List<std::shared_ptr<LoadJob>>& jobList)
+{
+    RYME_PROFILE_FUNCTION();
+
+    List<Texture::Upload> uploadList;
+    uploadList.reserve(jobList.size());
+
+    for (auto& job : jobList) {
+        // When reloading, the previous image is destroyed once the GPU is no longer using it
+        job->Texture->Free();
+        job->Texture->CreateImage(job->ImageData, job->MipLevels, job->SamplerCreateInfo);
+
+        uploadList.push_back(Texture::Upload{
+            .Target = job->Texture.get(),
+            .MipLevelList = job->ImageData.MipLevelList,
+            .Data = job->ImageData.Data,
+        });
+    }
+
+    uint64_t timelineValue = Texture::SubmitUploadList(uploadList);
+
+    // The pixels have been copied, so there is no need to hold on to them until the upload finishes
+    for (auto& job : jobList) {
+        job->ImageData = {};
+    }
+
+    _pendingUploadQueue.push_back(PendingUpload{
+        .TimelineValue = timelineValue,
+        .JobList = std::move(jobList),
+    });
+}
+
+RYME_API
+std::shared_ptr<Texture> LoadAsync(
+    const Path& path,
+    vk::SamplerCreateInfo samplerCreateInfo /*= {}*/,
+    CompleteFunc completeFunc /*= {}*/,
+    bool search /*= true*/
+)
+{
+    auto job = createJob(path, samplerCreateInfo, search);
+    job->CompleteFunc = completeFunc;
+
+    submitJobList({ job });
+
+    return job->Texture;
+}
+
+RYME_API
+List<std::shared_ptr<Texture>> LoadAsync(
+    const List<Path>& pathList,
+    vk::SamplerCreateInfo samplerCreateInfo /*= {}*/,
+    ProgressFunc progressFunc /*= {}*/,
+    std::function<void()> completeFunc /*= {}*/,
+    bool search /*= true*/
+)
+{
+    auto group = std::make_shared<LoadGroup>();
+    group->TotalCount = pathList.size();
+    group->ProgressFunc = progressFunc;
+    group->CompleteFunc = completeFunc;
+
+    List<std::shared_ptr<Texture>> textureList;
+    textureList.reserve(pathList.size());
+
+    List<std::shared_ptr<LoadJob>> jobList;
+    jobList.reserve(pathList.size());
+
+    for (const auto& path : pathList) {
+        auto job = createJob(path, samplerCreateInfo, search);
+        job->Group = group;
+
+        textureList.push_back(job->Texture);
+        jobList.push_back(job);
+    }
+
+    submitJobList(std::move(jobList));
+
+    return textureList;
+}
+
+RYME_API
+void Update()
+{
+    RYME_PROFILE_FUNCTION();
+
+    while (not _pendingUploadQueue.empty()
+        and Graphics::IsTimelineValueComplete(_pendingUploadQueue.front().TimelineValue)) {
+        for (auto& job : _pendingUploadQueue.front().JobList) {
+            completeJob(*job);
+        }
+
+        _pendingUploadQueue.pop_front();
+    }
+
+    List<std::shared_ptr<LoadJob>> failedJobList;
+    List<std::shared_ptr<LoadJob>> uploadJobList;
+
+    {
+        std::lock_guard<std::mutex> lock(_decodedJobMutex);
+
+        size_t uploadSize = 0;
+
+        while (not _decodedJobQueue.empty()) {
+            auto& job = _decodedJobQueue.front();
+
+            if (not job->IsDecoded) {
+                failedJobList.push_back(job);
+            }
+            else {
+                size_t size = job->ImageData.Data.size();
+
+                if (not uploadJobList.empty() and uploadSize + size > _uploadBudget) {
+                    break;
+                }
+
+                uploadSize += size;
+                uploadJobList.push_back(job);
+            }
+
+            _decodedJobQueue.pop_front();
+        }
+    }
+
+    // Callbacks are called without the lock held, so they are free to request more textures
+    for (auto& job : failedJobList) {
+        completeJob(*job);
+    }
+
+    if (not uploadJobList.empty()) {
+        uploadJobs(uploadJobList);
+    }
+}
+
+RYME_API
+void Wait()
+{
+    while (_pendingCount > 0) {
+        Update();
+
+        if (not _pendingUploadQueue.empty()) {
+            Graphics::WaitForTimelineValue(_pendingUploadQueue.back().TimelineValue);
+        }
+        else {
+            std::unique_lock<std::mutex> lock(_decodedJobMutex);
+
+            _decodedJobCondition.wait(lock, []() {
+                return not _decodedJobQueue.empty();
+            });
+        }
+    }
+}
+
+RYME_API
+size_t GetPendingCount()
+{
+    return _pendingCount;
+}
+
+RYME_API
+void SetUploadBudget(size_t bytes)
+{
+    _uploadBudget = bytes;
+}
+
+RYME_API
+size_t GetUploadBudget()
+{
+    return _uploadBudget;
+}
+
+} // namespace TextureLoader
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,554 @@
+#include <Ryme/TextureStreamer.hpp>
+#include <Ryme/Graphics.hpp>
+#include <Ryme/ImageData.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Map.hpp>
+#include <Ryme/Profiler.hpp>
+#include <Ryme/Queue.hpp>
+#include <Ryme/ThreadPool.hpp>
+#include <Ryme/VFS.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include <pybind11/stl.h>
+
+namespace ryme {
+
+namespace TextureStreamer {
+
+struct StreamedTexture
+{
+    std::shared_ptr<ryme::Texture> Texture;
+
+    ryme::Path Path;
+
+    vk::SamplerCreateInfo SamplerCreateInfo;
+
+    bool Search;
+
+    // Every level, kept in system memory so they can be uploaded again after being evicted
+    ryme::ImageData ImageData;
+
+    bool IsDecoded = false;
+
+    // The least detailed level that is resident, from there down to the last level is always resident
+    uint32_t MinResidentLevel = 0;
+
+    // The most detailed level that is resident, or the level count when none are
+    uint32_t ResidentLevel = 0;
+
+    // The level being uploaded, or ResidentLevel when nothing is in flight
+    uint32_t PendingLevel = 0;
+
+    // The most detailed level requested during the current frame
+    uint32_t RequestedLevel = 0;
+
+    // The most detailed level requested during the last frame the texture was used
+    uint32_t WantedLevel = 0;
+
+    uint32_t HeapIndex = VK_MAX_MEMORY_HEAPS;
+
+    uint64_t LastUsedFrame = 0;
+
+}; // struct StreamedTexture
+
+struct LevelChange
+{
+    std::shared_ptr<StreamedTexture> Streamed;
+
+    // Holds the new image until the upload finishes, then the previous one until it is destroyed
+    std::unique_ptr<ryme::Texture> Texture;
+
+    uint32_t Level;
+
+}; // struct LevelChange
+
+struct PendingUpload
+{
+    uint64_t TimelineValue;
+
+    List<LevelChange> ChangeList;
+
+}; // struct PendingUpload
+
+size_t _uploadBudget = 16 * 1024 * 1024;
+
+uint32_t _minResidentSize = 64;
+
+vk::DeviceSize _heapBudgetList[VK_MAX_MEMORY_HEAPS] = {};
+
+uint64_t _frameIndex = 1;
+
+Stats _stats;
+
+Map<const Texture *, std::shared_ptr<StreamedTexture>> _streamedTextureMap;
+
+std::mutex _decodedMutex;
+
+Queue<std::shared_ptr<StreamedTexture>> _decodedQueue;
+
+Queue<PendingUpload> _pendingUploadQueue;
+
+void decodeTexture(std::shared_ptr<StreamedTexture> streamed)
+{
+    RYME_PROFILE_ZONE("TextureStreamer::decodeTexture");
+
+    try {
+        Path loadPath = (streamed->Search ? VFS::GetCookedPath(streamed->Path, "ktx2") : streamed->Path);
+
+        VFS::File file = VFS::Open(loadPath, streamed->Search);
+
+        if (file.IsOpen()) {
+            streamed->IsDecoded = LoadImageData(file.GetSpan(), file.GetPath(), streamed->ImageData);
+        }
+
+        if (streamed->IsDecoded) {
+            streamed->Path = file.GetPath();
+
+            // Levels are uploaded a few at a time, so they can't be blitted on the GPU
+            uint32_t mipLevels = Texture::PrepareImageData(streamed->ImageData);
+            if (mipLevels > streamed->ImageData.MipLevelList.size()) {
+                GenerateMipmaps(streamed->ImageData);
+            }
+        }
+        else {
+            Log(RYME_ANCHOR, "Failed to load '{}'", streamed->Path);
+        }
+    }
+    catch (const std::exception& e) {
+        Log(RYME_ANCHOR, "Failed to load '{}': {}", streamed->Path, e.what());
+        streamed->IsDecoded = false;
+    }
+
+    std::lock_guard<std::mutex> lock(_decodedMutex);
+    _decodedQueue.push_back(streamed);
+}
+
+///
+/// @return The size of the levels from level down to the last one
+///
+vk::DeviceSize getChainSize(const ImageData& imageData, uint32_t level)
+{
+    const auto& lastLevel = imageData.MipLevelList.back();
+    return (lastLevel.Offset + lastLevel.Size) - imageData.MipLevelList[level].Offset;
+}
+
+///
+/// @return A description of the levels from level down to the last one, without their data
+///
+ImageData getChainImageData(const ImageData& imageData, uint32_t level)
+{
+    const auto& firstLevel = imageData.MipLevelList[level];
+
+    ImageData chain;
+    chain.Format = imageData.Format;
+    chain.Width = firstLevel.Width;
+    chain.Height = firstLevel.Height;
+
+    for (uint32_t i = level; i < imageData.MipLevelList.size(); ++i) {
+        MipLevel mipLevel = imageData.MipLevelList[i];
+        mipLevel.Offset -= firstLevel.Offset;
+
+        chain.MipLevelList.push_back(mipLevel);
+    }
+
+    return chain;
+}
+
+vk::DeviceSize getHeapBudget(uint32_t heapIndex, const VmaBudget& budget)
+{
+    if (_heapBudgetList[heapIndex] > 0) {
+        return _heapBudgetList[heapIndex];
+    }
+
+    // Leave some room for everything that isn't streamed, and for the driver
+    return budget.budget / 10 * 9;
+}
+
+void uploadChanges(List<LevelChange>& changeList)
+{
+    RYME_PROFILE_FUNCTION();
+
+    List<Texture::Upload> uploadList;
+    uploadList.reserve(changeList.size());
+
+    for (auto& change : changeList) {
+        const auto& imageData = change.Streamed->ImageData;
+
+        ImageData chain = getChainImageData(imageData, change.Level);
+
+        change.Texture = std::make_unique<Texture>();
+        change.Texture->CreateImage(chain, chain.MipLevelList.size(), change.Streamed->SamplerCreateInfo);
+
+        uploadList.push_back(Texture::Upload{
+            .Target = change.Texture.get(),
+            .MipLevelList = std::move(chain.MipLevelList),
+            .Data = Span<const uint8_t>(imageData.Data).subspan(
+                imageData.MipLevelList[change.Level].Offset,
+                getChainSize(imageData, change.Level)
+            ),
+        });
+    }
+
+    uint64_t timelineValue = Texture::SubmitUploadList(uploadList);
+
+    _pendingUploadQueue.push_back(PendingUpload{
+        .TimelineValue = timelineValue,
+        .ChangeList = std::move(changeList),
+    });
+}
+
+void completeChange(LevelChange& change)
+{
+    auto& streamed = *change.Streamed;
+
+    // Frees the previous image, deferring its destruction until the GPU is done with it, and leaves
+    // change.Texture without an image
+    streamed.Texture->ReplaceImage(*change.Texture);
+    streamed.ResidentLevel = change.Level;
+
+    VmaAllocationInfo allocationInfo;
+    vmaGetAllocationInfo(Graphics::Allocator, streamed.Texture->GetAllocation(), &allocationInfo);
+
+    const VkPhysicalDeviceMemoryProperties * memoryProperties;
+    vmaGetMemoryProperties(Graphics::Allocator, &memoryProperties);
+
+    streamed.HeapIndex = memoryProperties->memoryTypes[allocationInfo.memoryType].heapIndex;
+
+    if (not streamed.Texture->IsLoaded()) {
+        streamed.Texture->FinishLoading(streamed.Path);
+    }
+}
+
+void registerTexture(std::shared_ptr<StreamedTexture> streamed)
+{
+    const auto& mipLevelList = streamed->ImageData.MipLevelList;
+    uint32_t mipLevels = mipLevelList.size();
+
+    streamed->MinResidentLevel = mipLevels - 1;
+
+    for (uint32_t level = 0; level < mipLevels; ++level) {
+        if (std::max(mipLevelList[level].Width, mipLevelList[level].Height) <= _minResidentSize) {
+            streamed->MinResidentLevel = level;
+            break;
+        }
+    }
+
+    streamed->ResidentLevel = mipLevels;
+    streamed->PendingLevel = mipLevels;
+    streamed->RequestedLevel = streamed->MinResidentLevel;
+    streamed->WantedLevel = streamed->MinResidentLevel;
+    streamed->LastUsedFrame = _frameIndex;
+
+    _streamedTextureMap[streamed->Texture.get()] = streamed;
+}
+
+void addChange(List<LevelChange>& changeList, std::shared_ptr<StreamedTexture> streamed, uint32_t level)
+{
+    streamed->PendingLevel = level;
+
+    changeList.push_back(LevelChange{
+        .Streamed = streamed,
+        .Level = level,
+    });
+}
+
+RYME_API
+std::shared_ptr<Texture> Load(const Path& path, vk::SamplerCreateInfo samplerCreateInfo /*= {}*/, bool search /*= true*/)
+{
+    auto streamed = std::make_shared<StreamedTexture>();
+    streamed->Texture = std::make_shared<Texture>();
+    streamed->Path = path;
+    streamed->SamplerCreateInfo = samplerCreateInfo;
+    streamed->Search = search;
+
+    GetThreadPool().Submit([streamed]() {
+        decodeTexture(streamed);
+    });
+
+    return streamed->Texture;
+}
+
+RYME_API
+void Request(const Texture& texture, float screenSize)
+{
+    auto it = _streamedTextureMap.find(&texture);
+    if (it == _streamedTextureMap.end()) {
+        return;
+    }
+
+    auto& streamed = *it->second;
+
+    const auto& firstLevel = streamed.ImageData.MipLevelList.front();
+    float size = std::max(firstLevel.Width, firstLevel.Height);
+
+    // One texel per pixel, any more detail than that would only be filtered away
+    uint32_t level = streamed.MinResidentLevel;
+    if (screenSize > 0.0f) {
+        float lod = std::floor(std::log2(size / screenSize));
+        level = std::min(uint32_t(std::max(lod, 0.0f)), streamed.MinResidentLevel);
+    }
+
+    if (streamed.LastUsedFrame != _frameIndex) {
+        streamed.LastUsedFrame = _frameIndex;
+        streamed.RequestedLevel = level;
+    }
+    else {
+        streamed.RequestedLevel = std::min(streamed.RequestedLevel, level);
+    }
+}
+
+RYME_API
+void Update()
+{
+    RYME_PROFILE_FUNCTION();
+
+    _stats.StreamedLevelCount = 0;
+    _stats.EvictedLevelCount = 0;
+
+    for (auto& [texture, streamed] : _streamedTextureMap) {
+        if (streamed->LastUsedFrame == _frameIndex) {
+            streamed->WantedLevel = streamed->RequestedLevel;
+        }
+    }
+
+    ++_frameIndex;
+
+    while (not _pendingUploadQueue.empty()
+        and Graphics::IsTimelineValueComplete(_pendingUploadQueue.front().TimelineValue)) {
+        for (auto& change : _pendingUploadQueue.front().ChangeList) {
+            completeChange(change);
+        }
+
+        _pendingUploadQueue.pop_front();
+    }
+
+    List<LevelChange> changeList;
+
+    {
+        std::lock_guard<std::mutex> lock(_decodedMutex);
+
+        while (not _decodedQueue.empty()) {
+            auto streamed = _decodedQueue.front();
+            _decodedQueue.pop_front();
+
+            if (streamed->IsDecoded) {
+                registerTexture(streamed);
+
+                // The smallest levels are uploaded right away, regardless of the budget
+                addChange(changeList, streamed, streamed->MinResidentLevel);
+            }
+        }
+    }
+
+    // Stop streaming textures that are only referenced by the streamer, once they are idle
+    for (auto it = _streamedTextureMap.begin(); it != _streamedTextureMap.end();) {
+        const auto& streamed = *it->second;
+
+        if (streamed.Texture.use_count() == 1 and streamed.PendingLevel == streamed.ResidentLevel) {
+            it = _streamedTextureMap.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    VmaBudget budgetList[VK_MAX_MEMORY_HEAPS] = {};
+    vmaGetHeapBudgets(Graphics::Allocator, budgetList);
+
+    // How much each heap can grow, negative when it is over budget
+    int64_t headroomList[VK_MAX_MEMORY_HEAPS];
+    for (uint32_t heap = 0; heap < VK_MAX_MEMORY_HEAPS; ++heap) {
+        headroomList[heap] = int64_t(getHeapBudget(heap, budgetList[heap])) - int64_t(budgetList[heap].usage);
+    }
+
+    // Only textures with their levels resident and no upload in flight can change
+    List<std::shared_ptr<StreamedTexture>> idleList;
+
+    _stats.TextureCount = _streamedTextureMap.size();
+    _stats.ResidentSize = 0;
+    _stats.TotalSize = 0;
+
+    for (auto& [texture, streamed] : _streamedTextureMap) {
+        const auto& imageData = streamed->ImageData;
+
+        _stats.TotalSize += getChainSize(imageData, 0);
+
+        if (streamed->ResidentLevel < imageData.MipLevelList.size()) {
+            _stats.ResidentSize += getChainSize(imageData, streamed->ResidentLevel);
+        }
+
+        if (streamed->PendingLevel == streamed->ResidentLevel and streamed->HeapIndex < VK_MAX_MEMORY_HEAPS) {
+            idleList.push_back(streamed);
+        }
+    }
+
+    // Least recently used first
+    std::sort(idleList.begin(), idleList.end(),
+        [](const auto& a, const auto& b) {
+            return a->LastUsedFrame < b->LastUsedFrame;
+        }
+    );
+
+    // Evict the most detailed level of each texture in turn, until every heap is back under budget
+    for (const auto& streamed : idleList) {
+        auto& headroom = headroomList[streamed->HeapIndex];
+        if (headroom >= 0 or streamed->ResidentLevel >= streamed->MinResidentLevel) {
+            continue;
+        }
+
+        const auto& imageData = streamed->ImageData;
+        headroom += imageData.MipLevelList[streamed->ResidentLevel].Size;
+
+        ++_stats.EvictedLevelCount;
+
+        addChange(changeList, streamed, streamed->ResidentLevel + 1);
+    }
+
+    // Upload one more level for the textures that want it, most recently used first
+    size_t uploadSize = 0;
+
+    for (auto it = idleList.rbegin(); it != idleList.rend(); ++it) {
+        const auto& streamed = *it;
+
+        // Skip the textures that were just evicted
+        if (streamed->WantedLevel >= streamed->ResidentLevel or streamed->PendingLevel != streamed->ResidentLevel) {
+            continue;
+        }
+
+        // Both images exist until the previous one is destroyed
+        uint32_t level = streamed->ResidentLevel - 1;
+        vk::DeviceSize size = getChainSize(streamed->ImageData, level);
+
+        auto& headroom = headroomList[streamed->HeapIndex];
+        if (headroom < int64_t(size)) {
+            continue;
+        }
+
+        if (not changeList.empty() and uploadSize + size > _uploadBudget) {
+            break;
+        }
+
+        headroom -= size;
+        uploadSize += size;
+
+        ++_stats.StreamedLevelCount;
+
+        addChange(changeList, streamed, level);
+    }
+
+    if (not changeList.empty()) {
+        uploadChanges(changeList);
+    }
+}
+
+RYME_API
+void Term()
+{
+    _pendingUploadQueue.clear();
+    _streamedTextureMap.clear();
+
+    std::lock_guard<std::mutex> lock(_decodedMutex);
+    _decodedQueue.clear();
+}
+
+RYME_API
+void SetHeapBudget(uint32_t heapIndex, vk::DeviceSize bytes)
+{
+    if (heapIndex < VK_MAX_MEMORY_HEAPS) {
+        _heapBudgetList[heapIndex] = bytes;
+    }
+}
+
+RYME_API
+vk::DeviceSize GetHeapBudget(uint32_t heapIndex)
+{
+    if (heapIndex >= VK_MAX_MEMORY_HEAPS) {
+        return 0;
+    }
+
+    VmaBudget budgetList[VK_MAX_MEMORY_HEAPS] = {};
+    vmaGetHeapBudgets(Graphics::Allocator, budgetList);
+
+    return getHeapBudget(heapIndex, budgetList[heapIndex]);
+}
+
+RYME_API
+void SetUploadBudget(size_t bytes)
+{
+    _uploadBudget = bytes;
+}
+
+RYME_API
+size_t GetUploadBudget()
+{
+    return _uploadBudget;
+}
+
+RYME_API
+void SetMinResidentSize(uint32_t size)
+{
+    _minResidentSize = std::max(size, 1u);
+}
+
+RYME_API
+uint32_t GetMinResidentSize()
+{
+    return _minResidentSize;
+}
+
+RYME_API
+uint32_t GetResidentLevel(const Texture& texture)
+{
+    auto it = _streamedTextureMap.find(&texture);
+    if (it == _streamedTextureMap.end()) {
+        return 0;
+    }
+
+    return it->second->ResidentLevel;
+}
+
+RYME_API
+Stats GetStats()
+{
+    return _stats;
+}
+
+RYME_API
+void ScriptInit(py::module m)
+{
+    auto textureStreamer = m.def_submodule("TextureStreamer");
+
+    // Texture is bound by Texture::ScriptInit(), which has to run first
+
+    py::class_<Stats>(textureStreamer, "Stats")
+        .def_readonly("TextureCount", &Stats::TextureCount)
+        .def_readonly("ResidentSize", &Stats::ResidentSize)
+        .def_readonly("TotalSize", &Stats::TotalSize)
+        .def_readonly("StreamedLevelCount", &Stats::StreamedLevelCount)
+        .def_readonly("EvictedLevelCount", &Stats::EvictedLevelCount);
+
+    textureStreamer
+        .def("Load",
+            [](const String& path, bool search) {
+                return Load(path, {}, search);
+            },
+            py::arg("path"),
+            py::arg("search") = true)
+        .def("Request", &Request, py::arg("texture"), py::arg("screenSize"))
+        .def("SetHeapBudget", &SetHeapBudget)
+        .def("GetHeapBudget", &GetHeapBudget)
+        .def("SetUploadBudget", &SetUploadBudget)
+        .def("GetUploadBudget", &GetUploadBudget)
+        .def("SetMinResidentSize", &SetMinResidentSize)
+        .def("GetMinResidentSize", &GetMinResidentSize)
+        .def("GetResidentLevel", &GetResidentLevel)
+        .def("GetStats", &GetStats);
+}
+
+} // namespace TextureStreamer
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include <Ryme/ThreadPool.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace ryme {
+
+RYME_API
+ThreadPool::ThreadPool(unsigned threadCount /*= 0*/, StringView name /*= "Worker"*/)
+{
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    _threadList.reserve(threadCount);
+
+    for (unsigned i = 0; i < threadCount; ++i) {
+        _threadList.emplace_back(&ThreadPool::workerMain, this, fmt::format("{} {}", name, i));
+    }
+}
+
+RYME_API
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+
+    _taskCondition.notify_all();
+
+    for (auto& thread : _threadList) {
+        thread.join();
+    }
+}
+
+RYME_API
+void ThreadPool::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _taskQueue.push_back(std::move(task));
+        ++_unfinishedTaskCount;
+    }
+
+    _taskCondition.notify_one();
+}
+
+RYME_API
+void ThreadPool::ParallelFor(size_t count, std::function<void(size_t index)> func)
+{
+    if (count < 2 or _threadList.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    struct State
+    {
+        std::function<void(size_t index)> Func;
+
+        size_t Count;
+
+        std::atomic_size_t NextIndex = 0;
+
+        std::atomic_size_t FinishedCount = 0;
+
+        std::mutex ExceptionMutex;
+
+        // The first exception thrown by Func, on any thread
+        std::exception_ptr Exception;
+
+    }; // struct State
+
+    auto state = std::make_shared<State>();
+    state->Func = std::move(func);
+    state->Count = count;
+
+    // Workers that only start once every index has been taken return without calling Func, so they
+    // never outlive what it refers to. Exceptions are caught so that every index is counted as
+    // finished, and the calling thread doesn't return while workers are still calling Func
+    auto run = [state]() {
+        size_t index;
+        while ((index = state->NextIndex++) < state->Count) {
+            try {
+                state->Func(index);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(state->ExceptionMutex);
+                if (not state->Exception) {
+                    state->Exception = std::current_exception();
+                }
+            }
+
+            if (++state->FinishedCount == state->Count) {
+                state->FinishedCount.notify_all();
+            }
+        }
+    };
+
+    size_t taskCount = std::min(_threadList.size(), count - 1);
+    for (size_t i = 0; i < taskCount; ++i) {
+        Submit(run);
+    }
+
+    run();
+
+    size_t finishedCount;
+    while ((finishedCount = state->FinishedCount) < count) {
+        state->FinishedCount.wait(finishedCount);
+    }
+
+    if (state->Exception) {
+        std::rethrow_exception(state->Exception);
+    }
+}
+
+RYME_API
+void ThreadPool::Wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _idleCondition.wait(lock, [this]() {
+        return (_unfinishedTaskCount == 0);
+    });
+}
+
+void ThreadPool::workerMain(String name)
+{
+    Profiler::SetThreadName(name);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        _taskCondition.wait(lock, [this]() {
+            return (_isStopping or not _taskQueue.empty());
+        });
+
+        // Remaining tasks are still run when stopping, so nothing that was submitted is lost
+        if (_taskQueue.empty()) {
+            break;
+        }
+
+        auto task = std::move(_taskQueue.front());
+        _taskQueue.pop_front();
+
+        lock.unlock();
+
+        // An exception would otherwise terminate the whole process
+        try {
+            task();
+        }
+        catch (const std::exception& e) {
+            Log("Exception", "{}", e.what());
+        }
+
+        lock.lock();
+
+        --_unfinishedTaskCount;
+
+        if (_unfinishedTaskCount == 0) {
+            _idleCondition.notify_all();
+        }
+    }
+}
+
+} // namespace ryme
\ No newline at end of file
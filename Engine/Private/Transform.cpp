@@ -3,7 +3,7 @@
 namespace ryme {
 
 RYME_API
-inline Mat4 Transform::ToMatrix() const
+Mat4 Transform::ToMatrix() const
 {
     Mat4 matrix = Mat4(1.0f);
     matrix = glm::translate(matrix, Position);
@@ -0,0 +1,687 @@
+#include <Ryme/TriangleBVH.hpp>
+#include <Ryme/Entity.hpp>
+#include <Ryme/Exception.hpp>
+#include <Ryme/Mesh.hpp>
+#include <Ryme/ModelComponent.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(RYME_SIMD_SSE2)
+    #include <emmintrin.h>
+#elif defined(RYME_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace ryme {
+
+// The number of buckets the centers are sorted into, when looking for the best split
+const size_t TriangleBinCount = 12;
+
+// Past this depth nodes are split at the median instead, which bounds the depth of the tree by the
+// log of the number of triangles, and keeps the traversal stack small
+const uint32_t MaxSAHDepth = 40;
+
+const uint32_t MaxDepth = 96;
+
+// Half of the surface area of a box, which is all the heuristic needs
+inline float getHalfSurfaceArea(const Vec3& min, const Vec3& max)
+{
+    Vec3 size = max - min;
+    return (size.x * size.y) + (size.y * size.z) + (size.z * size.x);
+}
+
+// The distance along a ray to where it enters a box, or infinity if it misses or the box is farther
+// than maxDistance
+inline float intersectBox(const Vec3& min, const Vec3& max, const Vec3& origin, const Vec3& inverseDirection, float maxDistance)
+{
+    Vec3 slab0 = (min - origin) * inverseDirection;
+    Vec3 slab1 = (max - origin) * inverseDirection;
+
+    Vec3 enter = glm::min(slab0, slab1);
+    Vec3 exit = glm::max(slab0, slab1);
+
+    float enterDistance = std::max(std::max(enter.x, enter.y), std::max(enter.z, 0.0f));
+    float exitDistance = std::min(std::min(exit.x, exit.y), std::min(exit.z, maxDistance));
+
+    if (enterDistance > exitDistance) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    return enterDistance;
+}
+
+RYME_API
+TriangleBVH::TriangleBVH(const MeshData& data)
+{
+    if (data.PrimitiveTopology != vk::PrimitiveTopology::eTriangleList) {
+        return;
+    }
+
+    List<Vec3> positionList;
+    positionList.reserve(data.VertexList.size());
+
+    for (const auto& vertex : data.VertexList) {
+        positionList.push_back(Vec3(vertex.Position));
+    }
+
+    if (data.IndexList.empty()) {
+        List<uint32_t> indexList(positionList.size());
+
+        for (size_t i = 0; i < indexList.size(); ++i) {
+            indexList[i] = static_cast<uint32_t>(i);
+        }
+
+        Build(positionList, indexList);
+    }
+    else {
+        Build(positionList, data.IndexList);
+    }
+}
+
+RYME_API
+TriangleBVH::TriangleBVH(Span<const Vec3> positionList, Span<const uint32_t> indexList)
+{
+    Build(positionList, indexList);
+}
+
+RYME_API
+void TriangleBVH::Build(Span<const Vec3> positionList, Span<const uint32_t> indexList)
+{
+    RYME_PROFILE_FUNCTION();
+
+    _nodeList.clear();
+    _packetList.clear();
+
+    _triangleCount = static_cast<uint32_t>(indexList.size() / 3);
+
+    if (_triangleCount == 0) {
+        return;
+    }
+
+    List<BuildTriangle> triangleList(_triangleCount);
+
+    for (uint32_t i = 0; i < _triangleCount; ++i) {
+        const Vec3& v0 = positionList[indexList[i * 3 + 0]];
+        const Vec3& v1 = positionList[indexList[i * 3 + 1]];
+        const Vec3& v2 = positionList[indexList[i * 3 + 2]];
+
+        triangleList[i] = BuildTriangle{
+            .Min = glm::min(glm::min(v0, v1), v2),
+            .Triangle = i,
+            .Max = glm::max(glm::max(v0, v1), v2),
+        };
+    }
+
+    // Every leaf has at least one triangle, and a binary tree has fewer internal nodes than leaves
+    _nodeList.reserve(_triangleCount * 2);
+    _nodeList.emplace_back();
+
+    buildNode(0, triangleList.data(), triangleList.size(), 0, positionList, indexList);
+}
+
+RYME_API
+bool TriangleBVH::Intersect(const Ray& ray, RayHit& hit) const
+{
+    return intersect<false>(ray, hit);
+}
+
+RYME_API
+bool TriangleBVH::IntersectAny(const Ray& ray) const
+{
+    RayHit hit;
+    return intersect<true>(ray, hit);
+}
+
+RYME_API
+void TriangleBVH::IntersectList(Span<const Ray> rayList, Span<RayHit> hitList, ThreadPool * threadPool /*= nullptr*/) const
+{
+    RYME_PROFILE_FUNCTION();
+
+    if (hitList.size() < rayList.size()) {
+        throw Exception("TriangleBVH::IntersectList() needs a hit for each of the {} rays, {} given",
+            rayList.size(),
+            hitList.size()
+        );
+    }
+
+    auto intersectRay = [&](size_t index) {
+        hitList[index] = {};
+        intersect<false>(rayList[index], hitList[index]);
+    };
+
+    if (threadPool) {
+        threadPool->ParallelFor(rayList.size(), intersectRay);
+    }
+    else {
+        for (size_t i = 0; i < rayList.size(); ++i) {
+            intersectRay(i);
+        }
+    }
+}
+
+void TriangleBVH::buildNode(
+    uint32_t index,
+    BuildTriangle * triangleList,
+    size_t triangleCount,
+    uint32_t depth,
+    Span<const Vec3> positionList,
+    Span<const uint32_t> indexList
+)
+{
+    // Twice the center, which sorts the same
+    auto getCenter = [](const BuildTriangle& triangle) {
+        return triangle.Min + triangle.Max;
+    };
+
+    Vec3 min = triangleList[0].Min;
+    Vec3 max = triangleList[0].Max;
+
+    Vec3 centerMin = getCenter(triangleList[0]);
+    Vec3 centerMax = centerMin;
+
+    for (size_t i = 1; i < triangleCount; ++i) {
+        min = glm::min(min, triangleList[i].Min);
+        max = glm::max(max, triangleList[i].Max);
+
+        Vec3 center = getCenter(triangleList[i]);
+        centerMin = glm::min(centerMin, center);
+        centerMax = glm::max(centerMax, center);
+    }
+
+    _nodeList[index].Min = min;
+    _nodeList[index].Max = max;
+
+    if (triangleCount <= LeafTriangleCount) {
+        TrianglePacket packet = {};
+
+        for (uint32_t lane = 0; lane < LeafTriangleCount; ++lane) {
+            packet.TriangleList[lane] = UINT32_MAX;
+        }
+
+        for (uint32_t lane = 0; lane < triangleCount; ++lane) {
+            uint32_t triangle = triangleList[lane].Triangle;
+
+            const Vec3& v0 = positionList[indexList[triangle * 3 + 0]];
+            const Vec3& v1 = positionList[indexList[triangle * 3 + 1]];
+            const Vec3& v2 = positionList[indexList[triangle * 3 + 2]];
+
+            Vec3 edge1 = v1 - v0;
+            Vec3 edge2 = v2 - v0;
+
+            for (unsigned k = 0; k < 3; ++k) {
+                packet.Vertex0[k][lane] = v0[k];
+                packet.Edge1[k][lane] = edge1[k];
+                packet.Edge2[k][lane] = edge2[k];
+            }
+
+            packet.TriangleList[lane] = triangle;
+        }
+
+        _nodeList[index].First = static_cast<uint32_t>(_packetList.size());
+        _nodeList[index].TriangleCount = static_cast<uint32_t>(triangleCount);
+
+        _packetList.push_back(packet);
+
+        return;
+    }
+
+    Vec3 extent = centerMax - centerMin;
+
+    unsigned axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
+
+    size_t splitCount = 0;
+
+    if (extent[axis] > 0.0f and depth < MaxSAHDepth) {
+        struct Bin
+        {
+            Vec3 Min = Vec3(std::numeric_limits<float>::max());
+
+            Vec3 Max = Vec3(std::numeric_limits<float>::lowest());
+
+            size_t Count = 0;
+
+        }; // struct Bin
+
+        Array<Bin, TriangleBinCount> binList;
+
+        float scale = TriangleBinCount / extent[axis];
+
+        auto getBin = [&](const BuildTriangle& triangle) {
+            size_t bin = static_cast<size_t>((getCenter(triangle)[axis] - centerMin[axis]) * scale);
+            return std::min(bin, TriangleBinCount - 1);
+        };
+
+        for (size_t i = 0; i < triangleCount; ++i) {
+            auto& bin = binList[getBin(triangleList[i])];
+            bin.Min = glm::min(bin.Min, triangleList[i].Min);
+            bin.Max = glm::max(bin.Max, triangleList[i].Max);
+            ++bin.Count;
+        }
+
+        // The cost of everything right of each split, swept from the right
+        Array<float, TriangleBinCount> rightCostList;
+        Bin right;
+
+        for (size_t i = TriangleBinCount - 1; i > 0; --i) {
+            right.Min = glm::min(right.Min, binList[i].Min);
+            right.Max = glm::max(right.Max, binList[i].Max);
+            right.Count += binList[i].Count;
+
+            rightCostList[i] = (right.Count > 0 ? getHalfSurfaceArea(right.Min, right.Max) * right.Count : 0.0f);
+        }
+
+        Bin left;
+        float bestCost = std::numeric_limits<float>::max();
+        size_t bestBin = 0;
+
+        // Split between bin i - 1 and bin i
+        for (size_t i = 1; i < TriangleBinCount; ++i) {
+            left.Min = glm::min(left.Min, binList[i - 1].Min);
+            left.Max = glm::max(left.Max, binList[i - 1].Max);
+            left.Count += binList[i - 1].Count;
+
+            if (left.Count == 0 or left.Count == triangleCount) {
+                continue;
+            }
+
+            float cost = getHalfSurfaceArea(left.Min, left.Max) * left.Count + rightCostList[i];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestBin = i;
+            }
+        }
+
+        if (bestBin > 0) {
+            auto it = std::partition(triangleList, triangleList + triangleCount, [&](const auto& triangle) {
+                return (getBin(triangle) < bestBin);
+            });
+
+            splitCount = static_cast<size_t>(it - triangleList);
+        }
+    }
+
+    if (splitCount == 0) {
+        splitCount = triangleCount / 2;
+
+        std::nth_element(triangleList, triangleList + splitCount, triangleList + triangleCount,
+            [&](const auto& a, const auto& b) {
+                return (getCenter(a)[axis] < getCenter(b)[axis]);
+            });
+    }
+
+    uint32_t first = static_cast<uint32_t>(_nodeList.size());
+
+    _nodeList[index].First = first;
+    _nodeList[index].TriangleCount = 0;
+
+    _nodeList.emplace_back();
+    _nodeList.emplace_back();
+
+    buildNode(first, triangleList, splitCount, depth + 1, positionList, indexList);
+    buildNode(first + 1, triangleList + splitCount, triangleCount - splitCount, depth + 1, positionList, indexList);
+}
+
+template <bool Any>
+bool TriangleBVH::intersect(const Ray& ray, RayHit& hit) const
+{
+    if (_nodeList.empty()) {
+        return false;
+    }
+
+    // Components of 0 become infinity, which the slabs handle as parallel to the ray
+    Vec3 inverseDirection = 1.0f / ray.Direction;
+
+    float maxDistance = std::min(ray.MaxDistance, hit.Distance);
+
+    const auto& root = _nodeList[0];
+    if (intersectBox(root.Min, root.Max, ray.Origin, inverseDirection, maxDistance) == std::numeric_limits<float>::infinity()) {
+        return false;
+    }
+
+    // The children that were hit but not visited yet, with the distance to where the ray enters them
+    Array<uint32_t, MaxDepth> stack;
+    Array<float, MaxDepth> stackDistance;
+    size_t stackSize = 0;
+
+    uint32_t index = 0;
+    bool isHit = false;
+
+    while (true) {
+        const auto& node = _nodeList[index];
+
+        if (node.TriangleCount > 0) {
+            if (intersectPacket(_packetList[node.First], ray, maxDistance, hit)) {
+                isHit = true;
+
+                if constexpr (Any) {
+                    return true;
+                }
+
+                maxDistance = hit.Distance;
+            }
+        }
+        else {
+            uint32_t child0 = node.First;
+            uint32_t child1 = node.First + 1;
+
+            float distance0 = intersectBox(_nodeList[child0].Min, _nodeList[child0].Max, ray.Origin, inverseDirection, maxDistance);
+            float distance1 = intersectBox(_nodeList[child1].Min, _nodeList[child1].Max, ray.Origin, inverseDirection, maxDistance);
+
+            // Visit the closer child first, so hits found in it can skip the other
+            if (distance1 < distance0) {
+                std::swap(child0, child1);
+                std::swap(distance0, distance1);
+            }
+
+            if (distance0 != std::numeric_limits<float>::infinity()) {
+                if (distance1 != std::numeric_limits<float>::infinity()) {
+                    stack[stackSize] = child1;
+                    stackDistance[stackSize] = distance1;
+                    ++stackSize;
+                }
+
+                index = child0;
+                continue;
+            }
+        }
+
+        // Skip the nodes that are farther than the closest hit found since they were added
+        while (stackSize > 0 and stackDistance[stackSize - 1] > maxDistance) {
+            --stackSize;
+        }
+
+        if (stackSize == 0) {
+            break;
+        }
+
+        --stackSize;
+        index = stack[stackSize];
+    }
+
+    return isHit;
+}
+
+bool TriangleBVH::intersectPacket(const TrianglePacket& packet, const Ray& ray, float maxDistance, RayHit& hit)
+{
+    // Möller and Trumbore, "Fast, Minimum Storage Ray/Triangle Intersection", for four triangles
+    // at once. Each lane is calculated in the same order as the scalar version, so they give the
+    // same results
+    Array<float, 4> distanceList;
+    Array<float, 4> uList;
+    Array<float, 4> vList;
+
+    int hitMask = 0;
+
+    #if defined(RYME_SIMD_SSE2)
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        const __m128 ox = _mm_set1_ps(ray.Origin.x);
+        const __m128 oy = _mm_set1_ps(ray.Origin.y);
+        const __m128 oz = _mm_set1_ps(ray.Origin.z);
+
+        const __m128 dx = _mm_set1_ps(ray.Direction.x);
+        const __m128 dy = _mm_set1_ps(ray.Direction.y);
+        const __m128 dz = _mm_set1_ps(ray.Direction.z);
+
+        __m128 e1x = _mm_load_ps(packet.Edge1[0].data());
+        __m128 e1y = _mm_load_ps(packet.Edge1[1].data());
+        __m128 e1z = _mm_load_ps(packet.Edge1[2].data());
+
+        __m128 e2x = _mm_load_ps(packet.Edge2[0].data());
+        __m128 e2y = _mm_load_ps(packet.Edge2[1].data());
+        __m128 e2z = _mm_load_ps(packet.Edge2[2].data());
+
+        // p = direction x edge2
+        __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+        __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        __m128 inverseDet = _mm_div_ps(one, det);
+
+        // t = origin - vertex0
+        __m128 tx = _mm_sub_ps(ox, _mm_load_ps(packet.Vertex0[0].data()));
+        __m128 ty = _mm_sub_ps(oy, _mm_load_ps(packet.Vertex0[1].data()));
+        __m128 tz = _mm_sub_ps(oz, _mm_load_ps(packet.Vertex0[2].data()));
+
+        __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), inverseDet);
+
+        // q = t x edge1
+        __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+        __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+        __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+
+        __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inverseDet);
+        __m128 distance = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverseDet);
+
+        __m128 mask = _mm_cmpneq_ps(det, zero);
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(distance, zero));
+        mask = _mm_and_ps(mask, _mm_cmplt_ps(distance, _mm_set1_ps(maxDistance)));
+
+        hitMask = _mm_movemask_ps(mask);
+
+        if (hitMask == 0) {
+            return false;
+        }
+
+        _mm_storeu_ps(distanceList.data(), distance);
+        _mm_storeu_ps(uList.data(), u);
+        _mm_storeu_ps(vList.data(), v);
+
+    #elif defined(RYME_SIMD_NEON)
+
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+
+        const float32x4_t ox = vdupq_n_f32(ray.Origin.x);
+        const float32x4_t oy = vdupq_n_f32(ray.Origin.y);
+        const float32x4_t oz = vdupq_n_f32(ray.Origin.z);
+
+        const float32x4_t dx = vdupq_n_f32(ray.Direction.x);
+        const float32x4_t dy = vdupq_n_f32(ray.Direction.y);
+        const float32x4_t dz = vdupq_n_f32(ray.Direction.z);
+
+        float32x4_t e1x = vld1q_f32(packet.Edge1[0].data());
+        float32x4_t e1y = vld1q_f32(packet.Edge1[1].data());
+        float32x4_t e1z = vld1q_f32(packet.Edge1[2].data());
+
+        float32x4_t e2x = vld1q_f32(packet.Edge2[0].data());
+        float32x4_t e2y = vld1q_f32(packet.Edge2[1].data());
+        float32x4_t e2z = vld1q_f32(packet.Edge2[2].data());
+
+        // p = direction x edge2
+        float32x4_t px = vsubq_f32(vmulq_f32(dy, e2z), vmulq_f32(dz, e2y));
+        float32x4_t py = vsubq_f32(vmulq_f32(dz, e2x), vmulq_f32(dx, e2z));
+        float32x4_t pz = vsubq_f32(vmulq_f32(dx, e2y), vmulq_f32(dy, e2x));
+
+        float32x4_t det = vaddq_f32(vaddq_f32(vmulq_f32(e1x, px), vmulq_f32(e1y, py)), vmulq_f32(e1z, pz));
+        float32x4_t inverseDet = vdivq_f32(one, det);
+
+        // t = origin - vertex0
+        float32x4_t tx = vsubq_f32(ox, vld1q_f32(packet.Vertex0[0].data()));
+        float32x4_t ty = vsubq_f32(oy, vld1q_f32(packet.Vertex0[1].data()));
+        float32x4_t tz = vsubq_f32(oz, vld1q_f32(packet.Vertex0[2].data()));
+
+        float32x4_t u = vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(tx, px), vmulq_f32(ty, py)), vmulq_f32(tz, pz)), inverseDet);
+
+        // q = t x edge1
+        float32x4_t qx = vsubq_f32(vmulq_f32(ty, e1z), vmulq_f32(tz, e1y));
+        float32x4_t qy = vsubq_f32(vmulq_f32(tz, e1x), vmulq_f32(tx, e1z));
+        float32x4_t qz = vsubq_f32(vmulq_f32(tx, e1y), vmulq_f32(ty, e1x));
+
+        float32x4_t v = vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(dx, qx), vmulq_f32(dy, qy)), vmulq_f32(dz, qz)), inverseDet);
+        float32x4_t distance = vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(e2x, qx), vmulq_f32(e2y, qy)), vmulq_f32(e2z, qz)), inverseDet);
+
+        uint32x4_t mask = vmvnq_u32(vceqq_f32(det, zero));
+        mask = vandq_u32(mask, vcgeq_f32(u, zero));
+        mask = vandq_u32(mask, vcgeq_f32(v, zero));
+        mask = vandq_u32(mask, vcleq_f32(vaddq_f32(u, v), one));
+        mask = vandq_u32(mask, vcgeq_f32(distance, zero));
+        mask = vandq_u32(mask, vcltq_f32(distance, vdupq_n_f32(maxDistance)));
+
+        if (vmaxvq_u32(mask) == 0) {
+            return false;
+        }
+
+        Array<uint32_t, 4> maskList;
+        vst1q_u32(maskList.data(), mask);
+
+        for (unsigned lane = 0; lane < 4; ++lane) {
+            if (maskList[lane]) {
+                hitMask |= (1 << lane);
+            }
+        }
+
+        vst1q_f32(distanceList.data(), distance);
+        vst1q_f32(uList.data(), u);
+        vst1q_f32(vList.data(), v);
+
+    #else
+
+        for (unsigned lane = 0; lane < 4; ++lane) {
+            Vec3 edge1 = { packet.Edge1[0][lane], packet.Edge1[1][lane], packet.Edge1[2][lane] };
+            Vec3 edge2 = { packet.Edge2[0][lane], packet.Edge2[1][lane], packet.Edge2[2][lane] };
+            Vec3 vertex0 = { packet.Vertex0[0][lane], packet.Vertex0[1][lane], packet.Vertex0[2][lane] };
+
+            const Vec3& d = ray.Direction;
+
+            Vec3 p = {
+                d.y * edge2.z - d.z * edge2.y,
+                d.z * edge2.x - d.x * edge2.z,
+                d.x * edge2.y - d.y * edge2.x,
+            };
+
+            float det = edge1.x * p.x + edge1.y * p.y + edge1.z * p.z;
+            float inverseDet = 1.0f / det;
+
+            Vec3 t = ray.Origin - vertex0;
+
+            float u = (t.x * p.x + t.y * p.y + t.z * p.z) * inverseDet;
+
+            Vec3 q = {
+                t.y * edge1.z - t.z * edge1.y,
+                t.z * edge1.x - t.x * edge1.z,
+                t.x * edge1.y - t.y * edge1.x,
+            };
+
+            float v = (d.x * q.x + d.y * q.y + d.z * q.z) * inverseDet;
+            float distance = (edge2.x * q.x + edge2.y * q.y + edge2.z * q.z) * inverseDet;
+
+            if (det != 0.0f and u >= 0.0f and v >= 0.0f and u + v <= 1.0f and distance >= 0.0f and distance < maxDistance) {
+                hitMask |= (1 << lane);
+            }
+
+            distanceList[lane] = distance;
+            uList[lane] = u;
+            vList[lane] = v;
+        }
+
+        if (hitMask == 0) {
+            return false;
+        }
+
+    #endif
+
+    // The closest lane, or the first of those at the same distance
+    unsigned closest = 4;
+
+    for (unsigned lane = 0; lane < 4; ++lane) {
+        if ((hitMask & (1 << lane)) and (closest == 4 or distanceList[lane] < distanceList[closest])) {
+            closest = lane;
+        }
+    }
+
+    hit.Distance = distanceList[closest];
+    hit.Barycentric = Vec2(uList[closest], vList[closest]);
+    hit.Triangle = packet.TriangleList[closest];
+
+    return true;
+}
+
+RYME_API
+void TriangleBVH::ScriptInit(py::module m)
+{
+    py::class_<Ray>(m, "Ray")
+        .def(py::init())
+        .def(py::init(
+            [](const Vec3& origin, const Vec3& direction, float maxDistance) {
+                return Ray{ origin, direction, maxDistance };
+            }),
+            py::arg("origin"),
+            py::arg("direction"),
+            py::arg("maxDistance") = std::numeric_limits<float>::infinity())
+        .def_readwrite("Origin", &Ray::Origin)
+        .def_readwrite("Direction", &Ray::Direction)
+        .def_readwrite("MaxDistance", &Ray::MaxDistance)
+        .def("GetPoint", &Ray::GetPoint);
+
+    py::class_<RayHit>(m, "RayHit")
+        .def(py::init())
+        .def_readonly("Distance", &RayHit::Distance)
+        .def_readonly("Barycentric", &RayHit::Barycentric)
+        .def_readonly("Triangle", &RayHit::Triangle)
+        .def_readonly("Mesh", &RayHit::Mesh)
+        .def("IsHit", &RayHit::IsHit)
+        .def("GetEntityName",
+            [](const RayHit& hit) -> String {
+                if (not hit.Component or not hit.Component->GetEntity()) {
+                    return {};
+                }
+
+                return String(hit.Component->GetEntity()->GetName());
+            });
+
+    py::class_<TriangleBVH>(m, "TriangleBVH")
+        .def(py::init())
+        .def(py::init(
+            [](const List<Vec3>& positionList, const List<uint32_t>& indexList) {
+                return std::make_unique<TriangleBVH>(positionList, indexList);
+            }),
+            py::arg("positionList"),
+            py::arg("indexList"))
+        .def("Build",
+            [](TriangleBVH& bvh, const List<Vec3>& positionList, const List<uint32_t>& indexList) {
+                bvh.Build(positionList, indexList);
+            })
+        .def("Intersect",
+            [](const TriangleBVH& bvh, const Ray& ray) -> std::optional<RayHit> {
+                RayHit hit;
+                if (bvh.Intersect(ray, hit)) {
+                    return hit;
+                }
+
+                return std::nullopt;
+            })
+        .def("IntersectAny", &TriangleBVH::IntersectAny)
+        .def("IntersectList",
+            [](const TriangleBVH& bvh, const List<Ray>& rayList) {
+                List<RayHit> hitList(rayList.size());
+
+                // The rays don't touch any Python objects, so other Python threads can run meanwhile
+                py::gil_scoped_release release;
+                bvh.IntersectList(rayList, hitList, &GetThreadPool());
+
+                return hitList;
+            })
+        .def("GetTriangleCount", &TriangleBVH::GetTriangleCount)
+        .def("GetNodeCount", &TriangleBVH::GetNodeCount)
+        .def("GetBoundsMin", &TriangleBVH::GetBoundsMin)
+        .def("GetBoundsMax", &TriangleBVH::GetBoundsMax);
+}
+
+} // namespace ryme
\ No newline at end of file
@@ -0,0 +1,487 @@
+#include <Ryme/VFS.hpp>
+#include <Ryme/Archive.hpp>
+#include <Ryme/Exception.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Map.hpp>
+#include <Ryme/Profiler.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <utility>
+
+namespace ryme {
+
+namespace VFS {
+
+RYME_API
+File::File(MappedFile&& mappedFile, const Path& path)
+    : _isOpen(mappedFile.IsOpen())
+    , _data(mappedFile.GetData())
+    , _size(mappedFile.GetSize())
+    , _path(path)
+    , _mappedFile(std::move(mappedFile))
+{ }
+
+RYME_API
+File::File(std::shared_ptr<const void> owner, Span<const uint8_t> data, const Path& path)
+    : _isOpen(true)
+    , _data(data.data())
+    , _size(data.size())
+    , _path(path)
+    , _owner(std::move(owner))
+{ }
+
+RYME_API
+File::File(List<uint8_t>&& data, const Path& path)
+    : _isOpen(true)
+    , _path(path)
+    , _buffer(std::move(data))
+{
+    _data = _buffer.data();
+    _size = _buffer.size();
+}
+
+RYME_API
+File::File(File&& rhs)
+{
+    *this = std::move(rhs);
+}
+
+RYME_API
+File& File::operator=(File&& rhs)
+{
+    if (this != &rhs) {
+        // Moving the mapping or buffer leaves the data where it is
+        _isOpen = std::exchange(rhs._isOpen, false);
+        _data = std::exchange(rhs._data, nullptr);
+        _size = std::exchange(rhs._size, 0);
+        _path = rhs._path;
+        _mappedFile = std::move(rhs._mappedFile);
+        _owner = std::move(rhs._owner);
+        _buffer = std::move(rhs._buffer);
+    }
+
+    return *this;
+}
+
+std::filesystem::path getFilesystemPath(const Path& path)
+{
+    const String& str = path.ToString();
+    return std::filesystem::path(std::u8string(reinterpret_cast<const char8_t *>(str.data()), str.size()));
+}
+
+Path getAbsolutePath(const Path& path)
+{
+    return (path.IsRelative() ? GetCurrentPath() / path : path);
+}
+
+class DirectoryMount : public Mount
+{
+public:
+
+    DirectoryMount(const Path& path)
+        : _path(getAbsolutePath(path))
+    { }
+
+    const Path& GetPath() const override {
+        return _path;
+    }
+
+    void Scan(const std::function<void(const Path&)>& func) override {
+        std::error_code error;
+
+        std::filesystem::path root = getFilesystemPath(_path);
+        std::filesystem::recursive_directory_iterator it(root, error), end;
+
+        for (; not error and it != end; it.increment(error)) {
+            if (not it->is_regular_file(error)) {
+                continue;
+            }
+
+            auto relativePath = it->path().lexically_relative(root).u8string();
+            func(Path(StringView(reinterpret_cast<const char *>(relativePath.data()), relativePath.size())));
+        }
+
+        if (error) {
+            Log(RYME_ANCHOR, "Failed to scan '{}': {}", _path, error.message());
+        }
+    }
+
+    File Open(const Path& relativePath) override {
+        Path fullPath = _path / relativePath;
+        return File(MappedFile(fullPath), fullPath);
+    }
+
+private:
+
+    Path _path;
+
+}; // class DirectoryMount
+
+class ArchiveMount : public Mount
+{
+public:
+
+    ArchiveMount(Archive&& archive)
+        : _path(getAbsolutePath(archive.GetPath()))
+        , _archive(std::move(archive))
+    { }
+
+    const Path& GetPath() const override {
+        return _path;
+    }
+
+    void Scan(const std::function<void(const Path&)>& func) override {
+        for (const auto& entry : _archive.GetEntryList()) {
+            func(Path(_archive.GetName(entry)));
+        }
+    }
+
+    File Open(const Path& relativePath) override {
+        // Names in the archive always use / separators
+        String name = relativePath.ToString();
+        for (auto& c : name) {
+            if (c == Path::Separator) {
+                c = '/';
+            }
+        }
+
+        const ArchiveEntry * entry = _archive.Find(name);
+        if (not entry) {
+            return {};
+        }
+
+        return _archive.Read(*entry);
+    }
+
+private:
+
+    Path _path;
+
+    Archive _archive;
+
+}; // class ArchiveMount
+
+struct MountEntry
+{
+    std::shared_ptr<Mount> Ref;
+
+    // The files found by the last scan, so the index can be rebuilt without scanning again
+    List<String> FileList;
+
+}; // struct MountEntry
+
+std::mutex _vfsMutex;
+
+bool _isInitialized = false;
+
+List<MountEntry> _mountList;
+
+// The relative path of every file, to the index of the mount it is in
+Map<String, size_t> _fileIndex;
+
+// Remove "." components and resolve ".." components, without looking at the filesystem
+String getIndexKey(StringView path)
+{
+    List<StringView> componentList;
+
+    while (not path.empty()) {
+        size_t pivot = path.find(Path::Separator);
+        StringView component = path.substr(0, pivot);
+        path = (pivot == StringView::npos ? StringView() : path.substr(pivot + 1));
+
+        if (component.empty() or component == ".") {
+            continue;
+        }
+
+        if (component == ".." and not componentList.empty() and componentList.back() != "..") {
+            componentList.pop_back();
+        }
+        else {
+            componentList.push_back(component);
+        }
+    }
+
+    String key;
+
+    for (const auto& component : componentList) {
+        if (not key.empty()) {
+            key += Path::Separator;
+        }
+
+        key += component;
+    }
+
+    return key;
+}
+
+void scanMount(MountEntry& entry)
+{
+    RYME_PROFILE_FUNCTION();
+
+    entry.FileList.clear();
+
+    entry.Ref->Scan([&](const Path& relativePath) {
+        entry.FileList.push_back(getIndexKey(relativePath.ToString()));
+    });
+
+    Log(RYME_ANCHOR, "Found {} files in '{}'", entry.FileList.size(), entry.Ref->GetPath());
+}
+
+void addToIndex(size_t mountIndex)
+{
+    for (const auto& key : _mountList[mountIndex].FileList) {
+        _fileIndex[key] = mountIndex;
+    }
+}
+
+void rebuildIndex()
+{
+    _fileIndex.clear();
+
+    for (size_t i = 0; i < _mountList.size(); ++i) {
+        addToIndex(i);
+    }
+}
+
+void addMount(std::shared_ptr<Mount> mount)
+{
+    _mountList.push_back(MountEntry{ .Ref = std::move(mount), .FileList = {} });
+
+    scanMount(_mountList.back());
+    addToIndex(_mountList.size() - 1);
+}
+
+// An invalid archive is logged and skipped, rather than thrown, so the rest of the assets can still be found
+std::shared_ptr<Mount> openArchive(const Path& path)
+{
+    Archive archive;
+
+    try {
+        if (not archive.Open(path)) {
+            return nullptr;
+        }
+    }
+    catch (const std::exception& e) {
+        Log(RYME_ANCHOR, "Failed to mount '{}': {}", path, e.what());
+        return nullptr;
+    }
+
+    return std::make_shared<ArchiveMount>(std::move(archive));
+}
+
+// Mount the asset paths the first time the VFS is used, in reverse so that the first asset path
+// takes priority, the same as searching them in order
+void initialize()
+{
+    if (_isInitialized) {
+        return;
+    }
+
+    _isInitialized = true;
+
+    const auto& assetPathList = GetAssetPathList();
+
+    for (auto it = assetPathList.rbegin(); it != assetPathList.rend(); ++it) {
+        std::error_code error;
+        auto status = std::filesystem::status(getFilesystemPath(*it), error);
+
+        if (std::filesystem::is_directory(status)) {
+            addMount(std::make_shared<DirectoryMount>(*it));
+        }
+        else if (std::filesystem::is_regular_file(status)) {
+            auto mount = openArchive(*it);
+            if (mount) {
+                addMount(std::move(mount));
+            }
+        }
+    }
+}
+
+RYME_API
+bool MountDirectory(const Path& path)
+{
+    std::error_code error;
+    if (not std::filesystem::is_directory(getFilesystemPath(path), error)) {
+        return false;
+    }
+
+    AddMount(std::make_shared<DirectoryMount>(path));
+    return true;
+}
+
+RYME_API
+bool MountArchive(const Path& path)
+{
+    auto mount = openArchive(path);
+    if (not mount) {
+        return false;
+    }
+
+    AddMount(std::move(mount));
+    return true;
+}
+
+RYME_API
+void AddMount(std::shared_ptr<Mount> mount)
+{
+    std::lock_guard<std::mutex> lock(_vfsMutex);
+
+    initialize();
+
+    addMount(std::move(mount));
+}
+
+RYME_API
+bool Unmount(const Path& path)
+{
+    std::lock_guard<std::mutex> lock(_vfsMutex);
+
+    initialize();
+
+    auto it = std::find_if(_mountList.begin(), _mountList.end(), [&](const auto& entry) {
+        return (entry.Ref->GetPath() == getAbsolutePath(path));
+    });
+
+    if (it == _mountList.end()) {
+        return false;
+    }
+
+    _mountList.erase(it);
+    rebuildIndex();
+
+    return true;
+}
+
+RYME_API
+void Rescan()
+{
+    std::lock_guard<std::mutex> lock(_vfsMutex);
+
+    initialize();
+
+    for (auto& entry : _mountList) {
+        scanMount(entry);
+    }
+
+    rebuildIndex();
+}
+
+RYME_API
+File Open(const Path& path, bool search /*= true*/)
+{
+    std::shared_ptr<Mount> mount;
+    String key;
+
+    if (search) {
+        key = getIndexKey(path.ToString());
+
+        std::lock_guard<std::mutex> lock(_vfsMutex);
+
+        initialize();
+
+        auto it = _fileIndex.find(key);
+        if (it == _fileIndex.end()) {
+            return {};
+        }
+
+        mount = _mountList[it->second].Ref;
+    }
+    else {
+        MappedFile mappedFile;
+        if (mappedFile.Open(path)) {
+            return File(std::move(mappedFile), path);
+        }
+
+        // Files in archives can't be opened directly, but their full paths start with the archive
+        const String& fullPath = getAbsolutePath(path).ToString();
+
+        std::lock_guard<std::mutex> lock(_vfsMutex);
+
+        for (const auto& entry : _mountList) {
+            const String& mountPath = entry.Ref->GetPath().ToString();
+
+            if (fullPath.size() > mountPath.size()
+                and fullPath.compare(0, mountPath.size(), mountPath) == 0
+                and fullPath[mountPath.size()] == Path::Separator) {
+                mount = entry.Ref;
+                key = getIndexKey(StringView(fullPath).substr(mountPath.size() + 1));
+            }
+        }
+
+        if (not mount) {
+            return {};
+        }
+    }
+
+    // Opened without holding the lock, the mount is kept alive even if it is unmounted meanwhile
+    return mount->Open(key);
+}
+
+RYME_API
+Path Resolve(const Path& path)
+{
+    String key = getIndexKey(path.ToString());
+
+    std::lock_guard<std::mutex> lock(_vfsMutex);
+
+    initialize();
+
+    auto it = _fileIndex.find(key);
+    if (it == _fileIndex.end()) {
+        return Path();
+    }
+
+    return _mountList[it->second].Ref->GetPath() / key;
+}
+
+RYME_API
+bool Exists(const Path& path)
+{
+    String key = getIndexKey(path.ToString());
+
+    std::lock_guard<std::mutex> lock(_vfsMutex);
+
+    initialize();
+
+    return _fileIndex.contains(key);
+}
+
+RYME_API
+Path GetCookedPath(const Path& path, StringView extension)
+{
+    String key = getIndexKey(path.ToString());
+    String cookedKey = fmt::format("{}.{}", key, extension);
+
+    std::lock_guard<std::mutex> lock(_vfsMutex);
+
+    initialize();
+
+    auto cookedIt = _fileIndex.find(cookedKey);
+    if (cookedIt == _fileIndex.end()) {
+        return path;
+    }
+
+    // Mounts added later take priority
+    auto it = _fileIndex.find(key);
+    if (it != _fileIndex.end() and it->second > cookedIt->second) {
+        return path;
+    }
+
+    return Path(cookedKey);
+}
+
+RYME_API
+size_t GetFileCount()
+{
+    std::lock_guard<std::mutex> lock(_vfsMutex);
+
+    initialize();
+
+    return _fileIndex.size();
+}
+
+} // namespace VFS
+
+} // namespace ryme
\ No newline at end of file
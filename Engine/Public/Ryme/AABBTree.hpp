@@ -0,0 +1,245 @@
+#ifndef RYME_AABB_TREE_HPP
+#define RYME_AABB_TREE_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Frustum.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Math.hpp>
+#include <Ryme/NonCopyable.hpp>
+
+namespace ryme {
+
+///
+/// A bounding volume hierarchy of axis aligned boxes, which objects can be added to, removed from and
+/// moved around in without building it again
+///
+/// Every object is a proxy, the index of a leaf that stays the same for as long as the object is in
+/// the tree. Leaves are stored with a margin around their bounds, so small movements don't change the
+/// tree at all. Larger ones only grow the boxes of the nodes above the leaf, which Update() refits in
+/// one pass. As objects move away from where they were inserted the boxes overlap more, and once
+/// the cost of the tree has grown too much Update() builds it again with the surface area heuristic.
+///
+class RYME_API AABBTree : public NonCopyable
+{
+public:
+
+    static inline const uint32_t NullNode = UINT32_MAX;
+
+    struct RayHit
+    {
+        uint32_t Proxy;
+
+        // Along the ray, to where it enters the bounds of the proxy
+        float Distance;
+
+    }; // struct RayHit
+
+    struct Stats
+    {
+        size_t ProxyCount = 0;
+
+        size_t NodeCount = 0;
+
+        uint32_t Height = 0;
+
+        // The surface area of every internal node, relative to the root
+        float Cost = 0.0f;
+
+        // Proxies whose movement went outside of their margin
+        size_t MovedCount = 0;
+
+        size_t RebuildCount = 0;
+
+    }; // struct Stats
+
+    AABBTree() = default;
+
+    virtual ~AABBTree() = default;
+
+    ///
+    /// @param userData Returned by GetUserData() for the proxy
+    /// @return The proxy, to move or remove it later
+    ///
+    uint32_t Insert(const Vec3& min, const Vec3& max, void * userData);
+
+    void Remove(uint32_t proxy);
+
+    ///
+    /// Set new bounds for a proxy, the tree is not valid for queries until Update() is called
+    ///
+    /// @return True if the bounds went outside of the margin, and the tree needs to be refit
+    ///
+    bool Move(uint32_t proxy, const Vec3& min, const Vec3& max);
+
+    ///
+    /// Refit the nodes above every proxy that moved since the last call, then rebuild the tree if
+    /// its cost has grown past the rebuild threshold
+    ///
+    void Update();
+
+    ///
+    /// Build the whole tree again with the surface area heuristic, the proxies stay the same
+    ///
+    void Rebuild();
+
+    void Clear();
+
+    ///
+    /// Append the proxies whose bounds are inside of or intersect the frustum
+    ///
+    void QueryFrustum(const Frustum& frustum, List<uint32_t>& proxyList) const;
+
+    void QueryBox(const Vec3& min, const Vec3& max, List<uint32_t>& proxyList) const;
+
+    void QuerySphere(const Vec3& center, float radius, List<uint32_t>& proxyList) const;
+
+    ///
+    /// Append the proxies whose bounds are hit by a ray, in no particular order
+    ///
+    /// @param direction Does not need to be normalized, distances are in multiples of it
+    /// @param maxDistance How far along the ray to look
+    ///
+    void QueryRay(const Vec3& origin, const Vec3& direction, float maxDistance, List<RayHit>& hitList) const;
+
+    inline void * GetUserData(uint32_t proxy) const {
+        return _nodeList[proxy].UserData;
+    }
+
+    ///
+    /// @return The bounds the proxy was given, without the margin
+    ///
+    inline Vec3 GetBoundsMin(uint32_t proxy) const {
+        return _leafBoundsList[proxy].Min;
+    }
+
+    inline Vec3 GetBoundsMax(uint32_t proxy) const {
+        return _leafBoundsList[proxy].Max;
+    }
+
+    ///
+    /// The distance to grow the bounds of proxies by, applied the next time they are inserted or move
+    ///
+    inline void SetMargin(float margin) {
+        _margin = margin;
+    }
+
+    inline float GetMargin() const {
+        return _margin;
+    }
+
+    ///
+    /// Rebuild in Update() once the cost is this many times what it was after the last rebuild, or
+    /// never if it is 0
+    ///
+    inline void SetRebuildThreshold(float threshold) {
+        _rebuildThreshold = threshold;
+    }
+
+    inline float GetRebuildThreshold() const {
+        return _rebuildThreshold;
+    }
+
+    ///
+    /// @return The tree as of the last call to Update() or Rebuild()
+    ///
+    inline const Stats& GetStats() const {
+        return _stats;
+    }
+
+private:
+
+    struct Node
+    {
+        Vec3 Min;
+
+        uint32_t Parent = NullNode;
+
+        Vec3 Max;
+
+        // 0 for leaves, and NullNode for nodes that are not in use
+        uint32_t Height = 0;
+
+        // NullNode for leaves, the next free node is stored in Parent for nodes that are not in use
+        uint32_t ChildList[2] = { NullNode, NullNode };
+
+        void * UserData = nullptr;
+
+        // The bounds of a child have grown since this was last fit around them
+        bool IsDirty = false;
+
+        inline bool IsLeaf() const {
+            return (ChildList[0] == NullNode);
+        }
+
+    }; // struct Node
+
+    struct Bounds
+    {
+        Vec3 Min;
+
+        Vec3 Max;
+
+    }; // struct Bounds
+
+    // A leaf being sorted by Rebuild(), kept apart from the nodes so the sorting stays in cache
+    struct BuildEntry
+    {
+        Vec3 Min;
+
+        uint32_t Leaf;
+
+        Vec3 Max;
+
+    }; // struct BuildEntry
+
+    uint32_t allocateNode();
+
+    void freeNode(uint32_t index);
+
+    void insertLeaf(uint32_t leaf);
+
+    void removeLeaf(uint32_t leaf);
+
+    void fitNode(uint32_t index);
+
+    void refitDirty();
+
+    uint32_t buildNode(BuildEntry * entryList, size_t entryCount, uint32_t parent);
+
+    uint32_t buildSplit(BuildEntry * entryList, size_t entryCount, size_t splitCount, uint32_t parent);
+
+    void updateStats();
+
+    template <class Overlaps, class Contains, class Visit>
+    void query(Overlaps overlaps, Contains contains, Visit visit) const;
+
+    List<Node> _nodeList;
+
+    // The bounds of each leaf without the margin, indexed like _nodeList
+    List<Bounds> _leafBoundsList;
+
+    uint32_t _root = NullNode;
+
+    uint32_t _freeNode = NullNode;
+
+    float _margin = 0.1f;
+
+    float _rebuildThreshold = 1.5f;
+
+    // The sum of the surface areas of the internal nodes, kept up to date as they are fit so the cost
+    // doesn't need to walk the tree
+    double _internalArea = 0.0;
+
+    float _rebuiltCost = 0.0f;
+
+    bool _isDirty = false;
+
+    size_t _movedCount = 0;
+
+    Stats _stats;
+
+}; // class AABBTree
+
+} // namespace ryme
+
+#endif // RYME_AABB_TREE_HPP
\ No newline at end of file
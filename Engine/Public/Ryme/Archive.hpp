@@ -0,0 +1,229 @@
+#ifndef RYME_ARCHIVE_HPP
+#define RYME_ARCHIVE_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/MappedFile.hpp>
+#include <Ryme/NonCopyable.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/Set.hpp>
+#include <Ryme/Span.hpp>
+#include <Ryme/String.hpp>
+#include <Ryme/VFS.hpp>
+
+#include <cstdint>
+#include <memory>
+
+namespace ryme {
+
+enum class ArchiveCompression : uint32_t
+{
+    None = 0,
+
+    // CompressLZ()
+    LZ = 1,
+
+}; // enum class ArchiveCompression
+
+///
+/// The start of an archive, followed by the data of every entry, then the table of contents, then
+/// the names of the entries
+///
+struct ArchiveHeader
+{
+    uint32_t Magic;
+
+    uint32_t Version;
+
+    uint32_t EntryCount;
+
+    uint32_t Alignment;
+
+    uint64_t EntryListOffset;
+
+    uint64_t NameListOffset;
+
+    uint64_t NameListSize;
+
+}; // struct ArchiveHeader
+
+static_assert(sizeof(ArchiveHeader) == 40);
+
+///
+/// An entry in the table of contents, which is sorted by PathHash
+///
+struct ArchiveEntry
+{
+    // Hash64() of the name
+    uint64_t PathHash;
+
+    // Hash64() of the data once decompressed
+    uint64_t ContentHash;
+
+    // From the start of the archive, aligned to ArchiveHeader::Alignment
+    uint64_t Offset;
+
+    uint64_t StoredSize;
+
+    uint64_t Size;
+
+    uint32_t NameOffset;
+
+    uint32_t NameSize;
+
+    ArchiveCompression Compression;
+
+    uint32_t Reserved;
+
+}; // struct ArchiveEntry
+
+static_assert(sizeof(ArchiveEntry) == 56);
+
+///
+/// A single file packing many assets, which is mapped into memory as a whole
+///
+/// Entries are found by the hash of their name, relative to the archive with / separators.
+/// Uncompressed entries are read directly from the mapping without being copied.
+///
+class RYME_API Archive : public NonCopyable
+{
+public:
+
+    static inline const uint32_t Magic = 0x4B415052; // RPAK
+
+    static inline const uint32_t Version = 1;
+
+    static inline const uint32_t DefaultAlignment = 16;
+
+    static inline const char * const Extension = "rpak";
+
+    Archive() = default;
+
+    Archive(const Path& path);
+
+    Archive(Archive&&) = default;
+
+    virtual ~Archive() = default;
+
+    Archive& operator=(Archive&&) = default;
+
+    ///
+    /// @return False if the file could not be opened, throws if it is not a valid archive
+    ///
+    bool Open(const Path& path);
+
+    void Close();
+
+    inline bool IsOpen() const {
+        return (_file != nullptr);
+    }
+
+    inline const Path& GetPath() const {
+        return _path;
+    }
+
+    inline Span<const ArchiveEntry> GetEntryList() const {
+        return _entryList;
+    }
+
+    StringView GetName(const ArchiveEntry& entry) const;
+
+    ///
+    /// @param name Relative to the archive, with / separators
+    /// @return The entry, or nullptr if there is none with that name
+    ///
+    const ArchiveEntry * Find(StringView name) const;
+
+    ///
+    /// Read an entry, decompressing it if needed, throws if the compressed data is corrupt
+    ///
+    VFS::File Read(const ArchiveEntry& entry) const;
+
+private:
+
+    Path _path;
+
+    std::shared_ptr<MappedFile> _file;
+
+    Span<const ArchiveEntry> _entryList;
+
+    StringView _nameList;
+
+}; // class Archive
+
+///
+/// Build an archive from files on disk or data in memory, which is written out all at once
+///
+class RYME_API ArchiveWriter : public NonCopyable
+{
+public:
+
+    ///
+    /// @param alignment The offset of every entry is a multiple of this, a power of two of at least 16
+    ///
+    ArchiveWriter(uint32_t alignment = Archive::DefaultAlignment);
+
+    virtual ~ArchiveWriter() = default;
+
+    ///
+    /// Add a file, which is not read until Write()
+    ///
+    /// @param name Relative to the archive, with / separators
+    /// @param compress Compress the entry, if that makes it smaller
+    /// @return False if there is already an entry with the same name
+    ///
+    bool AddFile(StringView name, const Path& path, bool compress = false);
+
+    bool AddData(StringView name, List<uint8_t>&& data, bool compress = false);
+
+    inline size_t GetEntryCount() const {
+        return _pendingList.size();
+    }
+
+    ///
+    /// Write the archive to a temporary file, which replaces path once it is complete
+    ///
+    /// @return False if a file could not be read or written
+    ///
+    bool Write(const Path& path);
+
+    ///
+    /// @return The total size of the entries, and their size once stored, after the last Write()
+    ///
+    inline uint64_t GetSize() const {
+        return _size;
+    }
+
+    inline uint64_t GetStoredSize() const {
+        return _storedSize;
+    }
+
+private:
+
+    struct PendingEntry
+    {
+        String Name;
+
+        Path SourcePath;
+
+        List<uint8_t> Data;
+
+        bool Compress;
+
+    }; // struct PendingEntry
+
+    uint32_t _alignment;
+
+    List<PendingEntry> _pendingList;
+
+    Set<String> _nameSet;
+
+    uint64_t _size = 0;
+
+    uint64_t _storedSize = 0;
+
+}; // class ArchiveWriter
+
+} // namespace ryme
+
+#endif // RYME_ARCHIVE_HPP
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <Ryme/Config.hpp>
 #include <Ryme/NonCopyable.hpp>
 
+#include <cstddef>
+
 namespace ryme {
 
 class RYME_API Asset : public NonCopyable
@@ -27,6 +29,14 @@ public:
         return false;
     }
 
+    ///
+    /// @return The number of bytes of device memory used by the asset, for AssetManager's memory budget
+    ///
+    virtual size_t GetMemorySize() const
+    {
+        return 0;
+    }
+
     explicit operator bool() const
     {
       return _isLoaded;
@@ -39,8 +49,6 @@ public:
 
 protected:
 
-    unsigned _references = 0;
-
     bool _isLoaded = false;
 
 }; // class Asset
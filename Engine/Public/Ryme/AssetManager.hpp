@@ -0,0 +1,147 @@
+#ifndef RYME_ASSET_MANAGER_HPP
+#define RYME_ASSET_MANAGER_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Asset.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Model.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/Shader.hpp>
+#include <Ryme/String.hpp>
+#include <Ryme/Texture.hpp>
+#include <Ryme/Types.hpp>
+
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace ryme {
+
+///
+/// Shared Assets
+///
+/// Every request for the same type of asset with the same canonical key shares one asset, so a path
+/// referenced by thousands of prefabs is only loaded once. The manager keeps a reference of its own,
+/// and an asset with no other references is unused.
+///
+/// Without a memory budget, unused assets are unloaded by the next Update(). With one, they stay
+/// loaded so they can be requested again for free, and the least recently used are evicted once the
+/// assets together use more than the budget.
+///
+namespace AssetManager {
+
+using LoadFunc = std::function<std::shared_ptr<Asset>()>;
+
+struct Stats
+{
+    size_t AssetCount;
+
+    // The number of assets with no references other than the manager's
+    size_t UnusedCount;
+
+    // The sum of Asset::GetMemorySize() of every asset
+    size_t MemoryUsage;
+
+    // The number of requests that were given an asset that was already loaded
+    size_t HitCount;
+
+    // The number of requests that had to load a new asset
+    size_t MissCount;
+
+    // The number of unused assets that have been unloaded
+    size_t EvictedCount;
+
+}; // struct Stats
+
+///
+/// Resolve a path the same way the loaders do, finding it in the VFS first if requested
+///
+/// @return An absolute path, equal for every path that refers to the same file
+///
+RYME_API
+Path GetCanonicalPath(const Path& path, bool search = true);
+
+///
+/// @param type The type of asset, keys only have to be unique for each type
+/// @param loadFunc Called to load the asset if there is none with the same key, may request other assets
+///
+RYME_API
+std::shared_ptr<Asset> GetOrLoad(TypeIndex type, const String& key, LoadFunc loadFunc);
+
+template <class T, class Func>
+inline std::shared_ptr<T> GetOrLoad(const String& key, Func&& loadFunc)
+{
+    static_assert(std::is_base_of_v<Asset, T>);
+
+    return std::static_pointer_cast<T>(GetOrLoad(typeid(T), key, [&]() -> std::shared_ptr<Asset> {
+        return loadFunc();
+    }));
+}
+
+///
+/// When searching, a cooked .rmesh of path is loaded instead if there is one, see VFS::GetCookedPath()
+///
+/// @return A model shared with every other request for the same file, check IsLoaded() to know
+///   whether loading succeeded
+///
+RYME_API
+std::shared_ptr<Model> LoadModel(const Path& path, bool search = true);
+
+///
+/// Start loading a texture with TextureLoader, if it isn't already loaded or loading
+///
+/// When searching, a cooked .ktx2 of path is loaded instead if there is one, see VFS::GetCookedPath()
+///
+/// @return A texture shared with every other request for the same file and sampler state, requests
+///   with a pNext chain on samplerCreateInfo can't be compared and get a texture of their own
+///
+RYME_API
+std::shared_ptr<Texture> LoadTexture(const Path& path, vk::SamplerCreateInfo samplerCreateInfo = {}, bool search = true);
+
+///
+/// @return A shader shared with every other request for the same files in the same order
+///
+RYME_API
+std::shared_ptr<Shader> LoadShader(const List<Path>& pathList, bool search = true);
+
+///
+/// Unload unused assets, or evict them until the memory budget is met
+///
+/// Called once a frame by ryme::Run()
+///
+RYME_API
+void Update();
+
+///
+/// Unload every unused asset, regardless of the memory budget
+///
+RYME_API
+void UnloadUnused();
+
+///
+/// Release every asset, any still referenced elsewhere are freed by the last reference
+///
+/// Called by ryme::Term(), before the device is destroyed
+///
+RYME_API
+void Term();
+
+///
+/// @param bytes 0 to unload assets as soon as they are unused
+///
+RYME_API
+void SetMemoryBudget(size_t bytes);
+
+RYME_API
+size_t GetMemoryBudget();
+
+RYME_API
+Stats GetStats();
+
+} // namespace AssetManager
+
+} // namespace ryme
+
+#endif // RYME_ASSET_MANAGER_HPP
\ No newline at end of file
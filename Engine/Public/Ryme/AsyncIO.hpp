@@ -0,0 +1,120 @@
+#ifndef RYME_ASYNC_IO_HPP
+#define RYME_ASYNC_IO_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/Span.hpp>
+
+#include <cstdint>
+#include <functional>
+
+namespace ryme {
+
+///
+/// Asynchronous File I/O
+///
+/// Reads are queued and run together in the background, so many files are in flight at once
+/// instead of one blocking read at a time. On Linux they are submitted in batches through io_uring,
+/// elsewhere, or if the kernel doesn't support it, they run on a small pool of threads of their own.
+///
+namespace AsyncIO {
+
+enum class Backend
+{
+    None,
+
+    IOURing,
+
+    ThreadPool,
+
+}; // enum class Backend
+
+struct ReadRequest
+{
+    // A file on disk, files in an Archive are already mapped and should be opened with VFS::Open()
+    ryme::Path Path;
+
+    uint64_t Offset = 0;
+
+    // 0 to read from Offset to the end of the file
+    uint64_t Size = 0;
+
+    // Read into this instead of a new buffer, such as the mapped memory of a staging buffer, which
+    // must stay valid until the read completes, Size can't be 0 when this is set
+    uint8_t * Destination = nullptr;
+
+}; // struct ReadRequest
+
+struct ReadResult
+{
+    ryme::Path Path;
+
+    // The index of the request in the list passed to Read()
+    size_t Index = 0;
+
+    // 0 if every byte was read, otherwise the errno of the failure
+    int Error = 0;
+
+    // The bytes read, in ReadRequest::Destination if there was one, otherwise in Buffer
+    Span<const uint8_t> Data;
+
+    List<uint8_t> Buffer;
+
+}; // struct ReadResult
+
+///
+/// Called on an I/O thread once a read has finished, successfully or not, anything slow such as
+/// decoding should be submitted to the ThreadPool to keep other reads moving
+///
+using CompleteFunc = std::function<void(ReadResult&& result)>;
+
+///
+/// Start the I/O thread, or threads
+///
+/// Called by the first read if it hasn't been already
+///
+/// @param useIOURing False to use the thread pool even if io_uring is supported
+///
+RYME_API
+void Init(bool useIOURing = true);
+
+///
+/// Finish every read that has been requested, and stop the I/O thread, or threads
+///
+/// Called by ryme::Term()
+///
+RYME_API
+void Term();
+
+RYME_API
+Backend GetBackend();
+
+RYME_API
+void Read(ReadRequest request, CompleteFunc completeFunc);
+
+///
+/// Queue every request together, so they are submitted with as few system calls as possible
+///
+/// @param completeFunc Called once for each request, in the order they finish
+///
+RYME_API
+void Read(List<ReadRequest> requestList, CompleteFunc completeFunc);
+
+///
+/// Block until every read that has been requested has completed
+///
+RYME_API
+void Wait();
+
+///
+/// @return The number of reads that have been requested but not completed
+///
+RYME_API
+size_t GetPendingCount();
+
+} // namespace AsyncIO
+
+} // namespace ryme
+
+#endif // RYME_ASYNC_IO_HPP
\ No newline at end of file
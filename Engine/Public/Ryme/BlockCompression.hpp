@@ -0,0 +1,65 @@
+#ifndef RYME_BLOCK_COMPRESSION_HPP
+#define RYME_BLOCK_COMPRESSION_HPP
+
+#include <Ryme/Config.hpp>
+
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+#include <cstdint>
+
+namespace ryme {
+
+///
+/// @return Whether the format is one of the BC formats that can be encoded and decoded,
+/// BC1, BC3, BC4, BC5 and BC7 in their UNORM and sRGB variants
+///
+RYME_API
+bool IsBlockCompressedFormat(vk::Format format);
+
+///
+/// @return The size of a 4x4 block in bytes, 8 for BC1 and BC4, 16 for the rest, or 0 if the
+/// format is not block compressed
+///
+RYME_API
+uint32_t GetBlockSize(vk::Format format);
+
+///
+/// @return The size of a width by height image in the given format, in bytes, rounded up to whole
+/// blocks for compressed formats
+///
+RYME_API
+size_t GetImageSize(vk::Format format, uint32_t width, uint32_t height);
+
+///
+/// @return The RGBA8 format that a block compressed format decompresses to, preserving sRGB
+///
+RYME_API
+vk::Format GetDecompressedFormat(vk::Format format);
+
+///
+/// Decompress an image into RGBA8
+///
+/// BC4 and BC5 only have one and two channels, the rest are filled with 0 and alpha with 255.
+///
+/// @param src The compressed blocks, GetImageSize(format, width, height) bytes
+/// @param dst The destination image, width * height * 4 bytes
+///
+RYME_API
+void DecompressImage(vk::Format format, const uint8_t * src, uint32_t width, uint32_t height, uint8_t * dst);
+
+///
+/// Compress an RGBA8 image
+///
+/// This is a fast encoder meant for offline use, it fits each block to the bounding box of its
+/// colors, and only uses mode 6 for BC7. Edges of images that are not a multiple of 4 are padded
+/// by clamping.
+///
+/// @param src The source image, width * height * 4 bytes
+/// @param dst The compressed blocks, GetImageSize(format, width, height) bytes
+///
+RYME_API
+void CompressImage(vk::Format format, const uint8_t * src, uint32_t width, uint32_t height, uint8_t * dst);
+
+} // namespace ryme
+
+#endif // RYME_BLOCK_COMPRESSION_HPP
\ No newline at end of file
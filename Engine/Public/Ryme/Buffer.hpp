@@ -14,7 +14,7 @@ public:
 
     Buffer() = default;
     
-    Buffer(Buffer&&) = default;
+    Buffer(Buffer&& rhs);
 
     virtual ~Buffer();
 
@@ -48,7 +48,11 @@ public:
 
 private:
 
-    vk::DeviceSize _size;
+    vk::BufferCreateInfo getBufferCreateInfo() const;
+
+    void registerMovable();
+
+    vk::DeviceSize _size = 0;
 
     vk::BufferUsageFlags _bufferUsage;
 
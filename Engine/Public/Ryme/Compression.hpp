@@ -0,0 +1,38 @@
+#ifndef RYME_COMPRESSION_HPP
+#define RYME_COMPRESSION_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Span.hpp>
+
+#include <cstdint>
+
+namespace ryme {
+
+///
+/// @return The largest size CompressLZ() can produce for size bytes of data
+///
+RYME_API
+size_t GetMaxCompressedSizeLZ(size_t size);
+
+///
+/// Compress data with a fast LZ77 codec, using the LZ4 block format
+///
+/// This favors decompression speed over ratio, for data that is read rarely enough that it is not
+/// worth storing uncompressed, but still needs to load quickly.
+///
+/// @return The compressed data, which does not record the original size
+///
+RYME_API
+List<uint8_t> CompressLZ(Span<const uint8_t> data);
+
+///
+/// @param dst Exactly as large as the data that was compressed
+/// @return False if src is corrupt, or does not decompress to exactly the size of dst
+///
+RYME_API
+bool DecompressLZ(Span<const uint8_t> src, Span<uint8_t> dst);
+
+} // namespace ryme
+
+#endif // RYME_COMPRESSION_HPP
\ No newline at end of file
@@ -0,0 +1,136 @@
+#ifndef RYME_DEFRAGMENTER_HPP
+#define RYME_DEFRAGMENTER_HPP
+
+#include <Ryme/Config.hpp>
+
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+#include <functional>
+
+namespace ryme {
+
+///
+/// Incremental GPU Memory Defragmentation
+///
+/// Loading and unloading assets leaves holes in the memory blocks allocated by VMA. Once a device
+/// local heap is fragmented enough, a defragmentation is started with VMA's defragmentation API, and
+/// a bounded number of allocations is moved each pass, one pass in flight at a time.
+///
+/// Only registered allocations are moved. For each one, a new buffer or image is created in the new
+/// memory and the contents are copied on the GPU. Once the copy is complete, the owner is given the
+/// new handle through its move function, and the frame command buffers are recorded again. The
+/// previous handle and memory are only released once every frame that could be using them has
+/// finished.
+///
+namespace Defragmenter {
+
+///
+/// Called on the main thread with the buffer or image that replaces the registered one, which is
+/// destroyed by the Defragmenter afterwards
+///
+using BufferMoveFunc = std::function<void(vk::Buffer buffer)>;
+
+using ImageMoveFunc = std::function<void(vk::Image image)>;
+
+///
+/// Allow an allocation to be moved, registering it again replaces the move function
+///
+/// Buffers must have been created with eTransferSrc, and are copied in full. They must not be
+/// persistently mapped, as the mapping moves with the memory.
+///
+RYME_API
+void RegisterBuffer(
+    VmaAllocation allocation,
+    vk::Buffer buffer,
+    const vk::BufferCreateInfo& bufferCreateInfo,
+    BufferMoveFunc moveFunc
+);
+
+///
+/// Images must have been created with eTransferSrc, and be in eShaderReadOnlyOptimal once uploaded
+///
+RYME_API
+void RegisterImage(
+    VmaAllocation allocation,
+    vk::Image image,
+    const vk::ImageCreateInfo& imageCreateInfo,
+    ImageMoveFunc moveFunc
+);
+
+///
+/// Stop moving an allocation, called when the owner is freeing it, before it is destroyed
+///
+RYME_API
+void Unregister(VmaAllocation allocation);
+
+///
+/// Called by Graphics::FreeMemory(), allocations that are being moved can't be freed until the
+/// pass ends, so VMA frees them then instead
+///
+/// @return Whether the allocation is being moved, and will be freed by the Defragmenter
+///
+RYME_API
+bool ReleaseAllocation(VmaAllocation allocation);
+
+///
+/// Check the fragmentation of the device local heaps, and advance the defragmentation if one is
+/// running
+///
+/// Called once a frame by ryme::Run()
+///
+RYME_API
+void Update();
+
+///
+/// Wait for the pass in flight and stop defragmenting, called by ryme::Term()
+///
+RYME_API
+void Term();
+
+///
+/// Start defragmenting now, regardless of the fragmentation threshold
+///
+RYME_API
+void Start();
+
+RYME_API
+bool IsRunning();
+
+RYME_API
+void SetEnabled(bool enabled);
+
+RYME_API
+bool IsEnabled();
+
+///
+/// Start a defragmentation once a device local heap is more fragmented than this, from 0 to 1
+///
+RYME_API
+void SetFragmentationThreshold(float threshold);
+
+RYME_API
+float GetFragmentationThreshold();
+
+///
+/// Limit the number of allocations moved by each pass
+///
+RYME_API
+void SetMaxMovesPerPass(uint32_t moves);
+
+RYME_API
+uint32_t GetMaxMovesPerPass();
+
+///
+/// Limit the number of bytes moved by each pass
+///
+RYME_API
+void SetMaxBytesPerPass(vk::DeviceSize bytes);
+
+RYME_API
+vk::DeviceSize GetMaxBytesPerPass();
+
+} // namespace Defragmenter
+
+} // namespace ryme
+
+#endif // RYME_DEFRAGMENTER_HPP
\ No newline at end of file
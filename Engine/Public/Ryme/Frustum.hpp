@@ -0,0 +1,34 @@
+#ifndef RYME_FRUSTUM_HPP
+#define RYME_FRUSTUM_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Array.hpp>
+#include <Ryme/Math.hpp>
+
+namespace ryme {
+
+///
+/// The six planes bounding what a camera can see
+///
+struct RYME_API Frustum
+{
+    // Left, Right, Bottom, Top, Near, Far, as (normal, distance) with the normals pointing inside
+    Array<Vec4, 6> PlaneList;
+
+    ///
+    /// Extract the planes from a projection matrix, with depth from 0 to 1
+    ///
+    /// The planes are in the space the matrix transforms from, so passing projection * view * model
+    /// gives a frustum in the space of the model.
+    ///
+    static Frustum FromMatrix(const Mat4& matrix);
+
+    bool IntersectsSphere(const Vec3& center, float radius) const;
+
+    bool IntersectsBox(const Vec3& min, const Vec3& max) const;
+
+}; // struct Frustum
+
+} // namespace ryme
+
+#endif // RYME_FRUSTUM_HPP
\ No newline at end of file
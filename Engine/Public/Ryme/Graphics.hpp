@@ -3,7 +3,9 @@
 
 #include <Ryme/Config.hpp>
 #include <Ryme/InitInfo.hpp>
+#include <Ryme/List.hpp>
 #include <Ryme/Math.hpp>
+#include <Ryme/RenderGraph.hpp>
 #include <Ryme/String.hpp>
 #include <Ryme/Tuple.hpp>
 
@@ -12,6 +14,8 @@
 #include <Ryme/ThirdParty/vulkan.hpp>
 #include <vulkan/vulkan_core.h>
 
+#include <functional>
+
 namespace ryme {
 
 ///
@@ -19,6 +23,27 @@ namespace ryme {
 ///
 namespace Graphics {
 
+struct RYME_API FrameStats
+{
+    // Total number of frames presented
+    uint64_t FrameCount;
+
+    // The remaining values are averaged over the last sampling period of ~1s
+
+    double FramesPerSecond;
+
+    double FrameMilliseconds;
+
+    // Time the CPU spent blocked waiting for a frame in flight to finish
+    double FrameWaitMilliseconds;
+
+    // Time from an input event being queued to the first frame rendered after it being presented
+    double InputLatencyMilliseconds;
+
+    double MaxInputLatencyMilliseconds;
+
+}; // struct FrameStats
+
 extern vk::Instance Instance;
 
 extern vk::Device Device;
@@ -51,26 +76,311 @@ void SetWindowSize(Vec2i windowSize);
 RYME_API
 Vec2i GetWindowSize();
 
+///
+/// Request a present mode, this will recreate the swapchain before the next frame
+///
+/// If the surface does not support the present mode, FIFO will be used instead
+///
+RYME_API
+void SetPresentMode(vk::PresentModeKHR presentMode);
+
+///
+/// @return The present mode currently in use by the swapchain
+///
+RYME_API
+vk::PresentModeKHR GetPresentMode();
+
+///
+/// Request a number of swapchain images, this will recreate the swapchain before the next frame
+///
+/// @param swapchainImageCount The number of images, clamped to the surface limits, or 0 for the minimum
+///
+RYME_API
+void SetSwapchainImageCount(unsigned swapchainImageCount);
+
+///
+/// @return The number of images currently in the swapchain
+///
+RYME_API
+unsigned GetSwapchainImageCount();
+
+///
+/// Set the number of frames the CPU can record before waiting on the GPU
+///
+/// Fewer frames reduce latency, more frames increase throughput
+///
+RYME_API
+void SetFramesInFlight(unsigned framesInFlight);
+
+RYME_API
+unsigned GetFramesInFlight();
+
+RYME_API
+FrameStats GetFrameStats();
+
+///
+/// Replace the default render graph, this will rebuild the graph before the next frame
+///
+/// The function is called whenever the swapchain is recreated, with the backbuffer already set.
+/// The default graph is a single "Main" pass that renders to the backbuffer with a depth buffer.
+/// Graphics::RenderPass is taken from the pass named "Main", if there is one.
+///
+RYME_API
+void SetRenderGraphFunc(std::function<void(RenderGraph&)> func);
+
+///
+/// @return The best supported format for depth buffers
+///
+RYME_API
+vk::Format GetDepthImageFormat();
+
+///
+/// What an allocation is used for, so memory usage can be broken down in GetMemoryStats()
+///
+enum class MemoryCategory
+{
+    Other,
+    Mesh,
+    Texture,
+    Uniform,
+    Staging,
+    RenderTarget,
+
+}; // enum class MemoryCategory
+
+constexpr size_t MemoryCategoryCount = 6;
+
+RYME_API
+StringView GetMemoryCategoryName(MemoryCategory category);
+
+///
+/// @param category Tags the allocation, it must be freed with FreeMemory() to be untracked
+///
 RYME_API
 Tuple<vk::Buffer, VmaAllocation> CreateBuffer(
     vk::BufferCreateInfo& bufferCreateInfo,
     VmaAllocationCreateInfo& allocationCreateInfo,
-    VmaAllocationInfo * allocationInfo = nullptr
+    VmaAllocationInfo * allocationInfo = nullptr,
+    MemoryCategory category = MemoryCategory::Other
 );
 
+///
+/// @param category Tags the allocation, it must be freed with FreeMemory() to be untracked
+///
 RYME_API
 Tuple<vk::Image, VmaAllocation> CreateImage(
     vk::ImageCreateInfo& imageCreateInfo,
     VmaAllocationCreateInfo& allocationCreateInfo,
-    VmaAllocationInfo * allocationInfo = nullptr
+    VmaAllocationInfo * allocationInfo = nullptr,
+    MemoryCategory category = MemoryCategory::Other
 );
 
+///
+/// Tag an allocation made directly with VMA, CreateBuffer() and CreateImage() do this already
+///
+RYME_API
+void TrackAllocation(VmaAllocation allocation, MemoryCategory category);
+
+///
+/// Untrack and free an allocation, use this in place of vmaFreeMemory()
+///
+RYME_API
+void FreeMemory(VmaAllocation allocation);
+
+struct RYME_API MemoryHeapStats
+{
+    vk::DeviceSize Size;
+
+    bool IsDeviceLocal;
+
+    // From vmaGetHeapBudgets(), including memory allocated by other processes and outside of VMA
+    vk::DeviceSize Usage;
+
+    vk::DeviceSize Budget;
+
+    // Memory blocks allocated by VMA, and the allocations placed in them
+
+    uint32_t BlockCount;
+
+    uint32_t AllocationCount;
+
+    vk::DeviceSize BlockBytes;
+
+    vk::DeviceSize AllocationBytes;
+
+    // Free space between allocations in the blocks
+
+    uint32_t UnusedRangeCount;
+
+    vk::DeviceSize LargestUnusedRange;
+
+    // 0 when the free space in the blocks is one contiguous range, approaching 1 as it is split
+    // into many small ones
+    float Fragmentation;
+
+}; // struct MemoryHeapStats
+
+struct RYME_API MemoryCategoryStats
+{
+    MemoryCategory Category;
+
+    size_t AllocationCount;
+
+    vk::DeviceSize Bytes;
+
+}; // struct MemoryCategoryStats
+
+struct RYME_API MemoryStats
+{
+    // Indexed by heap
+    List<MemoryHeapStats> HeapList;
+
+    // Indexed by MemoryCategory
+    List<MemoryCategoryStats> CategoryList;
+
+}; // struct MemoryStats
+
+RYME_API
+MemoryStats GetMemoryStats();
+
+///
+/// @param detailed Include every block and allocation, not just the totals
+/// @return The JSON from vmaBuildStatsString()
+///
+RYME_API
+String GetMemoryStatsJSON(bool detailed = false);
+
+RYME_API
+void LogMemoryStats();
+
+///
+/// Submit a command buffer to the graphics queue
+///
+/// @return The timeline value that will be signalled when the command buffer has completed
+///
+RYME_API
+uint64_t Submit(vk::CommandBuffer commandBuffer);
+
+///
+/// Every submission to the graphics queue signals a timeline semaphore with an increasing value,
+/// so GPU progress can be tracked by comparing values instead of waiting on fences
+///
+/// @return The timeline value signalled by the most recent submission
+///
+RYME_API
+uint64_t GetSubmittedTimelineValue();
+
+///
+/// @return The most recent timeline value that the GPU has completed
+///
+RYME_API
+uint64_t GetCompletedTimelineValue();
+
+RYME_API
+bool IsTimelineValueComplete(uint64_t value);
+
+///
+/// Block until the GPU has completed all submissions up to and including the timeline value
+///
+RYME_API
+void WaitForTimelineValue(uint64_t value);
+
+///
+/// Destroy an object once every submission that could reference it has completed
+///
+/// Everything submitted so far may still be using the object, and so may a frame that is still on
+/// its way to being submitted, so the destruction is delayed until the GPU reaches one past the
+/// current timeline value. This allows assets to be freed or reloaded without waiting for the
+/// device to be idle.
+///
+/// Objects that may be recorded into the frame command buffers must also call
+/// InvalidateCommandBuffers(), otherwise the recorded commands keep using them after they have
+/// been destroyed. Safe to call from any thread.
+///
+/// @param destroyFunc Called from Render() or Term() to perform the actual destruction
+///
+RYME_API
+void DeferDestroy(std::function<void()> destroyFunc);
+
 RYME_API
 void CopyBuffer(vk::Buffer src, vk::Buffer dst, vk::BufferCopy region);
 
 RYME_API
 void CopyBufferToImage(vk::Buffer src, vk::Image dst, vk::BufferImageCopy region);
 
+///
+/// Copy mip levels from a buffer into an image, generate the remaining levels with linear blits,
+/// and leave every level in eShaderReadOnlyOptimal
+///
+/// @param regionList One region per level provided in the buffer, starting at level 0
+/// @param mipLevels The number of levels in the image, generating levels requires the format to
+///   support eBlitSrc, eBlitDst and eSampledImageFilterLinear
+///
+RYME_API
+void UploadTexture(
+    vk::Buffer src,
+    vk::Image dst,
+    const List<vk::BufferImageCopy>& regionList,
+    uint32_t mipLevels
+);
+
+struct RYME_API TextureUpload
+{
+    vk::Image Image;
+
+    // One region per level provided in the buffer, starting at level 0
+    List<vk::BufferImageCopy> RegionList;
+
+    uint32_t MipLevels;
+
+}; // struct TextureUpload
+
+///
+/// Record the uploads of several textures, as in UploadTexture(), into a single command buffer and
+/// submit it without waiting
+///
+/// @param src A buffer holding the data for every upload, which must stay alive until the uploads
+///   have finished, such as by destroying it with DeferDestroy()
+/// @return The timeline value that will be signalled once the uploads have finished
+///
+RYME_API
+uint64_t SubmitTextureUploadList(vk::Buffer src, const List<TextureUpload>& uploadList);
+
+///
+/// Record a one-time command buffer and submit it to the graphics queue without waiting
+///
+/// @return The timeline value that will be signalled once the commands have finished
+///
+RYME_API
+uint64_t SubmitCommands(std::function<void(vk::CommandBuffer)> recordFunc);
+
+///
+/// Record the frame command buffers again before they are next used, such as after a buffer or
+/// image they reference has been replaced
+///
+/// Safe to call from any thread, takes effect from the next call to Render().
+///
+RYME_API
+void InvalidateCommandBuffers();
+
+///
+/// @return Whether images in the format with optimal tiling support all of the features
+///
+RYME_API
+bool IsFormatFeatureSupported(vk::Format format, vk::FormatFeatureFlags formatFeatures);
+
+///
+/// @return Whether drawIndexedIndirect() can be called with a drawCount greater than 1
+///
+RYME_API
+bool IsMultiDrawIndirectSupported();
+
+///
+/// @return Whether drawIndexedIndirectCount() can be used, to read the draw count from a buffer
+///
+RYME_API
+bool IsDrawIndirectCountSupported();
+
 RYME_API
 void ScriptInit(py::module);
 
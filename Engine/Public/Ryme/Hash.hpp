@@ -0,0 +1,25 @@
+#ifndef RYME_HASH_HPP
+#define RYME_HASH_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Span.hpp>
+#include <Ryme/String.hpp>
+
+#include <cstdint>
+
+namespace ryme {
+
+///
+/// A fast, non-cryptographic 64-bit hash of the contents of a buffer, for detecting when files
+/// change and for keying caches. This is XXH64, so it matches other tools that use it.
+///
+RYME_API
+uint64_t Hash64(Span<const uint8_t> data, uint64_t seed = 0);
+
+inline uint64_t Hash64(StringView str, uint64_t seed = 0) {
+    return Hash64(Span<const uint8_t>(reinterpret_cast<const uint8_t *>(str.data()), str.size()), seed);
+}
+
+} // namespace ryme
+
+#endif // RYME_HASH_HPP
\ No newline at end of file
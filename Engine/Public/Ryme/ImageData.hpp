@@ -0,0 +1,97 @@
+#ifndef RYME_IMAGE_DATA_HPP
+#define RYME_IMAGE_DATA_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Mipmap.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/Span.hpp>
+
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+namespace ryme {
+
+///
+/// Pixel data of an image in system memory, ready to be uploaded
+///
+struct RYME_API ImageData
+{
+    vk::Format Format = vk::Format::eUndefined;
+
+    uint32_t Width = 0;
+
+    uint32_t Height = 0;
+
+    // Levels stored in Data, starting at level 0, may be just level 0 for images without mips
+    List<MipLevel> MipLevelList;
+
+    List<uint8_t> Data;
+
+}; // struct ImageData
+
+///
+/// Load an image, choosing the loader from the extension
+///
+/// KTX2 and DDS files are loaded as-is, with any compression and mips they contain. Everything
+/// else is decoded by stb_image to a single level of eR8G8B8A8Srgb.
+///
+/// @param search Find path in the VFS, otherwise it is opened as a full path
+///
+RYME_API
+bool LoadImageData(const Path& path, ImageData& imageData, bool search = false);
+
+///
+/// Load an image that has already been read into memory
+///
+/// @param path The file the data was read from, to choose the loader and report errors
+///
+RYME_API
+bool LoadImageData(Span<const uint8_t> data, const Path& path, ImageData& imageData);
+
+///
+/// Load a KTX2 file without supercompression, containing a single 2D image
+///
+RYME_API
+bool LoadKTX2(Span<const uint8_t> data, const Path& path, ImageData& imageData);
+
+///
+/// Load a DDS file containing a single 2D image in BC1, BC3, BC4, BC5 or BC7
+///
+RYME_API
+bool LoadDDS(Span<const uint8_t> data, const Path& path, ImageData& imageData);
+
+///
+/// Save a KTX2 file, for the formats supported by GetImageSize()
+///
+RYME_API
+bool SaveKTX2(const Path& path, const ImageData& imageData);
+
+///
+/// @return One copy region per level in imageData.Data, for uploading it from a staging buffer
+///
+/// @param bufferOffset The offset of imageData.Data in the staging buffer
+///
+RYME_API
+List<vk::BufferImageCopy> GetCopyRegionList(const ImageData& imageData, vk::DeviceSize bufferOffset = 0);
+
+///
+/// Fill out the rest of the mip chain of an eR8G8B8A8 image from level 0
+///
+RYME_API
+void GenerateMipmaps(ImageData& imageData);
+
+///
+/// Decompress every level of a block compressed image into RGBA8
+///
+RYME_API
+void DecompressImageData(ImageData& imageData);
+
+///
+/// Compress every level of an RGBA8 image into a block compressed format
+///
+RYME_API
+void CompressImageData(ImageData& imageData, vk::Format format);
+
+} // namespace ryme
+
+#endif // RYME_IMAGE_DATA_HPP
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <Ryme/String.hpp>
 #include <Ryme/Version.hpp>
 
+#include <Ryme/ThirdParty/vulkan.hpp>
+
 namespace ryme {
 
 struct RYME_API InitInfo
@@ -20,6 +22,18 @@ struct RYME_API InitInfo
 
     Vec4 ClearColor = Color::CornflowerBlue;
 
+    // Falls back to FIFO if the surface does not support it
+    vk::PresentModeKHR PresentMode = vk::PresentModeKHR::eMailbox;
+
+    // Clamped to the surface limits, 0 will use the minimum supported by the surface
+    unsigned SwapchainImageCount = 0;
+
+    // The number of frames the CPU can record before waiting on the GPU
+    unsigned FramesInFlight = 2;
+
+    // The number of threads in the engine ThreadPool, 0 will use one less than the number of cores
+    unsigned WorkerThreadCount = 0;
+
 }; // struct InitInfo
 
 } // namespace ryme
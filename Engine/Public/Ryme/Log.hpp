@@ -3,11 +3,11 @@
 
 #include <Ryme/Config.hpp>
 #include <Ryme/Path.hpp>
+#include <Ryme/Profiler.hpp>
 #include <Ryme/String.hpp>
 
 #include <Ryme/ThirdParty/fmt.hpp>
 
-#include <chrono>
 #include <utility>
 
 namespace ryme {
@@ -28,13 +28,19 @@ inline StringView LogGetFilename(StringView filename)
 #if defined(RYME_ENABLE_BENCHMARK)
 
     #define RYME_BENCHMARK_START() \
-        auto rymeBenchmarkStart = std::chrono::high_resolution_clock::now()
+        ryme::ProfileZone rymeBenchmarkZone(RYME_FUNCTION_NAME, true)
 
     #define RYME_BENCHMARK_END()                                                    \
         ryme::Log(RYME_ANCHOR, "Function '{}' took {:.3} ms", RYME_FUNCTION_NAME,   \
-            std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(  \
-                std::chrono::high_resolution_clock::now() - rymeBenchmarkStart      \
-            ).count())
+            rymeBenchmarkZone.End())
+
+#elif defined(RYME_ENABLE_PROFILER)
+
+    #define RYME_BENCHMARK_START() \
+        ryme::ProfileZone rymeBenchmarkZone(RYME_FUNCTION_NAME)
+
+    #define RYME_BENCHMARK_END() \
+        rymeBenchmarkZone.End()
 
 #else
 
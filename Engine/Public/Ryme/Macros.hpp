@@ -10,6 +10,9 @@
 #define _RYME_STRINGIFY(x) #x
 #define RYME_STRINGIFY(x) _RYME_STRINGIFY(x)
 
+#define _RYME_CONCAT(x, y) x##y
+#define RYME_CONCAT(x, y) _RYME_CONCAT(x, y)
+
 #if defined(RYME_COMPILER_MSVC)
 
     #define RYME_DISABLE_WARNINGS() \
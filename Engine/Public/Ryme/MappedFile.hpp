@@ -0,0 +1,75 @@
+#ifndef RYME_MAPPED_FILE_HPP
+#define RYME_MAPPED_FILE_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/NonCopyable.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/Span.hpp>
+
+#include <cstdint>
+
+namespace ryme {
+
+///
+/// A read-only view of a whole file, mapped into memory instead of copied into a buffer
+///
+/// The data is aligned to at least a page, so it can be read as any type directly.
+///
+class RYME_API MappedFile : public NonCopyable
+{
+public:
+
+    MappedFile() = default;
+
+    MappedFile(const Path& path);
+
+    MappedFile(MappedFile&& rhs);
+
+    virtual ~MappedFile();
+
+    MappedFile& operator=(MappedFile&& rhs);
+
+    ///
+    /// @return False if the file could not be opened, empty files are opened but have no data
+    ///
+    bool Open(const Path& path);
+
+    void Close();
+
+    inline bool IsOpen() const {
+        return _isOpen;
+    }
+
+    inline const uint8_t * GetData() const {
+        return _data;
+    }
+
+    inline size_t GetSize() const {
+        return _size;
+    }
+
+    inline Span<const uint8_t> GetSpan() const {
+        return { _data, _size };
+    }
+
+private:
+
+    bool _isOpen = false;
+
+    const uint8_t * _data = nullptr;
+
+    size_t _size = 0;
+
+#if defined(RYME_PLATFORM_WINDOWS)
+
+    void * _fileHandle = nullptr;
+
+    void * _mappingHandle = nullptr;
+
+#endif
+
+}; // class MappedFile
+
+} // namespace ryme
+
+#endif // RYME_MAPPED_FILE_HPP
\ No newline at end of file
@@ -5,13 +5,29 @@
 #include <Ryme/Asset.hpp>
 #include <Ryme/Buffer.hpp>
 #include <Ryme/List.hpp>
+#include <Ryme/Math.hpp>
+#include <Ryme/Meshlet.hpp>
 #include <Ryme/NonCopyable.hpp>
 #include <Ryme/Vertex.hpp>
 
 #include <Ryme/ThirdParty/vulkan.hpp>
 
+#include <algorithm>
+
 namespace ryme {
 
+///
+/// A simplified version of a mesh, sharing the VertexList of the MeshData it was generated from
+///
+struct RYME_API MeshLOD
+{
+    List<uint32_t> IndexList;
+
+    // The furthest the simplified surface strays from the original, in the units of the mesh
+    float Error = 0.0f;
+
+}; // struct MeshLOD
+
 class RYME_API MeshData
 {
 public:
@@ -22,10 +38,48 @@ public:
 
     List<Vertex> VertexList;
 
+    // Ordered from most to least detailed, not including the full detail IndexList
+    List<MeshLOD> LODList;
+
     // Material
 
     void CalculateTangents();
 
+    ///
+    /// Merge identical vertices and fill in IndexList, if the mesh is not already indexed
+    ///
+    void GenerateIndexList();
+
+    ///
+    /// Simplify a triangle list by collapsing edges in order of their quadric error
+    ///
+    /// Vertices are welded by position, so the mesh is simplified as one surface even where it is
+    /// split for normals or texture coordinates. The edges along those attribute seams, and along
+    /// open borders, only collapse onto themselves, so they keep their shape and stay closed.
+    ///
+    /// @param targetRatio The fraction of the triangles to keep
+    /// @param maxError Stop before the surface strays further than this, relative to the size of the mesh
+    /// @return An IndexList into VertexList with at most targetRatio of the triangles, unless maxError is reached first
+    ///
+    MeshLOD Simplify(float targetRatio, float maxError = 1.0f) const;
+
+    ///
+    /// Fill in LODList, each LOD is simplified from the previous one
+    ///
+    /// LODs that fail to remove at least a tenth of the remaining triangles are dropped, along with
+    /// the ones that would follow them.
+    ///
+    /// @param ratioList The fraction of the original triangles to keep for each LOD
+    ///
+    void GenerateLODs(const List<float>& ratioList = { 0.5f, 0.25f, 0.125f }, float maxError = 1.0f);
+
+    ///
+    /// Split the mesh into meshlets of neighbouring triangles that face similar directions
+    ///
+    /// IndexList is reordered so the triangles of each meshlet are contiguous, LODList is left as-is.
+    ///
+    MeshletData BuildMeshlets(uint32_t maxVertexCount = 64, uint32_t maxTriangleCount = 124);
+
 }; // class MeshData
 
 class RYME_API Mesh : public NonCopyable
@@ -38,13 +92,60 @@ public:
 
     virtual ~Mesh() = default;
 
-    void GenerateCommands(vk::CommandBuffer buffer);
+    ///
+    /// @param lod Clamped to the least detailed LOD available, 0 is full detail
+    ///
+    void GenerateCommands(vk::CommandBuffer buffer, uint32_t lod = 0);
+
+    ///
+    /// Bind the vertex and index buffers, for recording draws of parts of the mesh, such as meshlets
+    ///
+    void Bind(vk::CommandBuffer buffer);
+
+    ///
+    /// @return The number of LODs including full detail, always at least 1
+    ///
+    inline uint32_t GetLODCount() const {
+        return static_cast<uint32_t>(_lodList.size());
+    }
+
+    inline float GetLODError(uint32_t lod) const {
+        return _lodList[std::min(lod, GetLODCount() - 1)].Error;
+    }
+
+    uint32_t GetTriangleCount(uint32_t lod = 0) const;
+
+    inline size_t GetMemorySize() const {
+        return static_cast<size_t>(_vertexBuffer.GetSize() + _indexBuffer.GetSize());
+    }
+
+    inline Vec3 GetBoundsMin() const {
+        return _boundsMin;
+    }
+
+    inline Vec3 GetBoundsMax() const {
+        return _boundsMax;
+    }
 
 private:
 
+    struct LOD
+    {
+        uint32_t FirstIndex;
+
+        uint32_t Count;
+
+        float Error;
+
+    }; // struct LOD
+
     bool _indexed = false;
 
-    uint32_t _count;
+    List<LOD> _lodList;
+
+    Vec3 _boundsMin = Vec3(0.0f);
+
+    Vec3 _boundsMax = Vec3(0.0f);
 
     vk::PrimitiveTopology _primitiveTopology;
 
@@ -0,0 +1,118 @@
+#ifndef RYME_MESHLET_HPP
+#define RYME_MESHLET_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Frustum.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Math.hpp>
+#include <Ryme/Span.hpp>
+
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+namespace ryme {
+
+///
+/// A small cluster of neighbouring triangles, which is culled as a whole
+///
+struct RYME_API Meshlet
+{
+    // The range of MeshData::IndexList holding the triangles of the meshlet
+    uint32_t FirstIndex;
+
+    uint32_t IndexCount;
+
+    // The range of MeshletData::VertexList holding the vertices used by the meshlet
+    uint32_t FirstVertex;
+
+    uint32_t VertexCount;
+
+}; // struct Meshlet
+
+///
+/// Matches the layout of MeshletBounds in MeshletCull.comp.glsl
+///
+struct RYME_API MeshletBounds
+{
+    Vec3 Center;
+
+    float Radius;
+
+    // Every triangle faces away from a camera inside the cone behind ConeApex, which is when
+    // dot(normalize(ConeApex - cameraPosition), ConeAxis) >= ConeCutoff
+    Vec3 ConeApex;
+
+    float Padding;
+
+    Vec3 ConeAxis;
+
+    // 1 when the triangles face too many directions for the cone to ever cull them
+    float ConeCutoff;
+
+}; // struct MeshletBounds
+
+static_assert(
+    sizeof(MeshletBounds) == 48,
+    "sizeof(MeshletBounds) does not match GLSL layout std430"
+);
+
+struct RYME_API MeshletData
+{
+    List<Meshlet> MeshletList;
+
+    // One for each Meshlet in MeshletList
+    List<MeshletBounds> BoundsList;
+
+    // Indices into MeshData::VertexList
+    List<uint32_t> VertexList;
+
+}; // struct MeshletData
+
+struct RYME_API MeshletCullStats
+{
+    size_t MeshletCount = 0;
+
+    size_t FrustumCulledCount = 0;
+
+    size_t ConeCulledCount = 0;
+
+    size_t VisibleTriangleCount = 0;
+
+}; // struct MeshletCullStats
+
+///
+/// @param frustum In the space of the mesh, see Frustum::FromMatrix()
+/// @param cameraPosition In the space of the mesh
+///
+RYME_API
+bool IsMeshletVisible(const MeshletBounds& bounds, const Frustum& frustum, const Vec3& cameraPosition);
+
+///
+/// Cull the meshlets of a mesh, and fill drawList with indirect draws of the ones that remain
+///
+/// Visible meshlets that are next to each other in the index buffer are merged into one draw.
+///
+RYME_API
+MeshletCullStats CullMeshlets(
+    const MeshletData& meshletData,
+    const Frustum& frustum,
+    const Vec3& cameraPosition,
+    List<vk::DrawIndexedIndirectCommand>& drawList
+);
+
+///
+/// Cull the meshlets of a mesh, and fill visibleIndexList with the indices of the ones that remain
+///
+/// @param indexList The IndexList of the MeshData the meshlets were built from
+///
+RYME_API
+MeshletCullStats CullMeshlets(
+    const MeshletData& meshletData,
+    Span<const uint32_t> indexList,
+    const Frustum& frustum,
+    const Vec3& cameraPosition,
+    List<uint32_t>& visibleIndexList
+);
+
+} // namespace ryme
+
+#endif // RYME_MESHLET_HPP
\ No newline at end of file
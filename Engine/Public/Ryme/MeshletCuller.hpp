@@ -0,0 +1,108 @@
+#ifndef RYME_MESHLET_CULLER_HPP
+#define RYME_MESHLET_CULLER_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Buffer.hpp>
+#include <Ryme/Frustum.hpp>
+#include <Ryme/Math.hpp>
+#include <Ryme/Meshlet.hpp>
+#include <Ryme/NonCopyable.hpp>
+#include <Ryme/Shader.hpp>
+
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+namespace ryme {
+
+///
+/// Culls the meshlets of a mesh with a compute shader, and draws the ones that remain with indirect
+/// draws, without needing mesh shaders
+///
+/// The draws are compacted and counted on the GPU. When drawIndexedIndirectCount() is not supported,
+/// every slot is drawn and the culled ones are left with no instances.
+///
+class RYME_API MeshletCuller : public NonCopyable
+{
+public:
+
+    MeshletCuller() = default;
+
+    virtual ~MeshletCuller();
+
+    void Create(const MeshletData& meshletData);
+
+    void Destroy();
+
+    ///
+    /// Set the view to cull against, before the frame is rendered
+    ///
+    /// The view is recorded into the command buffers by Cull(), so they are recorded again with
+    /// Graphics::InvalidateCommandBuffers() whenever it changes.
+    ///
+    /// @param frustum In the space of the mesh, see Frustum::FromMatrix()
+    /// @param cameraPosition In the space of the mesh
+    ///
+    void SetView(const Frustum& frustum, const Vec3& cameraPosition);
+
+    ///
+    /// Record the culling dispatch against the view from SetView(), must be recorded outside of a
+    /// render pass
+    ///
+    void Cull(vk::CommandBuffer buffer);
+
+    ///
+    /// Record the draws of the meshlets that survived the last Cull(), the Mesh the meshlets were
+    /// built from must be bound with Mesh::Bind()
+    ///
+    void Draw(vk::CommandBuffer buffer);
+
+    inline uint32_t GetMeshletCount() const {
+        return _meshletCount;
+    }
+
+private:
+
+    struct PushConstants
+    {
+        Array<Vec4, 6> FrustumPlanes;
+
+        Vec3 CameraPosition;
+
+        uint32_t MeshletCount;
+
+    }; // struct PushConstants
+
+    void createPipeline();
+
+    void createDescriptorSet();
+
+    uint32_t _meshletCount = 0;
+
+    Frustum _frustum = {};
+
+    Vec3 _cameraPosition = Vec3(0.0f);
+
+    Buffer _meshletBuffer;
+
+    Buffer _boundsBuffer;
+
+    vk::Buffer _drawBuffer = nullptr;
+
+    VmaAllocation _drawAllocation = nullptr;
+
+    vk::Buffer _drawCountBuffer = nullptr;
+
+    VmaAllocation _drawCountAllocation = nullptr;
+
+    Shader _shader;
+
+    vk::Pipeline _pipeline;
+
+    vk::DescriptorPool _descriptorPool;
+
+    vk::DescriptorSet _descriptorSet;
+
+}; // class MeshletCuller
+
+} // namespace ryme
+
+#endif // RYME_MESHLET_CULLER_HPP
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef RYME_MIPMAP_HPP
+#define RYME_MIPMAP_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+
+#include <cstdint>
+
+namespace ryme {
+
+struct RYME_API MipLevel
+{
+    uint32_t Width;
+
+    uint32_t Height;
+
+    // Offset of the level from the start of the mip chain, in bytes
+    size_t Offset;
+
+    size_t Size;
+
+}; // struct MipLevel
+
+///
+/// @return The number of levels in a full mip chain, down to 1x1
+///
+RYME_API
+uint32_t GetMipLevelCount(uint32_t width, uint32_t height);
+
+///
+/// Lay out a full mip chain with the levels stored consecutively, starting at level 0
+///
+RYME_API
+List<MipLevel> GetMipLevelList(uint32_t width, uint32_t height, uint32_t bytesPerTexel);
+
+///
+/// Downsample an RGBA8 image to half its size with a 2x2 box filter
+///
+/// The result is max(width / 2, 1) by max(height / 2, 1), odd edges are clamped. Filtering is done on
+/// the encoded values, so sRGB images come out slightly darker than with a GPU blit, which filters in
+/// linear space.
+///
+/// @param src The source image, width * height * 4 bytes
+/// @param dst The destination image, large enough for the next level
+///
+RYME_API
+void DownsampleRGBA8(const uint8_t * src, uint32_t width, uint32_t height, uint8_t * dst);
+
+} // namespace ryme
+
+#endif // RYME_MIPMAP_HPP
\ No newline at end of file
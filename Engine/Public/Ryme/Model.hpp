@@ -5,7 +5,12 @@
 #include <Ryme/Asset.hpp>
 #include <Ryme/List.hpp>
 #include <Ryme/Mesh.hpp>
+#include <Ryme/Math.hpp>
+#include <Ryme/OcclusionBuffer.hpp>
 #include <Ryme/Path.hpp>
+#include <Ryme/Ray.hpp>
+#include <Ryme/Span.hpp>
+#include <Ryme/TriangleBVH.hpp>
 #include <Ryme/Vertex.hpp>
 
 #include <Ryme/JSON.hpp>
@@ -32,18 +37,102 @@ public:
         return true;
     }
 
-    void Render(vk::CommandBuffer buffer);
+    ///
+    /// @return The size of the vertex and index buffers of every Mesh
+    ///
+    size_t GetMemorySize() const override;
+
+    ///
+    /// @param lod Meshes with fewer LODs use their least detailed one
+    ///
+    void Render(vk::CommandBuffer buffer, uint32_t lod = 0);
+
+    ///
+    /// @return The number of LODs including full detail, the most of any Mesh
+    ///
+    inline uint32_t GetLODCount() const {
+        return static_cast<uint32_t>(_lodErrorList.size());
+    }
 
-private:
+    ///
+    /// @return The largest error of any Mesh at each LOD, in the units of the model
+    ///
+    inline Span<const float> GetLODErrorList() const {
+        return { _lodErrorList.begin(), _lodErrorList.end() };
+    }
+
+    uint32_t GetTriangleCount(uint32_t lod = 0) const;
+
+    inline Vec3 GetBoundingCenter() const {
+        return _boundingCenter;
+    }
+
+    inline float GetBoundingRadius() const {
+        return _boundingRadius;
+    }
+
+    inline Vec3 GetBoundsMin() const {
+        return _boundsMin;
+    }
+
+    inline Vec3 GetBoundsMax() const {
+        return _boundsMax;
+    }
+
+    ///
+    /// @return The least detailed LOD of every Mesh, for drawing into an OcclusionBuffer
+    ///
+    inline const OccluderMesh& GetOccluderMesh() const {
+        return _occluderMesh;
+    }
 
-    bool LoadGLTF2(const Path& path, bool search);
+    ///
+    /// Find the closest triangle of any Mesh hit by a ray in the space of the model
+    ///
+    /// @return True if a triangle closer than hit.Distance was hit, and hit was filled in
+    ///
+    bool Intersect(const Ray& ray, RayHit& hit) const;
 
-    bool LoadOBJ(const Path& path, bool search);
+    bool IntersectAny(const Ray& ray) const;
+
+    ///
+    /// @return The TriangleBVH of each Mesh, in the same order
+    ///
+    inline Span<const TriangleBVH> GetTriangleBVHList() const {
+        return { _triangleBVHList.begin(), _triangleBVHList.end() };
+    }
+
+    ///
+    /// Set the fraction of the triangles kept by each LOD generated while loading, empty to disable
+    ///
+    /// Meshes loaded from a file cooked by RymeCook keep the LODs that were generated then.
+    ///
+    static void SetLODRatioList(const List<float>& ratioList);
+
+    static const List<float>& GetLODRatioList();
+
+private:
+
+    void CalculateLODs();
 
     Path _path;
 
     List<Mesh> _meshList;
 
+    List<float> _lodErrorList;
+
+    Vec3 _boundingCenter = Vec3(0.0f);
+
+    float _boundingRadius = 0.0f;
+
+    Vec3 _boundsMin = Vec3(0.0f);
+
+    Vec3 _boundsMax = Vec3(0.0f);
+
+    OccluderMesh _occluderMesh;
+
+    List<TriangleBVH> _triangleBVHList;
+
 }; // class Model
 
 } // namespace ryme
@@ -5,27 +5,79 @@
 #include <Ryme/Component.hpp>
 #include <Ryme/Model.hpp>
 
+#include <memory>
+
 namespace ryme {
 
 class RYME_API ModelComponent : public Component
 {
 public:
 
-    ModelComponent(Model * model);
+    ///
+    /// @param model Shared with every other component using it, such as one from AssetManager::LoadModel()
+    ///
+    ModelComponent(std::shared_ptr<Model> model);
 
-    virtual ~ModelComponent();
+    virtual ~ModelComponent() = default;
 
     void Attach(Entity * entity) override;
 
     void Detach() override;
 
     Model * GetModel() const {
+        return _model.get();
+    }
+
+    inline const std::shared_ptr<Model>& GetModelRef() const {
         return _model;
     }
 
+    ///
+    /// Chosen by RenderSystem::SelectLODs(), the draws are pre-recorded so anything else changing it
+    /// has to call Graphics::InvalidateCommandBuffers()
+    ///
+    inline void SetLOD(uint32_t lod) {
+        _lod = lod;
+    }
+
+    inline uint32_t GetLOD() const {
+        return _lod;
+    }
+
+    ///
+    /// Draw the model into the OcclusionBuffer of the RenderSystem, to hide the models behind it
+    ///
+    inline void SetOccluder(bool occluder) {
+        _isOccluder = occluder;
+    }
+
+    inline bool IsOccluder() const {
+        return _isOccluder;
+    }
+
+    ///
+    /// Chosen by RenderSystem::CullOccluded(), models that are not visible do not need to be drawn
+    ///
+    /// The draws are pre-recorded, so anything else changing it has to call
+    /// Graphics::InvalidateCommandBuffers()
+    ///
+    inline void SetVisible(bool visible) {
+        _isVisible = visible;
+    }
+
+    inline bool IsVisible() const {
+        return _isVisible;
+    }
+
 private:
 
-    Model * _model;
+    std::shared_ptr<Model> _model;
+
+    uint32_t _lod = 0;
+
+    bool _isOccluder = false;
+
+    bool _isVisible = true;
 
 }; // class ModelComponent
 
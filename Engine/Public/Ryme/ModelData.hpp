@@ -0,0 +1,67 @@
+#ifndef RYME_MODEL_DATA_HPP
+#define RYME_MODEL_DATA_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Mesh.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/Span.hpp>
+
+namespace ryme {
+
+///
+/// The meshes of a model in system memory, ready to be uploaded
+///
+struct RYME_API ModelData
+{
+    List<MeshData> MeshList;
+
+    // Every other file that was read, such as the MTL files of an OBJ
+    List<Path> DependencyList;
+
+}; // struct ModelData
+
+///
+/// Load a model, choosing the loader from the extension
+///
+/// RMESH files are loaded as-is, with any LODs they contain. Everything else is indexed and has
+/// tangents calculated, but has no LODs.
+///
+/// @param search Find path in the VFS, otherwise it is opened as a full path
+///
+RYME_API
+bool LoadModelData(const Path& path, ModelData& modelData, bool search = false);
+
+///
+/// Load a model that has already been read into memory
+///
+/// @param path The file the data was read from, to choose the loader, find the files it
+///   references, and report errors
+///
+RYME_API
+bool LoadModelData(Span<const uint8_t> data, const Path& path, ModelData& modelData);
+
+///
+/// Load an OBJ file, and any MTL files it references from next to it
+///
+RYME_API
+bool LoadOBJ(Span<const uint8_t> data, const Path& path, ModelData& modelData);
+
+RYME_API
+bool LoadGLTF2(Span<const uint8_t> data, const Path& path, ModelData& modelData);
+
+///
+/// Load an RMESH file, the binary format written by SaveRMESH()
+///
+RYME_API
+bool LoadRMESH(Span<const uint8_t> data, const Path& path, ModelData& modelData);
+
+///
+/// Save every mesh and its LODs as they are in memory, so they can be loaded without any processing
+///
+RYME_API
+bool SaveRMESH(const Path& path, const ModelData& modelData);
+
+} // namespace ryme
+
+#endif // RYME_MODEL_DATA_HPP
\ No newline at end of file
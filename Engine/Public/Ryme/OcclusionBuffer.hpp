@@ -0,0 +1,184 @@
+#ifndef RYME_OCCLUSION_BUFFER_HPP
+#define RYME_OCCLUSION_BUFFER_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Array.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Math.hpp>
+#include <Ryme/NonCopyable.hpp>
+#include <Ryme/ThreadPool.hpp>
+
+namespace ryme {
+
+class MeshData;
+
+///
+/// The positions and triangles of a mesh, kept in system memory to be drawn into an OcclusionBuffer
+///
+struct RYME_API OccluderMesh
+{
+    List<Vec3> PositionList;
+
+    List<uint32_t> IndexList;
+
+    ///
+    /// Add the triangles of the least detailed LOD of a mesh, as occluders don't need to be exact
+    ///
+    void Append(const MeshData& data);
+
+}; // struct OccluderMesh
+
+///
+/// A low resolution depth buffer, drawn on the CPU from a few large occluders, to find which objects
+/// are hidden behind them before recording their draws
+///
+/// Occluders are drawn from both sides, with no backface culling. Pixels are covered when their
+/// center is inside of a triangle, and every triangle only ever moves the depth closer, so the
+/// result does not depend on the order of the occluders or the number of threads.
+///
+class RYME_API OcclusionBuffer : public NonCopyable
+{
+public:
+
+    // The buffer is split into tiles of this many pixels, each drawn by a single thread
+    static inline const uint32_t TileWidth = 32;
+
+    static inline const uint32_t TileHeight = 32;
+
+    struct Stats
+    {
+        size_t OccluderCount = 0;
+
+        size_t TriangleCount = 0;
+
+        // Triangles left after clipping to the near plane and the viewport
+        size_t RasterizedTriangleCount = 0;
+
+    }; // struct Stats
+
+    ///
+    /// @param width Rounded up to a multiple of 4
+    ///
+    OcclusionBuffer(uint32_t width = 256, uint32_t height = 128);
+
+    virtual ~OcclusionBuffer() = default;
+
+    void Resize(uint32_t width, uint32_t height);
+
+    ///
+    /// Clear the depth and forget the occluders, to draw another frame
+    ///
+    /// @param viewProjection Projection * View, with depth from 0 to 1
+    ///
+    void Clear(const Mat4& viewProjection);
+
+    ///
+    /// Queue an occluder to be drawn by Rasterize(), the mesh must stay alive until then
+    ///
+    void AddOccluder(const OccluderMesh& mesh, const Mat4& model);
+
+    ///
+    /// Draw every queued occluder, then build the hierarchical depth used by IsBoxVisible()
+    ///
+    /// @param threadPool The pool to split the work across, or nullptr to draw on this thread
+    ///
+    void Rasterize(ThreadPool * threadPool = nullptr);
+
+    ///
+    /// Test a bounding box against the hierarchical depth, conservatively
+    ///
+    /// @return False if the box is entirely behind the occluders, or outside of the viewport
+    ///
+    bool IsBoxVisible(const Vec3& min, const Vec3& max, const Mat4& model) const;
+
+    inline uint32_t GetWidth() const {
+        return _width;
+    }
+
+    inline uint32_t GetHeight() const {
+        return _height;
+    }
+
+    ///
+    /// @return The depth of each pixel, row by row, from 0 at the near plane to 1 at the far plane
+    ///
+    inline const List<float>& GetDepthList() const {
+        return _depthList;
+    }
+
+    inline const Stats& GetStats() const {
+        return _stats;
+    }
+
+private:
+
+    struct Occluder
+    {
+        const OccluderMesh * Mesh;
+
+        Mat4 Transform;
+
+    }; // struct Occluder
+
+    // A triangle in pixels, with its depth
+    struct ScreenTriangle
+    {
+        Array<Vec3, 3> VertexList;
+
+    }; // struct ScreenTriangle
+
+    // A range of triangles, which may span several occluders, transformed and sorted into tiles by
+    // one thread
+    struct Batch
+    {
+        // Where the range starts
+        uint32_t Occluder;
+
+        uint32_t FirstTriangle;
+
+        uint32_t TriangleCount;
+
+        List<ScreenTriangle> TriangleList;
+
+        // The indices in TriangleList of the triangles touching each tile
+        List<List<uint32_t>> TileTriangleListList;
+
+    }; // struct Batch
+
+    void setupBatch(Batch& batch);
+
+    void addScreenTriangle(Batch& batch, const Vec4& v0, const Vec4& v1, const Vec4& v2);
+
+    void rasterizeTile(uint32_t tile);
+
+    void rasterizeTriangle(const ScreenTriangle& triangle, uint32_t tileX, uint32_t tileY);
+
+    void buildHierarchy();
+
+    uint32_t _width;
+
+    uint32_t _height;
+
+    uint32_t _tileCountX;
+
+    uint32_t _tileCountY;
+
+    Mat4 _viewProjection = Mat4(1.0f);
+
+    List<float> _depthList;
+
+    // Each level holds the farthest depth of 2x2 texels of the one before it, starting with half
+    // the size of _depthList
+    List<List<float>> _levelList;
+
+    List<Occluder> _occluderList;
+
+    List<Batch> _batchList;
+
+    Stats _stats;
+
+}; // class OcclusionBuffer
+
+} // namespace ryme
+
+#endif // RYME_OCCLUSION_BUFFER_HPP
\ No newline at end of file
@@ -9,6 +9,9 @@
 #include <Ryme/ThirdParty/fmt.hpp>
 #include <Ryme/ThirdParty/python.hpp>
 
+#include <cstdio>
+#include <functional>
+
 namespace ryme {
 
 class RYME_API Path
@@ -178,8 +181,20 @@ public:
 RYME_API
 Path GetCurrentPath();
 
+///
+/// Write a file to a temporary file next to it, which then replaces it, so anything reading the file
+/// at the same time sees either the old contents or the new ones, and never half of them
+///
+/// @param writeFunc Writes the contents, return false to discard the temporary file instead
+///
+RYME_API
+bool WriteFileReplacing(const Path& path, std::function<bool(FILE * file)> writeFunc);
+
+///
+/// @return The paths in the RYME_ASSET_PATH environment variable, read once
+///
 RYME_API
-List<Path> GetAssetPathList();
+const List<Path>& GetAssetPathList();
 
 } // namespace ryme
 
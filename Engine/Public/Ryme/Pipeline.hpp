@@ -3,12 +3,90 @@
 
 #include <Ryme/Config.hpp>
 #include <Ryme/Asset.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/PipelineCache.hpp>
 #include <Ryme/Shader.hpp>
+#include <Ryme/Span.hpp>
 
 #include <Ryme/ThirdParty/vulkan.hpp>
 
+#include <cstring>
+#include <unordered_map>
+
 namespace ryme {
 
+///
+/// Values for the specialization constants of a Shader, by their constant_id
+///
+/// Equal sets of values compare equal no matter what order they were set in, so they can be used to
+/// find the pipeline already created for them.
+///
+class RYME_API SpecializationValues
+{
+public:
+
+    SpecializationValues() = default;
+
+    inline void Set(uint32_t constantID, bool value) {
+        SetBits(constantID, (value ? VK_TRUE : VK_FALSE));
+    }
+
+    inline void Set(uint32_t constantID, int32_t value) {
+        SetBits(constantID, static_cast<uint32_t>(value));
+    }
+
+    inline void Set(uint32_t constantID, uint32_t value) {
+        SetBits(constantID, value);
+    }
+
+    inline void Set(uint32_t constantID, float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        SetBits(constantID, bits);
+    }
+
+    ///
+    /// Set the value of a constant to these 32 bits, replacing the value it had before
+    ///
+    void SetBits(uint32_t constantID, uint32_t bits);
+
+    void Clear();
+
+    inline bool IsEmpty() const {
+        return _constantIDList.empty();
+    }
+
+    inline Span<const uint32_t> GetConstantIDList() const {
+        return { _constantIDList.begin(), _constantIDList.end() };
+    }
+
+    inline Span<const uint32_t> GetValueList() const {
+        return { _valueList.begin(), _valueList.end() };
+    }
+
+    uint64_t GetHash() const;
+
+    inline bool operator==(const SpecializationValues& rhs) const {
+        return (_constantIDList == rhs._constantIDList and _valueList == rhs._valueList);
+    }
+
+private:
+
+    // Sorted, with the value of each at the same index in _valueList
+    List<uint32_t> _constantIDList;
+
+    List<uint32_t> _valueList;
+
+}; // class SpecializationValues
+
+struct SpecializationValuesHash
+{
+    inline size_t operator()(const SpecializationValues& values) const {
+        return static_cast<size_t>(values.GetHash());
+    }
+
+}; // struct SpecializationValuesHash
+
 class RYME_API Pipeline : public Asset
 {
 public:
@@ -19,6 +97,13 @@ public:
 
     void Create();
 
+    ///
+    /// Set the render pass to create the pipeline against, defaults to Graphics::RenderPass
+    ///
+    inline void SetRenderPass(vk::RenderPass renderPass) {
+        _renderPass = renderPass;
+    }
+
     void Free() override;
 
     bool Reload() override;
@@ -27,14 +112,32 @@ public:
         return true;
     }
 
+    ///
+    /// @return The pipeline with the default values for every specialization constant
+    ///
     inline vk::Pipeline GetVkPipeline() {
         return _pipeline;
     }
+
+    ///
+    /// Get the pipeline with these values for the specialization constants of the shader, creating it
+    /// the first time each set of values is used. Constants that aren't set keep their default value.
+    ///
+    vk::Pipeline GetVkPipeline(const SpecializationValues& values);
+
+    ///
+    /// @return The number of pipelines created for sets of specialization values
+    ///
+    inline size_t GetSpecializedPipelineCount() const {
+        return _specializedPipelineMap.size();
+    }
     
     // TODO: Add getters/setters
 
 private:
 
+    PipelineCache::PipelineRef createPipeline(const SpecializationValues * values);
+
     Shader * _shader = nullptr;
 
     vk::PipelineInputAssemblyStateCreateInfo _inputAssemblyStateCreateInfo;
@@ -51,10 +154,16 @@ private:
 
     vk::PipelineLayout _pipelineLayout;
 
+    vk::RenderPass _renderPass;
+
     bool _needReload = false;
 
+    PipelineCache::PipelineRef _pipelineRef;
+
     vk::Pipeline _pipeline;
 
+    std::unordered_map<SpecializationValues, PipelineCache::PipelineRef, SpecializationValuesHash> _specializedPipelineMap;
+
 }; // class Pipeline
 
 } // namespace ryme
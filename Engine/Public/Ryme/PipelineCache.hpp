@@ -0,0 +1,101 @@
+#ifndef RYME_PIPELINE_CACHE_HPP
+#define RYME_PIPELINE_CACHE_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Span.hpp>
+
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+#include <memory>
+
+namespace ryme {
+
+///
+/// Shared Shader Modules, Layouts and Pipelines
+///
+/// Materials are mostly permutations of a few shaders, so the same modules, layouts and pipeline
+/// states are requested over and over. Every request equal to one that is still alive shares the
+/// same Vulkan object, which is destroyed once the last reference is dropped and the GPU is done
+/// with it, the same as SamplerCache.
+///
+/// Requests are compared by the handles of the objects they refer to. Objects that are not created by
+/// the cache must be passed to EraseDependents() when they are destroyed, so a new object given the
+/// same handle is never matched with what was created with the old one.
+///
+namespace PipelineCache {
+
+using ShaderModuleRef = std::shared_ptr<const vk::ShaderModule>;
+
+using DescriptorSetLayoutRef = std::shared_ptr<const vk::DescriptorSetLayout>;
+
+using PipelineLayoutRef = std::shared_ptr<const vk::PipelineLayout>;
+
+using PipelineRef = std::shared_ptr<const vk::Pipeline>;
+
+struct Stats
+{
+    size_t ShaderModuleCount;
+
+    size_t DescriptorSetLayoutCount;
+
+    size_t PipelineLayoutCount;
+
+    size_t PipelineCount;
+
+    // The number of requests that were given an object that already existed
+    size_t HitCount;
+
+    // The number of requests that had to create a new object
+    size_t MissCount;
+
+}; // struct Stats
+
+///
+/// @param contentHash Hash64() of the code
+///
+RYME_API
+ShaderModuleRef GetShaderModule(Span<const uint32_t> code, uint64_t contentHash);
+
+///
+/// Bindings are compared in order, along with the handles of any immutable samplers
+///
+RYME_API
+DescriptorSetLayoutRef GetDescriptorSetLayout(Span<const vk::DescriptorSetLayoutBinding> bindingList);
+
+///
+/// The pipeline layout keeps the descriptor set layouts it was created with alive
+///
+RYME_API
+PipelineLayoutRef GetPipelineLayout(
+    Span<const DescriptorSetLayoutRef> descriptorSetLayoutList,
+    Span<const vk::PushConstantRange> pushConstantRangeList
+);
+
+///
+/// @return A pipeline shared with every other request for equal state, requests with a pNext chain
+///   on any part of the state can't be compared and get a pipeline of their own
+///
+RYME_API
+PipelineRef GetGraphicsPipeline(const vk::GraphicsPipelineCreateInfo& graphicsPipelineCreateInfo);
+
+///
+/// Stop sharing anything created with the render pass, before it is destroyed
+///
+RYME_API
+void EraseDependents(vk::RenderPass renderPass);
+
+///
+/// Stop sharing any descriptor set layout created with the sampler as an immutable sampler, before it
+/// is destroyed
+///
+RYME_API
+void EraseDependents(vk::Sampler sampler);
+
+RYME_API
+Stats GetStats();
+
+} // namespace PipelineCache
+
+} // namespace ryme
+
+#endif // RYME_PIPELINE_CACHE_HPP
\ No newline at end of file
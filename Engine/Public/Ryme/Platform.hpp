@@ -67,6 +67,20 @@
 
 #endif
 
+#if defined(__x86_64__) or defined(_M_X64)
+
+    // x86-64, SSE2 is part of the base instruction set
+    #define RYME_ARCH_X86_64
+    #define RYME_SIMD_SSE2
+
+#elif defined(__aarch64__) or defined(_M_ARM64)
+
+    // ARM64, NEON is part of the base instruction set
+    #define RYME_ARCH_ARM64
+    #define RYME_SIMD_NEON
+
+#endif
+
 #if defined(NDEBUG)
 
     #define RYME_BUILD_RELEASE
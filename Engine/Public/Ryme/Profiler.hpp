@@ -0,0 +1,192 @@
+#ifndef RYME_PROFILER_HPP
+#define RYME_PROFILER_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/String.hpp>
+
+#include <Ryme/ThirdParty/python.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace ryme {
+
+///
+/// Scoped-zone CPU Profiler
+///
+/// Each thread records completed zones into its own fixed-size ring buffer, so recording
+/// never locks, and only allocates on the first zone of a thread. When the buffer is full
+/// the oldest zones are overwritten. The recorded zones can be aggregated, or exported in
+/// the Chrome Trace Event format for chrome://tracing or https://ui.perfetto.dev
+///
+namespace Profiler {
+
+struct RYME_API ZoneStats
+{
+    String Name;
+
+    uint64_t Count;
+
+    double TotalMilliseconds;
+
+    double MinMilliseconds;
+
+    double MaxMilliseconds;
+
+}; // struct ZoneStats
+
+extern RYME_API std::atomic_bool _enabled;
+
+///
+/// @return A monotonic timestamp in nanoseconds
+///
+inline uint64_t GetTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+inline bool IsEnabled()
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+RYME_API
+void SetEnabled(bool enabled);
+
+///
+/// Set the name of the calling thread's track in exported traces
+///
+RYME_API
+void SetThreadName(StringView name);
+
+///
+/// Record a completed zone on the calling thread's track
+///
+/// @param name A string with static storage duration, such as a literal or RYME_FUNCTION_NAME
+/// @param start The timestamp the zone began, from GetTimestamp()
+/// @param end The timestamp the zone ended, from GetTimestamp()
+///
+RYME_API
+void RecordZone(const char * name, uint64_t start, uint64_t end);
+
+///
+/// Mark the end of a frame, recording a "Frame" zone since the previous mark
+///
+RYME_API
+void MarkFrame();
+
+RYME_API
+uint64_t GetFrameCount();
+
+///
+/// Discard all recorded zones on every thread, threads can keep recording meanwhile
+///
+RYME_API
+void Clear();
+
+///
+/// Aggregate all recorded zones by name, sorted by total time descending
+///
+RYME_API
+List<ZoneStats> GetZoneStatsList();
+
+///
+/// Write all recorded zones to a Chrome Trace Event JSON file
+///
+RYME_API
+bool WriteChromeTrace(const Path& path);
+
+RYME_API
+void ScriptInit(py::module);
+
+} // namespace Profiler
+
+///
+/// Records the time between construction and End() or destruction
+///
+/// When the profiler is disabled at runtime, this costs a single relaxed atomic load
+///
+class RYME_API ProfileZone
+{
+public:
+
+    RYME_DISALLOW_COPY_AND_ASSIGN(ProfileZone)
+
+    ///
+    /// @param name A string with static storage duration, such as a literal or RYME_FUNCTION_NAME
+    /// @param alwaysTime Measure the duration even when the profiler is disabled
+    ///
+    inline explicit ProfileZone(const char * name, bool alwaysTime = false)
+        : _name(name)
+        , _isRecording(Profiler::IsEnabled())
+    {
+        if (_isRecording or alwaysTime) {
+            _isOpen = true;
+            _start = Profiler::GetTimestamp();
+        }
+    }
+
+    inline ~ProfileZone()
+    {
+        End();
+    }
+
+    ///
+    /// Close the zone early
+    ///
+    /// @return The duration of the zone in milliseconds, or 0 if it was not timed
+    ///
+    inline double End()
+    {
+        if (_isOpen) {
+            _isOpen = false;
+
+            uint64_t end = Profiler::GetTimestamp();
+            if (_isRecording) {
+                Profiler::RecordZone(_name, _start, end);
+            }
+
+            _milliseconds = static_cast<double>(end - _start) / 1.0e6;
+        }
+
+        return _milliseconds;
+    }
+
+private:
+
+    const char * _name;
+
+    bool _isRecording;
+
+    bool _isOpen = false;
+
+    uint64_t _start = 0;
+
+    double _milliseconds = 0.0;
+
+}; // class ProfileZone
+
+#if defined(RYME_ENABLE_PROFILER)
+
+    #define RYME_PROFILE_ZONE(NAME) \
+        ryme::ProfileZone RYME_CONCAT(rymeProfileZone, __LINE__)(NAME)
+
+    #define RYME_PROFILE_FUNCTION() \
+        RYME_PROFILE_ZONE(RYME_FUNCTION_NAME)
+
+#else
+
+    #define RYME_PROFILE_ZONE(NAME)
+
+    #define RYME_PROFILE_FUNCTION()
+
+#endif
+
+} // namespace ryme
+
+#endif // RYME_PROFILER_HPP
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef RYME_RAY_HPP
+#define RYME_RAY_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Math.hpp>
+
+#include <limits>
+
+namespace ryme {
+
+class ModelComponent;
+
+struct RYME_API Ray
+{
+    Vec3 Origin = Vec3(0.0f);
+
+    // Does not need to be normalized, distances are in multiples of it
+    Vec3 Direction = Vec3(0.0f, 0.0f, -1.0f);
+
+    float MaxDistance = std::numeric_limits<float>::infinity();
+
+    inline Vec3 GetPoint(float distance) const {
+        return Origin + Direction * distance;
+    }
+
+}; // struct Ray
+
+///
+/// The closest triangle hit by a Ray, filled in as it is tested against a TriangleBVH, then a Model,
+/// then a scene
+///
+struct RYME_API RayHit
+{
+    // Along the ray, only triangles closer than this are hit
+    float Distance = std::numeric_limits<float>::infinity();
+
+    // The weights of the second and third vertices of the triangle at the hit
+    Vec2 Barycentric = Vec2(0.0f);
+
+    uint32_t Triangle = UINT32_MAX;
+
+    // The index of the Mesh in its Model
+    uint32_t Mesh = UINT32_MAX;
+
+    ModelComponent * Component = nullptr;
+
+    inline bool IsHit() const {
+        return (Triangle != UINT32_MAX);
+    }
+
+}; // struct RayHit
+
+} // namespace ryme
+
+#endif // RYME_RAY_HPP
\ No newline at end of file
@@ -0,0 +1,293 @@
+#ifndef RYME_RENDER_GRAPH_HPP
+#define RYME_RENDER_GRAPH_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Math.hpp>
+#include <Ryme/NonCopyable.hpp>
+#include <Ryme/String.hpp>
+
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace ryme {
+
+///
+/// Index of an image owned or imported by a RenderGraph
+///
+using RenderGraphImage = uint32_t;
+
+struct RYME_API RenderGraphImageInfo
+{
+    vk::Format Format = vk::Format::eUndefined;
+
+    // A width or height of 0 uses the backbuffer extent multiplied by Scale
+    vk::Extent2D Extent = { 0, 0 };
+
+    float Scale = 1.0f;
+
+}; // struct RenderGraphImageInfo
+
+class RYME_API RenderGraphPass : NonCopyable
+{
+public:
+
+    RenderGraphPass(StringView name)
+        : _name(name)
+    { }
+
+    virtual ~RenderGraphPass() = default;
+
+    inline const String& GetName() const {
+        return _name;
+    }
+
+    ///
+    /// Render to the image as the next color attachment
+    ///
+    /// @param clearColor Clear the image when the pass begins, otherwise its contents are preserved
+    ///
+    void AddColorAttachment(RenderGraphImage image, std::optional<Vec4> clearColor = std::nullopt);
+
+    ///
+    /// Render to the image as the depth attachment
+    ///
+    /// @param clearDepth Clear the image when the pass begins, otherwise its contents are preserved
+    ///
+    void SetDepthAttachment(RenderGraphImage image, std::optional<float> clearDepth = std::nullopt);
+
+    ///
+    /// Depth test against the image without writing to it, such as after a depth prepass
+    ///
+    void SetDepthInput(RenderGraphImage image);
+
+    ///
+    /// Sample the image from a shader, such as a shadow map or a post-processing source
+    ///
+    void AddSampledImage(
+        RenderGraphImage image,
+        vk::PipelineStageFlags stageMask = vk::PipelineStageFlagBits::eFragmentShader
+    );
+
+    ///
+    /// Called while recording, inside the render pass if the pass has any attachments
+    ///
+    inline void SetExecuteFunc(std::function<void(vk::CommandBuffer)> func) {
+        _executeFunc = func;
+    }
+
+    ///
+    /// Passes whose outputs never reach the backbuffer are culled, unless they are not cullable
+    ///
+    inline void SetCullable(bool cullable) {
+        _isCullable = cullable;
+    }
+
+    inline bool IsCulled() const {
+        return _isCulled;
+    }
+
+    ///
+    /// @return The render pass to create pipelines against, valid after RenderGraph::Compile()
+    ///
+    inline vk::RenderPass GetVkRenderPass() const {
+        return _renderPass;
+    }
+
+    inline vk::Extent2D GetExtent() const {
+        return _extent;
+    }
+
+private:
+
+    friend class RenderGraph;
+
+    enum class AccessType
+    {
+        ColorAttachment,
+        DepthAttachment,
+        DepthInput,
+        Sampled,
+
+    }; // enum class AccessType
+
+    struct Access
+    {
+        RenderGraphImage Image;
+
+        AccessType Type;
+
+        std::optional<vk::ClearValue> ClearValue;
+
+        vk::PipelineStageFlags StageMask;
+
+    }; // struct Access
+
+    struct Barrier
+    {
+        RenderGraphImage Image;
+
+        vk::ImageLayout OldLayout;
+
+        vk::ImageLayout NewLayout;
+
+        vk::AccessFlags SrcAccessMask;
+
+        vk::AccessFlags DstAccessMask;
+
+    }; // struct Barrier
+
+    String _name;
+
+    List<Access> _accessList;
+
+    std::function<void(vk::CommandBuffer)> _executeFunc;
+
+    bool _isCullable = true;
+
+    bool _isCulled = false;
+
+    // Compiled
+
+    List<Barrier> _barrierList;
+
+    vk::PipelineStageFlags _srcStageMask;
+
+    vk::PipelineStageFlags _dstStageMask;
+
+    vk::RenderPass _renderPass;
+
+    // One per backbuffer image if the pass renders to the backbuffer, otherwise just one
+    List<vk::Framebuffer> _framebufferList;
+
+    List<vk::ClearValue> _clearValueList;
+
+    vk::Extent2D _extent;
+
+}; // class RenderGraphPass
+
+///
+/// Declarative frame graph
+///
+/// Passes declare which images they read and write, and Compile() works out the rest:
+///  - Passes that do not contribute to the backbuffer are culled
+///  - Layout transitions and barriers are placed between passes
+///  - Load and store ops are chosen from how each image is used before and after the pass
+///  - Transient images that are never alive at the same time share memory
+///  - Images that only live within a single pass use lazily allocated memory where supported
+///
+/// Passes execute in the order they were added.
+///
+class RYME_API RenderGraph : NonCopyable
+{
+public:
+
+    static constexpr RenderGraphImage Backbuffer = 0;
+
+    RenderGraph();
+
+    virtual ~RenderGraph();
+
+    ///
+    /// Set the swapchain images that RenderGraph::Backbuffer refers to
+    ///
+    void SetBackbuffer(
+        vk::Format format,
+        vk::Extent2D extent,
+        const List<vk::Image>& imageList,
+        const List<vk::ImageView>& imageViewList
+    );
+
+    ///
+    /// Declare a transient image, which is only created if a pass that is not culled uses it
+    ///
+    RenderGraphImage CreateImage(StringView name, const RenderGraphImageInfo& info);
+
+    ///
+    /// @return A reference that is valid until Reset() is called
+    ///
+    RenderGraphPass& AddPass(StringView name);
+
+    RenderGraphPass * FindPass(StringView name);
+
+    ///
+    /// Cull passes, compute barriers, and create the images, memory, render passes and framebuffers
+    ///
+    void Compile();
+
+    ///
+    /// Record every pass that was not culled
+    ///
+    /// @param backbufferIndex The index of the swapchain image being rendered to
+    ///
+    void Execute(vk::CommandBuffer commandBuffer, uint32_t backbufferIndex);
+
+    ///
+    /// Remove all passes and images, their Vulkan objects are destroyed once the GPU is done with them
+    ///
+    void Reset();
+
+private:
+
+    struct Image
+    {
+        String Name;
+
+        RenderGraphImageInfo Info;
+
+        vk::Extent2D Extent;
+
+        vk::ImageUsageFlags Usage;
+
+        // Index of the first and last pass that uses this image, or -1 if it is unused
+        int FirstPass = -1;
+
+        int LastPass = -1;
+
+        bool IsLazilyAllocated = false;
+
+        vk::Image VkImage;
+
+        vk::ImageView VkImageView;
+
+        // Only set for lazily allocated images, aliased images are bound to a shared allocation
+        VmaAllocation Allocation = nullptr;
+
+    }; // struct Image
+
+    void free();
+
+    void cullPasses();
+
+    void createImages();
+
+    void compilePasses();
+
+    vk::Image getVkImage(RenderGraphImage image, uint32_t backbufferIndex);
+
+    vk::ImageView getVkImageView(RenderGraphImage image, uint32_t backbufferIndex);
+
+    List<Image> _imageList;
+
+    List<std::unique_ptr<RenderGraphPass>> _passList;
+
+    // Memory shared by aliased images
+    List<VmaAllocation> _allocationList;
+
+    List<vk::Image> _backbufferImageList;
+
+    List<vk::ImageView> _backbufferImageViewList;
+
+    // Transitions the backbuffer to be presented after the last pass
+    RenderGraphPass::Barrier _presentBarrier;
+
+    vk::PipelineStageFlags _presentSrcStageMask;
+
+}; // class RenderGraph
+
+} // namespace ryme
+
+#endif // RYME_RENDER_GRAPH_HPP
\ No newline at end of file
@@ -2,8 +2,11 @@
 #define RYME_RENDER_SYSTEM_HPP
 
 #include <Ryme/Config.hpp>
+#include <Ryme/Camera.hpp>
 #include <Ryme/System.hpp>
 #include <Ryme/ModelComponent.hpp>
+#include <Ryme/OcclusionBuffer.hpp>
+#include <Ryme/Span.hpp>
 
 namespace ryme {
 
@@ -11,6 +14,35 @@ class RYME_API RenderSystem : public System
 {
 public:
 
+    struct LODStats
+    {
+        size_t InstanceCount = 0;
+
+        // Triangles in the selected LODs
+        size_t TriangleCount = 0;
+
+        // Triangles if every instance was drawn at full detail
+        size_t FullTriangleCount = 0;
+
+        // Instances that changed LOD
+        size_t SwitchCount = 0;
+
+    }; // struct LODStats
+
+    struct OcclusionStats
+    {
+        size_t OccluderCount = 0;
+
+        size_t OccluderTriangleCount = 0;
+
+        // Models that were tested against the OcclusionBuffer
+        size_t TestedCount = 0;
+
+        // Models hidden behind the occluders, or outside of the view
+        size_t OccludedCount = 0;
+
+    }; // struct OcclusionStats
+
     RenderSystem() = default;
 
     virtual ~RenderSystem() = default;
@@ -19,10 +51,95 @@ public:
 
     void RemoveModelComponent(ModelComponent * modelComponent);
 
+    ///
+    /// Choose the LOD of every ModelComponent from how large its errors appear on the screen
+    ///
+    /// Call this every frame before Graphics::Render(). The command buffers are invalidated whenever
+    /// an LOD changes, so they are recorded again with the new LODs.
+    ///
+    /// @param viewportHeight The height of the viewport in pixels
+    ///
+    void SelectLODs(const Camera& camera, float viewportHeight);
+
+    ///
+    /// Choose the least detailed LOD whose error appears smaller than threshold
+    ///
+    /// To keep instances near a threshold from switching back and forth every frame, a less
+    /// detailed LOD is only chosen once its error is smaller than threshold * (1 - hysteresis).
+    ///
+    /// @param lodErrorList The error of each LOD, starting at full detail
+    /// @param pixelsPerUnit The size on the screen of one unit at the distance of the instance
+    /// @param currentLOD The LOD chosen last time
+    /// @param threshold The largest error allowed, in pixels
+    /// @param hysteresis The fraction of threshold to move past before choosing a less detailed LOD
+    ///
+    static uint32_t SelectLOD(
+        Span<const float> lodErrorList,
+        float pixelsPerUnit,
+        uint32_t currentLOD,
+        float threshold,
+        float hysteresis
+    );
+
+    ///
+    /// Draw the occluders into the OcclusionBuffer, then test the bounds of every ModelComponent
+    /// against it, and mark the ones that are hidden as not visible
+    ///
+    /// Call this every frame before Graphics::Render(). The command buffers are invalidated whenever
+    /// a model becomes visible or hidden, so they are recorded again without the hidden models.
+    ///
+    /// @param threadPool The pool to draw the occluders on, or nullptr to draw on this thread
+    ///
+    void CullOccluded(const Camera& camera, ThreadPool * threadPool = nullptr);
+
+    inline OcclusionBuffer& GetOcclusionBuffer() {
+        return _occlusionBuffer;
+    }
+
+    ///
+    /// @return The results of the last call to CullOccluded()
+    ///
+    inline const OcclusionStats& GetOcclusionStats() const {
+        return _occlusionStats;
+    }
+
+    inline void SetLODThreshold(float pixels) {
+        _lodThreshold = pixels;
+    }
+
+    inline float GetLODThreshold() const {
+        return _lodThreshold;
+    }
+
+    inline void SetLODHysteresis(float hysteresis) {
+        _lodHysteresis = hysteresis;
+    }
+
+    inline float GetLODHysteresis() const {
+        return _lodHysteresis;
+    }
+
+    ///
+    /// @return The LODs chosen by the last call to SelectLODs()
+    ///
+    inline const LODStats& GetLODStats() const {
+        return _lodStats;
+    }
+
 private:
 
     List<ModelComponent *> _modelComponentList;
 
+    float _lodThreshold = 1.0f;
+
+    float _lodHysteresis = 0.25f;
+
+    LODStats _lodStats;
+
+    OcclusionBuffer _occlusionBuffer;
+
+    OcclusionStats _occlusionStats;
+
 }; // class RenderSystem
 
 } // namespace ryme
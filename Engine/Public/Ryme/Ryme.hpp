@@ -3,15 +3,23 @@
 
 // TODO
 #include <Ryme/Config.hpp>
+#include <Ryme/AssetManager.hpp>
+#include <Ryme/AsyncIO.hpp>
 #include <Ryme/Color.hpp>
+#include <Ryme/Defragmenter.hpp>
 #include <Ryme/Exception.hpp>
 #include <Ryme/Graphics.hpp>
 #include <Ryme/InitInfo.hpp>
 #include <Ryme/Log.hpp>
 #include <Ryme/Math.hpp>
 #include <Ryme/Path.hpp>
+#include <Ryme/Profiler.hpp>
+#include <Ryme/RenderGraph.hpp>
 #include <Ryme/Script.hpp>
 #include <Ryme/String.hpp>
+#include <Ryme/TextureLoader.hpp>
+#include <Ryme/TextureStreamer.hpp>
+#include <Ryme/ThreadPool.hpp>
 #include <Ryme/Transform.hpp>
 #include <Ryme/UTF.hpp>
 #include <Ryme/Version.hpp>
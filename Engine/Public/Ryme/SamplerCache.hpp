@@ -0,0 +1,50 @@
+#ifndef RYME_SAMPLER_CACHE_HPP
+#define RYME_SAMPLER_CACHE_HPP
+
+#include <Ryme/Config.hpp>
+
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+#include <array>
+#include <memory>
+
+namespace ryme {
+
+///
+/// Shared Samplers
+///
+/// There are usually only a handful of distinct sampler states, so rather than creating one sampler
+/// per texture, every request with an equal vk::SamplerCreateInfo shares the same sampler. It is
+/// destroyed once the last reference is dropped and the GPU is done with it.
+///
+namespace SamplerCache {
+
+using SamplerRef = std::shared_ptr<const vk::Sampler>;
+
+///
+/// The sampler state of a vk::SamplerCreateInfo, field by field, as padding and pNext are not part
+/// of it, for comparing and hashing sampler states
+///
+using SamplerKey = std::array<uint32_t, 16>;
+
+RYME_API
+SamplerKey GetKey(const vk::SamplerCreateInfo& samplerCreateInfo);
+
+///
+/// @return A sampler shared with every other request for an equal samplerCreateInfo, requests with
+///   a pNext chain can't be compared and get a sampler of their own
+///
+RYME_API
+SamplerRef Get(const vk::SamplerCreateInfo& samplerCreateInfo);
+
+///
+/// @return The number of distinct samplers currently alive
+///
+RYME_API
+size_t GetCount();
+
+} // namespace SamplerCache
+
+} // namespace ryme
+
+#endif // RYME_SAMPLER_CACHE_HPP
\ No newline at end of file
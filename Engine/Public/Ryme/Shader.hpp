@@ -4,12 +4,45 @@
 #include <Ryme/Config.hpp>
 #include <Ryme/Asset.hpp>
 #include <Ryme/List.hpp>
+#include <Ryme/Map.hpp>
 #include <Ryme/Path.hpp>
+#include <Ryme/PipelineCache.hpp>
+#include <Ryme/SamplerCache.hpp>
+#include <Ryme/Span.hpp>
+#include <Ryme/String.hpp>
 
 #include <Ryme/ThirdParty/vulkan.hpp>
 
 namespace ryme {
 
+enum class SpecializationConstantType : uint32_t
+{
+    Bool,
+    Int,
+    UInt,
+    Float,
+
+}; // enum class SpecializationConstantType
+
+///
+/// A constant declared with layout(constant_id = N) in a shader, which can be given a different value
+/// for each pipeline
+///
+struct RYME_API SpecializationConstant
+{
+    uint32_t ConstantID;
+
+    SpecializationConstantType Type;
+
+    // The bits of the value from the shader, used when a pipeline doesn't set one
+    uint32_t DefaultValue;
+
+    vk::ShaderStageFlags StageFlags;
+
+    String Name;
+
+}; // struct SpecializationConstant
+
 class RYME_API Shader : public Asset
 {
 public:
@@ -22,6 +55,12 @@ public:
 
     bool LoadFromFiles(const List<Path>& pathList, bool search = true);
 
+    ///
+    /// Bake a sampler into the descriptor set layout for the sampled image with this name, so it
+    /// never has to be written into descriptor sets. Takes effect the next time the shader is loaded.
+    ///
+    void SetImmutableSampler(const String& name, vk::SamplerCreateInfo samplerCreateInfo);
+
     void Free() override;
 
     bool Reload() override;
@@ -38,13 +77,76 @@ public:
         return _pipelineLayout;
     }
 
+    inline const List<vk::DescriptorSetLayout>& GetDescriptorSetLayoutList() const {
+        return _descriptorSetLayoutList;
+    }
+
+    ///
+    /// @return The specialization constants of every stage, sorted by ConstantID
+    ///
+    inline const List<SpecializationConstant>& GetSpecializationConstantList() const {
+        return _specializationConstantList;
+    }
+
+    ///
+    /// @return The specialization constant with this name in any stage, or nullptr if there is none
+    ///
+    const SpecializationConstant * FindSpecializationConstant(StringView name) const;
+
+    ///
+    /// Reflect a SPIR-V module ahead of time and write the cache that is otherwise written the first
+    /// time it is loaded, used by RymeCook
+    ///
+    /// @param path The file the data was read from, to report errors
+    /// @param cachePath Where to write the cache, which is loaded from path + ".reflect"
+    ///
+    static bool CookReflectionCache(Span<const uint8_t> data, const Path& path, const Path& cachePath);
+
 private:
 
+    // Everything needed from a SPIR-V module to build its layouts, which is slow to find with
+    // spirv_cross and so is cached in a file next to it
+    struct Reflection
+    {
+        struct Resource
+        {
+            uint32_t Set;
+
+            uint32_t Binding;
+
+            vk::DescriptorType DescriptorType;
+
+            String Name;
+
+        }; // struct Resource
+
+        vk::ShaderStageFlagBits Stage;
+
+        String EntryPointName;
+
+        List<Resource> ResourceList;
+
+        // 0 if there are no push constants
+        uint32_t PushConstantSize = 0;
+
+        List<SpecializationConstant> SpecializationConstantList;
+
+    }; // struct Reflection
+
     bool LoadSPV(const Path& path, bool search);
 
+    static Reflection Reflect(Span<const uint32_t> code);
+
+    ///
+    /// @return False if there is no cache, or it was written for different contents or by a different version
+    ///
+    static bool ReadReflectionCache(const Path& path, uint64_t contentHash, Reflection& reflection);
+
+    static bool WriteReflectionCache(const Path& path, uint64_t contentHash, const Reflection& reflection);
+
     List<Path> _pathList;
 
-    List<vk::ShaderModule> _shaderModuleList;
+    List<PipelineCache::ShaderModuleRef> _shaderModuleList;
 
     List<char *> _entryPointNameList;
 
@@ -54,8 +156,20 @@ private:
 
     List<vk::PushConstantRange> _pushConstantRangeList;
 
+    List<SpecializationConstant> _specializationConstantList;
+
+    // Baked into the current layouts
+    Map<String, SamplerCache::SamplerRef> _immutableSamplerMap;
+
+    // Set by SetImmutableSampler(), and baked into the layouts the next time the shader is loaded
+    Map<String, SamplerCache::SamplerRef> _pendingImmutableSamplerMap;
+
+    List<PipelineCache::DescriptorSetLayoutRef> _descriptorSetLayoutRefList;
+
     List<vk::DescriptorSetLayout> _descriptorSetLayoutList;
 
+    PipelineCache::PipelineLayoutRef _pipelineLayoutRef;
+
     vk::PipelineLayout _pipelineLayout;
 
 }; // class Shader
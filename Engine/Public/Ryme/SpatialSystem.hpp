@@ -0,0 +1,108 @@
+#ifndef RYME_SPATIAL_SYSTEM_HPP
+#define RYME_SPATIAL_SYSTEM_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/AABBTree.hpp>
+#include <Ryme/Frustum.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Map.hpp>
+#include <Ryme/ModelComponent.hpp>
+#include <Ryme/Ray.hpp>
+#include <Ryme/Span.hpp>
+#include <Ryme/System.hpp>
+#include <Ryme/ThreadPool.hpp>
+
+#include <Ryme/ThirdParty/python.hpp>
+
+namespace ryme {
+
+///
+/// Keeps the world bounds of every ModelComponent in an AABBTree, to find the ones in a region
+/// without going through every Entity
+///
+class RYME_API SpatialSystem : public System
+{
+public:
+
+    struct BoundsHit
+    {
+        ModelComponent * Component;
+
+        // Along the ray, to where it enters the bounds of the model
+        float Distance;
+
+    }; // struct BoundsHit
+
+    SpatialSystem() = default;
+
+    virtual ~SpatialSystem() = default;
+
+    void AddModelComponent(ModelComponent * modelComponent);
+
+    void RemoveModelComponent(ModelComponent * modelComponent);
+
+    ///
+    /// Move every model to the world bounds of its Entity, and add the ones that finished loading
+    ///
+    /// Transforms don't report when they change, so this needs to be called once per frame before
+    /// any queries.
+    ///
+    void Update();
+
+    void QueryFrustum(const Frustum& frustum, List<ModelComponent *>& modelComponentList) const;
+
+    void QueryBox(const Vec3& min, const Vec3& max, List<ModelComponent *>& modelComponentList) const;
+
+    void QuerySphere(const Vec3& center, float radius, List<ModelComponent *>& modelComponentList) const;
+
+    ///
+    /// Append the models whose bounds are hit by a ray, sorted from the closest to the farthest
+    ///
+    void QueryRay(const Vec3& origin, const Vec3& direction, float maxDistance, List<BoundsHit>& hitList) const;
+
+    ///
+    /// Find the closest triangle of any model hit by a ray in world space, only testing the
+    /// triangles of the models whose bounds are hit, from the closest to the farthest
+    ///
+    /// @return True if a triangle closer than hit.Distance was hit, and hit was filled in
+    ///
+    bool Raycast(const Ray& ray, RayHit& hit) const;
+
+    ///
+    /// Stop at the first triangle of any model hit by a ray in world space, for line of sight
+    ///
+    bool RaycastAny(const Ray& ray) const;
+
+    ///
+    /// Find the closest hit of every ray, split across threadPool when there is one
+    ///
+    /// @param hitList Must be as long as rayList, each hit is reset before the ray is tested
+    ///
+    void RaycastList(Span<const Ray> rayList, Span<RayHit> hitList, ThreadPool * threadPool = nullptr) const;
+
+    inline AABBTree& GetTree() {
+        return _tree;
+    }
+
+    inline const AABBTree& GetTree() const {
+        return _tree;
+    }
+
+private:
+
+    void getProxyComponentList(const List<uint32_t>& proxyList, List<ModelComponent *>& modelComponentList) const;
+
+    AABBTree _tree;
+
+    // NullNode until the model has loaded, and its bounds are known
+    Map<ModelComponent *, uint32_t> _proxyMap;
+
+public:
+
+    static void ScriptInit(py::module);
+
+}; // class SpatialSystem
+
+} // namespace ryme
+
+#endif // RYME_SPATIAL_SYSTEM_HPP
\ No newline at end of file
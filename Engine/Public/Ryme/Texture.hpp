@@ -3,8 +3,11 @@
 
 #include <Ryme/Config.hpp>
 #include <Ryme/Asset.hpp>
+#include <Ryme/ImageData.hpp>
 #include <Ryme/Path.hpp>
+#include <Ryme/SamplerCache.hpp>
 
+#include <Ryme/ThirdParty/python.hpp>
 #include <Ryme/ThirdParty/vulkan.hpp>
 
 namespace ryme {
@@ -13,12 +16,79 @@ class RYME_API Texture : public Asset
 {
 public:
 
+    ///
+    /// Create an empty texture, to be loaded later or by TextureLoader
+    ///
+    Texture();
+
     Texture(const Path& path, vk::SamplerCreateInfo samplerCreateInfo = {}, bool search = true);
 
     virtual ~Texture();
 
+    ///
+    /// Load a KTX2, DDS, or any image supported by stb_image
+    ///
     bool LoadFromFile(const Path& path, vk::SamplerCreateInfo samplerCreateInfo = {}, bool search = true);
 
+    ///
+    /// Upload an image, decompressing it first if the device cannot sample its format
+    ///
+    /// Images with a single level of RGBA8 get a full mip chain generated, anything else is uploaded
+    /// with the levels it already has.
+    ///
+    bool LoadFromImageData(ImageData& imageData, vk::SamplerCreateInfo samplerCreateInfo = {});
+
+    ///
+    /// The steps of LoadFromImageData(), for loaders that upload several textures at once
+    ///
+
+    ///
+    /// Do the CPU work needed before uploading, safe to call from any thread
+    ///
+    /// Formats the device cannot sample are decompressed, and mips are generated here if the device
+    /// cannot blit them.
+    ///
+    /// @return The number of levels the texture will have, levels missing from imageData are blitted
+    ///   by Graphics::UploadTexture()
+    ///
+    static uint32_t PrepareImageData(ImageData& imageData);
+
+    ///
+    /// Create the image and view, and get a shared sampler, the contents are undefined until they are uploaded
+    ///
+    void CreateImage(const ImageData& imageData, uint32_t mipLevels, vk::SamplerCreateInfo samplerCreateInfo = {});
+
+    struct Upload
+    {
+        // A texture whose image has been created with CreateImage()
+        Texture * Target;
+
+        // The levels to copy, starting at level 0 of the image, with offsets relative to Data
+        List<MipLevel> MipLevelList;
+
+        Span<const uint8_t> Data;
+
+    }; // struct Upload
+
+    ///
+    /// Pack the levels of several textures into one staging buffer and submit their uploads without
+    /// waiting, the staging buffer is destroyed once the GPU is done with it
+    ///
+    /// @return The timeline value that will be signalled once the uploads have finished
+    ///
+    static uint64_t SubmitUploadList(const List<Upload>& uploadList);
+
+    ///
+    /// Mark the texture as loaded, once its upload has been submitted
+    ///
+    void FinishLoading(const Path& path);
+
+    ///
+    /// Take the image, view and sampler of another texture, such as one with a different number of
+    /// levels resident, the previous ones are destroyed once the GPU is done with them
+    ///
+    void ReplaceImage(Texture& other);
+
     void Free() override;
 
     bool Reload() override;
@@ -27,23 +97,75 @@ public:
         return true;
     }
 
+    ///
+    /// @return The size of the allocation of the image, including any padding for alignment
+    ///
+    size_t GetMemorySize() const override;
+
+    inline vk::Image GetImage() const {
+        return _image;
+    }
+
+    inline VmaAllocation GetAllocation() const {
+        return _allocation;
+    }
+
     inline vk::ImageView& GetImageView() {
         return _imageView;
     }
 
+    inline vk::Sampler GetSampler() const {
+        return (_sampler ? *_sampler : vk::Sampler());
+    }
+
+    inline vk::Format GetFormat() const {
+        return _format;
+    }
+
+    inline uint32_t GetWidth() const {
+        return _width;
+    }
+
+    inline uint32_t GetHeight() const {
+        return _height;
+    }
+
+    inline uint32_t GetMipLevels() const {
+        return _mipLevels;
+    }
+
 private:
 
+    vk::ImageCreateInfo getImageCreateInfo() const;
+
+    void createImageView();
+
+    void registerMovable();
+
     Path _path;
 
     vk::SamplerCreateInfo _samplerCreateInfo;
 
+    vk::Format _format = vk::Format::eUndefined;
+
+    uint32_t _width = 0;
+
+    uint32_t _height = 0;
+
+    uint32_t _mipLevels = 0;
+
     vk::Image _image = nullptr;
 
     VmaAllocation _allocation = nullptr;
 
     vk::ImageView _imageView = nullptr;
 
-    vk::Sampler _sampler = nullptr;
+    // Shared with every other texture using the same sampler state
+    SamplerCache::SamplerRef _sampler;
+
+public:
+
+    static void ScriptInit(py::module);
 
 }; // class Texture
 
@@ -0,0 +1,93 @@
+#ifndef RYME_TEXTURE_LOADER_HPP
+#define RYME_TEXTURE_LOADER_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/Texture.hpp>
+
+#include <functional>
+#include <memory>
+
+namespace ryme {
+
+///
+/// Asynchronous Texture Loading
+///
+/// Files are read in batches with AsyncIO, and each is decoded on the engine ThreadPool as soon as
+/// it has been read, then the textures that are ready are uploaded together once a frame, in a
+/// single submission. Callbacks are always called on the main
+/// thread, from Update().
+///
+namespace TextureLoader {
+
+///
+/// @param texture Check IsLoaded() to know whether loading succeeded
+///
+using CompleteFunc = std::function<void(Texture& texture)>;
+
+using ProgressFunc = std::function<void(size_t completedCount, size_t totalCount)>;
+
+///
+/// Start loading a texture
+///
+/// @return A texture that becomes loaded once its upload has been submitted
+///
+RYME_API
+std::shared_ptr<Texture> LoadAsync(
+    const Path& path,
+    vk::SamplerCreateInfo samplerCreateInfo = {},
+    CompleteFunc completeFunc = {},
+    bool search = true
+);
+
+///
+/// Start loading a group of textures
+///
+/// @param progressFunc Called each time a texture in the group finishes, successfully or not
+/// @param completeFunc Called once every texture in the group has finished
+/// @return The textures in the same order as pathList
+///
+RYME_API
+List<std::shared_ptr<Texture>> LoadAsync(
+    const List<Path>& pathList,
+    vk::SamplerCreateInfo samplerCreateInfo = {},
+    ProgressFunc progressFunc = {},
+    std::function<void()> completeFunc = {},
+    bool search = true
+);
+
+///
+/// Upload the textures that have been decoded, and finish the ones whose uploads are complete
+///
+/// Called once a frame by ryme::Run()
+///
+RYME_API
+void Update();
+
+///
+/// Block until every texture that has been requested has finished loading
+///
+RYME_API
+void Wait();
+
+///
+/// @return The number of textures that have been requested but not finished loading
+///
+RYME_API
+size_t GetPendingCount();
+
+///
+/// Limit the size of the textures uploaded each frame, at least one is always uploaded
+///
+RYME_API
+void SetUploadBudget(size_t bytes);
+
+RYME_API
+size_t GetUploadBudget();
+
+} // namespace TextureLoader
+
+} // namespace ryme
+
+#endif // RYME_TEXTURE_LOADER_HPP
\ No newline at end of file
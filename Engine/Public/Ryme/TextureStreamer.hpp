@@ -0,0 +1,121 @@
+#ifndef RYME_TEXTURE_STREAMER_HPP
+#define RYME_TEXTURE_STREAMER_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/Texture.hpp>
+
+#include <Ryme/ThirdParty/python.hpp>
+#include <Ryme/ThirdParty/vulkan.hpp>
+
+#include <memory>
+
+namespace ryme {
+
+///
+/// Texture Streaming
+///
+/// Streamed textures keep their full mip chain in system memory, but only the levels that are
+/// needed are resident on the GPU. The smallest levels are uploaded first, then more detailed levels
+/// are uploaded as Request() reports that the texture covers more of the screen. When a memory heap
+/// goes over its budget, the most detailed levels of the least recently used textures are evicted.
+///
+/// Changing the resident levels creates a new image and uploads them, the texture only switches to
+/// it once the upload has finished, so the previous levels can be sampled in the meantime.
+///
+namespace TextureStreamer {
+
+struct RYME_API Stats
+{
+    size_t TextureCount = 0;
+
+    // Size of the levels currently resident on the GPU
+    vk::DeviceSize ResidentSize = 0;
+
+    // Size of every level of every texture, as if they were all resident
+    vk::DeviceSize TotalSize = 0;
+
+    // Levels uploaded and evicted during the last Update()
+    size_t StreamedLevelCount = 0;
+
+    size_t EvictedLevelCount = 0;
+
+}; // struct Stats
+
+///
+/// Start streaming a texture, it becomes loaded once its smallest levels have been uploaded
+///
+RYME_API
+std::shared_ptr<Texture> Load(const Path& path, vk::SamplerCreateInfo samplerCreateInfo = {}, bool search = true);
+
+///
+/// Report that a texture is being used this frame, call this every frame the texture is drawn and
+/// before Update(), textures that aren't requested are the first to be evicted
+///
+/// @param screenSize The size in pixels of the texture on screen, along its largest dimension, the
+///   most detailed level uploaded is the one with about one texel per pixel
+///
+RYME_API
+void Request(const Texture& texture, float screenSize);
+
+///
+/// Register the textures that have been decoded, swap in the uploads that have finished, and then
+/// choose which levels to evict or upload next
+///
+/// Called once a frame by ryme::Run()
+///
+RYME_API
+void Update();
+
+///
+/// Stop streaming every texture, called by ryme::Term()
+///
+RYME_API
+void Term();
+
+///
+/// Limit how much of a memory heap streamed textures can fill, along with everything else in it
+///
+/// @param bytes The budget for the heap, or 0 to use 90% of the budget reported by the driver
+///
+RYME_API
+void SetHeapBudget(uint32_t heapIndex, vk::DeviceSize bytes);
+
+RYME_API
+vk::DeviceSize GetHeapBudget(uint32_t heapIndex);
+
+///
+/// Limit the size of the levels uploaded each frame, at least one texture is always updated
+///
+RYME_API
+void SetUploadBudget(size_t bytes);
+
+RYME_API
+size_t GetUploadBudget();
+
+///
+/// Levels this size and smaller are always resident, and are uploaded as soon as a texture loads
+///
+RYME_API
+void SetMinResidentSize(uint32_t size);
+
+RYME_API
+uint32_t GetMinResidentSize();
+
+///
+/// @return The most detailed level that is resident, 0 when the texture is fully resident
+///
+RYME_API
+uint32_t GetResidentLevel(const Texture& texture);
+
+RYME_API
+Stats GetStats();
+
+RYME_API
+void ScriptInit(py::module);
+
+} // namespace TextureStreamer
+
+} // namespace ryme
+
+#endif // RYME_TEXTURE_STREAMER_HPP
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef RYME_THREAD_POOL_HPP
+#define RYME_THREAD_POOL_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/NonCopyable.hpp>
+#include <Ryme/Queue.hpp>
+#include <Ryme/String.hpp>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ryme {
+
+///
+/// Fixed set of worker threads that run tasks in the order they were submitted
+///
+class RYME_API ThreadPool : NonCopyable
+{
+public:
+
+    ///
+    /// @param threadCount The number of worker threads, 0 uses one less than the number of cores,
+    ///   leaving one for the main thread
+    /// @param name Workers are named "{name} {index}" in the profiler
+    ///
+    ThreadPool(unsigned threadCount = 0, StringView name = "Worker");
+
+    ///
+    /// Finishes every task that was submitted, then joins the workers
+    ///
+    virtual ~ThreadPool();
+
+    void Submit(std::function<void()> task);
+
+    ///
+    /// Call func with every index from 0 to count - 1, spread across the workers and the calling
+    /// thread, and block until every call has returned
+    ///
+    /// Unlike Wait(), this does not wait for other tasks that were submitted to the pool.
+    ///
+    /// If func throws, the first exception is rethrown on the calling thread once every call has
+    /// returned.
+    ///
+    void ParallelFor(size_t count, std::function<void(size_t index)> func);
+
+    ///
+    /// Block until every task submitted so far has finished
+    ///
+    void Wait();
+
+    inline unsigned GetThreadCount() const {
+        return _threadList.size();
+    }
+
+private:
+
+    void workerMain(String name);
+
+    List<std::thread> _threadList;
+
+    std::mutex _mutex;
+
+    std::condition_variable _taskCondition;
+
+    std::condition_variable _idleCondition;
+
+    Queue<std::function<void()>> _taskQueue;
+
+    // Tasks that are queued or running
+    size_t _unfinishedTaskCount = 0;
+
+    bool _isStopping = false;
+
+}; // class ThreadPool
+
+///
+/// @return The pool shared by the engine, created by ryme::Init() and destroyed by ryme::Term()
+///
+RYME_API
+ThreadPool& GetThreadPool();
+
+} // namespace ryme
+
+#endif // RYME_THREAD_POOL_HPP
\ No newline at end of file
@@ -0,0 +1,154 @@
+#ifndef RYME_TRIANGLE_BVH_HPP
+#define RYME_TRIANGLE_BVH_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/Array.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/Math.hpp>
+#include <Ryme/NonCopyable.hpp>
+#include <Ryme/Ray.hpp>
+#include <Ryme/Span.hpp>
+#include <Ryme/ThreadPool.hpp>
+
+#include <Ryme/ThirdParty/python.hpp>
+
+namespace ryme {
+
+class MeshData;
+
+///
+/// A bounding volume hierarchy over the triangles of a mesh, kept in system memory to intersect rays
+/// with, such as for picking or line of sight
+///
+/// Each leaf holds up to four triangles, which are tested against a ray at the same time. Triangles
+/// are hit from both sides.
+///
+class RYME_API TriangleBVH : public NonCopyable
+{
+public:
+
+    static inline const uint32_t LeafTriangleCount = 4;
+
+    TriangleBVH() = default;
+
+    ///
+    /// Build from the full detail triangles of a mesh
+    ///
+    TriangleBVH(const MeshData& data);
+
+    TriangleBVH(Span<const Vec3> positionList, Span<const uint32_t> indexList);
+
+    TriangleBVH(TriangleBVH&&) = default;
+
+    virtual ~TriangleBVH() = default;
+
+    ///
+    /// @param indexList Three indices into positionList for each triangle
+    ///
+    void Build(Span<const Vec3> positionList, Span<const uint32_t> indexList);
+
+    ///
+    /// Find the closest triangle hit by the ray, closer than both ray.MaxDistance and hit.Distance
+    ///
+    /// @return True if a triangle was hit, and hit was filled in
+    ///
+    bool Intersect(const Ray& ray, RayHit& hit) const;
+
+    ///
+    /// Stop at the first triangle hit by the ray, for line of sight
+    ///
+    bool IntersectAny(const Ray& ray) const;
+
+    ///
+    /// Find the closest hit of every ray, split across threadPool when there is one
+    ///
+    /// @param hitList Must be as long as rayList, each hit is reset before the ray is tested
+    ///
+    void IntersectList(Span<const Ray> rayList, Span<RayHit> hitList, ThreadPool * threadPool = nullptr) const;
+
+    inline uint32_t GetTriangleCount() const {
+        return _triangleCount;
+    }
+
+    inline size_t GetNodeCount() const {
+        return _nodeList.size();
+    }
+
+    inline Vec3 GetBoundsMin() const {
+        return (_nodeList.empty() ? Vec3(0.0f) : _nodeList[0].Min);
+    }
+
+    inline Vec3 GetBoundsMax() const {
+        return (_nodeList.empty() ? Vec3(0.0f) : _nodeList[0].Max);
+    }
+
+private:
+
+    struct Node
+    {
+        Vec3 Min;
+
+        // The first of two children next to each other, or the packet of a leaf
+        uint32_t First;
+
+        Vec3 Max;
+
+        // The number of triangles in a leaf, 0 for internal nodes
+        uint32_t TriangleCount;
+
+    }; // struct Node
+
+    // The triangles of a leaf, with each component in its own row to be loaded four at a time.
+    // Unused triangles are left with no area, so they are never hit
+    struct alignas(16) TrianglePacket
+    {
+        Array<Array<float, 4>, 3> Vertex0;
+
+        Array<Array<float, 4>, 3> Edge1;
+
+        Array<Array<float, 4>, 3> Edge2;
+
+        Array<uint32_t, 4> TriangleList;
+
+    }; // struct TrianglePacket
+
+    struct BuildTriangle
+    {
+        Vec3 Min;
+
+        uint32_t Triangle;
+
+        Vec3 Max;
+
+    }; // struct BuildTriangle
+
+    void buildNode(
+        uint32_t index,
+        BuildTriangle * triangleList,
+        size_t triangleCount,
+        uint32_t depth,
+        Span<const Vec3> positionList,
+        Span<const uint32_t> indexList
+    );
+
+    template <bool Any>
+    bool intersect(const Ray& ray, RayHit& hit) const;
+
+    // Test the triangles of a packet, and fill in hit with the closest one nearer than maxDistance
+    static bool intersectPacket(const TrianglePacket& packet, const Ray& ray, float maxDistance, RayHit& hit);
+
+    uint32_t _triangleCount = 0;
+
+    List<Node> _nodeList;
+
+    List<TrianglePacket> _packetList;
+
+public:
+
+    static void ScriptInit(py::module);
+
+}; // class TriangleBVH
+
+} // namespace ryme
+
+#endif // RYME_TRIANGLE_BVH_HPP
\ No newline at end of file
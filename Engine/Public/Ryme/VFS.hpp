@@ -0,0 +1,197 @@
+#ifndef RYME_VFS_HPP
+#define RYME_VFS_HPP
+
+#include <Ryme/Config.hpp>
+#include <Ryme/List.hpp>
+#include <Ryme/MappedFile.hpp>
+#include <Ryme/NonCopyable.hpp>
+#include <Ryme/Path.hpp>
+#include <Ryme/Span.hpp>
+#include <Ryme/String.hpp>
+
+#include <functional>
+#include <memory>
+
+namespace ryme {
+
+///
+/// Virtual File System
+///
+/// The directories and archives that assets are loaded from are mounted and scanned once, into an
+/// index of every file by its path relative to the mount. Searching for an asset is then a single
+/// lookup, instead of trying to open it in each directory in turn.
+///
+/// The asset paths from GetAssetPathList() are mounted the first time the VFS is used, each as a
+/// directory or an Archive. When the same relative path is in more than one mount, the file in the
+/// last one mounted is used.
+///
+namespace VFS {
+
+///
+/// The contents of a file, mapped into memory or held in a buffer, for as long as it is open
+///
+/// The data is aligned to at least 16 bytes, so it can be read as words directly.
+///
+class RYME_API File : public NonCopyable
+{
+public:
+
+    File() = default;
+
+    File(MappedFile&& mappedFile, const Path& path);
+
+    ///
+    /// @param owner Kept alive for as long as the file, such as the mapping of an archive data points into
+    ///
+    File(std::shared_ptr<const void> owner, Span<const uint8_t> data, const Path& path);
+
+    File(List<uint8_t>&& data, const Path& path);
+
+    File(File&& rhs);
+
+    virtual ~File() = default;
+
+    File& operator=(File&& rhs);
+
+    inline bool IsOpen() const {
+        return _isOpen;
+    }
+
+    inline const uint8_t * GetData() const {
+        return _data;
+    }
+
+    inline size_t GetSize() const {
+        return _size;
+    }
+
+    inline Span<const uint8_t> GetSpan() const {
+        return { _data, _size };
+    }
+
+    inline StringView GetString() const {
+        return { reinterpret_cast<const char *>(_data), _size };
+    }
+
+    ///
+    /// @return The full path of the file, which opens it again without searching
+    ///
+    inline const Path& GetPath() const {
+        return _path;
+    }
+
+private:
+
+    bool _isOpen = false;
+
+    const uint8_t * _data = nullptr;
+
+    size_t _size = 0;
+
+    Path _path;
+
+    MappedFile _mappedFile;
+
+    std::shared_ptr<const void> _owner;
+
+    List<uint8_t> _buffer;
+
+}; // class File
+
+///
+/// A directory or archive whose files can be found through the VFS
+///
+class RYME_API Mount : public NonCopyable
+{
+public:
+
+    virtual ~Mount() = default;
+
+    ///
+    /// @return The absolute path of the directory or archive, the full path of each file in the
+    ///   mount starts with it
+    ///
+    virtual const Path& GetPath() const = 0;
+
+    ///
+    /// Call func with the path of every file in the mount, relative to the mount
+    ///
+    virtual void Scan(const std::function<void(const Path&)>& func) = 0;
+
+    ///
+    /// @param relativePath Normalized, without any "." or ".." components
+    ///
+    virtual File Open(const Path& relativePath) = 0;
+
+}; // class Mount
+
+///
+/// @return False if path is not a directory
+///
+RYME_API
+bool MountDirectory(const Path& path);
+
+///
+/// @return False if path could not be opened or is not a valid archive, which is logged
+///
+RYME_API
+bool MountArchive(const Path& path);
+
+///
+/// Scan a mount, and add its files to the index
+///
+RYME_API
+void AddMount(std::shared_ptr<Mount> mount);
+
+///
+/// @return False if nothing is mounted at path
+///
+RYME_API
+bool Unmount(const Path& path);
+
+///
+/// Scan every mount again, for files that have been added or removed since they were mounted
+///
+RYME_API
+void Rescan();
+
+///
+/// @param search Find path in the index, otherwise it is opened as a full path, which may be in an archive
+/// @return A file that is not open if it could not be found
+///
+RYME_API
+File Open(const Path& path, bool search = true);
+
+///
+/// @return The full path of the file indexed at path, or an empty path if there is none
+///
+RYME_API
+Path Resolve(const Path& path);
+
+RYME_API
+bool Exists(const Path& path);
+
+///
+/// Find the version of an asset processed ahead of time by RymeCook, which is stored next to it
+/// with an extra extension, such as "Models/Cube.obj.rmesh" for "Models/Cube.obj"
+///
+/// A cooked file in a mount with a lower priority than the source is ignored, as it would be
+/// for a different file.
+///
+/// @param extension The extension of the cooked format, without the "."
+/// @return The path of the cooked file, or path if there is none
+///
+RYME_API
+Path GetCookedPath(const Path& path, StringView extension);
+
+///
+/// @return The number of files in the index
+///
+RYME_API
+size_t GetFileCount();
+
+} // namespace VFS
+
+} // namespace ryme
+
+#endif // RYME_VFS_HPP
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include <Ryme/Archive.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Profiler.hpp>
+#include <Ryme/Set.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+
+using namespace ryme;
+
+// Pack the files of one or more asset directories into a single archive, which the VFS can mount
+// in place of the directories
+
+void printUsage()
+{
+    fmt::print(
+        "usage: " TOOL_NAME " [--compress EXT,...] [--exclude EXT,...] [--alignment N] OUTPUT INPUT_DIR...\n"
+        "\n"
+        "  --compress   Compress files with these extensions, if that makes them smaller\n"
+        "  --exclude    Skip files with these extensions\n"
+        "  --alignment  Align every file to N bytes, a power of two of at least 16, defaults to 16\n"
+        "\n"
+        "When the same file is in more than one input directory, the first one is used, the same as\n"
+        "searching the asset path.\n"
+    );
+}
+
+std::filesystem::path getFilesystemPath(const Path& path)
+{
+    const String& str = path.ToString();
+    return std::filesystem::path(std::u8string(reinterpret_cast<const char8_t *>(str.data()), str.size()));
+}
+
+String getString(const std::u8string& str)
+{
+    return String(reinterpret_cast<const char *>(str.data()), str.size());
+}
+
+Set<String> getExtensionSet(StringView list)
+{
+    Set<String> extensionSet;
+
+    for (const auto& extension : Split(list, ",")) {
+        if (not extension.empty()) {
+            extensionSet.insert(extension);
+        }
+    }
+
+    return extensionSet;
+}
+
+int main(int argc, char ** argv)
+{
+    Set<String> compressSet;
+    Set<String> excludeSet;
+    uint32_t alignment = Archive::DefaultAlignment;
+
+    List<Path> pathList;
+
+    for (int i = 1; i < argc; ++i) {
+        StringView arg = argv[i];
+
+        if (arg == "--compress" and i + 1 < argc) {
+            compressSet = getExtensionSet(argv[++i]);
+        }
+        else if (arg == "--exclude" and i + 1 < argc) {
+            excludeSet = getExtensionSet(argv[++i]);
+        }
+        else if (arg == "--alignment" and i + 1 < argc) {
+            alignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--help" or arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else {
+            pathList.push_back(Path(arg));
+        }
+    }
+
+    if (pathList.size() < 2) {
+        printUsage();
+        return 1;
+    }
+
+    const Path& outputPath = pathList[0];
+
+    try {
+        ProfileZone zone("Pack", true);
+
+        ArchiveWriter writer(alignment);
+
+        for (size_t i = 1; i < pathList.size(); ++i) {
+            std::error_code error;
+
+            std::filesystem::path root = getFilesystemPath(pathList[i]);
+            if (not std::filesystem::is_directory(root, error)) {
+                Log(TOOL_NAME, "Skipping '{}', which is not a directory", pathList[i]);
+                continue;
+            }
+
+            // Sorted, so the same files always produce the same archive
+            List<std::filesystem::path> fileList;
+
+            std::filesystem::recursive_directory_iterator it(root, error), end;
+            for (; not error and it != end; it.increment(error)) {
+                if (it->is_regular_file(error)) {
+                    fileList.push_back(it->path());
+                }
+            }
+
+            if (error) {
+                Log(TOOL_NAME, "Failed to scan '{}': {}", pathList[i], error.message());
+                return 1;
+            }
+
+            std::sort(fileList.begin(), fileList.end());
+
+            for (const auto& file : fileList) {
+                String name = getString(file.lexically_relative(root).generic_u8string());
+                Path filePath(getString(file.u8string()));
+
+                String extension = filePath.GetExtension().ToString();
+
+                if (excludeSet.contains(extension) or extension == Archive::Extension) {
+                    continue;
+                }
+
+                // Files already added from an earlier directory take priority
+                writer.AddFile(name, filePath, compressSet.contains(extension));
+            }
+        }
+
+        if (not writer.Write(outputPath)) {
+            Log(TOOL_NAME, "Failed to write '{}'", outputPath);
+            return 1;
+        }
+
+        double milliseconds = zone.End();
+
+        Log(TOOL_NAME, "Packed {} files into '{}' in {:.1f} ms, {} KiB -> {} KiB",
+            writer.GetEntryCount(),
+            outputPath,
+            milliseconds,
+            writer.GetSize() / 1024,
+            writer.GetStoredSize() / 1024
+        );
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+        return 1;
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,568 @@
+#include <Ryme/Hash.hpp>
+#include <Ryme/ImageData.hpp>
+#include <Ryme/JSON.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Model.hpp>
+#include <Ryme/ModelData.hpp>
+#include <Ryme/Profiler.hpp>
+#include <Ryme/Set.hpp>
+#include <Ryme/Shader.hpp>
+#include <Ryme/ThreadPool.hpp>
+#include <Ryme/VFS.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+
+using namespace ryme;
+
+// Convert the models, images and shaders of one or more asset directories into the formats that are
+// loaded at runtime, so that work isn't repeated every time they are loaded. Each cooked file is
+// stored under the output directory at the path of its source, with the extension of its format
+// added, where the VFS looks for it first.
+//
+// Cook.json in the output directory records the content hash of every source and of every file it
+// depends on, such as the MTL files of an OBJ, so only the assets that have changed are cooked again.
+
+// Increment when what is cooked, or how, changes, to cook everything again
+const int CookVersion = 1;
+
+void printUsage()
+{
+    fmt::print(
+        "usage: " TOOL_NAME " [--output DIR] [--force] [--jobs N] INPUT_DIR...\n"
+        "\n"
+        "  --output  Write the cooked assets and Cook.json to DIR, defaults to Cooked\n"
+        "  --force   Cook every asset, even if it hasn't changed\n"
+        "  --jobs    Cook with N worker threads as well as the main thread, defaults to one less than\n"
+        "            the number of cores\n"
+        "\n"
+        "  obj                  -> .rmesh, indexed with tangents and LODs\n"
+        "  png, jpg, tga, bmp   -> .ktx2, BC7 with a full mip chain\n"
+        "  spv                  -> .spv, with its .reflect reflection cache\n"
+        "\n"
+        "When the same file is in more than one input directory, the first one is used, the same as\n"
+        "searching the asset path.\n"
+    );
+}
+
+std::filesystem::path getFilesystemPath(const Path& path)
+{
+    const String& str = path.ToString();
+    return std::filesystem::path(std::u8string(reinterpret_cast<const char8_t *>(str.data()), str.size()));
+}
+
+String getString(const std::u8string& str)
+{
+    return String(reinterpret_cast<const char *>(str.data()), str.size());
+}
+
+enum class CookType
+{
+    None,
+
+    Model,
+
+    Image,
+
+    Shader,
+
+}; // enum class CookType
+
+CookType getCookType(StringView extension)
+{
+    if (extension == "obj") {
+        return CookType::Model;
+    }
+    else if (extension == "png" or extension == "jpg" or extension == "jpeg" or extension == "tga" or extension == "bmp") {
+        return CookType::Image;
+    }
+    else if (extension == "spv") {
+        return CookType::Shader;
+    }
+
+    return CookType::None;
+}
+
+struct CookAsset
+{
+    // The path relative to the input directory, with '/' separators
+    String Name;
+
+    Path SourcePath;
+
+    CookType Type;
+
+    String Hash;
+
+    // Relative to the output directory, with '/' separators
+    List<String> OutputList;
+
+    // The content hash of every other file that was read, by full path
+    std::map<String, String> DependencyMap;
+
+    bool IsCooked = false;
+
+    bool IsFailed = false;
+
+}; // struct CookAsset
+
+String getContentHash(Span<const uint8_t> data)
+{
+    return fmt::format("{:016X}", Hash64(data));
+}
+
+// @return An empty string if the file can't be read
+String getFileHash(const Path& path)
+{
+    VFS::File file = VFS::Open(path, false);
+    if (not file.IsOpen()) {
+        return String();
+    }
+
+    return getContentHash(file.GetSpan());
+}
+
+// Check the entry for an asset in the last manifest against its current source, dependencies and outputs
+bool isUpToDate(const CookAsset& asset, const JSON& entry, const Path& outputPath)
+{
+    if (not entry.is_object()) {
+        return false;
+    }
+
+    auto hash = entry.find("Hash");
+    if (hash == entry.end() or not hash->is_string() or hash->get<String>() != asset.Hash) {
+        return false;
+    }
+
+    auto outputList = entry.find("Outputs");
+    if (outputList == entry.end() or not outputList->is_array() or outputList->empty()) {
+        return false;
+    }
+
+    for (const auto& output : *outputList) {
+        std::error_code error;
+
+        if (not output.is_string()
+            or not std::filesystem::is_regular_file(getFilesystemPath(outputPath / output.get<String>()), error)) {
+            return false;
+        }
+    }
+
+    auto dependencyMap = entry.find("Dependencies");
+    if (dependencyMap != entry.end()) {
+        if (not dependencyMap->is_object()) {
+            return false;
+        }
+
+        for (const auto& [dependency, dependencyHash] : dependencyMap->items()) {
+            if (not dependencyHash.is_string() or getFileHash(Path(dependency)) != dependencyHash.get<String>()) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool createParentDirectory(const Path& path)
+{
+    std::error_code error;
+    std::filesystem::create_directories(getFilesystemPath(path).parent_path(), error);
+    return not error;
+}
+
+bool cookModel(CookAsset& asset, const VFS::File& file, const Path& outputPath)
+{
+    ModelData modelData;
+    if (not LoadModelData(file.GetSpan(), file.GetPath(), modelData)) {
+        return false;
+    }
+
+    // Generated here, so they are loaded instead of being generated every time
+    const auto& lodRatioList = Model::GetLODRatioList();
+
+    if (not lodRatioList.empty()) {
+        for (auto& meshData : modelData.MeshList) {
+            meshData.GenerateLODs(lodRatioList);
+        }
+    }
+
+    for (const auto& dependency : modelData.DependencyList) {
+        String dependencyHash = getFileHash(dependency);
+        if (dependencyHash.empty()) {
+            return false;
+        }
+
+        asset.DependencyMap[dependency.ToString()] = dependencyHash;
+    }
+
+    String output = asset.Name + ".rmesh";
+    Path modelPath = outputPath / output;
+
+    if (not createParentDirectory(modelPath) or not SaveRMESH(modelPath, modelData)) {
+        return false;
+    }
+
+    asset.OutputList.push_back(output);
+
+    return true;
+}
+
+bool cookImage(CookAsset& asset, const VFS::File& file, const Path& outputPath)
+{
+    ImageData imageData;
+    if (not LoadImageData(file.GetSpan(), file.GetPath(), imageData)) {
+        return false;
+    }
+
+    // Decoded as sRGB the same as when it is loaded at runtime, so it looks the same either way
+    GenerateMipmaps(imageData);
+    CompressImageData(imageData, vk::Format::eBc7SrgbBlock);
+
+    String output = asset.Name + ".ktx2";
+    Path imagePath = outputPath / output;
+
+    if (not createParentDirectory(imagePath) or not SaveKTX2(imagePath, imageData)) {
+        return false;
+    }
+
+    asset.OutputList.push_back(output);
+
+    return true;
+}
+
+bool cookShader(CookAsset& asset, const VFS::File& file, const Path& outputPath)
+{
+    // Copied alongside its reflection cache, which is found next to whichever SPIR-V file is loaded
+    Path shaderPath = outputPath / asset.Name;
+
+    if (not createParentDirectory(shaderPath)) {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::copy_file(
+        getFilesystemPath(file.GetPath()),
+        getFilesystemPath(shaderPath),
+        std::filesystem::copy_options::overwrite_existing,
+        error
+    );
+
+    if (error) {
+        return false;
+    }
+
+    if (not Shader::CookReflectionCache(file.GetSpan(), file.GetPath(), shaderPath + ".reflect")) {
+        return false;
+    }
+
+    asset.OutputList.push_back(asset.Name);
+    asset.OutputList.push_back(asset.Name + ".reflect");
+
+    return true;
+}
+
+void cookAsset(CookAsset& asset, const JSON * entry, const Path& outputPath)
+{
+    VFS::File file = VFS::Open(asset.SourcePath, false);
+    if (not file.IsOpen()) {
+        Log(TOOL_NAME, "Failed to read '{}'", asset.SourcePath);
+        asset.IsFailed = true;
+        return;
+    }
+
+    asset.Hash = getContentHash(file.GetSpan());
+
+    if (entry and isUpToDate(asset, *entry, outputPath)) {
+        for (const auto& output : entry->at("Outputs")) {
+            asset.OutputList.push_back(output.get<String>());
+        }
+
+        auto dependencyMap = entry->find("Dependencies");
+        if (dependencyMap != entry->end()) {
+            for (const auto& [dependency, dependencyHash] : dependencyMap->items()) {
+                asset.DependencyMap[dependency] = dependencyHash.get<String>();
+            }
+        }
+
+        return;
+    }
+
+    bool cooked = false;
+
+    try {
+        switch (asset.Type) {
+        case CookType::Model:
+            cooked = cookModel(asset, file, outputPath);
+            break;
+        case CookType::Image:
+            cooked = cookImage(asset, file, outputPath);
+            break;
+        case CookType::Shader:
+            cooked = cookShader(asset, file, outputPath);
+            break;
+        default:
+            break;
+        }
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+    }
+
+    if (cooked) {
+        Log(TOOL_NAME, "Cooked '{}'", asset.Name);
+        asset.IsCooked = true;
+    }
+    else {
+        Log(TOOL_NAME, "Failed to cook '{}'", asset.SourcePath);
+        asset.IsFailed = true;
+    }
+}
+
+JSON readManifest(const Path& path)
+{
+    VFS::File file = VFS::Open(path, false);
+    if (not file.IsOpen()) {
+        return JSON();
+    }
+
+    // An unreadable manifest is the same as none, and everything is cooked again
+    JSON manifest = JSON::parse(file.GetString(), nullptr, false);
+
+    if (not manifest.is_object()
+        or manifest.value("Version", 0) != CookVersion
+        or not manifest.contains("Assets")
+        or not manifest["Assets"].is_object()) {
+        return JSON();
+    }
+
+    return manifest;
+}
+
+bool writeManifest(const Path& path, const JSON& manifest)
+{
+    String text = manifest.dump(4);
+
+    // Written to a temporary file first, so an interrupted cook never leaves half of a manifest
+    return WriteFileReplacing(path, [&](FILE * file) {
+        fwrite(text.data(), 1, text.size(), file);
+        return true;
+    });
+}
+
+int main(int argc, char ** argv)
+{
+    Path outputPath = "Cooked";
+    bool force = false;
+    unsigned jobCount = 0;
+
+    List<Path> pathList;
+
+    for (int i = 1; i < argc; ++i) {
+        StringView arg = argv[i];
+
+        if (arg == "--output" and i + 1 < argc) {
+            outputPath = Path(argv[++i]);
+        }
+        else if (arg == "--force") {
+            force = true;
+        }
+        else if (arg == "--jobs" and i + 1 < argc) {
+            jobCount = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--help" or arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else {
+            pathList.push_back(Path(arg));
+        }
+    }
+
+    if (pathList.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        ProfileZone zone("Cook", true);
+
+        std::error_code error;
+
+        std::filesystem::path outputRoot = getFilesystemPath(outputPath);
+        std::filesystem::create_directories(outputRoot, error);
+
+        if (error) {
+            Log(TOOL_NAME, "Failed to create '{}': {}", outputPath, error.message());
+            return 1;
+        }
+
+        List<CookAsset> assetList;
+        Set<String> nameSet;
+
+        for (const auto& path : pathList) {
+            std::filesystem::path root = getFilesystemPath(path);
+            if (not std::filesystem::is_directory(root, error)) {
+                Log(TOOL_NAME, "Skipping '{}', which is not a directory", path);
+                continue;
+            }
+
+            // Sorted, so assets are always cooked and recorded in the same order
+            List<std::filesystem::path> fileList;
+
+            std::filesystem::recursive_directory_iterator it(root, error), end;
+            for (; not error and it != end; it.increment(error)) {
+                // The output directory may be inside an input directory
+                if (it->is_directory(error) and std::filesystem::equivalent(it->path(), outputRoot, error)) {
+                    it.disable_recursion_pending();
+                }
+                else if (it->is_regular_file(error)) {
+                    fileList.push_back(it->path());
+                }
+            }
+
+            if (error) {
+                Log(TOOL_NAME, "Failed to scan '{}': {}", path, error.message());
+                return 1;
+            }
+
+            std::sort(fileList.begin(), fileList.end());
+
+            for (const auto& file : fileList) {
+                String name = getString(file.lexically_relative(root).generic_u8string());
+                Path filePath(getString(file.u8string()));
+
+                CookType type = getCookType(filePath.GetExtension().ToString());
+
+                // Files already found in an earlier directory take priority
+                if (type == CookType::None or not nameSet.insert(name).second) {
+                    continue;
+                }
+
+                assetList.push_back(CookAsset{
+                    .Name = name,
+                    .SourcePath = filePath,
+                    .Type = type,
+                });
+            }
+        }
+
+        Path manifestPath = outputPath / "Cook.json";
+
+        JSON lastManifest = (force ? JSON() : readManifest(manifestPath));
+
+        const JSON * lastAssetMap = (lastManifest.is_object() ? &lastManifest["Assets"] : nullptr);
+
+        {
+            ThreadPool threadPool(jobCount, "Cook");
+
+            threadPool.ParallelFor(assetList.size(), [&](size_t index) {
+                auto& asset = assetList[index];
+
+                const JSON * entry = nullptr;
+
+                if (lastAssetMap) {
+                    auto it = lastAssetMap->find(asset.Name);
+                    if (it != lastAssetMap->end()) {
+                        entry = &(*it);
+                    }
+                }
+
+                cookAsset(asset, entry, outputPath);
+            });
+        }
+
+        JSON assetMap = JSON::object();
+        Set<String> outputSet;
+
+        size_t cookedCount = 0;
+        size_t failedCount = 0;
+
+        for (const auto& asset : assetList) {
+            if (asset.IsFailed) {
+                // Not recorded, so it is cooked again next time
+                ++failedCount;
+                continue;
+            }
+
+            if (asset.IsCooked) {
+                ++cookedCount;
+            }
+
+            JSON dependencyMap = JSON::object();
+            for (const auto& [dependency, dependencyHash] : asset.DependencyMap) {
+                dependencyMap[dependency] = dependencyHash;
+            }
+
+            assetMap[asset.Name] = {
+                { "Hash", asset.Hash },
+                { "Outputs", asset.OutputList },
+                { "Dependencies", dependencyMap },
+            };
+
+            outputSet.insert(asset.OutputList.begin(), asset.OutputList.end());
+        }
+
+        // Remove what was cooked from sources that have since been removed, or that failed to cook, so
+        // they aren't loaded in place of the current source
+        size_t removedCount = 0;
+
+        if (lastAssetMap) {
+            for (const auto& [name, entry] : lastAssetMap->items()) {
+                if (not entry.is_object()) {
+                    continue;
+                }
+
+                auto outputList = entry.find("Outputs");
+                if (outputList == entry.end() or not outputList->is_array()) {
+                    continue;
+                }
+
+                for (const auto& output : *outputList) {
+                    if (output.is_string() and not outputSet.contains(output.get<String>())) {
+                        if (std::filesystem::remove(getFilesystemPath(outputPath / output.get<String>()), error)) {
+                            ++removedCount;
+                        }
+                    }
+                }
+            }
+        }
+
+        JSON manifest = {
+            { "Version", CookVersion },
+            { "Assets", assetMap },
+        };
+
+        if (not writeManifest(manifestPath, manifest)) {
+            Log(TOOL_NAME, "Failed to write '{}'", manifestPath);
+            return 1;
+        }
+
+        double milliseconds = zone.End();
+
+        Log(TOOL_NAME, "Cooked {} of {} assets into '{}' in {:.1f} ms, {} up to date, {} failed, {} removed",
+            cookedCount,
+            assetList.size(),
+            outputPath,
+            milliseconds,
+            assetList.size() - cookedCount - failedCount,
+            failedCount,
+            removedCount
+        );
+
+        if (failedCount > 0) {
+            return 1;
+        }
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+        return 1;
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file
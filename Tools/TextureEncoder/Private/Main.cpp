@@ -0,0 +1,140 @@
+#include <Ryme/BlockCompression.hpp>
+#include <Ryme/ImageData.hpp>
+#include <Ryme/Log.hpp>
+#include <Ryme/Profiler.hpp>
+
+using namespace ryme;
+
+// Convert PNG, JPG, or anything else stb_image can read into a block compressed KTX2 file with a
+// full mip chain, ready to be uploaded without decoding
+
+void printUsage()
+{
+    fmt::print(
+        "usage: " TOOL_NAME " [--format bc1|bc3|bc4|bc5|bc7] [--linear] [--no-mips] INPUT OUTPUT\n"
+        "\n"
+        "  --format   Block compression format, defaults to bc7\n"
+        "  --linear   Treat the input as linear data, such as a normal or roughness map, instead of sRGB\n"
+        "  --no-mips  Only store the first level\n"
+    );
+}
+
+vk::Format getFormat(StringView name, bool linear)
+{
+    if (name == "bc1") {
+        return (linear ? vk::Format::eBc1RgbUnormBlock : vk::Format::eBc1RgbSrgbBlock);
+    }
+    else if (name == "bc3") {
+        return (linear ? vk::Format::eBc3UnormBlock : vk::Format::eBc3SrgbBlock);
+    }
+    else if (name == "bc4") {
+        return vk::Format::eBc4UnormBlock;
+    }
+    else if (name == "bc5") {
+        return vk::Format::eBc5UnormBlock;
+    }
+    else if (name == "bc7") {
+        return (linear ? vk::Format::eBc7UnormBlock : vk::Format::eBc7SrgbBlock);
+    }
+
+    return vk::Format::eUndefined;
+}
+
+int main(int argc, char ** argv)
+{
+    String formatName = "bc7";
+    bool linear = false;
+    bool mips = true;
+
+    List<Path> pathList;
+
+    for (int i = 1; i < argc; ++i) {
+        StringView arg = argv[i];
+
+        if (arg == "--format" and i + 1 < argc) {
+            formatName = argv[++i];
+        }
+        else if (arg == "--linear") {
+            linear = true;
+        }
+        else if (arg == "--no-mips") {
+            mips = false;
+        }
+        else if (arg == "--help" or arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else {
+            pathList.push_back(Path(arg));
+        }
+    }
+
+    if (pathList.size() != 2) {
+        printUsage();
+        return 1;
+    }
+
+    // BC4 and BC5 only store one and two channels, so they are always linear
+    vk::Format format = getFormat(formatName, linear);
+    if (format == vk::Format::eUndefined) {
+        Log(TOOL_NAME, "Unknown format '{}'", formatName);
+        return 1;
+    }
+
+    const Path& inputPath = pathList[0];
+    const Path& outputPath = pathList[1];
+
+    try {
+        ProfileZone zone("Encode", true);
+
+        ImageData imageData;
+        if (not LoadImageData(inputPath, imageData)) {
+            Log(TOOL_NAME, "Failed to load '{}'", inputPath);
+            return 1;
+        }
+
+        if (imageData.Format != vk::Format::eR8G8B8A8Srgb) {
+            Log(TOOL_NAME, "'{}' is already {}", inputPath, vk::to_string(imageData.Format));
+            return 1;
+        }
+
+        if (linear) {
+            imageData.Format = vk::Format::eR8G8B8A8Unorm;
+        }
+
+        if (mips) {
+            GenerateMipmaps(imageData);
+        }
+
+        size_t uncompressedSize = imageData.Data.size();
+
+        CompressImageData(imageData, format);
+
+        if (not SaveKTX2(outputPath, imageData)) {
+            Log(TOOL_NAME, "Failed to write '{}'", outputPath);
+            return 1;
+        }
+
+        double milliseconds = zone.End();
+
+        Log(TOOL_NAME, "Encoded '{}' {}x{} with {} levels as {} in {:.1f} ms, {} KiB -> {} KiB ({:.1f}x smaller)",
+            inputPath,
+            imageData.Width,
+            imageData.Height,
+            imageData.MipLevelList.size(),
+            vk::to_string(format),
+            milliseconds,
+            uncompressedSize / 1024,
+            imageData.Data.size() / 1024,
+            double(uncompressedSize) / double(imageData.Data.size())
+        );
+    }
+    catch (const std::exception& e) {
+        Log("Exception", "{}", e.what());
+        return 1;
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
\ No newline at end of file